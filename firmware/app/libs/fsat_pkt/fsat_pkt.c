@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.8.21
+ * \version 0.10.2
  * 
  * \date 2020/03/14
  * 
@@ -121,4 +121,120 @@ void fsat_pkt_decode(uint8_t *raw_pkt, uint16_t len, fsat_pkt_pl_t *pkt)
     pkt->length = len - 7U - 1U;
 }
 
+int fsat_pkt_builder_init(fsat_pkt_builder_t *b, uint8_t *buf, uint16_t size, uint8_t id, const char *callsign)
+{
+    b->buf  = buf;
+    b->size = size;
+    b->len  = 0U;
+    b->err  = -1;
+
+    size_t cs_len = strlen(callsign);
+
+    if ((size >= FSAT_PKT_HEADER_LEN) && (cs_len <= FSAT_PKT_CALLSIGN_LEN))
+    {
+        /* Packet ID */
+        buf[0] = id;
+
+        /* Callsign */
+        memset(&buf[1], FSAT_PKT_CALLSIGN_PADDING_CHAR, FSAT_PKT_CALLSIGN_LEN - cs_len);
+        memcpy(&buf[1U + FSAT_PKT_CALLSIGN_LEN - cs_len], callsign, cs_len);
+
+        b->len = FSAT_PKT_HEADER_LEN;
+        b->err = 0;
+    }
+
+    return b->err;
+}
+
+void fsat_pkt_builder_put_callsign(fsat_pkt_builder_t *b, const uint8_t *callsign, uint8_t len)
+{
+    if ((b->err == 0) && (len <= FSAT_PKT_CALLSIGN_LEN) && (FSAT_PKT_CALLSIGN_LEN <= (uint16_t)(b->size - b->len)))
+    {
+        memset(&b->buf[b->len], FSAT_PKT_CALLSIGN_PADDING_CHAR, FSAT_PKT_CALLSIGN_LEN - len);
+        memcpy(&b->buf[b->len + FSAT_PKT_CALLSIGN_LEN - len], callsign, len);
+        b->len += FSAT_PKT_CALLSIGN_LEN;
+    }
+    else
+    {
+        b->err = -1;
+    }
+}
+
+void fsat_pkt_builder_put_u8(fsat_pkt_builder_t *b, uint8_t val)
+{
+    if ((b->err == 0) && (b->len < b->size))
+    {
+        b->buf[b->len] = val;
+        b->len++;
+    }
+    else
+    {
+        b->err = -1;
+    }
+}
+
+void fsat_pkt_builder_put_u16(fsat_pkt_builder_t *b, uint16_t val)
+{
+    fsat_pkt_builder_put_u8(b, (uint8_t)((val >> 8) & 0xFFU));
+    fsat_pkt_builder_put_u8(b, (uint8_t)(val & 0xFFU));
+}
+
+void fsat_pkt_builder_put_u32(fsat_pkt_builder_t *b, uint32_t val)
+{
+    fsat_pkt_builder_put_u8(b, (uint8_t)((val >> 24) & 0xFFU));
+    fsat_pkt_builder_put_u8(b, (uint8_t)((val >> 16) & 0xFFU));
+    fsat_pkt_builder_put_u8(b, (uint8_t)((val >> 8) & 0xFFU));
+    fsat_pkt_builder_put_u8(b, (uint8_t)(val & 0xFFU));
+}
+
+void fsat_pkt_builder_put_bytes(fsat_pkt_builder_t *b, const uint8_t *data, uint16_t len)
+{
+    if ((b->err == 0) && (len <= (b->size - b->len)))
+    {
+        memcpy(&b->buf[b->len], data, len);
+        b->len += len;
+    }
+    else
+    {
+        b->err = -1;
+    }
+}
+
+int fsat_pkt_builder_finish(const fsat_pkt_builder_t *b, uint16_t *len)
+{
+    *len = b->len;
+
+    return b->err;
+}
+
+int fsat_pkt_view(const uint8_t *raw_pkt, uint16_t len, fsat_pkt_view_t *view)
+{
+    int err = -1;
+
+    if (len >= FSAT_PKT_HEADER_LEN)
+    {
+        view->raw = raw_pkt;
+        view->id = raw_pkt[0];
+
+        /* Skip the callsign padding */
+        uint8_t i = 0U;
+        for(i = 0U; i < FSAT_PKT_CALLSIGN_LEN; i++)
+        {
+            if (raw_pkt[1U + i] != (uint8_t)FSAT_PKT_CALLSIGN_PADDING_CHAR)
+            {
+                break;
+            }
+        }
+
+        view->callsign      = &raw_pkt[1U + i];
+        view->callsign_len  = FSAT_PKT_CALLSIGN_LEN - i;
+        view->payload       = &raw_pkt[FSAT_PKT_HEADER_LEN];
+        view->length        = len - FSAT_PKT_HEADER_LEN;
+
+        err = 0;
+    }
+
+    return err;
+}
+
 /** \} End of fsat_pkt group */
@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.8.21
+ * \version 0.10.2
  * 
  * \date 2020/03/14
  * 
@@ -39,6 +39,9 @@
 #include <stdint.h>
 
 #define FSAT_PKT_CALLSIGN_PADDING_CHAR      (' ')
+#define FSAT_PKT_CALLSIGN_LEN               7U      /**< Callsign field length in bytes. */
+#define FSAT_PKT_HEADER_LEN                 (1U + FSAT_PKT_CALLSIGN_LEN)    /**< Packet ID + callsign. */
+#define FSAT_PKT_MAX_LEN                    220U    /**< Maximum raw packet length in bytes. */
 
 /**
  * \brief FloripaSat packet.
@@ -51,6 +54,34 @@ typedef struct
     uint16_t length;                        /**< Packet payload length. */
 } fsat_pkt_pl_t;
 
+/**
+ * \brief In-place packet builder.
+ *
+ * Writes the fields of a packet directly into the final transmission buffer.
+ */
+typedef struct
+{
+    uint8_t *buf;                           /**< Raw packet buffer. */
+    uint16_t size;                          /**< Buffer capacity in bytes. */
+    uint16_t len;                           /**< Number of bytes written so far. */
+    int err;                                /**< Sticky error flag (set when a field does not fit). */
+} fsat_pkt_builder_t;
+
+/**
+ * \brief Packet view.
+ *
+ * Points into a received raw packet, so no data is copied while parsing it.
+ */
+typedef struct
+{
+    const uint8_t *raw;                     /**< Raw packet (ID + callsign + payload). */
+    uint8_t id;                             /**< Packet ID. */
+    const uint8_t *callsign;                /**< First character of the callsign (without padding). */
+    uint8_t callsign_len;                   /**< Callsign length in bytes (without padding). */
+    const uint8_t *payload;                 /**< Packet payload. */
+    uint16_t length;                        /**< Packet payload length. */
+} fsat_pkt_view_t;
+
 /**
  * \brief Add the ID code to a FSat packet.
  *
@@ -112,6 +143,108 @@ void fsat_pkt_encode(fsat_pkt_pl_t pkt, uint8_t *pl, uint16_t *len);
  */
 void fsat_pkt_decode(uint8_t *raw_pkt, uint16_t len, fsat_pkt_pl_t *pkt);
 
+/**
+ * \brief Starts a new packet in a raw buffer.
+ *
+ * The packet ID and the source callsign (left padded) are written directly in the given buffer.
+ *
+ * \param[in,out] b is the builder to initialize.
+ *
+ * \param[in,out] buf is the buffer to store the raw packet.
+ *
+ * \param[in] size is the capacity of the buffer in bytes.
+ *
+ * \param[in] id is the packet ID code.
+ *
+ * \param[in] callsign is the callsign of the packet source.
+ *
+ * \return The status/error code.
+ */
+int fsat_pkt_builder_init(fsat_pkt_builder_t *b, uint8_t *buf, uint16_t size, uint8_t id, const char *callsign);
+
+/**
+ * \brief Appends a callsign field (left padded to FSAT_PKT_CALLSIGN_LEN bytes) to the payload of a packet.
+ *
+ * \param[in,out] b is the packet builder.
+ *
+ * \param[in] callsign is the callsign (without padding, as given by a packet view).
+ *
+ * \param[in] len is the length of the callsign in bytes.
+ *
+ * \return None.
+ */
+void fsat_pkt_builder_put_callsign(fsat_pkt_builder_t *b, const uint8_t *callsign, uint8_t len);
+
+/**
+ * \brief Appends a byte to the payload of a packet.
+ *
+ * \param[in,out] b is the packet builder.
+ *
+ * \param[in] val is the value to append.
+ *
+ * \return None.
+ */
+void fsat_pkt_builder_put_u8(fsat_pkt_builder_t *b, uint8_t val);
+
+/**
+ * \brief Appends a 16-bit value (big-endian) to the payload of a packet.
+ *
+ * \param[in,out] b is the packet builder.
+ *
+ * \param[in] val is the value to append.
+ *
+ * \return None.
+ */
+void fsat_pkt_builder_put_u16(fsat_pkt_builder_t *b, uint16_t val);
+
+/**
+ * \brief Appends a 32-bit value (big-endian) to the payload of a packet.
+ *
+ * \param[in,out] b is the packet builder.
+ *
+ * \param[in] val is the value to append.
+ *
+ * \return None.
+ */
+void fsat_pkt_builder_put_u32(fsat_pkt_builder_t *b, uint32_t val);
+
+/**
+ * \brief Appends a sequence of bytes to the payload of a packet.
+ *
+ * \param[in,out] b is the packet builder.
+ *
+ * \param[in] data is the sequence of bytes to append.
+ *
+ * \param[in] len is the number of bytes to append.
+ *
+ * \return None.
+ */
+void fsat_pkt_builder_put_bytes(fsat_pkt_builder_t *b, const uint8_t *data, uint16_t len);
+
+/**
+ * \brief Finishes a packet.
+ *
+ * \param[in] b is the packet builder.
+ *
+ * \param[in,out] len is the length of the raw packet in bytes.
+ *
+ * \return The status/error code (-1 if any field did not fit in the buffer).
+ */
+int fsat_pkt_builder_finish(const fsat_pkt_builder_t *b, uint16_t *len);
+
+/**
+ * \brief Parses a raw packet without copying it.
+ *
+ * \param[in] raw_pkt is an array with a raw packet.
+ *
+ * \param[in] len is length of the raw packet in bytes.
+ *
+ * \param[in,out] view is the view structure pointing into the raw packet.
+ *
+ * \return The status/error code.
+ */
+int fsat_pkt_view(const uint8_t *raw_pkt, uint16_t len, fsat_pkt_view_t *view);
+
 #endif /* FSAT_PKT_H_ */
 
 /** \} End of fsat_pkt group */
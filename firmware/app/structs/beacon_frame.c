@@ -0,0 +1,291 @@
+/*
+ * beacon_frame.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Pre-encoded beacon frame implementation.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.4
+ *
+ * \date 2022/11/20
+ *
+ * \addtogroup beacon_frame
+ * \{
+ */
+
+#include <FreeRTOS.h>
+#include <semphr.h>
+
+#include <config/config.h>
+#include <system/system.h>
+#include <system/sys_log/sys_log.h>
+#include <fsat_pkt/fsat_pkt.h>
+#include <devices/ttc/ttc_link.h>
+
+#include "satellite.h"
+#include "beacon_frame.h"
+
+static uint8_t beacon_frame[BEACON_FRAME_LEN] = {0};
+
+static SemaphoreHandle_t beacon_frame_mutex = NULL;
+
+/**
+ * \brief Takes the beacon frame mutex.
+ *
+ * \return The status/error code.
+ */
+static int beacon_frame_lock(void);
+
+/**
+ * \brief Gives the beacon frame mutex back.
+ *
+ * \return None.
+ */
+static void beacon_frame_unlock(void);
+
+/**
+ * \brief Writes a 16-bit value (big-endian) into the payload of the beacon frame.
+ *
+ * \param[in] pos is the position in the payload.
+ *
+ * \param[in] val is the value to write.
+ *
+ * \return None.
+ */
+static void beacon_frame_put_u16(uint8_t pos, uint16_t val);
+
+/**
+ * \brief Writes a 32-bit value (big-endian) into the payload of the beacon frame.
+ *
+ * \param[in] pos is the position in the payload.
+ *
+ * \param[in] val is the value to write.
+ *
+ * \return None.
+ */
+static void beacon_frame_put_u32(uint8_t pos, uint32_t val);
+
+/**
+ * \brief Writes a byte into the payload of the beacon frame.
+ *
+ * \param[in] pos is the position in the payload.
+ *
+ * \param[in] val is the value to write.
+ *
+ * \return None.
+ */
+static void beacon_frame_put_u8(uint8_t pos, uint8_t val);
+
+int beacon_frame_init(void)
+{
+    int err = 0;
+
+    if (beacon_frame_mutex == NULL)
+    {
+        beacon_frame_mutex = xSemaphoreCreateMutex();
+    }
+
+    if (beacon_frame_mutex == NULL)
+    {
+        sys_log_print_event_from_module(SYS_LOG_ERROR, BEACON_FRAME_NAME, "Error creating the beacon frame mutex!");
+        sys_log_new_line();
+
+        err = -1;
+    }
+    else
+    {
+        fsat_pkt_builder_t header = {0};
+
+        /* Packet ID and source callsign */
+        if ((fsat_pkt_builder_init(&header, beacon_frame, sizeof(beacon_frame), CONFIG_PKT_ID_DOWNLINK_GENERAL_TELEMETRY, CONFIG_SATELLITE_CALLSIGN) != 0) ||
+            (beacon_frame_update_obdh() != 0) ||
+            (beacon_frame_update_ttc() != 0) ||
+            (beacon_frame_update_antenna() != 0) ||
+            (beacon_frame_update_eps() != 0))
+        {
+            err = -1;
+        }
+    }
+
+    return err;
+}
+
+int beacon_frame_update_obdh(void)
+{
+    int err = beacon_frame_lock();
+
+    if (err == 0)
+    {
+        beacon_frame_put_u16(BEACON_FRAME_POS_OBDH + 0U, sat_data_buf.obdh.data.temperature);
+        beacon_frame_put_u16(BEACON_FRAME_POS_OBDH + 2U, sat_data_buf.obdh.data.current);
+        beacon_frame_put_u16(BEACON_FRAME_POS_OBDH + 4U, sat_data_buf.obdh.data.voltage);
+        beacon_frame_put_u8(BEACON_FRAME_POS_OBDH + 6U, sat_data_buf.obdh.data.last_reset_cause);
+        beacon_frame_put_u16(BEACON_FRAME_POS_OBDH + 7U, sat_data_buf.obdh.data.reset_counter);
+        beacon_frame_put_u8(BEACON_FRAME_POS_OBDH + 9U, sat_data_buf.obdh.data.last_valid_tc);
+
+        beacon_frame_unlock();
+    }
+
+    return err;
+}
+
+int beacon_frame_update_ttc(void)
+{
+    int err = beacon_frame_lock();
+
+    if (err == 0)
+    {
+        beacon_frame_put_u16(BEACON_FRAME_POS_TTC + 0U, sat_data_buf.ttc_1.data.temperature_radio);
+        beacon_frame_put_u16(BEACON_FRAME_POS_TTC + 2U, sat_data_buf.ttc_1.data.rssi_last_valid_tc);
+
+        beacon_frame_unlock();
+    }
+
+    return err;
+}
+
+int beacon_frame_update_antenna(void)
+{
+    int err = beacon_frame_lock();
+
+    if (err == 0)
+    {
+        beacon_frame_put_u16(BEACON_FRAME_POS_ANTENNA + 0U, sat_data_buf.antenna.data.temperature);
+        beacon_frame_put_u16(BEACON_FRAME_POS_ANTENNA + 2U, sat_data_buf.antenna.data.status.code);
+
+        beacon_frame_unlock();
+    }
+
+    return err;
+}
+
+int beacon_frame_update_eps(void)
+{
+    int err = beacon_frame_lock();
+
+    if (err == 0)
+    {
+        beacon_frame_put_u16(BEACON_FRAME_POS_EPS + 0U, sat_data_buf.eps.data.temperature_uc);
+        beacon_frame_put_u16(BEACON_FRAME_POS_EPS + 2U, sat_data_buf.eps.data.current);
+        beacon_frame_put_u8(BEACON_FRAME_POS_EPS + 4U, sat_data_buf.eps.data.last_reset_cause);
+        beacon_frame_put_u16(BEACON_FRAME_POS_EPS + 5U, sat_data_buf.eps.data.reset_counter);
+        beacon_frame_put_u16(BEACON_FRAME_POS_EPS + 7U, sat_data_buf.eps.data.solar_panel_voltage_my_px);
+        beacon_frame_put_u16(BEACON_FRAME_POS_EPS + 9U, sat_data_buf.eps.data.solar_panel_voltage_mx_pz);
+        beacon_frame_put_u16(BEACON_FRAME_POS_EPS + 11U, sat_data_buf.eps.data.solar_panel_voltage_mz_py);
+        beacon_frame_put_u16(BEACON_FRAME_POS_EPS + 13U, sat_data_buf.eps.data.solar_panel_current_my);
+        beacon_frame_put_u16(BEACON_FRAME_POS_EPS + 15U, sat_data_buf.eps.data.solar_panel_current_py);
+        beacon_frame_put_u16(BEACON_FRAME_POS_EPS + 17U, sat_data_buf.eps.data.solar_panel_current_mx);
+        beacon_frame_put_u16(BEACON_FRAME_POS_EPS + 19U, sat_data_buf.eps.data.solar_panel_current_px);
+        beacon_frame_put_u16(BEACON_FRAME_POS_EPS + 21U, sat_data_buf.eps.data.solar_panel_current_mz);
+        beacon_frame_put_u16(BEACON_FRAME_POS_EPS + 23U, sat_data_buf.eps.data.solar_panel_current_pz);
+        beacon_frame_put_u8(BEACON_FRAME_POS_EPS + 25U, sat_data_buf.eps.data.mppt_1_duty_cycle);
+        beacon_frame_put_u8(BEACON_FRAME_POS_EPS + 26U, sat_data_buf.eps.data.mppt_2_duty_cycle);
+        beacon_frame_put_u8(BEACON_FRAME_POS_EPS + 27U, sat_data_buf.eps.data.mppt_3_duty_cycle);
+        beacon_frame_put_u16(BEACON_FRAME_POS_EPS + 28U, sat_data_buf.eps.data.main_power_bus_voltage);
+        beacon_frame_put_u16(BEACON_FRAME_POS_EPS + 30U, sat_data_buf.eps.data.battery_voltage);
+        beacon_frame_put_u16(BEACON_FRAME_POS_EPS + 32U, sat_data_buf.eps.data.battery_current);
+        beacon_frame_put_u16(BEACON_FRAME_POS_EPS + 34U, sat_data_buf.eps.data.battery_average_current);
+        beacon_frame_put_u16(BEACON_FRAME_POS_EPS + 36U, sat_data_buf.eps.data.battery_acc_current);
+        beacon_frame_put_u16(BEACON_FRAME_POS_EPS + 38U, sat_data_buf.eps.data.battery_charge);
+        beacon_frame_put_u16(BEACON_FRAME_POS_EPS + 40U, sat_data_buf.eps.data.battery_monitor_temperature);
+        beacon_frame_put_u8(BEACON_FRAME_POS_EPS + 42U, sat_data_buf.eps.data.battery_heater_1_duty_cycle);
+        beacon_frame_put_u8(BEACON_FRAME_POS_EPS + 43U, sat_data_buf.eps.data.battery_heater_2_duty_cycle);
+
+        beacon_frame_unlock();
+    }
+
+    return err;
+}
+
+int beacon_frame_send(void)
+{
+    int err = beacon_frame_lock();
+
+    if (err == 0)
+    {
+        beacon_frame_put_u32(BEACON_FRAME_POS_TIMESTAMP, system_get_time());
+
+        uint8_t edc_status = 0x00U;
+
+        if (sat_data_buf.edc_0.enabled)
+        {
+            edc_status |= 0x01U;
+        }
+
+        if (sat_data_buf.edc_1.enabled)
+        {
+            edc_status |= 0x02U;
+        }
+
+        beacon_frame_put_u8(BEACON_FRAME_POS_PAYLOADS + 0U, edc_status);
+        beacon_frame_put_u8(BEACON_FRAME_POS_PAYLOADS + 1U, sat_data_buf.payload_x.enabled ? 0x01U : 0x00U);
+        beacon_frame_put_u8(BEACON_FRAME_POS_PAYLOADS + 2U, sat_data_buf.harsh.enabled ? 0x01U : 0x00U);
+
+        err = ttc_link_send(beacon_frame, BEACON_FRAME_LEN);
+
+        beacon_frame_unlock();
+    }
+
+    return err;
+}
+
+static int beacon_frame_lock(void)
+{
+    int err = -1;
+
+    if (beacon_frame_mutex != NULL)
+    {
+        if (xSemaphoreTake(beacon_frame_mutex, pdMS_TO_TICKS(BEACON_FRAME_MUTEX_WAIT_TIME_MS)) == pdTRUE)
+        {
+            err = 0;
+        }
+    }
+
+    return err;
+}
+
+static void beacon_frame_unlock(void)
+{
+    xSemaphoreGive(beacon_frame_mutex);
+}
+
+static void beacon_frame_put_u16(uint8_t pos, uint16_t val)
+{
+    beacon_frame[BEACON_FRAME_HEADER_LEN + pos]      = (val >> 8) & 0xFFU;
+    beacon_frame[BEACON_FRAME_HEADER_LEN + pos + 1U] = val & 0xFFU;
+}
+
+static void beacon_frame_put_u32(uint8_t pos, uint32_t val)
+{
+    beacon_frame[BEACON_FRAME_HEADER_LEN + pos]      = (val >> 24) & 0xFFU;
+    beacon_frame[BEACON_FRAME_HEADER_LEN + pos + 1U] = (val >> 16) & 0xFFU;
+    beacon_frame[BEACON_FRAME_HEADER_LEN + pos + 2U] = (val >> 8) & 0xFFU;
+    beacon_frame[BEACON_FRAME_HEADER_LEN + pos + 3U] = val & 0xFFU;
+}
+
+static void beacon_frame_put_u8(uint8_t pos, uint8_t val)
+{
+    beacon_frame[BEACON_FRAME_HEADER_LEN + pos] = val;
+}
+
+/** \} End of beacon_frame group */
@@ -0,0 +1,114 @@
+/*
+ * beacon_frame.h
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Pre-encoded beacon frame definition.
+ *
+ * The beacon frame is kept encoded in RAM (ID + callsign + payload). Each data
+ * producer patches its own fields in place after updating the satellite data
+ * buffer, so transmitting a beacon does not require any packing or copying.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.4
+ *
+ * \date 2022/11/20
+ *
+ * \defgroup beacon_frame Beacon Frame
+ * \ingroup structs
+ * \{
+ */
+
+#ifndef BEACON_FRAME_H_
+#define BEACON_FRAME_H_
+
+#include <stdint.h>
+
+#include <fsat_pkt/fsat_pkt.h>
+
+#define BEACON_FRAME_NAME                   "Beacon Frame"
+
+#define BEACON_FRAME_MUTEX_WAIT_TIME_MS     100U                    /**< Wait time to take the frame mutex in milliseconds. */
+
+#define BEACON_FRAME_HEADER_LEN             FSAT_PKT_HEADER_LEN     /**< Packet ID + callsign. */
+#define BEACON_FRAME_PAYLOAD_LEN            69U                     /**< Payload length in bytes. */
+#define BEACON_FRAME_LEN                    (BEACON_FRAME_HEADER_LEN + BEACON_FRAME_PAYLOAD_LEN)
+
+/* Payload fields positions (relative to the start of the payload) */
+#define BEACON_FRAME_POS_TIMESTAMP          0U                      /**< System time (4 bytes). */
+#define BEACON_FRAME_POS_OBDH               4U                      /**< OBDH data (10 bytes). */
+#define BEACON_FRAME_POS_TTC                14U                     /**< TTC data (4 bytes). */
+#define BEACON_FRAME_POS_ANTENNA            18U                     /**< Antenna data (4 bytes). */
+#define BEACON_FRAME_POS_EPS                22U                     /**< EPS data (44 bytes). */
+#define BEACON_FRAME_POS_PAYLOADS           66U                     /**< Payloads status (3 bytes). */
+
+/**
+ * \brief Initializes the beacon frame.
+ *
+ * Encodes the packet ID and the source callsign once, fills the payload with the current
+ * content of the satellite data buffer and creates the frame mutex.
+ *
+ * \return The status/error code.
+ */
+int beacon_frame_init(void);
+
+/**
+ * \brief Patches the OBDH fields of the beacon frame from the satellite data buffer.
+ *
+ * \return The status/error code.
+ */
+int beacon_frame_update_obdh(void);
+
+/**
+ * \brief Patches the TTC fields of the beacon frame from the satellite data buffer.
+ *
+ * \return The status/error code.
+ */
+int beacon_frame_update_ttc(void);
+
+/**
+ * \brief Patches the antenna fields of the beacon frame from the satellite data buffer.
+ *
+ * \return The status/error code.
+ */
+int beacon_frame_update_antenna(void);
+
+/**
+ * \brief Patches the EPS fields of the beacon frame from the satellite data buffer.
+ *
+ * \return The status/error code.
+ */
+int beacon_frame_update_eps(void);
+
+/**
+ * \brief Transmits the current beacon frame.
+ *
+ * Only the timestamp and the payloads status are patched at transmission time. The frame
+ * is handed to the TTC link layer directly from the cache.
+ *
+ * \return The status/error code.
+ */
+int beacon_frame_send(void);
+
+#endif /* BEACON_FRAME_H_ */
+
+/** \} End of beacon_frame group */
@@ -0,0 +1,641 @@
+/*
+ * params.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Parameters registry implementation.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.25
+ *
+ * \date 2022/11/21
+ *
+ * \addtogroup params
+ * \{
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <config/config.h>
+#include <system/system.h>
+#include <devices/ttc/ttc.h>
+#include <devices/eps/eps.h>
+#include <drivers/spi/spi.h>
+#include <drivers/i2c/i2c.h>
+#include <drivers/uart/uart.h>
+#include <libs/stats/bus_stats.h>
+#include <system/sys_log/sys_log.h>
+#include <app/tasks/cpu_usage.h>
+#include <app/tasks/stack_monitor.h>
+
+#include "satellite.h"
+#include "params.h"
+
+/**
+ * \brief Reads the system time counter.
+ *
+ * \param[in,out] val is a pointer to store the time counter.
+ *
+ * \return The status/error code.
+ */
+static int param_get_time_counter(uint32_t *val);
+
+/**
+ * \brief Writes the system time counter.
+ *
+ * \param[in] val is the new time counter value.
+ *
+ * \return The status/error code.
+ */
+static int param_set_time_counter(uint32_t val);
+
+/**
+ * \brief Reads an OBDH parameter from the local parameters table.
+ *
+ * \param[in] param is the parameter ID.
+ *
+ * \param[in,out] val is a pointer to store the read value.
+ *
+ * \return The status/error code.
+ */
+static int param_obdh_get(uint8_t param, uint32_t *val);
+
+/**
+ * \brief Writes an OBDH parameter of the local parameters table.
+ *
+ * \param[in] param is the parameter ID.
+ *
+ * \param[in] val is the new value of the parameter.
+ *
+ * \return The status/error code.
+ */
+static int param_obdh_set(uint8_t param, uint32_t val);
+
+/**
+ * \brief Reads a parameter from the TTC 0 device.
+ *
+ * \param[in] param is the parameter ID.
+ *
+ * \param[in,out] val is a pointer to store the read value.
+ *
+ * \return The status/error code.
+ */
+static int param_ttc_0_get(uint8_t param, uint32_t *val);
+
+/**
+ * \brief Writes a parameter of the TTC 0 device.
+ *
+ * \param[in] param is the parameter ID.
+ *
+ * \param[in] val is the new value of the parameter.
+ *
+ * \return The status/error code.
+ */
+static int param_ttc_0_set(uint8_t param, uint32_t val);
+
+/**
+ * \brief Reads a parameter from the TTC 1 device.
+ *
+ * \param[in] param is the parameter ID.
+ *
+ * \param[in,out] val is a pointer to store the read value.
+ *
+ * \return The status/error code.
+ */
+static int param_ttc_1_get(uint8_t param, uint32_t *val);
+
+/**
+ * \brief Writes a parameter of the TTC 1 device.
+ *
+ * \param[in] param is the parameter ID.
+ *
+ * \param[in] val is the new value of the parameter.
+ *
+ * \return The status/error code.
+ */
+static int param_ttc_1_set(uint8_t param, uint32_t val);
+
+/**
+ * \brief Reads a field of the SPI transaction statistics.
+ *
+ * \param[in] param is the parameter ID (channel and field).
+ *
+ * \param[in,out] val is a pointer to store the read value.
+ *
+ * \return The status/error code.
+ */
+static int param_spi_get(uint8_t param, uint32_t *val);
+
+/**
+ * \brief Clears a channel of the SPI transaction statistics.
+ *
+ * \param[in] param is the parameter ID (channel and field).
+ *
+ * \param[in] val is not used.
+ *
+ * \return The status/error code.
+ */
+static int param_spi_set(uint8_t param, uint32_t val);
+
+/**
+ * \brief Reads a field of the I2C transaction statistics.
+ *
+ * \param[in] param is the parameter ID (channel and field).
+ *
+ * \param[in,out] val is a pointer to store the read value.
+ *
+ * \return The status/error code.
+ */
+static int param_i2c_get(uint8_t param, uint32_t *val);
+
+/**
+ * \brief Clears a channel of the I2C transaction statistics.
+ *
+ * \param[in] param is the parameter ID (channel and field).
+ *
+ * \param[in] val is not used.
+ *
+ * \return The status/error code.
+ */
+static int param_i2c_set(uint8_t param, uint32_t val);
+
+/**
+ * \brief Reads a field of the UART transaction statistics.
+ *
+ * \param[in] param is the parameter ID (channel and field).
+ *
+ * \param[in,out] val is a pointer to store the read value.
+ *
+ * \return The status/error code.
+ */
+static int param_uart_get(uint8_t param, uint32_t *val);
+
+/**
+ * \brief Clears a channel of the UART transaction statistics.
+ *
+ * \param[in] param is the parameter ID (channel and field).
+ *
+ * \param[in] val is not used.
+ *
+ * \return The status/error code.
+ */
+static int param_uart_set(uint8_t param, uint32_t val);
+
+/**
+ * \brief Reads the runtime log level of a system log module.
+ *
+ * \param[in] param is the module ID (sys_log_module_e).
+ *
+ * \param[in,out] val is a pointer to store the level of the module.
+ *
+ * \return The status/error code.
+ */
+static int param_sys_log_get(uint8_t param, uint32_t *val);
+
+/**
+ * \brief Sets the runtime log level of a system log module.
+ *
+ * \param[in] param is the module ID (sys_log_module_e).
+ *
+ * \param[in] val is the new level (SYS_LOG_INFO to SYS_LOG_LEVEL_OFF).
+ *
+ * \return The status/error code.
+ */
+static int param_sys_log_set(uint8_t param, uint32_t val);
+
+/**
+ * \brief Reads a field of the CPU usage table.
+ *
+ * \param[in] param is the parameter ID (task index and field).
+ *
+ * \param[in,out] val is a pointer to store the read value.
+ *
+ * \return The status/error code.
+ */
+static int param_cpu_usage_get(uint8_t param, uint32_t *val);
+
+/**
+ * \brief Rejects the writes to the CPU usage table (read-only).
+ *
+ * \param[in] param is the parameter ID (task index and field).
+ *
+ * \param[in] val is not used.
+ *
+ * \return The status/error code (always an error).
+ */
+static int param_cpu_usage_set(uint8_t param, uint32_t val);
+
+/**
+ * \brief Reads a field of the stack monitor.
+ *
+ * \param[in] param is the parameter ID (task index and field).
+ *
+ * \param[in,out] val is a pointer to store the read value.
+ *
+ * \return The status/error code.
+ */
+static int param_stack_monitor_get(uint8_t param, uint32_t *val);
+
+/**
+ * \brief Rejects the writes to the stack monitor (read-only).
+ *
+ * \param[in] param is the parameter ID (task index and field).
+ *
+ * \param[in] val is not used.
+ *
+ * \return The status/error code (always an error).
+ */
+static int param_stack_monitor_set(uint8_t param, uint32_t val);
+
+/**
+ * \brief Looks up a subsystem in the registry.
+ *
+ * \param[in] subsystem is the subsystem ID.
+ *
+ * \return A pointer to the subsystem entry or NULL if the subsystem is unknown.
+ */
+static const param_subsystem_t *param_find_subsystem(uint8_t subsystem);
+
+/**
+ * \brief Looks up an OBDH parameter in the local table.
+ *
+ * \param[in] param is the parameter ID.
+ *
+ * \return A pointer to the parameter entry or NULL if the parameter is unknown.
+ */
+static const param_entry_t *param_find_obdh(uint8_t param);
+
+static const param_entry_t param_obdh_table[] =
+{
+    {OBDH_PARAM_ID_TIME_COUNTER,            PARAM_TYPE_U32,     PARAM_ACCESS_RW,    NULL,                                           param_get_time_counter, param_set_time_counter},
+    {OBDH_PARAM_ID_TEMPERATURE_UC,          PARAM_TYPE_U16,     PARAM_ACCESS_RO,    &sat_data_buf.obdh.data.temperature,            NULL,                   NULL},
+    {OBDH_PARAM_ID_INPUT_CURRENT,           PARAM_TYPE_U16,     PARAM_ACCESS_RO,    &sat_data_buf.obdh.data.current,                NULL,                   NULL},
+    {OBDH_PARAM_ID_INPUT_VOLTAGE,           PARAM_TYPE_U16,     PARAM_ACCESS_RO,    &sat_data_buf.obdh.data.voltage,                NULL,                   NULL},
+    {OBDH_PARAM_ID_LAST_RESET_CAUSE,        PARAM_TYPE_U8,      PARAM_ACCESS_RO,    &sat_data_buf.obdh.data.last_reset_cause,       NULL,                   NULL},
+    {OBDH_PARAM_ID_RESET_COUNTER,           PARAM_TYPE_U16,     PARAM_ACCESS_RO,    &sat_data_buf.obdh.data.reset_counter,          NULL,                   NULL},
+    {OBDH_PARAM_ID_LAST_VALID_TC,           PARAM_TYPE_U8,      PARAM_ACCESS_RO,    &sat_data_buf.obdh.data.last_valid_tc,          NULL,                   NULL},
+    {OBDH_PARAM_ID_TEMPERATURE_RADIO,       PARAM_TYPE_U16,     PARAM_ACCESS_RO,    &sat_data_buf.obdh.data.radio.temperature,      NULL,                   NULL},
+    {OBDH_PARAM_ID_RSSI_LAST_TC,            PARAM_TYPE_U16,     PARAM_ACCESS_RO,    &sat_data_buf.obdh.data.radio.last_valid_tc_rssi, NULL,                 NULL},
+    {OBDH_PARAM_ID_TEMPERATURE_ANTENNA,     PARAM_TYPE_U16,     PARAM_ACCESS_RO,    &sat_data_buf.antenna.data.temperature,         NULL,                   NULL},
+    {OBDH_PARAM_ID_ANTENNA_STATUS,          PARAM_TYPE_U16,     PARAM_ACCESS_RO,    &sat_data_buf.antenna.data.status.code,         NULL,                   NULL},
+    {OBDH_PARAM_ID_HARDWARE_VERSION,        PARAM_TYPE_U8,      PARAM_ACCESS_RO,    &sat_data_buf.obdh.data.hw_version,             NULL,                   NULL},
+    {OBDH_PARAM_ID_FIRMWARE_VERSION,        PARAM_TYPE_U32,     PARAM_ACCESS_RO,    &sat_data_buf.obdh.data.fw_version,             NULL,                   NULL},
+    {OBDH_PARAM_ID_MODE,                    PARAM_TYPE_U8,      PARAM_ACCESS_RW,    &sat_data_buf.obdh.data.mode,                   NULL,                   NULL},
+    {OBDH_PARAM_ID_TIMESTAMP_LAST_MODE,     PARAM_TYPE_U32,     PARAM_ACCESS_RW,    &sat_data_buf.obdh.data.ts_last_mode_change,    NULL,                   NULL},
+    {OBDH_PARAM_ID_MODE_DURATION,           PARAM_TYPE_U32,     PARAM_ACCESS_RW,    &sat_data_buf.obdh.data.mode_duration,          NULL,                   NULL},
+    {OBDH_PARAM_ID_INITIAL_HIB_EXECUTED,    PARAM_TYPE_BOOL,    PARAM_ACCESS_RO,    &sat_data_buf.obdh.data.initial_hib_executed,   NULL,                   NULL},
+    {OBDH_PARAM_ID_INITIAL_HIB_TIME_COUNTER,PARAM_TYPE_U8,      PARAM_ACCESS_RO,    &sat_data_buf.obdh.data.initial_hib_time_count, NULL,                   NULL},
+    {OBDH_PARAM_ID_ANT_DEPLOYMENT_EXECUTED, PARAM_TYPE_BOOL,    PARAM_ACCESS_RO,    &sat_data_buf.obdh.data.ant_deployment_executed,NULL,                   NULL},
+    {OBDH_PARAM_ID_ANT_DEPLOYMENT_COUNTER,  PARAM_TYPE_U8,      PARAM_ACCESS_RO,    &sat_data_buf.obdh.data.ant_deployment_counter, NULL,                   NULL},
+};
+
+static const param_subsystem_t param_subsystems[] =
+{
+    {CONFIG_SUBSYSTEM_ID_OBDH,             param_obdh_get,           param_obdh_set},
+    {CONFIG_SUBSYSTEM_ID_TTC_1,            param_ttc_0_get,          param_ttc_0_set},
+    {CONFIG_SUBSYSTEM_ID_TTC_2,            param_ttc_1_get,          param_ttc_1_set},
+    {CONFIG_SUBSYSTEM_ID_EPS,              eps_get_param,            eps_set_param},
+    {CONFIG_SUBSYSTEM_ID_SPI,              param_spi_get,            param_spi_set},
+    {CONFIG_SUBSYSTEM_ID_I2C,              param_i2c_get,            param_i2c_set},
+    {CONFIG_SUBSYSTEM_ID_UART,             param_uart_get,           param_uart_set},
+    {CONFIG_SUBSYSTEM_ID_SYS_LOG,          param_sys_log_get,        param_sys_log_set},
+    {CONFIG_SUBSYSTEM_ID_CPU_USAGE,        param_cpu_usage_get,      param_cpu_usage_set},
+    {CONFIG_SUBSYSTEM_ID_STACK_MONITOR,    param_stack_monitor_get,  param_stack_monitor_set},
+};
+
+int param_get(uint8_t subsystem, uint8_t param, uint32_t *val)
+{
+    int err = -1;
+
+    const param_subsystem_t *sub = param_find_subsystem(subsystem);
+
+    if (sub != NULL)
+    {
+        err = sub->get(param, val);
+    }
+
+    return err;
+}
+
+int param_set(uint8_t subsystem, uint8_t param, uint32_t val)
+{
+    int err = -1;
+
+    const param_subsystem_t *sub = param_find_subsystem(subsystem);
+
+    if (sub != NULL)
+    {
+        err = sub->set(param, val);
+    }
+
+    return err;
+}
+
+static int param_get_time_counter(uint32_t *val)
+{
+    *val = system_get_time();
+
+    return 0;
+}
+
+static int param_set_time_counter(uint32_t val)
+{
+    system_set_time(val);
+
+    return 0;
+}
+
+static int param_obdh_get(uint8_t param, uint32_t *val)
+{
+    int err = -1;
+
+    const param_entry_t *entry = param_find_obdh(param);
+
+    if (entry != NULL)
+    {
+        if (entry->value == NULL)
+        {
+            err = entry->get(val);
+        }
+        else
+        {
+            switch(entry->type)
+            {
+                case PARAM_TYPE_BOOL:   *val = *(bool*)entry->value ? 1UL : 0UL;    err = 0;    break;
+                case PARAM_TYPE_U8:     *val = *(uint8_t*)entry->value;             err = 0;    break;
+                case PARAM_TYPE_U16:    *val = *(uint16_t*)entry->value;            err = 0;    break;
+                case PARAM_TYPE_U32:    *val = *(uint32_t*)entry->value;            err = 0;    break;
+                default:                                                                        break;
+            }
+        }
+    }
+
+    return err;
+}
+
+static int param_obdh_set(uint8_t param, uint32_t val)
+{
+    int err = -1;
+
+    const param_entry_t *entry = param_find_obdh(param);
+
+    if ((entry != NULL) && (entry->access == PARAM_ACCESS_RW))
+    {
+        if (entry->value == NULL)
+        {
+            err = entry->set(val);
+        }
+        else
+        {
+            switch(entry->type)
+            {
+                case PARAM_TYPE_BOOL:   *(bool*)entry->value = (val != 0UL);        err = 0;    break;
+                case PARAM_TYPE_U8:     *(uint8_t*)entry->value = (uint8_t)val;     err = 0;    break;
+                case PARAM_TYPE_U16:    *(uint16_t*)entry->value = (uint16_t)val;   err = 0;    break;
+                case PARAM_TYPE_U32:    *(uint32_t*)entry->value = val;             err = 0;    break;
+                default:                                                                        break;
+            }
+        }
+    }
+
+    return err;
+}
+
+static int param_ttc_0_get(uint8_t param, uint32_t *val)
+{
+    return ttc_get_param(TTC_0, param, val);
+}
+
+static int param_ttc_0_set(uint8_t param, uint32_t val)
+{
+    return ttc_set_param(TTC_0, param, val);
+}
+
+static int param_ttc_1_get(uint8_t param, uint32_t *val)
+{
+    return ttc_get_param(TTC_1, param, val);
+}
+
+static int param_ttc_1_set(uint8_t param, uint32_t val)
+{
+    return ttc_set_param(TTC_1, param, val);
+}
+
+static int param_spi_get(uint8_t param, uint32_t *val)
+{
+    int err = -1;
+
+    bus_stats_t stats = {0};
+
+    uint8_t ch = PARAM_BUS_STATS_CHANNEL(param);
+
+    if (ch < PARAM_BUS_STATS_SPI_PORT_0)
+    {
+        err = spi_stats_get_cs((spi_cs_t)ch, &stats);
+    }
+    else
+    {
+        err = spi_stats_get_port((spi_port_t)(ch - PARAM_BUS_STATS_SPI_PORT_0), &stats);
+    }
+
+    if (err == 0)
+    {
+        err = bus_stats_get_field(&stats, PARAM_BUS_STATS_FIELD(param), val);
+    }
+
+    return err;
+}
+
+static int param_spi_set(uint8_t param, uint32_t val)
+{
+    (void)val;  /* Any write clears the channel */
+
+    int err = -1;
+
+    uint8_t ch = PARAM_BUS_STATS_CHANNEL(param);
+
+    if (ch < PARAM_BUS_STATS_SPI_PORT_0)
+    {
+        err = spi_stats_reset_cs((spi_cs_t)ch);
+    }
+    else
+    {
+        err = spi_stats_reset_port((spi_port_t)(ch - PARAM_BUS_STATS_SPI_PORT_0));
+    }
+
+    return err;
+}
+
+static int param_i2c_get(uint8_t param, uint32_t *val)
+{
+    bus_stats_t stats = {0};
+
+    int err = i2c_stats_get((i2c_port_t)PARAM_BUS_STATS_CHANNEL(param), &stats);
+
+    if (err == 0)
+    {
+        err = bus_stats_get_field(&stats, PARAM_BUS_STATS_FIELD(param), val);
+    }
+
+    return err;
+}
+
+static int param_i2c_set(uint8_t param, uint32_t val)
+{
+    (void)val;  /* Any write clears the channel */
+
+    return i2c_stats_reset((i2c_port_t)PARAM_BUS_STATS_CHANNEL(param));
+}
+
+static int param_uart_get(uint8_t param, uint32_t *val)
+{
+    int err = -1;
+
+    bus_stats_t stats = {0};
+
+    uint8_t ch = PARAM_BUS_STATS_CHANNEL(param);
+
+    if (ch < PARAM_BUS_STATS_UART_RX_0)
+    {
+        err = uart_stats_get(ch, UART_DIR_TX, &stats);
+    }
+    else
+    {
+        err = uart_stats_get(ch - PARAM_BUS_STATS_UART_RX_0, UART_DIR_RX, &stats);
+    }
+
+    if (err == 0)
+    {
+        err = bus_stats_get_field(&stats, PARAM_BUS_STATS_FIELD(param), val);
+    }
+
+    return err;
+}
+
+static int param_uart_set(uint8_t param, uint32_t val)
+{
+    (void)val;  /* Any write clears the channel */
+
+    int err = -1;
+
+    uint8_t ch = PARAM_BUS_STATS_CHANNEL(param);
+
+    if (ch < PARAM_BUS_STATS_UART_RX_0)
+    {
+        err = uart_stats_reset(ch, UART_DIR_TX);
+    }
+    else
+    {
+        err = uart_stats_reset(ch - PARAM_BUS_STATS_UART_RX_0, UART_DIR_RX);
+    }
+
+    return err;
+}
+
+static int param_sys_log_get(uint8_t param, uint32_t *val)
+{
+    uint8_t level = 0U;
+
+    int err = sys_log_get_level(param, &level);
+
+    if (err == 0)
+    {
+        *val = level;
+    }
+
+    return err;
+}
+
+static int param_sys_log_set(uint8_t param, uint32_t val)
+{
+    int err = -1;
+
+    if (val <= SYS_LOG_LEVEL_OFF)
+    {
+        err = sys_log_set_level(param, (uint8_t)val);
+    }
+
+    return err;
+}
+
+static int param_cpu_usage_get(uint8_t param, uint32_t *val)
+{
+    return cpu_usage_get(PARAM_CPU_USAGE_TASK(param), PARAM_CPU_USAGE_FIELD(param), val);
+}
+
+static int param_cpu_usage_set(uint8_t param, uint32_t val)
+{
+    (void)param;
+    (void)val;
+
+    return -1;
+}
+
+static int param_stack_monitor_get(uint8_t param, uint32_t *val)
+{
+    return stack_monitor_get(PARAM_STACK_MONITOR_TASK(param), PARAM_STACK_MONITOR_FIELD(param), val);
+}
+
+static int param_stack_monitor_set(uint8_t param, uint32_t val)
+{
+    (void)param;
+    (void)val;
+
+    return -1;
+}
+
+static const param_subsystem_t *param_find_subsystem(uint8_t subsystem)
+{
+    const param_subsystem_t *sub = NULL;
+
+    uint8_t i = 0U;
+    for(i = 0U; i < (sizeof(param_subsystems) / sizeof(param_subsystem_t)); i++)
+    {
+        if (param_subsystems[i].subsystem == subsystem)
+        {
+            sub = &param_subsystems[i];
+
+            break;
+        }
+    }
+
+    return sub;
+}
+
+static const param_entry_t *param_find_obdh(uint8_t param)
+{
+    const param_entry_t *entry = NULL;
+
+    /* The table is indexed by the parameter ID */
+    if (param < (sizeof(param_obdh_table) / sizeof(param_entry_t)))
+    {
+        if (param_obdh_table[param].id == param)
+        {
+            entry = &param_obdh_table[param];
+        }
+    }
+
+    return entry;
+}
+
+/** \} End of params group */
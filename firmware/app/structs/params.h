@@ -0,0 +1,135 @@
+/*
+ * params.h
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Parameters registry definition.
+ *
+ * Maps the (subsystem, parameter) IDs used by the telecommands to typed getters and setters.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.25
+ *
+ * \date 2022/11/21
+ *
+ * \defgroup params Parameters
+ * \ingroup structs
+ * \{
+ */
+
+#ifndef PARAMS_H_
+#define PARAMS_H_
+
+#include <stdint.h>
+
+#define PARAMS_NAME                 "Params"
+
+/* Bus statistics subsystems (SPI, I2C and UART): the channel is the upper nibble of the parameter ID */
+#define PARAM_BUS_STATS_CHANNEL(param)  ((uint8_t)(param) >> 4)     /**< Channel of a parameter ID. */
+#define PARAM_BUS_STATS_FIELD(param)    ((uint8_t)(param) & 0x0FU)  /**< Field (BUS_STATS_FIELD_*) of a parameter ID. */
+#define PARAM_BUS_STATS_SPI_PORT_0      10U     /**< First SPI port channel (channels 0 to 9 are the chip selects). */
+#define PARAM_BUS_STATS_UART_RX_0       3U      /**< First UART RX channel (channels 0 to 2 are the TX of each port). */
+
+/* CPU usage subsystem: the task index is the upper 6 bits of the parameter ID */
+#define PARAM_CPU_USAGE_TASK(param)     ((uint8_t)(param) >> 2)     /**< Task index (creation order) of a parameter ID. */
+#define PARAM_CPU_USAGE_FIELD(param)    ((uint8_t)(param) & 0x03U)  /**< Field (CPU_STATS_FIELD_* or CPU_USAGE_FIELD_NAME) of a parameter ID. */
+
+/* Stack monitor subsystem: same layout and task index of the CPU usage subsystem */
+#define PARAM_STACK_MONITOR_TASK(param)     PARAM_CPU_USAGE_TASK(param)     /**< Task index (xTaskNumber - 1) of a parameter ID. */
+#define PARAM_STACK_MONITOR_FIELD(param)    PARAM_CPU_USAGE_FIELD(param)    /**< Field (STACK_MONITOR_FIELD_*) of a parameter ID. */
+
+/**
+ * \brief Parameter value type.
+ */
+typedef enum
+{
+    PARAM_TYPE_BOOL=0,              /**< Boolean flag. */
+    PARAM_TYPE_U8,                  /**< 8-bit unsigned integer. */
+    PARAM_TYPE_U16,                 /**< 16-bit unsigned integer. */
+    PARAM_TYPE_U32                  /**< 32-bit unsigned integer. */
+} param_type_t;
+
+/**
+ * \brief Parameter access type.
+ */
+typedef enum
+{
+    PARAM_ACCESS_RO=0,              /**< Read-only. */
+    PARAM_ACCESS_RW                 /**< Read and write. */
+} param_access_t;
+
+/**
+ * \brief Local parameter entry.
+ *
+ * When value is NULL, the get/set accessors are used instead of the memory location.
+ */
+typedef struct
+{
+    uint8_t id;                     /**< Parameter ID. */
+    param_type_t type;              /**< Value type. */
+    param_access_t access;          /**< Access type. */
+    void *value;                    /**< Memory location of the value. */
+    int (*get)(uint32_t *val);      /**< Getter (used when value is NULL). */
+    int (*set)(uint32_t val);       /**< Setter (used when value is NULL). */
+} param_entry_t;
+
+/**
+ * \brief Subsystem entry.
+ */
+typedef struct
+{
+    uint8_t subsystem;                              /**< Subsystem ID. */
+    int (*get)(uint8_t param, uint32_t *val);       /**< Parameter getter. */
+    int (*set)(uint8_t param, uint32_t val);        /**< Parameter setter. */
+} param_subsystem_t;
+
+/**
+ * \brief Reads a parameter.
+ *
+ * \param[in] subsystem is the subsystem ID (CONFIG_SUBSYSTEM_ID_*).
+ *
+ * \param[in] param is the parameter ID.
+ *
+ * \param[in,out] val is a pointer to store the read value.
+ *
+ * \return The status/error code.
+ */
+int param_get(uint8_t subsystem, uint8_t param, uint32_t *val);
+
+/**
+ * \brief Writes a parameter.
+ *
+ * \param[in] subsystem is the subsystem ID (CONFIG_SUBSYSTEM_ID_*).
+ *
+ * \param[in] param is the parameter ID.
+ *
+ * \param[in] val is the new value of the parameter.
+ *
+ * \note Writing any field of a bus statistics channel clears the channel.
+ *
+ * \return The status/error code.
+ */
+int param_set(uint8_t subsystem, uint8_t param, uint32_t val);
+
+#endif /* PARAMS_H_ */
+
+/** \} End of params group */
@@ -0,0 +1,727 @@
+/*
+ * payload_data.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Payload data storage implementation.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.15
+ *
+ * \date 2022/11/24
+ *
+ * \addtogroup payload_data
+ * \{
+ */
+
+#include <stdbool.h>
+#include <string.h>
+
+#include <FreeRTOS.h>
+#include <semphr.h>
+
+#include <config/config.h>
+#include <system/sys_log/sys_log.h>
+#include <devices/media/media.h>
+
+#include "payload_data.h"
+
+#define PAYLOAD_DATA_MEM_ID         0x5BU       /**< First byte of a valid ring position in the FRAM. */
+#define PAYLOAD_DATA_INDEX_LEN      15U         /**< ID + head + count + sorted + CRC16. */
+#define PAYLOAD_DATA_SLOTS          (CONFIG_MEM_PAYLOAD_DATA_SIZE / PAYLOAD_DATA_RECORD_SIZE)
+
+/* A record with the longest data must fit in a NOR page */
+typedef char payload_data_record_check[((PAYLOAD_DATA_RECORD_HEADER_LEN + PAYLOAD_DATA_MAX_LEN + PAYLOAD_DATA_RECORD_CRC_LEN) <= PAYLOAD_DATA_RECORD_SIZE) ? 1 : -1];
+
+static SemaphoreHandle_t payload_data_mutex = NULL;
+
+static uint32_t payload_data_start = 0;         /**< Address of the first slot (the last CONFIG_MEM_PAYLOAD_DATA_SIZE bytes of the NOR memory). */
+static uint32_t payload_data_head = 0;          /**< Slot of the next record to write. */
+static uint32_t payload_data_count = 0;         /**< Number of valid records in the ring. */
+static uint32_t payload_data_sorted = 0;        /**< Number of newest records in chronological order. */
+static sys_time_t payload_data_last_time = 0;   /**< Time tag of the newest record. */
+static uint32_t payload_data_sub_sector_size = 0;
+static uint32_t payload_data_reserved = 0;      /**< Sub-sectors erased in advance, from the first one after the head. */
+
+static uint8_t payload_data_page[PAYLOAD_DATA_RECORD_SIZE] = {0};
+
+/**
+ * \brief Takes the storage mutex.
+ *
+ * \return The status/error code.
+ */
+static int payload_data_lock(void);
+
+/**
+ * \brief Gives the storage mutex back.
+ *
+ * \return None.
+ */
+static void payload_data_unlock(void);
+
+/**
+ * \brief Writes a record into the slot under the head and advances the head (the mutex must be taken).
+ *
+ * \param[in] pl_id is the payload ID.
+ *
+ * \param[in] type is the record type.
+ *
+ * \param[in] time_tag is the time tag of the record.
+ *
+ * \param[in] prefix is written before the data (NULL if prefix_len is zero).
+ *
+ * \param[in] prefix_len is the number of bytes of the prefix.
+ *
+ * \param[in] data is the data to store.
+ *
+ * \param[in] len is the number of bytes of data.
+ *
+ * \return The status/error code.
+ */
+static int payload_data_write_record(uint8_t pl_id, uint8_t type, sys_time_t time_tag, uint8_t *prefix, uint16_t prefix_len, uint8_t *data, uint16_t len);
+
+/**
+ * \brief Drops the oldest records, before their sub-sector is erased (the mutex must be taken).
+ *
+ * The index is saved before the erase, so it never covers erased records after a reset.
+ *
+ * \param[in] max_count is the maximum number of records left in the ring.
+ *
+ * \return The status/error code.
+ */
+static int payload_data_drop(uint32_t max_count);
+
+/**
+ * \brief Erases in advance the sub-sectors needed to write a number of records (the mutex must be taken).
+ *
+ * \param[in] slots is the number of records.
+ *
+ * \return The status/error code.
+ */
+static int payload_data_reserve(uint32_t slots);
+
+/**
+ * \brief Loads the position of the ring from the FRAM memory.
+ *
+ * \return The status/error code.
+ */
+static int payload_data_load_index(void);
+
+/**
+ * \brief Saves the position of the ring into the FRAM memory.
+ *
+ * \return The status/error code.
+ */
+static int payload_data_save_index(void);
+
+/**
+ * \brief Reads and checks the record stored in a given slot (the mutex must be taken).
+ *
+ * The record is read into the page buffer.
+ *
+ * \param[in] slot is the slot of the record.
+ *
+ * \param[in,out] time_tag is a pointer to store the time tag of the record.
+ *
+ * \return The status/error code (an error for erased or corrupted records).
+ */
+static int payload_data_read_page(uint32_t slot, sys_time_t *time_tag);
+
+/**
+ * \brief Computes the CRC16-CCITT of a sequence of bytes.
+ *
+ * \param[in] initial_value is the initial value of the CRC.
+ *
+ * \param[in] data is the sequence of bytes.
+ *
+ * \param[in] size is the number of bytes.
+ *
+ * \return The computed CRC16 value.
+ */
+static uint16_t payload_data_crc16(uint16_t initial_value, uint8_t *data, uint16_t size);
+
+int payload_data_init(void)
+{
+    int err = 0;
+
+    if (payload_data_mutex == NULL)
+    {
+        payload_data_mutex = xSemaphoreCreateMutex();
+    }
+
+    media_info_t nor_info = media_get_info(MEDIA_NOR);
+
+    payload_data_sub_sector_size = nor_info.sub_sector_size;
+    payload_data_start = nor_info.size - CONFIG_MEM_PAYLOAD_DATA_SIZE;
+
+    if (payload_data_mutex == NULL)
+    {
+        sys_log_print_event_from_module(SYS_LOG_ERROR, PAYLOAD_DATA_NAME, "Error creating the payload data mutex!");
+        sys_log_new_line();
+
+        err = -1;
+    }
+    else if ((payload_data_sub_sector_size < PAYLOAD_DATA_RECORD_SIZE) ||
+             (nor_info.size <= CONFIG_MEM_PAYLOAD_DATA_SIZE) ||
+             ((payload_data_start % payload_data_sub_sector_size) != 0U) ||
+             ((CONFIG_MEM_PAYLOAD_DATA_SIZE % payload_data_sub_sector_size) != 0U))
+    {
+        sys_log_print_event_from_module(SYS_LOG_ERROR, PAYLOAD_DATA_NAME, "The payload data region is not aligned to the NOR sub-sectors!");
+        sys_log_new_line();
+
+        payload_data_sub_sector_size = 0;
+
+        err = -1;
+    }
+    else
+    {
+        if (payload_data_load_index() != 0)
+        {
+            sys_log_print_event_from_module(SYS_LOG_WARNING, PAYLOAD_DATA_NAME, "No valid payload data index found! Starting an empty ring...");
+            sys_log_new_line();
+
+            payload_data_head = 0;
+            payload_data_count = 0;
+            payload_data_sorted = 0;
+        }
+
+        payload_data_reserved = 0;
+        payload_data_last_time = 0;
+
+        if (payload_data_count > 0U)
+        {
+            /* The next record is in order if it is not older than the newest one */
+            if (payload_data_read_page((payload_data_head + PAYLOAD_DATA_SLOTS - 1U) % PAYLOAD_DATA_SLOTS, &payload_data_last_time) != 0)
+            {
+                payload_data_sorted = 0;
+            }
+        }
+
+        sys_log_print_event_from_module(SYS_LOG_INFO, PAYLOAD_DATA_NAME, "");
+        sys_log_print_uint(payload_data_count);
+        sys_log_print_msg(" payload data record(s) stored");
+        sys_log_new_line();
+    }
+
+    return err;
+}
+
+int payload_data_write(uint8_t pl_id, payload_data_type_t type, sys_time_t time_tag, uint8_t *data, uint16_t len)
+{
+    int err = -1;
+
+    if ((len > PAYLOAD_DATA_MAX_LEN) || (payload_data_sub_sector_size == 0U))
+    {
+        sys_log_print_event_from_module(SYS_LOG_ERROR, PAYLOAD_DATA_NAME, "Error writing a payload data record! Invalid record!");
+        sys_log_new_line();
+    }
+    else if (payload_data_lock() == 0)
+    {
+        err = payload_data_write_record(pl_id, (uint8_t)type, time_tag, NULL, 0U, data, len);
+
+        payload_data_unlock();
+    }
+
+    return err;
+}
+
+int payload_data_stream_begin(payload_data_stream_t *st, uint8_t pl_id, payload_data_type_t type, sys_time_t time_tag, uint16_t len)
+{
+    int err = -1;
+
+    if (payload_data_sub_sector_size == 0U)
+    {
+        sys_log_print_event_from_module(SYS_LOG_ERROR, PAYLOAD_DATA_NAME, "Error starting a payload data stream! Storage not initialized!");
+        sys_log_new_line();
+    }
+    else if (payload_data_lock() == 0)
+    {
+        /* Chunk records + the final record */
+        err = payload_data_reserve((((uint32_t)len + PAYLOAD_DATA_STREAM_CHUNK_LEN - 1U) / PAYLOAD_DATA_STREAM_CHUNK_LEN) + 1U);
+
+        payload_data_unlock();
+
+        st->pl_id       = pl_id;
+        st->type        = (uint8_t)type;
+        st->time_tag    = time_tag;
+        st->offset      = 0U;
+        st->crc         = 0U;
+    }
+
+    return err;
+}
+
+int payload_data_stream_write(payload_data_stream_t *st, uint8_t *data, uint16_t len)
+{
+    int err = -1;
+
+    if ((len > PAYLOAD_DATA_STREAM_CHUNK_LEN) || (((uint32_t)st->offset + len) > UINT16_MAX) || (payload_data_sub_sector_size == 0U))
+    {
+        sys_log_print_event_from_module(SYS_LOG_ERROR, PAYLOAD_DATA_NAME, "Error writing a payload data stream! Invalid chunk!");
+        sys_log_new_line();
+    }
+    else if (payload_data_lock() == 0)
+    {
+        uint8_t offset[PAYLOAD_DATA_STREAM_OFFSET_LEN] = {0};
+
+        offset[0] = (st->offset >> 8) & 0xFFU;
+        offset[1] = st->offset & 0xFFU;
+
+        err = payload_data_write_record(st->pl_id, st->type, st->time_tag, offset, PAYLOAD_DATA_STREAM_OFFSET_LEN, data, len);
+
+        payload_data_unlock();
+
+        if (err == 0)
+        {
+            st->crc = payload_data_crc16(st->crc, data, len);
+            st->offset += len;
+        }
+    }
+
+    return err;
+}
+
+int payload_data_stream_end(payload_data_stream_t *st)
+{
+    int err = -1;
+
+    if (payload_data_lock() == 0)
+    {
+        uint8_t buf[4] = {0};
+
+        buf[0] = (st->offset >> 8) & 0xFFU;
+        buf[1] = st->offset & 0xFFU;
+        buf[2] = (st->crc >> 8) & 0xFFU;
+        buf[3] = st->crc & 0xFFU;
+
+        err = payload_data_write_record(st->pl_id, st->type | PAYLOAD_DATA_STREAM_END, st->time_tag, NULL, 0U, buf, sizeof(buf));
+
+        payload_data_unlock();
+    }
+
+    return err;
+}
+
+int payload_data_seek(sys_time_t start, sys_time_t end, payload_data_cursor_t *cur)
+{
+    int err = payload_data_lock();
+
+    if (err == 0)
+    {
+        uint32_t tail = (payload_data_head + PAYLOAD_DATA_SLOTS - payload_data_count) % PAYLOAD_DATA_SLOTS;
+
+        /* Binary search for the first record with a time tag >= start (only if the whole ring is in chronological order) */
+        bool sorted = (payload_data_sorted == payload_data_count);
+        bool valid = true;
+
+        uint32_t lo = 0;
+        uint32_t hi = sorted ? payload_data_count : 0U;
+
+        while((lo < hi) && valid)
+        {
+            uint32_t mid = lo + ((hi - lo) / 2U);
+            sys_time_t mid_time = 0;
+
+            if (payload_data_read_page((tail + mid) % PAYLOAD_DATA_SLOTS, &mid_time) != 0)
+            {
+                valid = false;
+            }
+            else if (mid_time < start)
+            {
+                lo = mid + 1U;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+
+        if (sorted && valid)
+        {
+            cur->pos        = (tail + lo) % PAYLOAD_DATA_SLOTS;
+            cur->remaining  = payload_data_count - lo;
+            cur->unsorted   = 0;
+        }
+        else
+        {
+            /* Records out of order or not readable: linear scan of the whole ring */
+            cur->pos        = tail;
+            cur->remaining  = payload_data_count;
+            cur->unsorted   = valid ? (payload_data_count - payload_data_sorted) : payload_data_count;
+        }
+
+        cur->start  = start;
+        cur->end    = end;
+
+        payload_data_unlock();
+    }
+
+    return err;
+}
+
+int payload_data_next(payload_data_cursor_t *cur, payload_data_record_t *rec)
+{
+    int err = -1;
+
+    if (payload_data_lock() == 0)
+    {
+        while((cur->remaining > 0U) && (err != 0))
+        {
+            sys_time_t time_tag = 0;
+
+            bool sorted = (cur->unsorted == 0U);
+
+            uint32_t slot = cur->pos;
+
+            cur->pos = (cur->pos + 1U) % PAYLOAD_DATA_SLOTS;
+            cur->remaining--;
+
+            if (!sorted)
+            {
+                cur->unsorted--;
+            }
+
+            /* Erased or corrupted records are skipped */
+            if (payload_data_read_page(slot, &time_tag) == 0)
+            {
+                if (time_tag > cur->end)
+                {
+                    if (sorted)
+                    {
+                        cur->remaining = 0;     /* The next records are newer */
+                    }
+                }
+                else if (time_tag >= cur->start)
+                {
+                    rec->pl_id      = payload_data_page[0];
+                    rec->type       = payload_data_page[1];
+                    rec->length     = payload_data_page[2];
+                    rec->time_tag   = time_tag;
+
+                    memcpy(rec->data, &payload_data_page[PAYLOAD_DATA_RECORD_HEADER_LEN], rec->length);
+
+                    err = 0;
+                }
+                else
+                {
+                    /* Older than the interval */
+                }
+            }
+        }
+
+        payload_data_unlock();
+    }
+
+    return err;
+}
+
+uint32_t payload_data_get_count(void)
+{
+    return payload_data_count;
+}
+
+int payload_data_clear(void)
+{
+    int err = payload_data_lock();
+
+    if (err == 0)
+    {
+        payload_data_head = 0;
+        payload_data_count = 0;
+        payload_data_sorted = 0;
+        payload_data_reserved = 0;
+
+        err = payload_data_save_index();
+
+        payload_data_unlock();
+    }
+
+    return err;
+}
+
+static int payload_data_lock(void)
+{
+    int err = -1;
+
+    if (payload_data_mutex != NULL)
+    {
+        if (xSemaphoreTake(payload_data_mutex, pdMS_TO_TICKS(PAYLOAD_DATA_MUTEX_WAIT_TIME_MS)) == pdTRUE)
+        {
+            err = 0;
+        }
+    }
+
+    return err;
+}
+
+static void payload_data_unlock(void)
+{
+    xSemaphoreGive(payload_data_mutex);
+}
+
+static int payload_data_write_record(uint8_t pl_id, uint8_t type, sys_time_t time_tag, uint8_t *prefix, uint16_t prefix_len, uint8_t *data, uint16_t len)
+{
+    int err = 0;
+
+    uint32_t adr = payload_data_start + (payload_data_head * PAYLOAD_DATA_RECORD_SIZE);
+    uint32_t slots_per_sub = payload_data_sub_sector_size / PAYLOAD_DATA_RECORD_SIZE;
+
+    /* Entering a new sub-sector: erase it (if not erased in advance), dropping the oldest records if the ring is full */
+    if ((payload_data_head % slots_per_sub) == 0U)
+    {
+        if (payload_data_reserved > 0U)
+        {
+            payload_data_reserved--;
+        }
+        else if ((payload_data_drop(PAYLOAD_DATA_SLOTS - slots_per_sub) != 0) ||
+                 (media_erase(MEDIA_NOR, MEDIA_ERASE_SUB_SECTOR, adr / payload_data_sub_sector_size) != 0))
+        {
+            err = -1;
+        }
+        else
+        {
+            /* Sub-sector ready */
+        }
+    }
+
+    if (err == 0)
+    {
+        uint16_t total_len = prefix_len + len;
+
+        memset(payload_data_page, 0xFF, sizeof(payload_data_page));
+
+        payload_data_page[0] = pl_id;
+        payload_data_page[1] = type;
+        payload_data_page[2] = (uint8_t)total_len;
+        payload_data_page[3] = ((uint32_t)time_tag >> 24) & 0xFFU;
+        payload_data_page[4] = ((uint32_t)time_tag >> 16) & 0xFFU;
+        payload_data_page[5] = ((uint32_t)time_tag >> 8) & 0xFFU;
+        payload_data_page[6] = (uint32_t)time_tag & 0xFFU;
+
+        if (prefix_len > 0U)
+        {
+            memcpy(&payload_data_page[PAYLOAD_DATA_RECORD_HEADER_LEN], prefix, prefix_len);
+        }
+
+        memcpy(&payload_data_page[PAYLOAD_DATA_RECORD_HEADER_LEN + prefix_len], data, len);
+
+        uint16_t crc = payload_data_crc16(0U, payload_data_page, PAYLOAD_DATA_RECORD_HEADER_LEN + total_len);
+
+        payload_data_page[PAYLOAD_DATA_RECORD_HEADER_LEN + total_len]      = (crc >> 8) & 0xFFU;
+        payload_data_page[PAYLOAD_DATA_RECORD_HEADER_LEN + total_len + 1U] = crc & 0xFFU;
+
+        err = media_write(MEDIA_NOR, adr, payload_data_page, PAYLOAD_DATA_RECORD_HEADER_LEN + total_len + PAYLOAD_DATA_RECORD_CRC_LEN);
+    }
+
+    if (err == 0)
+    {
+        /* A record older than the newest one breaks the chronological order */
+        if ((payload_data_sorted > 0U) && (time_tag < payload_data_last_time))
+        {
+            payload_data_sorted = 0;
+        }
+
+        payload_data_head = (payload_data_head + 1U) % PAYLOAD_DATA_SLOTS;
+        payload_data_count++;
+        payload_data_sorted++;
+        payload_data_last_time = time_tag;
+
+        err = payload_data_save_index();
+    }
+    else
+    {
+        sys_log_print_event_from_module(SYS_LOG_ERROR, PAYLOAD_DATA_NAME, "Error writing a payload data record to the NOR memory!");
+        sys_log_new_line();
+    }
+
+    return err;
+}
+
+static int payload_data_drop(uint32_t max_count)
+{
+    int err = 0;
+
+    if (payload_data_count > max_count)
+    {
+        payload_data_count = max_count;
+
+        if (payload_data_sorted > max_count)
+        {
+            payload_data_sorted = max_count;
+        }
+
+        err = payload_data_save_index();
+    }
+
+    return err;
+}
+
+static int payload_data_reserve(uint32_t slots)
+{
+    int err = 0;
+
+    uint32_t slots_per_sub = payload_data_sub_sector_size / PAYLOAD_DATA_RECORD_SIZE;
+
+    /* Free slots: the rest of the current sub-sector + the sub-sectors already erased */
+    uint32_t avail = ((slots_per_sub - (payload_data_head % slots_per_sub)) % slots_per_sub) + (payload_data_reserved * slots_per_sub);
+
+    if (slots > (PAYLOAD_DATA_SLOTS - slots_per_sub))
+    {
+        err = -1;
+    }
+
+    while((err == 0) && (avail < slots))
+    {
+        uint32_t slot = (payload_data_head + avail) % PAYLOAD_DATA_SLOTS;
+
+        /* The oldest records are dropped if the erased sub-sector is in use */
+        if ((payload_data_drop(PAYLOAD_DATA_SLOTS - avail - slots_per_sub) == 0) &&
+            (media_erase(MEDIA_NOR, MEDIA_ERASE_SUB_SECTOR, (payload_data_start + (slot * PAYLOAD_DATA_RECORD_SIZE)) / payload_data_sub_sector_size) == 0))
+        {
+            payload_data_reserved++;
+            avail += slots_per_sub;
+        }
+        else
+        {
+            sys_log_print_event_from_module(SYS_LOG_ERROR, PAYLOAD_DATA_NAME, "Error erasing the NOR memory in advance!");
+            sys_log_new_line();
+
+            err = -1;
+        }
+    }
+
+    return err;
+}
+
+static int payload_data_load_index(void)
+{
+    int err = -1;
+
+    uint8_t buf[PAYLOAD_DATA_INDEX_LEN] = {0};
+
+    if (media_read(MEDIA_FRAM, CONFIG_MEM_ADR_PAYLOAD_DATA_INDEX, buf, PAYLOAD_DATA_INDEX_LEN) == 0)
+    {
+        uint16_t crc = ((uint16_t)buf[13] << 8) | (uint16_t)buf[14];
+
+        if ((buf[0] == PAYLOAD_DATA_MEM_ID) && (payload_data_crc16(0U, buf, 13U) == crc))
+        {
+            uint32_t head = ((uint32_t)buf[1] << 24) | ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 8) | (uint32_t)buf[4];
+            uint32_t count = ((uint32_t)buf[5] << 24) | ((uint32_t)buf[6] << 16) | ((uint32_t)buf[7] << 8) | (uint32_t)buf[8];
+            uint32_t sorted = ((uint32_t)buf[9] << 24) | ((uint32_t)buf[10] << 16) | ((uint32_t)buf[11] << 8) | (uint32_t)buf[12];
+
+            /* A full ring (count == slots) is a valid state after the first wrap */
+            if ((head < PAYLOAD_DATA_SLOTS) && (count <= PAYLOAD_DATA_SLOTS) && (sorted <= count))
+            {
+                payload_data_head = head;
+                payload_data_count = count;
+                payload_data_sorted = sorted;
+
+                err = 0;
+            }
+        }
+    }
+
+    return err;
+}
+
+static int payload_data_save_index(void)
+{
+    int err = 0;
+
+    uint8_t buf[PAYLOAD_DATA_INDEX_LEN] = {0};
+
+    buf[0] = PAYLOAD_DATA_MEM_ID;
+    buf[1] = (payload_data_head >> 24) & 0xFFU;
+    buf[2] = (payload_data_head >> 16) & 0xFFU;
+    buf[3] = (payload_data_head >> 8) & 0xFFU;
+    buf[4] = payload_data_head & 0xFFU;
+    buf[5] = (payload_data_count >> 24) & 0xFFU;
+    buf[6] = (payload_data_count >> 16) & 0xFFU;
+    buf[7] = (payload_data_count >> 8) & 0xFFU;
+    buf[8] = payload_data_count & 0xFFU;
+    buf[9] = (payload_data_sorted >> 24) & 0xFFU;
+    buf[10] = (payload_data_sorted >> 16) & 0xFFU;
+    buf[11] = (payload_data_sorted >> 8) & 0xFFU;
+    buf[12] = payload_data_sorted & 0xFFU;
+
+    uint16_t crc = payload_data_crc16(0U, buf, 13U);
+
+    buf[13] = (crc >> 8) & 0xFFU;
+    buf[14] = crc & 0xFFU;
+
+    if (media_write(MEDIA_FRAM, CONFIG_MEM_ADR_PAYLOAD_DATA_INDEX, buf, PAYLOAD_DATA_INDEX_LEN) != 0)
+    {
+        sys_log_print_event_from_module(SYS_LOG_ERROR, PAYLOAD_DATA_NAME, "Error writing the payload data index to the FRAM memory!");
+        sys_log_new_line();
+
+        err = -1;
+    }
+
+    return err;
+}
+
+static int payload_data_read_page(uint32_t slot, sys_time_t *time_tag)
+{
+    int err = -1;
+
+    if (media_read(MEDIA_NOR, payload_data_start + (slot * PAYLOAD_DATA_RECORD_SIZE), payload_data_page, PAYLOAD_DATA_RECORD_SIZE) == 0)
+    {
+        uint16_t len = payload_data_page[2];
+
+        /* An erased page has a length of 0xFF */
+        if (len <= PAYLOAD_DATA_MAX_LEN)
+        {
+            uint16_t crc = ((uint16_t)payload_data_page[PAYLOAD_DATA_RECORD_HEADER_LEN + len] << 8) |
+                           (uint16_t)payload_data_page[PAYLOAD_DATA_RECORD_HEADER_LEN + len + 1U];
+
+            if (payload_data_crc16(0U, payload_data_page, PAYLOAD_DATA_RECORD_HEADER_LEN + len) == crc)
+            {
+                *time_tag = ((sys_time_t)payload_data_page[3] << 24) |
+                            ((sys_time_t)payload_data_page[4] << 16) |
+                            ((sys_time_t)payload_data_page[5] << 8) |
+                            (sys_time_t)payload_data_page[6];
+
+                err = 0;
+            }
+        }
+    }
+
+    return err;
+}
+
+static uint16_t payload_data_crc16(uint16_t initial_value, uint8_t *data, uint16_t size)
+{
+    uint8_t x = 0;
+    uint16_t crc = initial_value;
+
+    uint16_t i = 0;
+    for(i = 0; i < size; i++)
+    {
+        x = (crc >> 8) ^ data[i];
+        x ^= x >> 4;
+        crc = (crc << 8) ^ ((uint16_t)x << 12) ^ ((uint16_t)x << 5) ^ (uint16_t)x;
+    }
+
+    return crc;
+}
+
+/** \} End of payload_data group */
@@ -0,0 +1,242 @@
+/*
+ * payload_data.h
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Payload data storage definition.
+ *
+ * The payload data records are stored in a ring of NOR pages (one record per page), in the last
+ * CONFIG_MEM_PAYLOAD_DATA_SIZE bytes of the NOR memory. The records are normally written in
+ * chronological order, so the ring can be searched by time tag. The position of the ring (head,
+ * number of records and number of newest records in chronological order) is kept in the FRAM
+ * memory: when the system time is set backwards, the older records are searched linearly.
+ *
+ * The data of a record is limited to what fits in a single "payload data" downlink frame.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.24
+ *
+ * \date 2022/11/24
+ *
+ * \defgroup payload_data Payload Data
+ * \ingroup structs
+ * \{
+ */
+
+#ifndef PAYLOAD_DATA_H_
+#define PAYLOAD_DATA_H_
+
+#include <stdint.h>
+
+#include <system/system.h>
+
+#include <fsat_pkt/fsat_pkt.h>
+
+#define PAYLOAD_DATA_NAME                   "Payload Data"
+
+#define PAYLOAD_DATA_MUTEX_WAIT_TIME_MS     100U        /**< Wait time to take the storage mutex in milliseconds. */
+
+#define PAYLOAD_DATA_RECORD_SIZE            256U        /**< Record size in bytes (one NOR page). */
+#define PAYLOAD_DATA_RECORD_HEADER_LEN      7U          /**< Payload ID + type + length + time tag. */
+#define PAYLOAD_DATA_RECORD_CRC_LEN         2U          /**< CRC16 of the header and the data. */
+
+#define PAYLOAD_DATA_FRAME_HEADER_LEN       (FSAT_PKT_HEADER_LEN + FSAT_PKT_CALLSIGN_LEN + 2U)  /**< Header + requester callsign + sequence number of a downlink frame. */
+#define PAYLOAD_DATA_FRAME_RECORD_HEADER_LEN 6U         /**< Type + time tag + length of a record in a downlink frame. */
+#define PAYLOAD_DATA_MAX_LEN                (FSAT_PKT_MAX_LEN - PAYLOAD_DATA_FRAME_HEADER_LEN - PAYLOAD_DATA_FRAME_RECORD_HEADER_LEN)
+
+#define PAYLOAD_DATA_STREAM_OFFSET_LEN      2U          /**< Offset of the chunk in the stream (first bytes of the data of a stream record). */
+#define PAYLOAD_DATA_STREAM_CHUNK_LEN       (PAYLOAD_DATA_MAX_LEN - PAYLOAD_DATA_STREAM_OFFSET_LEN)
+#define PAYLOAD_DATA_STREAM_END             0x80U       /**< Type flag of the last record of a stream (length + CRC16 of the stream). */
+
+/**
+ * \brief Payload data record type.
+ */
+typedef enum
+{
+    PAYLOAD_DATA_TYPE_EDC_PTT=1,    /**< EDC PTT packet. */
+    PAYLOAD_DATA_TYPE_EDC_HK,       /**< EDC housekeeping frame. */
+    PAYLOAD_DATA_TYPE_EDC_ADC_SEQ,  /**< EDC ADC sequence frame (stream). */
+    PAYLOAD_DATA_TYPE_CPU_USAGE     /**< OBDH CPU usage table (task index, load and run time of each task). */
+} payload_data_type_t;
+
+/**
+ * \brief Payload data record.
+ */
+typedef struct
+{
+    uint8_t pl_id;                          /**< Payload ID (CONFIG_PL_ID_*). */
+    uint8_t type;                           /**< Record type (payload_data_type_t). */
+    uint8_t length;                         /**< Number of bytes of data. */
+    sys_time_t time_tag;                    /**< System time when the record was stored. */
+    uint8_t data[PAYLOAD_DATA_MAX_LEN];     /**< Raw data read from the payload. */
+} payload_data_record_t;
+
+/**
+ * \brief Payload data cursor (used to iterate over the stored records).
+ */
+typedef struct
+{
+    uint32_t pos;                           /**< Slot of the next record to read. */
+    uint32_t remaining;                     /**< Number of records after the cursor. */
+    uint32_t unsorted;                      /**< Number of records after the cursor not in chronological order. */
+    sys_time_t start;                       /**< Initial time tag of the search. */
+    sys_time_t end;                         /**< Final time tag of the search. */
+} payload_data_cursor_t;
+
+/**
+ * \brief Payload data stream (data too long for a single record).
+ *
+ * A stream is stored as a sequence of records of the same type and time tag, each one with
+ * the offset of its chunk, followed by a record of type PAYLOAD_DATA_STREAM_END with the
+ * length and the CRC16 of the whole stream.
+ */
+typedef struct
+{
+    uint8_t pl_id;                          /**< Payload ID (CONFIG_PL_ID_*). */
+    uint8_t type;                           /**< Record type (payload_data_type_t). */
+    sys_time_t time_tag;                    /**< Time tag of the records. */
+    uint16_t offset;                        /**< Number of bytes already stored. */
+    uint16_t crc;                           /**< CRC16 of the bytes already stored. */
+} payload_data_stream_t;
+
+/**
+ * \brief Initializes the payload data storage.
+ *
+ * Creates the storage mutex and loads the position of the ring from the FRAM memory. If no
+ * valid position is found, the ring starts empty.
+ *
+ * \return The status/error code.
+ */
+int payload_data_init(void);
+
+/**
+ * \brief Stores a payload data record.
+ *
+ * When the ring is full, the oldest sub-sector of records is erased to make room for the
+ * new ones.
+ *
+ * \param[in] pl_id is the payload ID (CONFIG_PL_ID_*).
+ *
+ * \param[in] type is the record type.
+ *
+ * \param[in] time_tag is the time tag of the record.
+ *
+ * \param[in] data is the data to store.
+ *
+ * \param[in] len is the number of bytes of data (up to PAYLOAD_DATA_MAX_LEN).
+ *
+ * \return The status/error code (an error for longer records).
+ */
+int payload_data_write(uint8_t pl_id, payload_data_type_t type, sys_time_t time_tag, uint8_t *data, uint16_t len);
+
+/**
+ * \brief Starts a stream of payload data.
+ *
+ * All the NOR sub-sectors needed by the stream are erased in advance, so the chunks can be
+ * written as fast as they are received.
+ *
+ * \param[in,out] st is a pointer to the stream.
+ *
+ * \param[in] pl_id is the payload ID (CONFIG_PL_ID_*).
+ *
+ * \param[in] type is the record type.
+ *
+ * \param[in] time_tag is the time tag of the records.
+ *
+ * \param[in] len is the expected length of the stream in bytes.
+ *
+ * \return The status/error code.
+ */
+int payload_data_stream_begin(payload_data_stream_t *st, uint8_t pl_id, payload_data_type_t type, sys_time_t time_tag, uint16_t len);
+
+/**
+ * \brief Stores the next chunk of a stream.
+ *
+ * \param[in,out] st is a pointer to the stream.
+ *
+ * \param[in] data is the chunk to store.
+ *
+ * \param[in] len is the number of bytes of the chunk (up to PAYLOAD_DATA_STREAM_CHUNK_LEN).
+ *
+ * \return The status/error code.
+ */
+int payload_data_stream_write(payload_data_stream_t *st, uint8_t *data, uint16_t len);
+
+/**
+ * \brief Finishes a stream, storing its length and CRC16.
+ *
+ * \param[in,out] st is a pointer to the stream.
+ *
+ * \return The status/error code.
+ */
+int payload_data_stream_end(payload_data_stream_t *st);
+
+/**
+ * \brief Places a cursor on the stored records with a time tag in a given interval.
+ *
+ * The ring is searched by bisection while all the records are in chronological order. If there
+ * are records out of order (e.g. after the system time is set back), or if an erased or corrupted
+ * record is found by the bisection, the cursor scans the whole ring instead.
+ *
+ * \param[in] start is the initial time tag.
+ *
+ * \param[in] end is the final time tag.
+ *
+ * \param[in,out] cur is a pointer to the cursor to place.
+ *
+ * \return The status/error code.
+ */
+int payload_data_seek(sys_time_t start, sys_time_t end, payload_data_cursor_t *cur);
+
+/**
+ * \brief Reads the next record of the interval of a cursor and advances the cursor.
+ *
+ * Records that were overwritten or are corrupted, and records out of the interval, are skipped.
+ *
+ * \param[in,out] cur is a pointer to the cursor.
+ *
+ * \param[in,out] rec is a pointer to store the read record.
+ *
+ * \return The status/error code (-1 when there are no more records).
+ */
+int payload_data_next(payload_data_cursor_t *cur, payload_data_record_t *rec);
+
+/**
+ * \brief Gets the number of stored records.
+ *
+ * \return The number of stored records.
+ */
+uint32_t payload_data_get_count(void);
+
+/**
+ * \brief Empties the ring, resetting its index in the FRAM.
+ *
+ * It must be called after the payload data region of the NOR memory is erased by other means
+ * (e.g. a die erase), so the index does not point to erased records.
+ *
+ * \return The status/error code.
+ */
+int payload_data_clear(void);
+
+#endif /* PAYLOAD_DATA_H_ */
+
+/** \} End of payload_data group */
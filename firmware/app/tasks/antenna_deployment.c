@@ -64,24 +64,17 @@ void vTaskAntennaDeployment(void)
     }
     else
     {
-        sys_log_print_event_from_module(SYS_LOG_INFO, TASK_ANTENNA_DEPLOYMENT_NAME, "Initial deployment already executed!");
-        sys_log_new_line();
+        SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_ANTENNA_DEPLOYMENT, SYS_LOG_TOK_ANT_DEPLOY_DONE, 0, 0);
     }
 
     /* Antenna deployment */
     if (sat_data_buf.obdh.data.ant_deployment_counter < CONFIG_ANTENNA_DEPLOYMENT_ATTEMPTS)
     {
-        sys_log_print_event_from_module(SYS_LOG_INFO, TASK_ANTENNA_DEPLOYMENT_NAME, "Antenna deployment attempt number ");
-        sys_log_print_uint(sat_data_buf.obdh.data.ant_deployment_counter + 1);
-        sys_log_print_msg(" of ");
-        sys_log_print_uint(CONFIG_ANTENNA_DEPLOYMENT_ATTEMPTS);
-        sys_log_print_msg("...");
-        sys_log_new_line();
+        SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_ANTENNA_DEPLOYMENT, SYS_LOG_TOK_ANT_DEPLOY_ATTEMPT, sat_data_buf.obdh.data.ant_deployment_counter + 1U, CONFIG_ANTENNA_DEPLOYMENT_ATTEMPTS);
 
         if (antenna_deploy(10U*1000U) != 0)
         {
-            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_ANTENNA_DEPLOYMENT_NAME, "Error deploying the antenna!");
-            sys_log_new_line();
+            SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_ANTENNA_DEPLOYMENT, SYS_LOG_TOK_ANT_DEPLOY_ERROR, 0, 0);
         }
 
         sat_data_buf.obdh.data.ant_deployment_counter = true;
@@ -90,10 +83,7 @@ void vTaskAntennaDeployment(void)
     }
     else
     {
-        sys_log_print_event_from_module(SYS_LOG_INFO, TASK_ANTENNA_DEPLOYMENT_NAME, "All antenna deployments attempts executed! (");
-        sys_log_print_uint(sat_data_buf.obdh.data.ant_deployment_counter + 1);
-        sys_log_print_msg(")");
-        sys_log_new_line();
+        SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_ANTENNA_DEPLOYMENT, SYS_LOG_TOK_ANT_DEPLOY_ALL_DONE, sat_data_buf.obdh.data.ant_deployment_counter + 1U, 0);
     }
 }
 
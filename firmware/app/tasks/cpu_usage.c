@@ -0,0 +1,236 @@
+/*
+ * cpu_usage.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief CPU usage task implementation.
+ *
+ * The run time counters are driven by the free-running microsecond timer (Timer_A1). Every
+ * period, the counters of all the tasks are sampled (scheduler suspended), and the load of
+ * each task in the last period and its total run time are stored in a table, read by the
+ * get parameter TC. Optionally, the table is also stored in the NOR memory. The stack high-water
+ * marks of the same sample (computed by the kernel) are passed to the stack monitor.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.25
+ *
+ * \date 2022/12/12
+ *
+ * \addtogroup cpu_usage
+ * \{
+ */
+
+#include <stddef.h>
+
+#include <config/config.h>
+#include <system/system.h>
+#include <system/sys_log/sys_log.h>
+#include <libs/stats/cpu_stats.h>
+#include <structs/payload_data.h>
+
+#include "cpu_usage.h"
+#include "stack_monitor.h"
+#include "startup.h"
+
+xTaskHandle xTaskCPUUsageHandle;
+
+static TaskStatus_t cpu_usage_status[CONFIG_CPU_USAGE_MAX_TASKS];   /* Too big for the task stack */
+
+static cpu_stats_t cpu_usage_stats[CONFIG_CPU_USAGE_MAX_TASKS];
+
+static const char *cpu_usage_names[CONFIG_CPU_USAGE_MAX_TASKS] = {NULL};
+
+/**
+ * \brief Samples the run time counters and updates the CPU usage table.
+ *
+ * \return The status/error code.
+ */
+static int cpu_usage_sample(void);
+
+#if defined(CONFIG_CPU_USAGE_NOR_LOG_ENABLED) && (CONFIG_CPU_USAGE_NOR_LOG_ENABLED == 1)
+/* The whole table must fit in a single payload data record */
+typedef char cpu_usage_record_check[((CONFIG_CPU_USAGE_MAX_TASKS * CPU_USAGE_RECORD_LEN) <= PAYLOAD_DATA_MAX_LEN) ? 1 : -1];
+
+/**
+ * \brief Stores the CPU usage table in the NOR memory.
+ *
+ * \return The status/error code.
+ */
+static int cpu_usage_store(void);
+#endif /* CONFIG_CPU_USAGE_NOR_LOG_ENABLED */
+
+void vTaskCPUUsage(void)
+{
+    /* Wait startup task to finish */
+    xEventGroupWaitBits(task_startup_status, TASK_STARTUP_DONE, pdFALSE, pdTRUE, pdMS_TO_TICKS(TASK_CPU_USAGE_INIT_TIMEOUT_MS));
+
+#if defined(CONFIG_CPU_USAGE_NOR_LOG_ENABLED) && (CONFIG_CPU_USAGE_NOR_LOG_ENABLED == 1)
+    uint8_t cycles = 0U;
+#endif /* CONFIG_CPU_USAGE_NOR_LOG_ENABLED */
+
+    while(1)
+    {
+        TickType_t last_cycle = xTaskGetTickCount();
+
+        if (cpu_usage_sample() != 0)
+        {
+            SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_CPU_USAGE, SYS_LOG_TOK_CPU_SAMPLE_ERROR, 0, 0);
+        }
+
+    #if defined(CONFIG_CPU_USAGE_NOR_LOG_ENABLED) && (CONFIG_CPU_USAGE_NOR_LOG_ENABLED == 1)
+        cycles++;
+
+        if (cycles >= TASK_CPU_USAGE_NOR_LOG_CYCLES)
+        {
+            cycles = 0U;
+
+            if (cpu_usage_store() != 0)
+            {
+                SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_CPU_USAGE, SYS_LOG_TOK_CPU_STORE_ERROR, 0, 0);
+            }
+        }
+    #endif /* CONFIG_CPU_USAGE_NOR_LOG_ENABLED */
+
+        vTaskDelayUntil(&last_cycle, pdMS_TO_TICKS(TASK_CPU_USAGE_PERIOD_MS));
+    }
+}
+
+int cpu_usage_get(uint8_t task, uint8_t field, uint32_t *val)
+{
+    int err = -1;
+
+    if ((task < CONFIG_CPU_USAGE_MAX_TASKS) && (cpu_usage_names[task] != NULL))
+    {
+        if (field == CPU_USAGE_FIELD_NAME)
+        {
+            const char *name = cpu_usage_names[task];
+
+            *val = 0UL;
+
+            uint8_t i = 0U;
+            for(i = 0U; i < 4U; i++)
+            {
+                *val <<= 8;
+
+                if (*name != '\0')
+                {
+                    *val |= (uint8_t)*name;
+                    name++;
+                }
+            }
+
+            err = 0;
+        }
+        else
+        {
+            taskENTER_CRITICAL();
+
+            cpu_stats_t stats = cpu_usage_stats[task];
+
+            taskEXIT_CRITICAL();
+
+            err = cpu_stats_get_field(&stats, field, val);
+        }
+    }
+
+    return err;
+}
+
+static int cpu_usage_sample(void)
+{
+    static uint32_t last_total = 0UL;
+
+    int err = -1;
+
+    uint32_t total = 0UL;
+
+    /* Returns 0 if the array is smaller than the number of tasks */
+    UBaseType_t n = uxTaskGetSystemState(cpu_usage_status, CONFIG_CPU_USAGE_MAX_TASKS, &total);
+
+    if (n > 0U)
+    {
+        /* The first window starts with the timer, at the same time as the counters */
+        uint32_t window = total - last_total;
+
+        last_total = total;
+
+        UBaseType_t i = 0U;
+        for(i = 0U; i < n; i++)
+        {
+            UBaseType_t task = cpu_usage_status[i].xTaskNumber - 1U;
+
+            if (task < CONFIG_CPU_USAGE_MAX_TASKS)
+            {
+                /* Only this task writes the table: the divisions are out of the critical section */
+                cpu_stats_t stats = cpu_usage_stats[task];
+
+                cpu_stats_update(&stats, cpu_usage_status[i].ulRunTimeCounter, window);
+
+                taskENTER_CRITICAL();
+
+                cpu_usage_stats[task] = stats;
+
+                taskEXIT_CRITICAL();
+
+                cpu_usage_names[task] = cpu_usage_status[i].pcTaskName;
+
+                stack_monitor_update((uint8_t)task, (uint16_t)cpu_usage_status[i].usStackHighWaterMark);
+            }
+        }
+
+        err = 0;
+    }
+
+    return err;
+}
+
+#if defined(CONFIG_CPU_USAGE_NOR_LOG_ENABLED) && (CONFIG_CPU_USAGE_NOR_LOG_ENABLED == 1)
+static int cpu_usage_store(void)
+{
+    static uint8_t buf[CONFIG_CPU_USAGE_MAX_TASKS * CPU_USAGE_RECORD_LEN] = {0};
+
+    uint16_t len = 0U;
+
+    uint8_t task = 0U;
+    for(task = 0U; task < CONFIG_CPU_USAGE_MAX_TASKS; task++)
+    {
+        if (cpu_usage_names[task] != NULL)
+        {
+            cpu_stats_t stats = cpu_usage_stats[task];  /* Written only by this task */
+
+            buf[len]        = task;
+            buf[len + 1U]   = (uint8_t)(stats.load >> 8);
+            buf[len + 2U]   = (uint8_t)stats.load;
+            buf[len + 3U]   = (uint8_t)(stats.run_time_ms >> 24);
+            buf[len + 4U]   = (uint8_t)(stats.run_time_ms >> 16);
+            buf[len + 5U]   = (uint8_t)(stats.run_time_ms >> 8);
+            buf[len + 6U]   = (uint8_t)stats.run_time_ms;
+
+            len += CPU_USAGE_RECORD_LEN;
+        }
+    }
+
+    return payload_data_write(CONFIG_PL_ID_OBDH, PAYLOAD_DATA_TYPE_CPU_USAGE, system_get_time(), buf, len);
+}
+#endif /* CONFIG_CPU_USAGE_NOR_LOG_ENABLED */
+
+/** \} End of cpu_usage group */
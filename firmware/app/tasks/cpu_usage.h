@@ -0,0 +1,86 @@
+/*
+ * cpu_usage.h
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief CPU usage task definition.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.25
+ *
+ * \date 2022/12/12
+ *
+ * \defgroup cpu_usage CPU Usage
+ * \ingroup tasks
+ * \{
+ */
+
+#ifndef CPU_USAGE_H_
+#define CPU_USAGE_H_
+
+#include <stdint.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#define TASK_CPU_USAGE_NAME                 "CPU Usage"     /**< Task name. */
+#define TASK_CPU_USAGE_STACK_SIZE           160             /**< Memory stack size in bytes. */
+#define TASK_CPU_USAGE_PRIORITY             1               /**< Priority. */
+#define TASK_CPU_USAGE_PERIOD_MS            10000           /**< Period in milliseconds (length of the load window). */
+#define TASK_CPU_USAGE_INIT_TIMEOUT_MS      2000            /**< Wait time to initialize the task in milliseconds. */
+#define TASK_CPU_USAGE_NOR_LOG_CYCLES       6U              /**< Number of periods between two records in the NOR memory. */
+
+#define CPU_USAGE_FIELD_NAME                2U              /**< First 4 characters of the task name (after the CPU_STATS_FIELD_* fields). */
+#define CPU_USAGE_RECORD_LEN                7U              /**< Task index + load + run time (NOR record entry). */
+
+/**
+ * \brief CPU usage task handle.
+ */
+extern xTaskHandle xTaskCPUUsageHandle;
+
+/**
+ * \brief CPU usage task.
+ *
+ * Samples the run time counters of all the tasks, updating their CPU usage table and
+ * their stack high-water marks (stack monitor).
+ *
+ * \return None.
+ */
+void vTaskCPUUsage(void);
+
+/**
+ * \brief Reads a field of the CPU usage table.
+ *
+ * \param[in] task is the task index (creation order, starting from 0, of all the tasks
+ * including the idle and the timer tasks).
+ *
+ * \param[in] field is the field ID (CPU_STATS_FIELD_* or CPU_USAGE_FIELD_NAME).
+ *
+ * \param[in,out] val is a pointer to store the field value.
+ *
+ * \return The status/error code.
+ */
+int cpu_usage_get(uint8_t task, uint8_t field, uint32_t *val);
+
+#endif /* CPU_USAGE_H_ */
+
+/** \} End of cpu_usage group */
@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.8.11
+ * \version 0.10.6
  * 
  * \date 2021/05/24
  * 
@@ -35,6 +35,7 @@
 
 #include <stdint.h>
 
+#include <config/config.h>
 #include <system/sys_log/sys_log.h>
 #include <devices/media/media.h>
 #include <structs/satellite.h>
@@ -285,7 +286,8 @@ void vTaskDataLog(void)
 
         mem_adr += nor_info.page_size;
 
-        if (mem_adr > nor_info.size)
+        /* The last CONFIG_MEM_PAYLOAD_DATA_SIZE bytes of the NOR memory are reserved to the payload data */
+        if (mem_adr >= (nor_info.size - CONFIG_MEM_PAYLOAD_DATA_SIZE))
         {
             mem_adr = nor_info.page_size;
         }
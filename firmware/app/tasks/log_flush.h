@@ -0,0 +1,63 @@
+/*
+ * log_flush.h
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Log flush task definition.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.19
+ *
+ * \date 2022/12/07
+ *
+ * \defgroup log_flush Log Flush
+ * \ingroup tasks
+ * \{
+ */
+
+#ifndef LOG_FLUSH_H_
+#define LOG_FLUSH_H_
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#define TASK_LOG_FLUSH_NAME                 "Log Flush"     /**< Task name. */
+#define TASK_LOG_FLUSH_STACK_SIZE           160             /**< Memory stack size in bytes. */
+#define TASK_LOG_FLUSH_PRIORITY             1               /**< Priority. */
+#define TASK_LOG_FLUSH_PERIOD_MS            100             /**< Period in milliseconds. */
+#define TASK_LOG_FLUSH_INIT_TIMEOUT_MS      2000            /**< Wait time to initialize the task in milliseconds. */
+
+/**
+ * \brief Log flush task handle.
+ */
+extern xTaskHandle xTaskLogFlushHandle;
+
+/**
+ * \brief Log flush task (renders the deferred log records).
+ *
+ * \return None.
+ */
+void vTaskLogFlush(void);
+
+#endif /* LOG_FLUSH_H_ */
+
+/** \} End of log_flush group */
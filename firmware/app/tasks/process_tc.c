@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.8.37
+ * \version 0.10.23
  * 
  * \date 2021/07/06
  * 
@@ -41,172 +41,232 @@
 #include <system/sys_log/sys_log.h>
 #include <system/system.h>
 #include <devices/ttc/ttc.h>
+#include <devices/ttc/ttc_link.h>
 #include <devices/media/media.h>
 #include <devices/payload/payload.h>
 #include <hmac/sha.h>
 
 #include <structs/satellite.h>
+#include <structs/beacon_frame.h>
+#include <structs/params.h>
+#include <structs/payload_data.h>
 
 #include <fsat_pkt/fsat_pkt.h>
 
 #include "process_tc.h"
 #include "startup.h"
 
+/* Requester callsign + sequence number + first record + number of records */
+#define PROCESS_TC_BLACK_BOX_HEADER_LEN         (7U + 2U + 4U + 1U)
+#define PROCESS_TC_BLACK_BOX_RECORDS_PER_FRAME  ((FSAT_PKT_MAX_LEN - FSAT_PKT_HEADER_LEN - PROCESS_TC_BLACK_BOX_HEADER_LEN) / SYS_LOG_BLACK_BOX_RECORD_LEN)
+
 xTaskHandle xTaskProcessTCHandle;
 
 /**
  * \brief Ping request telecommand.
  *
- * \param[in] pkt is the packet to process.
- *
- * \param[in] pkt_len is the number of bytes of the given packet.
+ * \param[in] tc is the view of the packet to process.
  *
  * \return None.
  */
-static void process_tc_ping_request(uint8_t *pkt, uint16_t pkt_len);
+static void process_tc_ping_request(const fsat_pkt_view_t *tc);
 
 /**
  * \brief Data request telecommand.
  *
- * \param[in] pkt is the packet to process.
- *
- * \param[in] pkt_len is the number of bytes of the given packet.
+ * \param[in] tc is the view of the packet to process.
  *
  * \return None.
  */
-static void process_tc_data_request(uint8_t *pkt, uint16_t pkt_len);
+static void process_tc_data_request(const fsat_pkt_view_t *tc);
 
 /**
  * \brief Broadcast message telecommand.
  *
- * \param[in] pkt is the packet to process.
- *
- * \param[in] pkt_len is the number of bytes of the given packet.
+ * \param[in] tc is the view of the packet to process.
  *
  * \return None.
  */
-static void process_tc_broadcast_message(uint8_t *pkt, uint16_t pkt_len);
+static void process_tc_broadcast_message(const fsat_pkt_view_t *tc);
 
 /**
  * \brief Enter hibernation telecommand.
  *
- * \param[in] pkt is the packet to process.
- *
- * \param[in] pkt_len is the number of bytes of the given packet.
+ * \param[in] tc is the view of the packet to process.
  *
  * \return None.
  */
-static void process_tc_enter_hibernation(uint8_t *pkt, uint16_t pkt_len);
+static void process_tc_enter_hibernation(const fsat_pkt_view_t *tc);
 
 /**
  * \brief Leave hibernation telecommand.
  *
- * \param[in] pkt is the packet to process.
- *
- * \param[in] pkt_len is the number of bytes of the given packet.
+ * \param[in] tc is the view of the packet to process.
  *
  * \return None.
  */
-static void process_tc_leave_hibernation(uint8_t *pkt, uint16_t pkt_len);
+static void process_tc_leave_hibernation(const fsat_pkt_view_t *tc);
 
 /**
  * \brief Activate module telecommand.
  *
- * \param[in] pkt is the packet to process.
- *
- * \param[in] pkt_len is the number of bytes of the given packet.
+ * \param[in] tc is the view of the packet to process.
  *
  * \return None.
  */
-static void process_tc_activate_module(uint8_t *pkt, uint16_t pkt_len);
+static void process_tc_activate_module(const fsat_pkt_view_t *tc);
 
 /**
  * \brief Deactivate module telecommand.
  *
- * \param[in] pkt is the packet to process.
- *
- * \param[in] pkt_len is the number of bytes of the given packet.
+ * \param[in] tc is the view of the packet to process.
  *
  * \return None.
  */
-static void process_tc_deactivate_module(uint8_t *pkt, uint16_t pkt_len);
+static void process_tc_deactivate_module(const fsat_pkt_view_t *tc);
 
 /**
  * \brief Activate payload telecommand.
  *
- * \param[in] pkt is the packet to process.
- *
- * \param[in] pkt_len is the number of bytes of the given packet.
+ * \param[in] tc is the view of the packet to process.
  *
  * \return None.
  */
-static void process_tc_activate_payload(uint8_t *pkt, uint16_t pkt_len);
+static void process_tc_activate_payload(const fsat_pkt_view_t *tc);
 
 /**
  * \brief Deactivate payload telecommand.
  *
- * \param[in] pkt is the packet to process.
- *
- * \param[in] pkt_len is the number of bytes of the given packet.
+ * \param[in] tc is the view of the packet to process.
  *
  * \return None.
  */
-static void process_tc_deactivate_payload(uint8_t *pkt, uint16_t pkt_len);
+static void process_tc_deactivate_payload(const fsat_pkt_view_t *tc);
 
 /**
  * \brief Erase memory telecommand.
  *
- * \param[in] pkt is the packet to process.
- *
- * \param[in] pkt_len is the number of bytes of the given packet.
+ * \param[in] tc is the view of the packet to process.
  *
  * \return None.
  */
-static void process_tc_erase_memory(uint8_t *pkt, uint16_t pkt_len);
+static void process_tc_erase_memory(const fsat_pkt_view_t *tc);
 
 /**
  * \brief Force reset telecommand.
  *
- * \param[in] pkt is the packet to process.
- *
- * \param[in] pkt_len is the number of bytes of the given packet.
+ * \param[in] tc is the view of the packet to process.
  *
  * \return None.
  */
-static void process_tc_force_reset(uint8_t *pkt, uint16_t pkt_len);
+static void process_tc_force_reset(const fsat_pkt_view_t *tc);
 
 /**
  * \brief Get payload data telecommand.
  *
- * \param[in] pkt is the packet to process.
+ * \param[in] tc is the view of the packet to process.
  *
- * \param[in] pkt_len is the number of bytes of the given packet.
+ * \return None.
+ */
+static void process_tc_get_payload_data(const fsat_pkt_view_t *tc);
+
+/**
+ * \brief Transmits the stored records of a payload as payload data frames.
+ *
+ * Each frame carries as many records as possible (type + time tag + length + data), and a
+ * sequence number to allow the ground station to detect lost frames.
+ *
+ * \param[in] tc is the view of the telecommand packet (used to get the requester callsign).
+ *
+ * \param[in] pl_id is the ID of the payload to transmit.
+ *
+ * \param[in,out] cur is the cursor placed on the requested interval.
  *
  * \return None.
  */
-//static void process_tc_get_payload_data(uint8_t *pkt, uint16_t pkt_len);
+static void process_tc_send_payload_data(const fsat_pkt_view_t *tc, uint8_t pl_id, payload_data_cursor_t *cur);
 
 /**
  * \brief Set parameter telecommand.
  *
- * \param[in] pkt is the packet to process.
- *
- * \param[in] pkt_len is the number of bytes of the given packet.
+ * \param[in] tc is the view of the packet to process.
  *
  * \return None.
  */
-static void process_tc_set_parameter(uint8_t *pkt, uint16_t pkt_len);
+static void process_tc_set_parameter(const fsat_pkt_view_t *tc);
 
 /**
  * \brief Get parameter telecommand.
  *
- * \param[in] pkt is the packet to process.
+ * \param[in] tc is the view of the packet to process.
+ *
+ * \return None.
+ */
+static void process_tc_get_parameter(const fsat_pkt_view_t *tc);
+
+/**
+ * \brief Set parameters (batch) telecommand.
+ *
+ * \param[in] tc is the view of the packet to process.
+ *
+ * \return None.
+ */
+static void process_tc_set_parameters(const fsat_pkt_view_t *tc);
+
+/**
+ * \brief Get parameters (batch) telecommand.
+ *
+ * \param[in] tc is the view of the packet to process.
+ *
+ * \return None.
+ */
+static void process_tc_get_parameters(const fsat_pkt_view_t *tc);
+
+/**
+ * \brief Transmits the values of a list of parameters in a single "parameter values" packet.
+ *
+ * The answer has its own packet ID (not the one of the single "get parameter" answer), since it
+ * also carries the number of values.
+ *
+ * Parameters that cannot be read are left out of the answer.
+ *
+ * \param[in] tc is the view of the requesting packet (used to get the requester callsign).
+ *
+ * \param[in] ids is the list of parameters as (subsystem ID, parameter ID) pairs.
+ *
+ * \param[in] stride is the distance in bytes between two consecutive pairs of the list.
+ *
+ * \param[in] n is the number of parameters of the list.
+ *
+ * \return None.
+ */
+static void process_tc_send_parameters(const fsat_pkt_view_t *tc, const uint8_t *ids, uint8_t stride, uint8_t n);
+
+/**
+ * \brief Get black box telecommand.
+ *
+ * \param[in] tc is the view of the packet to process.
+ *
+ * \return None.
+ */
+static void process_tc_get_black_box(const fsat_pkt_view_t *tc);
+
+/**
+ * \brief Transmits a sequence of black box records as black box frames.
+ *
+ * Each frame carries the sequence number of its first record, the number of records and up to
+ * PROCESS_TC_BLACK_BOX_RECORDS_PER_FRAME records. At least one frame is transmitted, so an
+ * empty answer still informs the ground station of the next sequence number.
  *
- * \param[in] pkt_len is the number of bytes of the given packet.
+ * \param[in] tc is the view of the telecommand packet (used to get the requester callsign).
+ *
+ * \param[in] seq is the sequence number of the first requested record.
+ *
+ * \param[in] n is the number of requested records.
  *
  * \return None.
  */
-static void process_tc_get_parameter(uint8_t *pkt, uint16_t pkt_len);
+static void process_tc_send_black_box(const fsat_pkt_view_t *tc, uint32_t seq, uint16_t n);
 
 /**
  * \brief Checks if a given HMAC is valid or not.
@@ -225,7 +285,7 @@ static void process_tc_get_parameter(uint8_t *pkt, uint16_t pkt_len);
  *
  * \return TRUE/FALSE if the key is valid or not.
  */
-static bool process_tc_validate_hmac(uint8_t *msg, uint16_t msg_len, uint8_t *msg_hash, uint16_t msg_hash_len, uint8_t *key, uint16_t key_len);
+static bool process_tc_validate_hmac(const uint8_t *msg, uint16_t msg_len, const uint8_t *msg_hash, uint16_t msg_hash_len, uint8_t *key, uint16_t key_len);
 
 void vTaskProcessTC(void)
 {
@@ -239,175 +299,183 @@ void vTaskProcessTC(void)
     {
         TickType_t last_cycle = xTaskGetTickCount();
 
-        int pkts = ttc_avail(TTC_1);
+        process_tc_poll();
 
-        if (pkts > 0)
-        {
-            sys_log_print_event_from_module(SYS_LOG_INFO, TASK_PROCESS_TC_NAME, "New ");
-            sys_log_print_uint((unsigned int)pkts);
-            sys_log_print_msg(" packet(s) available!");
-            sys_log_new_line();
+        vTaskDelayUntil(&last_cycle, pdMS_TO_TICKS(TASK_PROCESS_TC_PERIOD_MS));
+    }
+}
+
+void process_tc_poll(void)
+{
+    int pkts = ttc_avail(TTC_1);
 
-            uint8_t pkt[300] = {0};
-            uint16_t pkt_len = 0;
+    if (pkts > 0)
+    {
+        SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_PROCESS_TC, SYS_LOG_TOK_TC_NEW_PACKETS, (uint32_t)pkts, 0);
+
+        uint8_t pkt[300] = {0};
+        uint16_t pkt_len = 0;
+
+        fsat_pkt_view_t tc = {0};
 
-            if (ttc_recv(TTC_1, pkt, &pkt_len) != 0)
+        if ((ttc_recv(TTC_1, pkt, &pkt_len) == 0) && (fsat_pkt_view(pkt, pkt_len, &tc) == 0))
+        {
+            switch(tc.id)
             {
-                switch(pkt[0])
-                {
-                    case CONFIG_PKT_ID_UPLINK_PING_REQ:
-                        sys_log_print_event_from_module(SYS_LOG_INFO, TASK_PROCESS_TC_NAME, "Ping TC received!");
-                        sys_log_new_line();
+                case CONFIG_PKT_ID_UPLINK_PING_REQ:
+                    SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_PROCESS_TC, SYS_LOG_TOK_TC_PING, 0, 0);
 
-                        process_tc_ping_request(pkt, pkt_len);
+                    process_tc_ping_request(&tc);
 
-                        break;
-                    case CONFIG_PKT_ID_UPLINK_DATA_REQ:
-                        sys_log_print_event_from_module(SYS_LOG_INFO, TASK_PROCESS_TC_NAME, "Data request TC received!");
-                        sys_log_new_line();
+                    break;
+                case CONFIG_PKT_ID_UPLINK_DATA_REQ:
+                    SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_PROCESS_TC, SYS_LOG_TOK_TC_DATA_REQUEST, 0, 0);
 
-                        process_tc_data_request(pkt, pkt_len);
+                    process_tc_data_request(&tc);
 
-                        break;
-                    case CONFIG_PKT_ID_UPLINK_BROADCAST_MSG:
-                        sys_log_print_event_from_module(SYS_LOG_INFO, TASK_PROCESS_TC_NAME, "Broadcast message TC received!");
-                        sys_log_new_line();
+                    break;
+                case CONFIG_PKT_ID_UPLINK_BROADCAST_MSG:
+                    SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_PROCESS_TC, SYS_LOG_TOK_TC_BROADCAST, 0, 0);
 
-                        process_tc_broadcast_message(pkt, pkt_len);
+                    process_tc_broadcast_message(&tc);
 
-                        break;
-                    case CONFIG_PKT_ID_UPLINK_ENTER_HIBERNATION:
-                        sys_log_print_event_from_module(SYS_LOG_INFO, TASK_PROCESS_TC_NAME, "Executing the TC \"Enter Hibernation\"...");
-                        sys_log_new_line();
+                    break;
+                case CONFIG_PKT_ID_UPLINK_ENTER_HIBERNATION:
+                    SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_PROCESS_TC, SYS_LOG_TOK_TC_ENTER_HIBERNATION, 0, 0);
 
-                        process_tc_enter_hibernation(pkt, pkt_len);
+                    process_tc_enter_hibernation(&tc);
 
-                        break;
-                    case CONFIG_PKT_ID_UPLINK_LEAVE_HIBERNATION:
-                        sys_log_print_event_from_module(SYS_LOG_INFO, TASK_PROCESS_TC_NAME, "Executing the TC \"Leave Hibernation\"...");
-                        sys_log_new_line();
+                    break;
+                case CONFIG_PKT_ID_UPLINK_LEAVE_HIBERNATION:
+                    SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_PROCESS_TC, SYS_LOG_TOK_TC_LEAVE_HIBERNATION, 0, 0);
 
-                        process_tc_leave_hibernation(pkt, pkt_len);
+                    process_tc_leave_hibernation(&tc);
 
-                        break;
-                    case CONFIG_PKT_ID_UPLINK_ACTIVATE_MODULE:
-                        sys_log_print_event_from_module(SYS_LOG_INFO, TASK_PROCESS_TC_NAME, "Executing the TC \"Activate Module\"...");
-                        sys_log_new_line();
+                    break;
+                case CONFIG_PKT_ID_UPLINK_ACTIVATE_MODULE:
+                    SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_PROCESS_TC, SYS_LOG_TOK_TC_ACTIVATE_MODULE, 0, 0);
 
-                        process_tc_activate_module(pkt, pkt_len);
+                    process_tc_activate_module(&tc);
 
-                        break;
-                    case CONFIG_PKT_ID_UPLINK_DEACTIVATE_MODULE:
-                        sys_log_print_event_from_module(SYS_LOG_INFO, TASK_PROCESS_TC_NAME, "Executing the TC \"Deactivate Module\"...");
-                        sys_log_new_line();
+                    break;
+                case CONFIG_PKT_ID_UPLINK_DEACTIVATE_MODULE:
+                    SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_PROCESS_TC, SYS_LOG_TOK_TC_DEACTIVATE_MODULE, 0, 0);
 
-                        process_tc_deactivate_module(pkt, pkt_len);
+                    process_tc_deactivate_module(&tc);
 
-                        break;
-                    case CONFIG_PKT_ID_UPLINK_ACTIVATE_PAYLOAD:
-                        sys_log_print_event_from_module(SYS_LOG_INFO, TASK_PROCESS_TC_NAME, "Executing the TC \"Activate Payload\"...");
-                        sys_log_new_line();
+                    break;
+                case CONFIG_PKT_ID_UPLINK_ACTIVATE_PAYLOAD:
+                    SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_PROCESS_TC, SYS_LOG_TOK_TC_ACTIVATE_PAYLOAD, 0, 0);
 
-                        process_tc_activate_payload(pkt, pkt_len);
+                    process_tc_activate_payload(&tc);
 
-                        break;
-                    case CONFIG_PKT_ID_UPLINK_DEACTIVATE_PAYLOAD:
-                        sys_log_print_event_from_module(SYS_LOG_INFO, TASK_PROCESS_TC_NAME, "Executing the TC \"Deactivate Payload\"...");
-                        sys_log_new_line();
+                    break;
+                case CONFIG_PKT_ID_UPLINK_DEACTIVATE_PAYLOAD:
+                    SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_PROCESS_TC, SYS_LOG_TOK_TC_DEACTIVATE_PAYLOAD, 0, 0);
 
-                        process_tc_deactivate_payload(pkt, pkt_len);
+                    process_tc_deactivate_payload(&tc);
 
-                        break;
-                    case CONFIG_PKT_ID_UPLINK_ERASE_MEMORY:
-                        sys_log_print_event_from_module(SYS_LOG_INFO, TASK_PROCESS_TC_NAME, "Executing the TC \"Erase Memory\"...");
-                        sys_log_new_line();
+                    break;
+                case CONFIG_PKT_ID_UPLINK_ERASE_MEMORY:
+                    SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_PROCESS_TC, SYS_LOG_TOK_TC_ERASE_MEMORY, 0, 0);
 
-                        process_tc_erase_memory(pkt, pkt_len);
+                    process_tc_erase_memory(&tc);
 
-                        break;
-                    case CONFIG_PKT_ID_UPLINK_FORCE_RESET:
-                        sys_log_print_event_from_module(SYS_LOG_INFO, TASK_PROCESS_TC_NAME, "Executing the TC \"Force Reset\"...");
-                        sys_log_new_line();
+                    break;
+                case CONFIG_PKT_ID_UPLINK_FORCE_RESET:
+                    SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_PROCESS_TC, SYS_LOG_TOK_TC_FORCE_RESET, 0, 0);
 
-                        process_tc_force_reset(pkt, pkt_len);
+                    process_tc_force_reset(&tc);
 
-                        break;
-                    case CONFIG_PKT_ID_UPLINK_GET_PAYLOAD_DATA:
-                        break;
-                    case CONFIG_PKT_ID_UPLINK_SET_PARAM:
-                        sys_log_print_event_from_module(SYS_LOG_INFO, TASK_PROCESS_TC_NAME, "Executing the TC \"Set Parameter\"...");
-                        sys_log_new_line();
+                    break;
+                case CONFIG_PKT_ID_UPLINK_GET_PAYLOAD_DATA:
+                    SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_PROCESS_TC, SYS_LOG_TOK_TC_GET_PAYLOAD_DATA, 0, 0);
 
-                        process_tc_set_parameter(pkt, pkt_len);
+                    process_tc_get_payload_data(&tc);
 
-                        break;
-                    case CONFIG_PKT_ID_UPLINK_GET_PARAM:
-                        sys_log_print_event_from_module(SYS_LOG_INFO, TASK_PROCESS_TC_NAME, "Executing the TC \"Get Parameter\"...");
-                        sys_log_new_line();
+                    break;
+                case CONFIG_PKT_ID_UPLINK_SET_PARAM:
+                    SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_PROCESS_TC, SYS_LOG_TOK_TC_SET_PARAM, 0, 0);
 
-                        process_tc_get_parameter(pkt, pkt_len);
+                    process_tc_set_parameter(&tc);
 
-                        break;
-                    default:
-                        sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Unknown packet received!");
-                        sys_log_new_line();
+                    break;
+                case CONFIG_PKT_ID_UPLINK_GET_PARAM:
+                    SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_PROCESS_TC, SYS_LOG_TOK_TC_GET_PARAM, 0, 0);
 
-                        break;
-                }
+                    process_tc_get_parameter(&tc);
+
+                    break;
+                case CONFIG_PKT_ID_UPLINK_SET_PARAMS:
+                    SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_PROCESS_TC, SYS_LOG_TOK_TC_SET_PARAMS, 0, 0);
+
+                    process_tc_set_parameters(&tc);
+
+                    break;
+                case CONFIG_PKT_ID_UPLINK_GET_PARAMS:
+                    SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_PROCESS_TC, SYS_LOG_TOK_TC_GET_PARAMS, 0, 0);
+
+                    process_tc_get_parameters(&tc);
+
+                    break;
+                case CONFIG_PKT_ID_UPLINK_GET_BLACK_BOX:
+                    SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_PROCESS_TC, SYS_LOG_TOK_TC_GET_BLACK_BOX, 0, 0);
+
+                    process_tc_get_black_box(&tc);
+
+                    break;
+                default:
+                    SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_PROCESS_TC, SYS_LOG_TOK_TC_UNKNOWN, 0, 0);
+
+                    break;
             }
         }
-
-        vTaskDelayUntil(&last_cycle, pdMS_TO_TICKS(TASK_PROCESS_TC_PERIOD_MS));
     }
 }
 
-void process_tc_ping_request(uint8_t *pkt, uint16_t pkt_len)
+void process_tc_ping_request(const fsat_pkt_view_t *tc)
 {
-    if (pkt_len >= 8U)
-    {
-        fsat_pkt_pl_t pong_pl = {0};
+    uint8_t pong_pl_raw[16] = {0};
+    uint16_t pong_pl_raw_len = 0;
 
-        /* Packet ID */
-        fsat_pkt_add_id(&pong_pl, CONFIG_PKT_ID_DOWNLINK_PING_ANS);
+    fsat_pkt_builder_t pong_pl = {0};
 
-        /* Source callsign */
-        fsat_pkt_add_callsign(&pong_pl, CONFIG_SATELLITE_CALLSIGN);
+    fsat_pkt_builder_init(&pong_pl, pong_pl_raw, sizeof(pong_pl_raw), CONFIG_PKT_ID_DOWNLINK_PING_ANS, CONFIG_SATELLITE_CALLSIGN);
 
-        if (memcpy(&pong_pl.payload[0], &pkt[1], 7) == &pong_pl.payload[0])
-        {
-            pong_pl.length = 7U;
-
-            uint8_t pong_pl_raw[16] = {0};
-            uint16_t pong_pl_raw_len = 0;
+    /* Requester callsign */
+    fsat_pkt_builder_put_callsign(&pong_pl, tc->callsign, tc->callsign_len);
 
-            fsat_pkt_encode(pong_pl, pong_pl_raw, &pong_pl_raw_len);
+    if (fsat_pkt_builder_finish(&pong_pl, &pong_pl_raw_len) == 0)
+    {
+        if (ttc_link_send(pong_pl_raw, pong_pl_raw_len) != 0)
+        {
+            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error transmitting a ping answer!");
+            sys_log_new_line();
+        }
 
-            if (ttc_send(TTC_1, pong_pl_raw, pong_pl_raw_len) != 0)
+#if defined(CONFIG_BEACON_ON_PING_ENABLED) && (CONFIG_BEACON_ON_PING_ENABLED == 1)
+        /* No beacon in hibernation (the same as the beacon task) */
+        if (sat_data_buf.obdh.data.mode != OBDH_MODE_HIBERNATION)
+        {
+            if (beacon_frame_send() != 0)
             {
-                sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error transmitting a ping answer!");
+                sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error transmitting the beacon after a ping answer!");
                 sys_log_new_line();
             }
         }
+#endif /* CONFIG_BEACON_ON_PING_ENABLED */
     }
 }
 
-void process_tc_data_request(uint8_t *pkt, uint16_t pkt_len)
+void process_tc_data_request(const fsat_pkt_view_t *tc)
 {
-    if (pkt_len >= (1U + 7U + 1U + 4U + 4U))
+    if (tc->length >= (1U + 4U + 4U))
     {
-        fsat_pkt_pl_t data_pl = {0};
-
-        /* Packet ID */
-        fsat_pkt_add_id(&data_pl, CONFIG_PKT_ID_DOWNLINK_DATA_REQUEST_ANS);
-
-        /* Source callsign */
-        fsat_pkt_add_callsign(&data_pl, CONFIG_SATELLITE_CALLSIGN);
-
         uint8_t tc_key[16] = CONFIG_TC_KEY_DATA_REQUEST;
 
-        if (process_tc_validate_hmac(pkt, 1U + 7U + 1U + 4U + 4U, &pkt[17], 20U, tc_key, sizeof(CONFIG_TC_KEY_DATA_REQUEST)-1U))
+        if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN + 1U + 4U + 4U, &tc->payload[9], 20U, tc_key, sizeof(CONFIG_TC_KEY_DATA_REQUEST)-1U))
         {
-            switch(pkt[8])
+            switch(tc->payload[0])
             {
                 case CONFIG_DATA_ID_OBDH:
                     sys_log_print_event_from_module(SYS_LOG_WARNING, TASK_PROCESS_TC_NAME, "OBDH data request not implemented!");
@@ -444,49 +512,48 @@ void process_tc_data_request(uint8_t *pkt, uint16_t pkt_len)
     }
 }
 
-void process_tc_broadcast_message(uint8_t *pkt, uint16_t pkt_len)
+void process_tc_broadcast_message(const fsat_pkt_view_t *tc)
 {
-    if (pkt_len >= 15U)
+    if (tc->length >= 7U)
     {
-        fsat_pkt_pl_t broadcast_pl = {0};
+        uint8_t broadcast_pl_raw[55] = {0};
+        uint16_t broadcast_pl_raw_len = 0;
 
-        /* Packet ID */
-        fsat_pkt_add_id(&broadcast_pl, CONFIG_PKT_ID_DOWNLINK_MESSAGE_BROADCAST);
+        fsat_pkt_builder_t broadcast_pl = {0};
 
-        /* Source callsign */
-        fsat_pkt_add_callsign(&broadcast_pl, CONFIG_SATELLITE_CALLSIGN);
+        fsat_pkt_builder_init(&broadcast_pl, broadcast_pl_raw, sizeof(broadcast_pl_raw), CONFIG_PKT_ID_DOWNLINK_MESSAGE_BROADCAST, CONFIG_SATELLITE_CALLSIGN);
 
-        uint16_t msg_len = pkt_len - 7U - 7U - 1U;
+        /* Requester callsign + destination callsign + message */
+        fsat_pkt_builder_put_callsign(&broadcast_pl, tc->callsign, tc->callsign_len);
+        fsat_pkt_builder_put_bytes(&broadcast_pl, tc->payload, tc->length);
 
-        if (memcpy(&broadcast_pl.payload[0], &pkt[1], 14U + msg_len) == &broadcast_pl.payload[0])
+        if (fsat_pkt_builder_finish(&broadcast_pl, &broadcast_pl_raw_len) == 0)
         {
-            broadcast_pl.length = 14U + msg_len;
-
-            uint8_t broadcast_pl_raw[55] = {0};
-            uint16_t broadcast_pl_raw_len = 0;
-
-            fsat_pkt_encode(broadcast_pl, broadcast_pl_raw, &broadcast_pl_raw_len);
-
-            if (ttc_send(TTC_1, broadcast_pl_raw, broadcast_pl_raw_len) != 0)
+            if (ttc_link_send(broadcast_pl_raw, broadcast_pl_raw_len) != 0)
             {
                 sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error transmitting a message broadcast!");
                 sys_log_new_line();
             }
         }
+        else
+        {
+            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error executing the \"Broadcast Message\" TC! Message too long!");
+            sys_log_new_line();
+        }
     }
 }
 
-void process_tc_enter_hibernation(uint8_t *pkt, uint16_t pkt_len)
+void process_tc_enter_hibernation(const fsat_pkt_view_t *tc)
 {
-    if (pkt_len >= 30U)
+    if (tc->length >= 22U)
     {
         uint8_t tc_key[16] = CONFIG_TC_KEY_ENTER_HIBERNATION;
 
-        if (process_tc_validate_hmac(pkt, 1U + 7U + 2U, &pkt[10], 20U, tc_key, sizeof(CONFIG_TC_KEY_ENTER_HIBERNATION)-1U))
+        if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN + 2U, &tc->payload[2], 20U, tc_key, sizeof(CONFIG_TC_KEY_ENTER_HIBERNATION)-1U))
         {
             sat_data_buf.obdh.data.mode = OBDH_MODE_HIBERNATION;
             sat_data_buf.obdh.data.ts_last_mode_change = system_get_time();
-            sat_data_buf.obdh.data.mode_duration = (((sys_time_t)pkt[8] << 8) | (sys_time_t)pkt[9]) * 60UL * 60UL;
+            sat_data_buf.obdh.data.mode_duration = (((sys_time_t)tc->payload[0] << 8) | (sys_time_t)tc->payload[1]) * 60UL * 60UL;
         }
         else
         {
@@ -496,13 +563,13 @@ void process_tc_enter_hibernation(uint8_t *pkt, uint16_t pkt_len)
     }
 }
 
-void process_tc_leave_hibernation(uint8_t *pkt, uint16_t pkt_len)
+void process_tc_leave_hibernation(const fsat_pkt_view_t *tc)
 {
-    if (pkt_len >= 30U)
+    if (tc->length >= 22U)
     {
         uint8_t tc_key[16] = CONFIG_TC_KEY_LEAVE_HIBERNATION;
 
-        if (process_tc_validate_hmac(pkt, 1U + 7U, &pkt[8], 20U, tc_key, sizeof(CONFIG_TC_KEY_LEAVE_HIBERNATION)-1U))
+        if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN, &tc->payload[0], 20U, tc_key, sizeof(CONFIG_TC_KEY_LEAVE_HIBERNATION)-1U))
         {
             sat_data_buf.obdh.data.mode = OBDH_MODE_NORMAL;
             sat_data_buf.obdh.data.ts_last_mode_change = system_get_time();
@@ -515,11 +582,11 @@ void process_tc_leave_hibernation(uint8_t *pkt, uint16_t pkt_len)
     }
 }
 
-void process_tc_activate_module(uint8_t *pkt, uint16_t pkt_len)
+void process_tc_activate_module(const fsat_pkt_view_t *tc)
 {
-    if (pkt_len >= 29U)
+    if (tc->length >= 21U)
     {
-        switch(pkt[8])
+        switch(tc->payload[0])
         {
             case CONFIG_MODULE_ID_BATTERY_HEATER:
             {
@@ -528,7 +595,7 @@ void process_tc_activate_module(uint8_t *pkt, uint16_t pkt_len)
 
                 uint8_t tc_key[16] = CONFIG_TC_KEY_ACTIVATE_MODULE;
 
-                if (process_tc_validate_hmac(pkt, 1U + 7U + 1U, &pkt[9], 20U, tc_key, sizeof(CONFIG_TC_KEY_ACTIVATE_MODULE)-1U))
+                if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN + 1U, &tc->payload[1], 20U, tc_key, sizeof(CONFIG_TC_KEY_ACTIVATE_MODULE)-1U))
                 {
                     /* Enable the EPS heater */
                     sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "TC not implemented yet");
@@ -549,7 +616,7 @@ void process_tc_activate_module(uint8_t *pkt, uint16_t pkt_len)
 
                 uint8_t tc_key[16] = CONFIG_TC_KEY_ACTIVATE_MODULE;
 
-                if (process_tc_validate_hmac(pkt, 1U + 7U + 1U, &pkt[9], 20U, tc_key, sizeof(CONFIG_TC_KEY_ACTIVATE_MODULE)-1U))
+                if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN + 1U, &tc->payload[1], 20U, tc_key, sizeof(CONFIG_TC_KEY_ACTIVATE_MODULE)-1U))
                 {
                     /* Enable the beacon */
                     sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "TC not implemented yet");
@@ -570,7 +637,7 @@ void process_tc_activate_module(uint8_t *pkt, uint16_t pkt_len)
 
                 uint8_t tc_key[16] = CONFIG_TC_KEY_ACTIVATE_MODULE;
 
-                if (process_tc_validate_hmac(pkt, 1U + 7U + 1U, &pkt[9], 20U, tc_key, sizeof(CONFIG_TC_KEY_ACTIVATE_MODULE)-1U))
+                if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN + 1U, &tc->payload[1], 20U, tc_key, sizeof(CONFIG_TC_KEY_ACTIVATE_MODULE)-1U))
                 {
                     /* Enable the periodic telemetry */
                     sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "TC not implemented yet");
@@ -593,11 +660,11 @@ void process_tc_activate_module(uint8_t *pkt, uint16_t pkt_len)
     }
 }
 
-void process_tc_deactivate_module(uint8_t *pkt, uint16_t pkt_len)
+void process_tc_deactivate_module(const fsat_pkt_view_t *tc)
 {
-    if (pkt_len >= 29U)
+    if (tc->length >= 21U)
     {
-        switch(pkt[8])
+        switch(tc->payload[0])
         {
             case CONFIG_MODULE_ID_BATTERY_HEATER:
             {
@@ -606,7 +673,7 @@ void process_tc_deactivate_module(uint8_t *pkt, uint16_t pkt_len)
 
                 uint8_t tc_key[16] = CONFIG_TC_KEY_DEACTIVATE_MODULE;
 
-                if (process_tc_validate_hmac(pkt, 1U + 7U + 1U, &pkt[9], 20U, tc_key, sizeof(CONFIG_TC_KEY_DEACTIVATE_MODULE)-1U))
+                if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN + 1U, &tc->payload[1], 20U, tc_key, sizeof(CONFIG_TC_KEY_DEACTIVATE_MODULE)-1U))
                 {
                     /* Enable the EPS heater */
                     sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "TC not implemented yet");
@@ -627,7 +694,7 @@ void process_tc_deactivate_module(uint8_t *pkt, uint16_t pkt_len)
 
                 uint8_t tc_key[16] = CONFIG_TC_KEY_DEACTIVATE_MODULE;
 
-                if (process_tc_validate_hmac(pkt, 1U + 7U + 1U, &pkt[9], 20U, tc_key, sizeof(CONFIG_TC_KEY_DEACTIVATE_MODULE)-1U))
+                if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN + 1U, &tc->payload[1], 20U, tc_key, sizeof(CONFIG_TC_KEY_DEACTIVATE_MODULE)-1U))
                 {
                     /* Enable the beacon */
                     sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "TC not implemented yet");
@@ -648,7 +715,7 @@ void process_tc_deactivate_module(uint8_t *pkt, uint16_t pkt_len)
 
                 uint8_t tc_key[16] = CONFIG_TC_KEY_DEACTIVATE_MODULE;
 
-                if (process_tc_validate_hmac(pkt, 1U + 7U + 1U, &pkt[9], 20U, tc_key, sizeof(CONFIG_TC_KEY_DEACTIVATE_MODULE)-1U))
+                if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN + 1U, &tc->payload[1], 20U, tc_key, sizeof(CONFIG_TC_KEY_DEACTIVATE_MODULE)-1U))
                 {
                     /* Enable the periodic telemetry */
                     sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "TC not implemented yet");
@@ -671,11 +738,11 @@ void process_tc_deactivate_module(uint8_t *pkt, uint16_t pkt_len)
     }
 }
 
-void process_tc_activate_payload(uint8_t *pkt, uint16_t pkt_len)
+void process_tc_activate_payload(const fsat_pkt_view_t *tc)
 {
-    if (pkt_len >= 29U)
+    if (tc->length >= 21U)
     {
-        switch(pkt[8])
+        switch(tc->payload[0])
         {
             case CONFIG_PL_ID_EDC_1:
             {
@@ -684,7 +751,7 @@ void process_tc_activate_payload(uint8_t *pkt, uint16_t pkt_len)
 
                 uint8_t tc_key[16] = CONFIG_TC_KEY_ACTIVATE_PAYLOAD_EDC;
 
-                if (process_tc_validate_hmac(pkt, 1U + 7U + 1U, &pkt[9], 20U, tc_key, sizeof(CONFIG_TC_KEY_ACTIVATE_PAYLOAD_EDC)-1U))
+                if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN + 1U, &tc->payload[1], 20U, tc_key, sizeof(CONFIG_TC_KEY_ACTIVATE_PAYLOAD_EDC)-1U))
                 {
                     if (payload_enable(PAYLOAD_EDC_0) != 0)
                     {
@@ -707,7 +774,7 @@ void process_tc_activate_payload(uint8_t *pkt, uint16_t pkt_len)
 
                 uint8_t tc_key[16] = CONFIG_TC_KEY_ACTIVATE_PAYLOAD_EDC;
 
-                if (process_tc_validate_hmac(pkt, 1U + 7U + 1U, &pkt[9], 20U, tc_key, sizeof(CONFIG_TC_KEY_ACTIVATE_PAYLOAD_EDC)-1U))
+                if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN + 1U, &tc->payload[1], 20U, tc_key, sizeof(CONFIG_TC_KEY_ACTIVATE_PAYLOAD_EDC)-1U))
                 {
                     if (payload_enable(PAYLOAD_EDC_1) != 0)
                     {
@@ -730,7 +797,7 @@ void process_tc_activate_payload(uint8_t *pkt, uint16_t pkt_len)
 
                 uint8_t tc_key[16] = CONFIG_TC_KEY_ACTIVATE_PAYLOAD_PAYLOAD_X;
 
-                if (process_tc_validate_hmac(pkt, 1U + 7U + 1U, &pkt[9], 20U, tc_key, sizeof(CONFIG_TC_KEY_ACTIVATE_PAYLOAD_PAYLOAD_X)-1U))
+                if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN + 1U, &tc->payload[1], 20U, tc_key, sizeof(CONFIG_TC_KEY_ACTIVATE_PAYLOAD_PAYLOAD_X)-1U))
                 {
                     if (payload_enable(PAYLOAD_X) != 0)
                     {
@@ -753,7 +820,7 @@ void process_tc_activate_payload(uint8_t *pkt, uint16_t pkt_len)
 
                 uint8_t tc_key[16] = CONFIG_TC_KEY_ACTIVATE_PAYLOAD_HARSH;
 
-                if (process_tc_validate_hmac(pkt, 1U + 7U + 1U, &pkt[9], 20U, tc_key, sizeof(CONFIG_TC_KEY_ACTIVATE_PAYLOAD_HARSH)-1U))
+                if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN + 1U, &tc->payload[1], 20U, tc_key, sizeof(CONFIG_TC_KEY_ACTIVATE_PAYLOAD_HARSH)-1U))
                 {
                     if (payload_enable(PAYLOAD_HARSH) != 0)
                     {
@@ -778,11 +845,11 @@ void process_tc_activate_payload(uint8_t *pkt, uint16_t pkt_len)
     }
 }
 
-void process_tc_deactivate_payload(uint8_t *pkt, uint16_t pkt_len)
+void process_tc_deactivate_payload(const fsat_pkt_view_t *tc)
 {
-    if (pkt_len >= 29U)
+    if (tc->length >= 21U)
     {
-        switch(pkt[8])
+        switch(tc->payload[0])
         {
             case CONFIG_PL_ID_EDC_1:
             {
@@ -791,7 +858,7 @@ void process_tc_deactivate_payload(uint8_t *pkt, uint16_t pkt_len)
 
                 uint8_t tc_key[16] = CONFIG_TC_KEY_DEACTIVATE_PAYLOAD_EDC;
 
-                if (process_tc_validate_hmac(pkt, 1U + 7U + 1U, &pkt[9], 20U, tc_key, sizeof(CONFIG_TC_KEY_DEACTIVATE_PAYLOAD_EDC)-1U))
+                if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN + 1U, &tc->payload[1], 20U, tc_key, sizeof(CONFIG_TC_KEY_DEACTIVATE_PAYLOAD_EDC)-1U))
                 {
                     if (payload_disable(PAYLOAD_EDC_0) != 0)
                     {
@@ -814,7 +881,7 @@ void process_tc_deactivate_payload(uint8_t *pkt, uint16_t pkt_len)
 
                 uint8_t tc_key[16] = CONFIG_TC_KEY_DEACTIVATE_PAYLOAD_EDC;
 
-                if (process_tc_validate_hmac(pkt, 1U + 7U + 1U, &pkt[9], 20U, tc_key, sizeof(CONFIG_TC_KEY_DEACTIVATE_PAYLOAD_EDC)-1U))
+                if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN + 1U, &tc->payload[1], 20U, tc_key, sizeof(CONFIG_TC_KEY_DEACTIVATE_PAYLOAD_EDC)-1U))
                 {
                     if (payload_disable(PAYLOAD_EDC_1) != 0)
                     {
@@ -837,7 +904,7 @@ void process_tc_deactivate_payload(uint8_t *pkt, uint16_t pkt_len)
 
                 uint8_t tc_key[16] = CONFIG_TC_KEY_DEACTIVATE_PAYLOAD_PAYLOAD_X;
 
-                if (process_tc_validate_hmac(pkt, 1U + 7U + 1U, &pkt[9], 20U, tc_key, sizeof(CONFIG_TC_KEY_DEACTIVATE_PAYLOAD_PAYLOAD_X)-1U))
+                if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN + 1U, &tc->payload[1], 20U, tc_key, sizeof(CONFIG_TC_KEY_DEACTIVATE_PAYLOAD_PAYLOAD_X)-1U))
                 {
                     if (payload_disable(PAYLOAD_X) != 0)
                     {
@@ -860,7 +927,7 @@ void process_tc_deactivate_payload(uint8_t *pkt, uint16_t pkt_len)
 
                 uint8_t tc_key[16] = CONFIG_TC_KEY_DEACTIVATE_PAYLOAD_HARSH;
 
-                if (process_tc_validate_hmac(pkt, 1U + 7U + 1U, &pkt[9], 20U, tc_key, sizeof(CONFIG_TC_KEY_DEACTIVATE_PAYLOAD_HARSH)-1U))
+                if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN + 1U, &tc->payload[1], 20U, tc_key, sizeof(CONFIG_TC_KEY_DEACTIVATE_PAYLOAD_HARSH)-1U))
                 {
                     if (payload_disable(PAYLOAD_HARSH) != 0)
                     {
@@ -885,19 +952,26 @@ void process_tc_deactivate_payload(uint8_t *pkt, uint16_t pkt_len)
     }
 }
 
-void process_tc_erase_memory(uint8_t *pkt, uint16_t pkt_len)
+void process_tc_erase_memory(const fsat_pkt_view_t *tc)
 {
-    if (pkt_len >= 28U)
+    if (tc->length >= 20U)
     {
         uint8_t tc_key[16] = CONFIG_TC_KEY_ERASE_MEMORY;
 
-        if (process_tc_validate_hmac(pkt, 1U + 7U, &pkt[8], 20U, tc_key, sizeof(CONFIG_TC_KEY_ERASE_MEMORY)-1U))
+        if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN, &tc->payload[0], 20U, tc_key, sizeof(CONFIG_TC_KEY_ERASE_MEMORY)-1U))
         {
             if (media_erase(MEDIA_NOR, MEDIA_ERASE_DIE, 0U) != 0)
             {
                 sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error erasing the NOR memory!");
                 sys_log_new_line();
             }
+
+            /* The stored payload data is gone (or partially erased): the ring starts empty */
+            if (payload_data_clear() != 0)
+            {
+                sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error resetting the payload data index!");
+                sys_log_new_line();
+            }
         }
         else
         {
@@ -907,14 +981,19 @@ void process_tc_erase_memory(uint8_t *pkt, uint16_t pkt_len)
     }
 }
 
-void process_tc_force_reset(uint8_t *pkt, uint16_t pkt_len)
+void process_tc_force_reset(const fsat_pkt_view_t *tc)
 {
-    if (pkt_len >= 28U)
+    if (tc->length >= 20U)
     {
         uint8_t tc_key[16] = CONFIG_TC_KEY_FORCE_RESET;
 
-        if (process_tc_validate_hmac(pkt, 1U + 7U, &pkt[8], 20U, tc_key, sizeof(CONFIG_TC_KEY_FORCE_RESET)-1U))
+        if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN, &tc->payload[0], 20U, tc_key, sizeof(CONFIG_TC_KEY_FORCE_RESET)-1U))
         {
+            sys_log_print_event_from_module(SYS_LOG_INFO, TASK_PROCESS_TC_NAME, "Executing the \"Force Reset\" TC...");
+            sys_log_new_line();
+
+            sys_log_flush();
+
             system_reset();
         }
         else
@@ -925,69 +1004,176 @@ void process_tc_force_reset(uint8_t *pkt, uint16_t pkt_len)
     }
 }
 
-//void process_tc_get_payload_data(uint8_t *pkt, uint16_t pkt_len)
-//{
-//}
+void process_tc_get_payload_data(const fsat_pkt_view_t *tc)
+{
+    /* ID + callsign + payload ID + start time + end time + HMAC */
+    if (tc->length >= (1U + 4U + 4U + 20U))
+    {
+        uint8_t tc_key[16] = CONFIG_TC_KEY_GET_PAYLOAD_DATA;
 
-void process_tc_set_parameter(uint8_t *pkt, uint16_t pkt_len)
+        if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN + 1U + 4U + 4U, &tc->payload[9], 20U, tc_key, sizeof(CONFIG_TC_KEY_GET_PAYLOAD_DATA)-1U))
+        {
+            sys_time_t start = ((sys_time_t)tc->payload[1] << 24) |
+                               ((sys_time_t)tc->payload[2] << 16) |
+                               ((sys_time_t)tc->payload[3] << 8) |
+                               (sys_time_t)tc->payload[4];
+
+            sys_time_t end = ((sys_time_t)tc->payload[5] << 24) |
+                             ((sys_time_t)tc->payload[6] << 16) |
+                             ((sys_time_t)tc->payload[7] << 8) |
+                             (sys_time_t)tc->payload[8];
+
+            payload_data_cursor_t cur = {0};
+
+            if (payload_data_seek(start, end, &cur) == 0)
+            {
+                process_tc_send_payload_data(tc, tc->payload[0], &cur);
+            }
+            else
+            {
+                sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error searching the stored payload data!");
+                sys_log_new_line();
+            }
+        }
+        else
+        {
+            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error executing the \"Get Payload Data\" TC! Invalid key!");
+            sys_log_new_line();
+        }
+    }
+}
+
+void process_tc_send_payload_data(const fsat_pkt_view_t *tc, uint8_t pl_id, payload_data_cursor_t *cur)
 {
-    if (pkt_len >= (1U + 7U + 1U + 1U + 4U + 20U))
+    /* Static to keep the frame and the record out of the task stack */
+    static uint8_t pl_data_raw[FSAT_PKT_MAX_LEN];
+    static payload_data_record_t rec;
+
+    bool pending = false;       /* A record was read but not packed yet */
+    bool done = false;
+    uint16_t frames = 0U;
+
+    while(!done && (frames < CONFIG_PAYLOAD_DATA_MAX_FRAMES_PER_TC))
     {
-        uint8_t tc_key[16] = CONFIG_TC_KEY_SET_PARAMETER;
+        fsat_pkt_builder_t pl_data = {0};
+
+        fsat_pkt_builder_init(&pl_data, pl_data_raw, sizeof(pl_data_raw), CONFIG_PKT_ID_DOWNLINK_PAYLOAD_DATA, CONFIG_SATELLITE_CALLSIGN);
+
+        /* Requester callsign */
+        fsat_pkt_builder_put_callsign(&pl_data, tc->callsign, tc->callsign_len);
+
+        /* Sequence number (written by the link layer) */
+        uint16_t seq_pos = pl_data.len;
 
-        if (process_tc_validate_hmac(pkt, 1U + 7U + 1U + 1U + 4U, &pkt[14], 20U, tc_key, sizeof(CONFIG_TC_KEY_SET_PARAMETER)-1U))
+        fsat_pkt_builder_put_u16(&pl_data, 0U);
+
+        uint16_t records = 0U;
+        bool full = false;
+
+        while(!done && !full)
         {
-            uint32_t buf = ((uint32_t)pkt[10] << 24) |
-                           ((uint32_t)pkt[11] << 16) |
-                           ((uint32_t)pkt[12] << 8) |
-                           (uint32_t)pkt[13];
+            if (!pending)
+            {
+                if (payload_data_next(cur, &rec) != 0)
+                {
+                    done = true;
+                }
+                else
+                {
+                    pending = (rec.pl_id == pl_id);
+                }
+            }
 
-            switch(pkt[8])
+            if (pending)
             {
-                case CONFIG_SUBSYSTEM_ID_OBDH:
-                    switch(pkt[9])
-                    {
-                        case OBDH_PARAM_ID_TIME_COUNTER:        system_set_time(buf);                               break;
-                        case OBDH_PARAM_ID_MODE:                sat_data_buf.obdh.data.mode = (uint8_t)buf;         break;
-                        case OBDH_PARAM_ID_TIMESTAMP_LAST_MODE: sat_data_buf.obdh.data.ts_last_mode_change = buf;   break;
-                        case OBDH_PARAM_ID_MODE_DURATION:       sat_data_buf.obdh.data.mode_duration = buf;         break;
-                        default:
-                            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Invalid parameter to set in OBDH!");
-                            sys_log_new_line();
-
-                            break;
-                    }
+                if ((pl_data.len + PAYLOAD_DATA_FRAME_RECORD_HEADER_LEN + rec.length) <= sizeof(pl_data_raw))
+                {
+                    fsat_pkt_builder_put_u8(&pl_data, rec.type);
+                    fsat_pkt_builder_put_u32(&pl_data, rec.time_tag);
+                    fsat_pkt_builder_put_u8(&pl_data, rec.length);
+                    fsat_pkt_builder_put_bytes(&pl_data, rec.data, rec.length);
 
-                    break;
-                case CONFIG_SUBSYSTEM_ID_TTC_1:
-                    if (ttc_set_param(TTC_0, pkt[9], buf) != 0)
-                    {
-                        sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error writing a TTC 0 parameter!");
-                        sys_log_new_line();
-                    }
+                    records++;
+                    pending = false;
+                }
+                else
+                {
+                    full = true;
+                }
+            }
+        }
 
-                    break;
-                case CONFIG_SUBSYSTEM_ID_TTC_2:
-                    if (ttc_set_param(TTC_1, pkt[9], buf) != 0)
-                    {
-                        sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error writing a TTC 1 parameter!");
-                        sys_log_new_line();
-                    }
+        if (records > 0U)
+        {
+            uint16_t pl_data_raw_len = 0;
 
-                    break;
-                case CONFIG_SUBSYSTEM_ID_EPS:
-                    if (eps_set_param(pkt[9], buf) != 0)
+            if (fsat_pkt_builder_finish(&pl_data, &pl_data_raw_len) == 0)
+            {
+                int err = -1;
+
+                uint8_t i = 0U;
+                for(i = 0U; (i < CONFIG_PAYLOAD_DATA_TX_RETRIES) && (err != 0); i++)
+                {
+                    err = ttc_link_send_bulk(pl_data_raw, pl_data_raw_len, seq_pos);
+
+                    if (err != 0)
                     {
-                        sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error writing a EPS parameter!");
-                        sys_log_new_line();
+                        /* Wait for the radios to release their TX FIFOs */
+                        vTaskDelay(pdMS_TO_TICKS(CONFIG_PAYLOAD_DATA_TX_RETRY_DELAY_MS));
                     }
+                }
 
-                    break;
-                default:
-                    sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Invalid subsystem to set a parameter!");
+                if (err != 0)
+                {
+                    sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error transmitting a \"payload data\" frame!");
                     sys_log_new_line();
 
-                    break;
+                    done = true;
+                }
+            }
+
+            frames++;
+        }
+        else if (pending)
+        {
+            /* The record does not fit in an empty frame (not expected: the stored records are limited to PAYLOAD_DATA_MAX_LEN) */
+            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error transmitting a payload data record! The record is too long!");
+            sys_log_new_line();
+
+            pending = false;
+        }
+    }
+
+    if (SYS_LOG_ENABLED(SYS_LOG_INFO, SYS_LOG_MODULE_PROCESS_TC))
+    {
+        sys_log_print_event_from_module(SYS_LOG_INFO, TASK_PROCESS_TC_NAME, "");
+        sys_log_print_uint(frames);
+        sys_log_print_msg(" payload data frame(s) transmitted");
+        sys_log_new_line();
+    }
+}
+
+void process_tc_set_parameter(const fsat_pkt_view_t *tc)
+{
+    if (tc->length >= (1U + 1U + 4U + 20U))
+    {
+        uint8_t tc_key[16] = CONFIG_TC_KEY_SET_PARAMETER;
+
+        if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN + 1U + 1U + 4U, &tc->payload[6], 20U, tc_key, sizeof(CONFIG_TC_KEY_SET_PARAMETER)-1U))
+        {
+            uint32_t buf = ((uint32_t)tc->payload[2] << 24) |
+                           ((uint32_t)tc->payload[3] << 16) |
+                           ((uint32_t)tc->payload[4] << 8) |
+                           (uint32_t)tc->payload[5];
+
+            if (param_set(tc->payload[0], tc->payload[1], buf) != 0)
+            {
+                sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error writing the parameter ");
+                sys_log_print_uint(tc->payload[1]);
+                sys_log_print_msg(" of the subsystem ");
+                sys_log_print_uint(tc->payload[0]);
+                sys_log_print_msg("!");
+                sys_log_new_line();
             }
         }
         else
@@ -998,130 +1184,323 @@ void process_tc_set_parameter(uint8_t *pkt, uint16_t pkt_len)
     }
 }
 
-void process_tc_get_parameter(uint8_t *pkt, uint16_t pkt_len)
+void process_tc_get_parameter(const fsat_pkt_view_t *tc)
 {
-    if (pkt_len >= (1U + 7U + 1U + 1U + 20U))
+    if (tc->length >= (1U + 1U + 20U))
     {
         uint8_t tc_key[16] = CONFIG_TC_KEY_GET_PARAMETER;
 
-        if (process_tc_validate_hmac(pkt, 1U + 7U + 1U + 1U, &pkt[10], 20U, tc_key, sizeof(CONFIG_TC_KEY_GET_PARAMETER)-1U))
+        if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN + 1U + 1U, &tc->payload[2], 20U, tc_key, sizeof(CONFIG_TC_KEY_GET_PARAMETER)-1U))
         {
-            int error = 0;
-
             uint32_t buf = UINT32_MAX;
 
-            switch(pkt[8])
+            if (param_get(tc->payload[0], tc->payload[1], &buf) == 0)
             {
-                case CONFIG_SUBSYSTEM_ID_OBDH:
-                    switch(pkt[9])
-                    {
-                        case OBDH_PARAM_ID_TIME_COUNTER:        buf = system_get_time();                                break;
-                        case OBDH_PARAM_ID_TEMPERATURE_UC:      buf = sat_data_buf.obdh.data.temperature;               break;
-                        case OBDH_PARAM_ID_INPUT_CURRENT:       buf = sat_data_buf.obdh.data.current;                   break;
-                        case OBDH_PARAM_ID_INPUT_VOLTAGE:       buf = sat_data_buf.obdh.data.voltage;                   break;
-                        case OBDH_PARAM_ID_LAST_RESET_CAUSE:    buf = sat_data_buf.obdh.data.last_reset_cause;          break;
-                        case OBDH_PARAM_ID_RESET_COUNTER:       buf = sat_data_buf.obdh.data.reset_counter;             break;
-                        case OBDH_PARAM_ID_LAST_VALID_TC:       buf = sat_data_buf.obdh.data.last_valid_tc;             break;
-                        case OBDH_PARAM_ID_TEMPERATURE_RADIO:   buf = sat_data_buf.obdh.data.radio.temperature;         break;
-                        case OBDH_PARAM_ID_RSSI_LAST_TC:        buf = sat_data_buf.obdh.data.radio.last_valid_tc_rssi;  break;
-                        case OBDH_PARAM_ID_TEMPERATURE_ANTENNA: buf = sat_data_buf.antenna.data.temperature;            break;
-                        case OBDH_PARAM_ID_ANTENNA_STATUS:      buf = sat_data_buf.antenna.data.status.code;            break;
-                        case OBDH_PARAM_ID_HARDWARE_VERSION:    buf = sat_data_buf.obdh.data.hw_version;                break;
-                        case OBDH_PARAM_ID_FIRMWARE_VERSION:    buf = sat_data_buf.obdh.data.fw_version;                break;
-                        case OBDH_PARAM_ID_MODE:                buf = sat_data_buf.obdh.data.mode;                      break;
-                        case OBDH_PARAM_ID_TIMESTAMP_LAST_MODE: buf = sat_data_buf.obdh.data.ts_last_mode_change;       break;
-                        case OBDH_PARAM_ID_MODE_DURATION:       buf = sat_data_buf.obdh.data.mode_duration;             break;
-                        default:
-                            error = -1;
-
-                            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Invalid parameter to get from OBDH!");
-                            sys_log_new_line();
-
-                            break;
-                    }
+                uint8_t param_pl_raw[1U + 7U + 7U + 1U + 1U + 4U] = {0};
+                uint16_t param_pl_raw_len = 0;
 
-                    break;
-                case CONFIG_SUBSYSTEM_ID_TTC_1:
-                    if (ttc_get_param(TTC_0, pkt[9], &buf) != 0)
-                    {
-                        error = -1;
+                fsat_pkt_builder_t param_pl = {0};
 
-                        sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error reading a parameter from TTC 0!");
-                        sys_log_new_line();
-                    }
+                fsat_pkt_builder_init(&param_pl, param_pl_raw, sizeof(param_pl_raw), CONFIG_PKT_ID_DOWNLINK_PARAM_VALUE, CONFIG_SATELLITE_CALLSIGN);
 
-                    break;
-                case CONFIG_SUBSYSTEM_ID_TTC_2:
-                    if (ttc_get_param(TTC_1, pkt[9], &buf) != 0)
-                    {
-                        error = -1;
+                /* Requester callsign */
+                fsat_pkt_builder_put_callsign(&param_pl, tc->callsign, tc->callsign_len);
+
+                /* Subsystem ID, parameter ID and value */
+                fsat_pkt_builder_put_u8(&param_pl, tc->payload[0]);
+                fsat_pkt_builder_put_u8(&param_pl, tc->payload[1]);
+                fsat_pkt_builder_put_u32(&param_pl, buf);
 
-                        sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error reading a parameter from TTC 1!");
+                if (fsat_pkt_builder_finish(&param_pl, &param_pl_raw_len) == 0)
+                {
+                    if (ttc_link_send(param_pl_raw, param_pl_raw_len) != 0)
+                    {
+                        sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error transmitting a \"get parameter\" answer!");
                         sys_log_new_line();
                     }
+                }
+            }
+            else
+            {
+                sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error reading the parameter ");
+                sys_log_print_uint(tc->payload[1]);
+                sys_log_print_msg(" of the subsystem ");
+                sys_log_print_uint(tc->payload[0]);
+                sys_log_print_msg("!");
+                sys_log_new_line();
+            }
+        }
+        else
+        {
+            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error executing the \"Get Parameter\" TC! Invalid key!");
+            sys_log_new_line();
+        }
+    }
+}
 
-                    break;
-                case CONFIG_SUBSYSTEM_ID_EPS:
-                    if (eps_get_param(pkt[9], &buf) != 0)
-                    {
-                        error = -1;
+void process_tc_set_parameters(const fsat_pkt_view_t *tc)
+{
+    /* ID + callsign + number of parameters + N x (subsystem + parameter + value) + HMAC */
+    if (tc->length >= (1U + 20U))
+    {
+        uint8_t n = tc->payload[0];
+        uint16_t msg_len = 1U + (6U * (uint16_t)n);
+
+        if ((n == 0U) || (n > CONFIG_PARAMS_BATCH_MAX) || (tc->length < (msg_len + 20U)))
+        {
+            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error executing the \"Set Parameters\" TC! Invalid number of parameters!");
+            sys_log_new_line();
+        }
+        else
+        {
+            uint8_t tc_key[16] = CONFIG_TC_KEY_SET_PARAMETER;
+
+            if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN + msg_len, &tc->payload[msg_len], 20U, tc_key, sizeof(CONFIG_TC_KEY_SET_PARAMETER)-1U))
+            {
+                const uint8_t *item = &tc->payload[1];
+
+                uint8_t i = 0U;
+                for(i = 0U; i < n; i++)
+                {
+                    uint32_t buf = ((uint32_t)item[2] << 24) |
+                                   ((uint32_t)item[3] << 16) |
+                                   ((uint32_t)item[4] << 8) |
+                                   (uint32_t)item[5];
 
-                        sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error reading a EPS parameter!");
+                    if (param_set(item[0], item[1], buf) != 0)
+                    {
+                        sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error writing the parameter ");
+                        sys_log_print_uint(item[1]);
+                        sys_log_print_msg(" of the subsystem ");
+                        sys_log_print_uint(item[0]);
+                        sys_log_print_msg("!");
                         sys_log_new_line();
                     }
 
-                    break;
-                default:
-                    error = -1;
-
-                    sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Invalid subsystem to get a parameter!");
-                    sys_log_new_line();
+                    item += 6U;
+                }
 
-                    break;
+                /* Read back the written parameters */
+                process_tc_send_parameters(tc, &tc->payload[1], 6U, n);
+            }
+            else
+            {
+                sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error executing the \"Set Parameters\" TC! Invalid key!");
+                sys_log_new_line();
             }
+        }
+    }
+}
+
+void process_tc_get_parameters(const fsat_pkt_view_t *tc)
+{
+    /* ID + callsign + number of parameters + N x (subsystem + parameter) + HMAC */
+    if (tc->length >= (1U + 20U))
+    {
+        uint8_t n = tc->payload[0];
+        uint16_t msg_len = 1U + (2U * (uint16_t)n);
 
-            if (error == 0)
+        if ((n == 0U) || (n > CONFIG_PARAMS_BATCH_MAX) || (tc->length < (msg_len + 20U)))
+        {
+            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error executing the \"Get Parameters\" TC! Invalid number of parameters!");
+            sys_log_new_line();
+        }
+        else
+        {
+            uint8_t tc_key[16] = CONFIG_TC_KEY_GET_PARAMETER;
+
+            if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN + msg_len, &tc->payload[msg_len], 20U, tc_key, sizeof(CONFIG_TC_KEY_GET_PARAMETER)-1U))
             {
-                fsat_pkt_pl_t param_pl = {0};
+                process_tc_send_parameters(tc, &tc->payload[1], 2U, n);
+            }
+            else
+            {
+                sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error executing the \"Get Parameters\" TC! Invalid key!");
+                sys_log_new_line();
+            }
+        }
+    }
+}
 
-                /* Packet ID */
-                fsat_pkt_add_id(&param_pl, CONFIG_PKT_ID_DOWNLINK_PARAM_VALUE);
+void process_tc_send_parameters(const fsat_pkt_view_t *tc, const uint8_t *ids, uint8_t stride, uint8_t n)
+{
+    /* Static to keep the (large) answer out of the task stack */
+    static uint8_t param_pl_raw[1U + 7U + 7U + 1U + (6U * CONFIG_PARAMS_BATCH_MAX)];
+    uint16_t param_pl_raw_len = 0;
 
-                /* Source callsign */
-                fsat_pkt_add_callsign(&param_pl, CONFIG_SATELLITE_CALLSIGN);
+    fsat_pkt_builder_t param_pl = {0};
 
-                if (memcpy(&param_pl.payload[0], &pkt[1], 7) == &param_pl.payload[0])
-                {
-                    param_pl.payload[8] = pkt[8];
-                    param_pl.payload[9] = pkt[9];
-                    param_pl.payload[10] = (uint8_t)((buf >> 24) & 0xFFU);
-                    param_pl.payload[11] = (uint8_t)((buf >> 16) & 0xFFU);
-                    param_pl.payload[12] = (uint8_t)((buf >> 8) & 0xFFU);
-                    param_pl.payload[13] = (uint8_t)(buf & 0xFFU);
+    fsat_pkt_builder_init(&param_pl, param_pl_raw, sizeof(param_pl_raw), CONFIG_PKT_ID_DOWNLINK_PARAM_VALUES, CONFIG_SATELLITE_CALLSIGN);
 
-                    param_pl.length = 6U;
+    /* Requester callsign */
+    fsat_pkt_builder_put_callsign(&param_pl, tc->callsign, tc->callsign_len);
 
-                    uint8_t param_pl_raw[16] = {0};
-                    uint16_t param_pl_raw_len = 0;
+    /* Number of parameters (updated after reading all of them) */
+    uint16_t count_pos = param_pl.len;
+    uint8_t count = 0U;
 
-                    fsat_pkt_encode(param_pl, param_pl_raw, &param_pl_raw_len);
+    fsat_pkt_builder_put_u8(&param_pl, 0U);
 
-                    if (ttc_send(TTC_1, param_pl_raw, param_pl_raw_len) != 0)
-                    {
-                        sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error transmitting a \"get parameter\" answer!");
-                    }
-                }
-            }
+    uint8_t i = 0U;
+    for(i = 0U; i < n; i++)
+    {
+        uint32_t buf = UINT32_MAX;
+
+        if (param_get(ids[0], ids[1], &buf) == 0)
+        {
+            fsat_pkt_builder_put_u8(&param_pl, ids[0]);
+            fsat_pkt_builder_put_u8(&param_pl, ids[1]);
+            fsat_pkt_builder_put_u32(&param_pl, buf);
+
+            count++;
         }
         else
         {
-            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error executing the \"Get Parameter\" TC! Invalid key!");
+            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error reading the parameter ");
+            sys_log_print_uint(ids[1]);
+            sys_log_print_msg(" of the subsystem ");
+            sys_log_print_uint(ids[0]);
+            sys_log_print_msg("!");
+            sys_log_new_line();
+        }
+
+        ids += stride;
+    }
+
+    param_pl_raw[count_pos] = count;
+
+    if (fsat_pkt_builder_finish(&param_pl, &param_pl_raw_len) == 0)
+    {
+        if (ttc_link_send(param_pl_raw, param_pl_raw_len) != 0)
+        {
+            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error transmitting a \"get parameters\" answer!");
+            sys_log_new_line();
+        }
+    }
+}
+
+void process_tc_get_black_box(const fsat_pkt_view_t *tc)
+{
+    /* ID + callsign + first record + number of records + HMAC */
+    if (tc->length >= (4U + 2U + 20U))
+    {
+        uint8_t tc_key[16] = CONFIG_TC_KEY_GET_BLACK_BOX;
+
+        if (process_tc_validate_hmac(tc->raw, FSAT_PKT_HEADER_LEN + 4U + 2U, &tc->payload[6], 20U, tc_key, sizeof(CONFIG_TC_KEY_GET_BLACK_BOX)-1U))
+        {
+            uint32_t seq = ((uint32_t)tc->payload[0] << 24) |
+                           ((uint32_t)tc->payload[1] << 16) |
+                           ((uint32_t)tc->payload[2] << 8) |
+                           (uint32_t)tc->payload[3];
+
+            uint16_t n = ((uint16_t)tc->payload[4] << 8) | (uint16_t)tc->payload[5];
+
+            process_tc_send_black_box(tc, seq, n);
+        }
+        else
+        {
+            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error executing the \"Get Black Box\" TC! Invalid key!");
             sys_log_new_line();
         }
     }
 }
 
-bool process_tc_validate_hmac(uint8_t *msg, uint16_t msg_len, uint8_t *msg_hash, uint16_t msg_hash_len, uint8_t *key, uint16_t key_len)
+void process_tc_send_black_box(const fsat_pkt_view_t *tc, uint32_t seq, uint16_t n)
+{
+    /* Static to keep the frame and the records out of the task stack */
+    static uint8_t bb_raw[FSAT_PKT_MAX_LEN];
+    static uint8_t recs[PROCESS_TC_BLACK_BOX_RECORDS_PER_FRAME * SYS_LOG_BLACK_BOX_RECORD_LEN];
+
+    uint32_t first = sys_log_black_box_first();
+    uint32_t next = sys_log_black_box_next();
+
+    /* The records older than the first one were overwritten */
+    uint32_t cur = (seq < first) ? first : seq;
+    uint32_t end = cur;
+
+    if (cur < next)
+    {
+        end = ((next - cur) > n) ? (cur + n) : next;
+    }
+
+    bool done = false;
+    uint16_t frames = 0U;
+
+    while(!done && (frames < CONFIG_BLACK_BOX_MAX_FRAMES_PER_TC))
+    {
+        uint8_t k = ((end - cur) > PROCESS_TC_BLACK_BOX_RECORDS_PER_FRAME) ? PROCESS_TC_BLACK_BOX_RECORDS_PER_FRAME : (uint8_t)(end - cur);
+
+        if ((k > 0U) && (sys_log_black_box_read(cur, recs, k) != 0))
+        {
+            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error reading the black box!");
+            sys_log_new_line();
+
+            break;
+        }
+
+        fsat_pkt_builder_t bb = {0};
+
+        fsat_pkt_builder_init(&bb, bb_raw, sizeof(bb_raw), CONFIG_PKT_ID_DOWNLINK_BLACK_BOX, CONFIG_SATELLITE_CALLSIGN);
+
+        /* Requester callsign */
+        fsat_pkt_builder_put_callsign(&bb, tc->callsign, tc->callsign_len);
+
+        /* Sequence number (written by the link layer) */
+        uint16_t seq_pos = bb.len;
+
+        fsat_pkt_builder_put_u16(&bb, 0U);
+
+        fsat_pkt_builder_put_u32(&bb, cur);
+        fsat_pkt_builder_put_u8(&bb, k);
+        fsat_pkt_builder_put_bytes(&bb, recs, k * SYS_LOG_BLACK_BOX_RECORD_LEN);
+
+        uint16_t bb_raw_len = 0;
+
+        if (fsat_pkt_builder_finish(&bb, &bb_raw_len) == 0)
+        {
+            int err = -1;
+
+            uint8_t i = 0U;
+            for(i = 0U; (i < CONFIG_PAYLOAD_DATA_TX_RETRIES) && (err != 0); i++)
+            {
+                err = ttc_link_send_bulk(bb_raw, bb_raw_len, seq_pos);
+
+                if (err != 0)
+                {
+                    /* Wait for the radios to release their TX FIFOs */
+                    vTaskDelay(pdMS_TO_TICKS(CONFIG_PAYLOAD_DATA_TX_RETRY_DELAY_MS));
+                }
+            }
+
+            if (err != 0)
+            {
+                sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_PROCESS_TC_NAME, "Error transmitting a \"black box\" frame!");
+                sys_log_new_line();
+
+                done = true;
+            }
+        }
+
+        frames++;
+
+        cur += k;
+
+        if (cur >= end)
+        {
+            done = true;
+        }
+    }
+
+    if (SYS_LOG_ENABLED(SYS_LOG_INFO, SYS_LOG_MODULE_PROCESS_TC))
+    {
+        sys_log_print_event_from_module(SYS_LOG_INFO, TASK_PROCESS_TC_NAME, "");
+        sys_log_print_uint(frames);
+        sys_log_print_msg(" black box frame(s) transmitted");
+        sys_log_new_line();
+    }
+}
+
+bool process_tc_validate_hmac(const uint8_t *msg, uint16_t msg_len, const uint8_t *msg_hash, uint16_t msg_hash_len, uint8_t *key, uint16_t key_len)
 {
     bool res = false;
 
@@ -1129,7 +1508,7 @@ bool process_tc_validate_hmac(uint8_t *msg, uint16_t msg_len, uint8_t *msg_hash,
 
     if (hmac(SHA1, msg, msg_len, key, key_len, hash) == 0)
     {
-        if (memcmp(msg, msg_hash, (size_t)msg_hash_len) == 0)
+        if (memcmp(hash, msg_hash, (size_t)msg_hash_len) == 0)
         {
             res = true;
         }
@@ -59,6 +59,16 @@ extern xTaskHandle xTaskProcessTCHandle;
  */
 void vTaskProcessTC(void);
 
+/**
+ * \brief Executes one cycle of the process TC task.
+ *
+ * Reads the next telecommand received by the TTC_1 (if any) and executes it. It is called
+ * periodically by the task, and can be called directly by the host simulations.
+ *
+ * \return None.
+ */
+void process_tc_poll(void);
+
 #endif /* PROCESS_TC_H_ */
 
 /** \} End of process_tc group */
@@ -37,6 +37,7 @@
 #include <devices/antenna/antenna.h>
 
 #include <structs/satellite.h>
+#include <structs/beacon_frame.h>
 
 #include "read_antenna.h"
 #include "startup.h"
@@ -54,18 +55,21 @@ void vTaskReadAntenna(void)
 
         if (antenna_init() != 0)
         {
-            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_READ_ANTENNA_NAME, "Error initializing the Antenna device!");
-            sys_log_new_line();
+            SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_READ_ANTENNA, SYS_LOG_TOK_DEV_INIT_ERROR, 0, 0);
         }
 
         if (antenna_get_data(&sat_data_buf.antenna.data) == 0)
         {
             sat_data_buf.antenna.timestamp = system_get_time();
+
+            if (beacon_frame_update_antenna() != 0)
+            {
+                SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_READ_ANTENNA, SYS_LOG_TOK_BEACON_UPDATE_ERROR, BEACON_FRAME_POS_ANTENNA, 0);
+            }
         }
         else
         {
-            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_READ_ANTENNA_NAME, "Error reading data from the Antenna device!");
-            sys_log_new_line();
+            SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_READ_ANTENNA, SYS_LOG_TOK_DEV_READ_ERROR, 0, 0);
         }
 
         vTaskDelayUntil(&last_cycle, pdMS_TO_TICKS(TASK_READ_ANTENNA_PERIOD_MS));
@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.9.10
+ * \version 0.10.23
  * 
  * \date 2020/08/16
  * 
@@ -33,9 +33,12 @@
  * \{
  */
 
+#include <config/config.h>
+#include <system/system.h>
 #include <system/sys_log/sys_log.h>
 #include <devices/payload/payload.h>
 #include <drivers/edc/edc.h>
+#include <structs/payload_data.h>
 
 #include "read_edc.h"
 #include "startup.h"
@@ -44,6 +47,23 @@ xTaskHandle xTaskReadEDCHandle;
 
 pl_edc_hk_raw_t edc_hk_buf = {0};
 
+#if defined(TASK_READ_EDC_ADC_SEQ_ENABLED) && (TASK_READ_EDC_ADC_SEQ_ENABLED == 1)
+static uint8_t edc_adc_seq_chunk[PAYLOAD_DATA_STREAM_CHUNK_LEN] = {0};     /* Too big for the task stack */
+
+/**
+ * \brief Stores a chunk of an ADC sequence.
+ *
+ * \param[in] data is the chunk.
+ *
+ * \param[in] len is the number of bytes of the chunk.
+ *
+ * \param[in,out] arg is a pointer to the payload data stream.
+ *
+ * \return The status/error code.
+ */
+static int read_edc_store_chunk(uint8_t *data, uint16_t len, void *arg);
+#endif /* TASK_READ_EDC_ADC_SEQ_ENABLED */
+
 void vTaskReadEDC(void)
 {
     static payload_t pl_edc_active = PAYLOAD_EDC_0;
@@ -55,14 +75,48 @@ void vTaskReadEDC(void)
     {
         TickType_t last_cycle = xTaskGetTickCount();
 
+        uint8_t pl_id = (pl_edc_active == PAYLOAD_EDC_0) ? CONFIG_PL_ID_EDC_1 : CONFIG_PL_ID_EDC_2;
+
         /* Read housekeeping data */
-        if (payload_get_data(pl_edc_active, PAYLOAD_EDC_RAW_HK, edc_hk_buf.buffer, &edc_hk_buf.length) != 0)
+        if (payload_get_data(pl_edc_active, PAYLOAD_EDC_RAW_HK, edc_hk_buf.buffer, &edc_hk_buf.length) == 0)
+        {
+            if (payload_data_write(pl_id, PAYLOAD_DATA_TYPE_EDC_HK, system_get_time(), edc_hk_buf.buffer, (uint16_t)edc_hk_buf.length) != 0)
+            {
+                SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_READ_EDC, SYS_LOG_TOK_EDC_HK_STORE_ERROR, 0, 0);
+            }
+        }
+        else
+        {
+            SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_READ_EDC, SYS_LOG_TOK_EDC_HK_READ_ERROR, 0, 0);
+        }
+
+        vTaskDelay(pdMS_TO_TICKS(TASK_READ_EDC_CMD_GAP_MS));   /* Minimum gap before the next command */
+
+    #if defined(TASK_READ_EDC_ADC_SEQ_ENABLED) && (TASK_READ_EDC_ADC_SEQ_ENABLED == 1)
+        /* Read the last ADC sequence straight into the NOR memory (one downlink record per chunk) */
+        /* With I2C, each chunk is a separate read that must resume the frame (see edc_get_adc_seq_stream()) */
+        payload_data_stream_t adc_seq_stream = {0};
+        uint32_t adc_seq_len = 0;
+
+        if (payload_data_stream_begin(&adc_seq_stream, pl_id, PAYLOAD_DATA_TYPE_EDC_ADC_SEQ, system_get_time(), EDC_FRAME_ADC_SEQ_LEN) == 0)
         {
-            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_READ_EDC_NAME, "Error reading the housekeeping data!");
-            sys_log_new_line();
+            if ((payload_get_data_stream(pl_edc_active, PAYLOAD_EDC_ADC_SEQ, edc_adc_seq_chunk, sizeof(edc_adc_seq_chunk), read_edc_store_chunk, &adc_seq_stream, &adc_seq_len) == 0) &&
+                (payload_data_stream_end(&adc_seq_stream) == 0))
+            {
+                SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_READ_EDC, SYS_LOG_TOK_EDC_ADC_SEQ_STORED, adc_seq_len, 0);
+            }
+            else
+            {
+                SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_READ_EDC, SYS_LOG_TOK_EDC_ADC_SEQ_READ_ERROR, 0, 0);
+            }
+        }
+        else
+        {
+            SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_READ_EDC, SYS_LOG_TOK_EDC_ADC_SEQ_RESERVE_ERROR, 0, 0);
         }
 
-        vTaskDelay(pdMS_TO_TICKS(500));     /* Wait a while for the next command */
+        vTaskDelay(pdMS_TO_TICKS(TASK_READ_EDC_CMD_GAP_MS));   /* Minimum gap before the next command */
+    #endif /* TASK_READ_EDC_ADC_SEQ_ENABLED */
 
         /* Read packets */
         uint8_t state_arr[10] = {0};
@@ -76,10 +130,7 @@ void vTaskReadEDC(void)
 
                 if (state.ptt_available > 0)
                 {
-                    sys_log_print_event_from_module(SYS_LOG_INFO, TASK_READ_EDC_NAME, "");
-                    sys_log_print_uint(state.ptt_available);
-                    sys_log_print_msg(" PTT packet(s) available to read!");
-                    sys_log_new_line();
+                    SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_READ_EDC, SYS_LOG_TOK_EDC_PTT_AVAILABLE, state.ptt_available, 0);
 
                     uint8_t i = 0;
                     for(i = 0; i < state.ptt_available; i++)
@@ -91,45 +142,39 @@ void vTaskReadEDC(void)
                         {
                             edc_ptt_t ptt = *(edc_ptt_t*)&ptt_arr[0];
 
-                            sys_log_print_event_from_module(SYS_LOG_INFO, TASK_READ_EDC_NAME, "Received PTT packet:");
-                            sys_log_new_line();
-                            sys_log_print_event_from_module(SYS_LOG_INFO, TASK_READ_EDC_NAME, "\tTime: ");
-                            sys_log_print_uint(ptt.time_tag);
-                            sys_log_print_msg(" sec");
-                            sys_log_new_line();
-                            sys_log_print_event_from_module(SYS_LOG_INFO, TASK_READ_EDC_NAME, "\tError code: ");
-                            sys_log_print_uint(ptt.error_code);
-                            sys_log_new_line();
-                            sys_log_print_event_from_module(SYS_LOG_INFO, TASK_READ_EDC_NAME, "\tCarrier frequency: ");
-                            sys_log_print_uint(ptt.carrier_freq);
-                            sys_log_print_msg(" Hz");
-                            sys_log_new_line();
-                            sys_log_print_event_from_module(SYS_LOG_INFO, TASK_READ_EDC_NAME, "\tCarrier amplitude: ");
-                            sys_log_print_uint(ptt.carrier_abs);
-                            sys_log_new_line();
-                            sys_log_print_event_from_module(SYS_LOG_INFO, TASK_READ_EDC_NAME, "\tUser message: ");
-                            sys_log_dump_hex(ptt.user_msg, ptt.msg_byte_length);
-                            sys_log_new_line();
+                            /* The user message is only stored with the packet (it does not fit in a log record) */
+                            SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_READ_EDC, SYS_LOG_TOK_EDC_PTT_RECEIVED, ptt.time_tag, ptt.error_code);
+                            SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_READ_EDC, SYS_LOG_TOK_EDC_PTT_CARRIER, ptt.carrier_freq, ptt.carrier_abs);
+
+                            if (payload_data_write(pl_id, PAYLOAD_DATA_TYPE_EDC_PTT, system_get_time(), ptt_arr, (uint16_t)ptt_len) != 0)
+                            {
+                                SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_READ_EDC, SYS_LOG_TOK_EDC_PTT_STORE_ERROR, 0, 0);
+                            }
                         }
                         else
                         {
-                            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_READ_EDC_NAME, "Error reading PTT package!");
-                            sys_log_new_line();
+                            SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_READ_EDC, SYS_LOG_TOK_EDC_PTT_READ_ERROR, 0, 0);
                         }
 
-                        vTaskDelay(pdMS_TO_TICKS(500));     /* Wait a while for the next command */
+                        vTaskDelay(pdMS_TO_TICKS(TASK_READ_EDC_CMD_GAP_MS));   /* Minimum gap before the next command */
                     }
                 }
             }
         }
         else
         {
-            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_READ_EDC_NAME, "Error reading the state data!");
-            sys_log_new_line();
+            SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_READ_EDC, SYS_LOG_TOK_EDC_STATE_READ_ERROR, 0, 0);
         }
 
         vTaskDelayUntil(&last_cycle, pdMS_TO_TICKS(TASK_READ_EDC_PERIOD_MS));
     }
 }
 
+#if defined(TASK_READ_EDC_ADC_SEQ_ENABLED) && (TASK_READ_EDC_ADC_SEQ_ENABLED == 1)
+static int read_edc_store_chunk(uint8_t *data, uint16_t len, void *arg)
+{
+    return payload_data_stream_write((payload_data_stream_t*)arg, data, len);
+}
+#endif /* TASK_READ_EDC_ADC_SEQ_ENABLED */
+
 /** \} End of read_edc group */
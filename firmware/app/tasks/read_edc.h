@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.9.14
+ * \version 0.10.15
  * 
  * \date 2020/08/16
  * 
@@ -45,6 +45,8 @@
 #define TASK_READ_EDC_PRIORITY              3                   /**< Task priority. */
 #define TASK_READ_EDC_PERIOD_MS             (60000)             /**< Task period in milliseconds. */
 #define TASK_READ_EDC_INIT_TIMEOUT_MS       2000                /**< Wait time to initialize the task in milliseconds. */
+#define TASK_READ_EDC_CMD_GAP_MS            10                  /**< Gap between consecutive commands in milliseconds (the driver waits for each answer). */
+#define TASK_READ_EDC_ADC_SEQ_ENABLED       0                   /**< Stores the last ADC sequence every cycle (35 NOR pages per sequence). */
 
 /**
  * \brief EDC housekeeping raw data type.
@@ -37,6 +37,7 @@
 #include <devices/eps/eps.h>
 
 #include <structs/satellite.h>
+#include <structs/beacon_frame.h>
 
 #include "read_eps.h"
 #include "startup.h"
@@ -54,18 +55,21 @@ void vTaskReadEPS(void)
 
         if (eps_init() != 0)
         {
-            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_READ_EPS_NAME, "Error initializing the EPS device!");
-            sys_log_new_line();
+            SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_READ_EPS, SYS_LOG_TOK_DEV_INIT_ERROR, 0, 0);
         }
 
         if (eps_get_data(&sat_data_buf.eps.data) == 0)
         {
             sat_data_buf.eps.timestamp = system_get_time();
+
+            if (beacon_frame_update_eps() != 0)
+            {
+                SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_READ_EPS, SYS_LOG_TOK_BEACON_UPDATE_ERROR, BEACON_FRAME_POS_EPS, 0);
+            }
         }
         else
         {
-            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_READ_EPS_NAME, "Error reading data from the EPS device!");
-            sys_log_new_line();
+            SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_READ_EPS, SYS_LOG_TOK_DEV_READ_ERROR, 0, 0);
         }
 
         vTaskDelayUntil(&last_cycle, pdMS_TO_TICKS(TASK_READ_EPS_PERIOD_MS));
@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.8.5
+ * \version 0.10.18
  * 
  * \date 2020/07/12
  * 
@@ -33,11 +33,15 @@
  * \{
  */
 
+#include <config/config.h>
+#include <system/sys_log/sys_log.h>
+#include <drivers/adc/adc.h>
 #include <devices/current_sensor/current_sensor.h>
 #include <devices/voltage_sensor/voltage_sensor.h>
 #include <devices/temp_sensor/temp_sensor.h>
 
 #include <structs/satellite.h>
+#include <structs/beacon_frame.h>
 
 #include "read_sensors.h"
 #include "startup.h"
@@ -53,6 +57,17 @@ void vTaskReadSensors(void)
     {
         TickType_t last_cycle = xTaskGetTickCount();
 
+    #if defined(CONFIG_ADC_SEQ_ENABLED) && (CONFIG_ADC_SEQ_ENABLED == 1)
+        uint16_t raw[ADC_SEQ_LEN] = {0};
+
+        /* OBDH current, voltage and temperature (single oversampled scan) */
+        if (adc_read_seq(raw) == 0)
+        {
+            sat_data_buf.obdh.data.current      = current_sensor_raw_to_ma(raw[ADC_SEQ_CH_CURRENT]);
+            sat_data_buf.obdh.data.voltage      = voltage_sensor_raw_to_mv(raw[ADC_SEQ_CH_VOLTAGE]);
+            sat_data_buf.obdh.data.temperature  = raw[ADC_SEQ_CH_TEMP];
+        }
+    #else
         uint16_t buf = 0;
 
         /* OBDH current */
@@ -72,10 +87,16 @@ void vTaskReadSensors(void)
         {
             sat_data_buf.obdh.data.temperature = buf;
         }
+    #endif /* CONFIG_ADC_SEQ_ENABLED */
 
         /* Data timestamp */
         sat_data_buf.obdh.timestamp = system_get_time();
 
+        if (beacon_frame_update_obdh() != 0)
+        {
+            SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_BEACON, SYS_LOG_TOK_BEACON_UPDATE_ERROR, BEACON_FRAME_POS_OBDH, 0);
+        }
+
         vTaskDelayUntil(&last_cycle, pdMS_TO_TICKS(TASK_READ_SENSORS_PERIOD_MS));
     }
 }
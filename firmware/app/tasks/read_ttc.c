@@ -37,6 +37,7 @@
 #include <devices/ttc/ttc.h>
 
 #include <structs/satellite.h>
+#include <structs/beacon_frame.h>
 
 #include "read_ttc.h"
 #include "startup.h"
@@ -54,14 +55,12 @@ void vTaskReadTTC(void)
 
         if (ttc_init(TTC_0) != 0)
         {
-            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_READ_TTC_NAME, "Error initializing the TTC device!");
-            sys_log_new_line();
+            SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_READ_TTC, SYS_LOG_TOK_DEV_INIT_ERROR, 0, 0);
         }
 
         if (ttc_init(TTC_1) != 0)
         {
-            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_READ_TTC_NAME, "Error initializing the TTC device!");
-            sys_log_new_line();
+            SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_READ_TTC, SYS_LOG_TOK_DEV_INIT_ERROR, 1, 0);
         }
 
         if (ttc_get_data(TTC_0, &sat_data_buf.ttc_0.data) == 0)
@@ -70,18 +69,21 @@ void vTaskReadTTC(void)
         }
         else
         {
-            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_READ_TTC_NAME, "Error reading data from the TTC 0 device!");
-            sys_log_new_line();
+            SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_READ_TTC, SYS_LOG_TOK_DEV_READ_ERROR, 0, 0);
         }
 
         if (ttc_get_data(TTC_1, &sat_data_buf.ttc_1.data) == 0)
         {
             sat_data_buf.ttc_1.timestamp = system_get_time();
+
+            if (beacon_frame_update_ttc() != 0)
+            {
+                SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_READ_TTC, SYS_LOG_TOK_BEACON_UPDATE_ERROR, BEACON_FRAME_POS_TTC, 0);
+            }
         }
         else
         {
-            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_READ_TTC_NAME, "Error reading data from the TTC 1 device!");
-            sys_log_new_line();
+            SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_READ_TTC, SYS_LOG_TOK_DEV_READ_ERROR, 1, 0);
         }
 
         vTaskDelayUntil(&last_cycle, pdMS_TO_TICKS(TASK_READ_TTC_PERIOD_MS));
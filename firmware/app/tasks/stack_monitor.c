@@ -0,0 +1,106 @@
+/*
+ * stack_monitor.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Task stack monitor implementation.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.25
+ *
+ * \date 2022/12/13
+ *
+ * \addtogroup stack_monitor
+ * \{
+ */
+
+#include <stdbool.h>
+
+#include <config/config.h>
+#include <system/sys_log/sys_log.h>
+
+#include "stack_monitor.h"
+
+/* Stack sizes (0 for the tasks not created), written by the kernel when the tasks are created */
+static volatile uint16_t stack_monitor_size[CONFIG_CPU_USAGE_MAX_TASKS] = {0U};
+
+/* 16-bit values (atomic in the MSP430): read by the get parameter TC without a critical section */
+static volatile uint16_t stack_monitor_min_free[CONFIG_CPU_USAGE_MAX_TASKS] = {0U};
+static volatile bool stack_monitor_sampled[CONFIG_CPU_USAGE_MAX_TASKS] = {false};
+
+/* Minimum of the last log record of each task */
+static uint16_t stack_monitor_logged[CONFIG_CPU_USAGE_MAX_TASKS] = {0U};
+
+void stack_monitor_task_created(uint16_t number, uint16_t stack_size)
+{
+    if ((number > 0U) && (number <= CONFIG_CPU_USAGE_MAX_TASKS))
+    {
+        stack_monitor_size[number - 1U] = stack_size;
+    }
+}
+
+void stack_monitor_update(uint8_t task, uint16_t min_free)
+{
+    if (task < CONFIG_CPU_USAGE_MAX_TASKS)
+    {
+        stack_monitor_min_free[task] = min_free;
+
+        if (!stack_monitor_sampled[task])
+        {
+            stack_monitor_sampled[task] = true;
+
+            /* The minimum is logged from the next sample, so the first sample does not fill the log ring */
+            stack_monitor_logged[task] = UINT16_MAX;
+
+            sys_log_deferred(SYS_LOG_INFO, SYS_LOG_MODULE_SYSTEM, SYS_LOG_TOK_STACK_SIZE, task, stack_monitor_size[task]);
+        }
+        else if ((uint16_t)(stack_monitor_logged[task] - min_free) >= CONFIG_STACK_MONITOR_LOG_STEP)
+        {
+            stack_monitor_logged[task] = min_free;
+
+            sys_log_deferred((min_free < CONFIG_STACK_MONITOR_MIN_FREE) ? SYS_LOG_WARNING : SYS_LOG_INFO, SYS_LOG_MODULE_SYSTEM, SYS_LOG_TOK_STACK_MIN_FREE, task, min_free);
+        }
+        else
+        {
+            /* Not enough change to log a new record */
+        }
+    }
+}
+
+int stack_monitor_get(uint8_t task, uint8_t field, uint32_t *val)
+{
+    int err = -1;
+
+    if ((task < CONFIG_CPU_USAGE_MAX_TASKS) && stack_monitor_sampled[task])
+    {
+        switch(field)
+        {
+            case STACK_MONITOR_FIELD_MIN_FREE:  *val = stack_monitor_min_free[task];    err = 0;    break;
+            case STACK_MONITOR_FIELD_SIZE:      *val = stack_monitor_size[task];        err = 0;    break;
+            default:                                                                                break;  /* Invalid field */
+        }
+    }
+
+    return err;
+}
+
+/** \} End of stack_monitor group */
@@ -0,0 +1,93 @@
+/*
+ * stack_monitor.h
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Task stack monitor definition.
+ *
+ * The stack high-water mark (minimum free space since the task creation) of each task is taken
+ * from the run time counters sample of the CPU usage task, with the same task index (creation
+ * order). The stack sizes are recorded by the kernel when the tasks are created (traceTASK_CREATE,
+ * see FreeRTOSConfig.h). The first sample of a task logs its stack size, and then every time its
+ * minimum drops by CONFIG_STACK_MONITOR_LOG_STEP words a record is logged (and stored in the
+ * black box), as a warning when it is below CONFIG_STACK_MONITOR_MIN_FREE words. The host log
+ * decoder builds the stack budget report from these records (tests/tools).
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.25
+ *
+ * \date 2022/12/13
+ *
+ * \defgroup stack_monitor Stack Monitor
+ * \ingroup tasks
+ * \{
+ */
+
+#ifndef STACK_MONITOR_H_
+#define STACK_MONITOR_H_
+
+#include <stdint.h>
+
+/* Fields (parameter IDs) of a task */
+#define STACK_MONITOR_FIELD_MIN_FREE    0U      /**< Minimum free stack since the task creation in words. */
+#define STACK_MONITOR_FIELD_SIZE        1U      /**< Stack size in words. */
+
+/**
+ * \brief Records the stack size of a new task.
+ *
+ * Called by the kernel (traceTASK_CREATE) inside a critical section.
+ *
+ * \param[in] number is the task number (xTaskNumber, starting from 1).
+ *
+ * \param[in] stack_size is the stack size in words.
+ *
+ * \return None.
+ */
+void stack_monitor_task_created(uint16_t number, uint16_t stack_size);
+
+/**
+ * \brief Updates the stack high-water mark of a task.
+ *
+ * \param[in] task is the task index (xTaskNumber - 1, the same index of the CPU usage table).
+ *
+ * \param[in] min_free is the minimum free stack since the task creation in words.
+ *
+ * \return None.
+ */
+void stack_monitor_update(uint8_t task, uint16_t min_free);
+
+/**
+ * \brief Reads a field of the stack monitor.
+ *
+ * \param[in] task is the task index (the same index of the CPU usage table).
+ *
+ * \param[in] field is the field ID (STACK_MONITOR_FIELD_*).
+ *
+ * \param[in,out] val is a pointer to store the field value.
+ *
+ * \return The status/error code (an error for the tasks not created or not sampled yet).
+ */
+int stack_monitor_get(uint8_t task, uint8_t field, uint32_t *val);
+
+#endif /* STACK_MONITOR_H_ */
+
+/** \} End of stack_monitor group */
@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.9.20
+ * \version 0.10.22
  * 
  * \date 2019/12/04
  * 
@@ -39,6 +39,7 @@
 #include <system/system.h>
 #include <system/sys_log/sys_log.h>
 #include <system/clocks.h>
+#include <drivers/timer/timer.h>
 #include <devices/watchdog/watchdog.h>
 #include <devices/leds/leds.h>
 #include <devices/eps/eps.h>
@@ -48,6 +49,8 @@
 #include <devices/antenna/antenna.h>
 #include <devices/media/media.h>
 #include <devices/payload/payload.h>
+#include <structs/beacon_frame.h>
+#include <structs/payload_data.h>
 
 #include "startup.h"
 
@@ -83,6 +86,15 @@ void vTaskStartup(void)
     sys_log_print_msg(" Hz");
     sys_log_new_line();
 
+    /* Free-running timer (timestamps of the bus statistics and run time statistics counter) */
+    if (timer_init() != 0)
+    {
+        sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_STARTUP_NAME, "Error initializing the free-running timer! Bus and CPU statistics are not available!");
+        sys_log_new_line();
+
+        error_counter++;
+    }
+
     /* Print last reset cause (code) */
     sys_log_print_event_from_module(SYS_LOG_INFO, TASK_STARTUP_NAME, "Last reset cause: ");
     sys_log_print_hex(system_get_reset_cause());
@@ -104,6 +116,12 @@ void vTaskStartup(void)
         {
             error_counter++;
         }
+
+        /* Persistent event log */
+        if (sys_log_black_box_init() != 0)
+        {
+            error_counter++;
+        }
     }
 #endif /* CONFIG_DEV_MEDIA_FRAM_ENABLED */
 
@@ -181,6 +199,23 @@ void vTaskStartup(void)
     }
 #endif /* CONFIG_DEV_ANTENNA_ENABLED */
 
+    /* Pre-encoded beacon frame */
+    if (beacon_frame_init() != 0)
+    {
+        error_counter++;
+    }
+
+#if defined(CONFIG_DEV_MEDIA_NOR_ENABLED) && (CONFIG_DEV_MEDIA_NOR_ENABLED == 1)
+    /* Payload data storage */
+    if (payload_data_init() != 0)
+    {
+        error_counter++;
+    }
+#endif /* CONFIG_DEV_MEDIA_NOR_ENABLED */
+
+    /* Boot record of the black box */
+    sys_log_deferred((error_counter > 0U) ? SYS_LOG_ERROR : SYS_LOG_INFO, SYS_LOG_MODULE_STARTUP, SYS_LOG_TOK_BOOT, system_get_reset_cause(), error_counter);
+
     if (error_counter > 0U)
     {
         sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_STARTUP_NAME, "Boot completed with ");
@@ -49,6 +49,8 @@ void vTaskSystemReset(void)
         sys_log_print_event_from_module(SYS_LOG_INFO, TASK_SYSTEM_RESET_NAME, "Restarting the system...");
         sys_log_new_line();
 
+        sys_log_flush();
+
         system_reset();
     }
 }
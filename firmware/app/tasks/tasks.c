@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.9.18
+ * \version 0.10.24
  * 
  * \date 2019/11/02
  * 
@@ -52,6 +52,8 @@
 #include "read_antenna.h"
 #include "data_log.h"
 #include "process_tc.h"
+#include "log_flush.h"
+#include "cpu_usage.h"
 
 void create_tasks(void)
 {
@@ -184,6 +186,24 @@ void create_tasks(void)
     }
 #endif /* CONFIG_TASK_ANTENNA_DEPLOYMENT_ENABLED */
 
+#if defined(CONFIG_TASK_LOG_FLUSH_ENABLED) && (CONFIG_TASK_LOG_FLUSH_ENABLED == 1)
+    xTaskCreate(vTaskLogFlush, TASK_LOG_FLUSH_NAME, TASK_LOG_FLUSH_STACK_SIZE, NULL, TASK_LOG_FLUSH_PRIORITY, &xTaskLogFlushHandle);
+
+    if (xTaskLogFlushHandle == NULL)
+    {
+        /* Error creating the log flush task */
+    }
+#endif /* CONFIG_TASK_LOG_FLUSH_ENABLED */
+
+#if defined(CONFIG_TASK_CPU_USAGE_ENABLED) && (CONFIG_TASK_CPU_USAGE_ENABLED == 1)
+    xTaskCreate(vTaskCPUUsage, TASK_CPU_USAGE_NAME, TASK_CPU_USAGE_STACK_SIZE, NULL, TASK_CPU_USAGE_PRIORITY, &xTaskCPUUsageHandle);
+
+    if (xTaskCPUUsageHandle == NULL)
+    {
+        /* Error creating the CPU usage task */
+    }
+#endif /* CONFIG_TASK_CPU_USAGE_ENABLED */
+
     create_event_groups();
 }
 
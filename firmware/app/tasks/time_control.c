@@ -88,15 +88,11 @@ void vTaskTimeControl(void)
 
     if (time_control_load_sys_time(&last_sys_time) == 0)
     {
-        sys_log_print_event_from_module(SYS_LOG_INFO, TASK_TIME_CONTROL_NAME, "Last saved system time (epoch): ");
-        sys_log_print_uint(last_sys_time);
-        sys_log_print_msg(" sec");
-        sys_log_new_line();
+        SYS_LOG_DEFERRED(SYS_LOG_INFO, SYS_LOG_MODULE_TIME_CONTROL, SYS_LOG_TOK_TIME_LAST_SAVED, last_sys_time, 0);
     }
     else
     {
-        sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_TIME_CONTROL_NAME, "The last saved system time is not available!");
-        sys_log_new_line();
+        SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_TIME_CONTROL, SYS_LOG_TOK_TIME_NOT_AVAILABLE, 0, 0);
     }
 
     system_set_time(last_sys_time);
@@ -145,14 +141,12 @@ static int time_control_load_sys_time(sys_time_t *tm)
         }
         else
         {
-            sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_TIME_CONTROL_NAME, "Error reading the system time from the non-volatile memory!");
-            sys_log_new_line();
+            SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_TIME_CONTROL, SYS_LOG_TOK_TIME_READ_ERROR, 0, 0);
         }
     }
     else
     {
-        sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_TIME_CONTROL_NAME, "Error reading the system time from the non-volatile memory!");
-        sys_log_new_line();
+        SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_TIME_CONTROL, SYS_LOG_TOK_TIME_READ_ERROR, 0, 0);
     }
 
     return err;
@@ -173,8 +167,7 @@ static int time_control_save_sys_time(sys_time_t tm)
 
     if (media_write(TIME_CONTROL_MEDIA, CONFIG_MEM_ADR_SYS_TIME, buf, 6U) != 0)
     {
-        sys_log_print_event_from_module(SYS_LOG_ERROR, TASK_TIME_CONTROL_NAME, "Error writing the system time to the non-volatile memory!");
-        sys_log_new_line();
+        SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_TIME_CONTROL, SYS_LOG_TOK_TIME_WRITE_ERROR, 0, 0);
 
         err = -1;
     }
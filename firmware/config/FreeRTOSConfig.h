@@ -58,12 +58,12 @@
 #define configMAX_PRIORITIES			( 5 )
 #define configTOTAL_HEAP_SIZE			( ( size_t ) ( 40 * 1024 ) )
 #define configMAX_TASK_NAME_LEN			( 20 )
-#define configUSE_TRACE_FACILITY		0
+#define configUSE_TRACE_FACILITY		1
 #define configUSE_16_BIT_TICKS			0
 #define configIDLE_SHOULD_YIELD			1
 #define configUSE_MUTEXES				1
 #define configQUEUE_REGISTRY_SIZE		0
-#define configGENERATE_RUN_TIME_STATS	0
+#define configGENERATE_RUN_TIME_STATS	1
 #define configCHECK_FOR_STACK_OVERFLOW	2
 #define configUSE_RECURSIVE_MUTEXES		1
 #define configUSE_MALLOC_FAILED_HOOK	1
@@ -76,6 +76,18 @@
 	#define configMINIMAL_STACK_SIZE		( ( unsigned short ) 150 )
 #endif
 
+/* Run time statistics. The counter is the free-running microsecond timer (Timer_A1), started
+by the startup task (the counters read 0 before it). */
+extern uint32_t timer_get_us( void );
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()		timer_get_us()
+
+/* Stack monitor. The stack size (words) of each new task is recorded with its number, the same
+index of the run time statistics (the high address of the stack is needed to compute it). */
+#define configRECORD_STACK_HIGH_ADDRESS	1
+extern void stack_monitor_task_created( uint16_t number, uint16_t stack_size );
+#define traceTASK_CREATE( pxNewTCB )	stack_monitor_task_created( ( uint16_t ) ( pxNewTCB )->uxTCBNumber, ( uint16_t ) ( ( ( pxNewTCB )->pxEndOfStack - ( pxNewTCB )->pxStack ) + 1 ) )
+
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES 		0
 #define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
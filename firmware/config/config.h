@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.9.19
+ * \version 0.10.25
  * 
  * \date 2019/10/26
  * 
@@ -51,6 +51,8 @@
 #define CONFIG_TASK_DATA_LOG_ENABLED                    1
 #define CONFIG_TASK_PROCESS_TC_ENABLED                  1
 #define CONFIG_TASK_ANTENNA_DEPLOYMENT_ENABLED          0
+#define CONFIG_TASK_LOG_FLUSH_ENABLED                   1
+#define CONFIG_TASK_CPU_USAGE_ENABLED                   1
 
 /* Devices */
 #define CONFIG_DEV_MEDIA_INT_ENABLED                    1
@@ -66,9 +68,18 @@
 
 /* Drivers */
 #define CONFIG_DRV_ISIS_ANTENNA_ENABLED                 1
+#define CONFIG_ADC_SEQ_ENABLED                          1
+#define CONFIG_ADC_OVERSAMPLING                         16U     /* Samples per channel of the ADC sequence scan */
 
 /* Debug and log messages */
 #define CONFIG_DRIVERS_DEBUG_ENABLED                    0
+#define CONFIG_SYS_LOG_DEFERRED_ENABLED                 1
+#define CONFIG_SYS_LOG_DEFERRED_RECORDS                 32U     /* Power of two */
+#define CONFIG_SYS_LOG_TOKENIZED_ENABLED                1       /* Decoded by tests/tools/sys_log_decoder */
+#define CONFIG_SYS_LOG_BLACK_BOX_ENABLED                1
+#define CONFIG_SYS_LOG_BLACK_BOX_RECORDS                1024UL  /* Power of two (16 bytes each, in the FRAM) */
+#define CONFIG_SYS_LOG_LEVEL                            0       /* Lower event types are compiled out (0 = info, 1 = warning, 2 = error) */
+#define CONFIG_SYS_LOG_DEFAULT_LEVEL                    0       /* Initial runtime level of all modules (changed by the set param TC) */
 
 #define CONFIG_SATELLITE_CALLSIGN                       "PY0EFS"
 
@@ -80,6 +91,8 @@
 #define CONFIG_PKT_ID_DOWNLINK_PAYLOAD_DATA             0x24
 #define CONFIG_PKT_ID_DOWNLINK_TC_FEEDBACK              0x25
 #define CONFIG_PKT_ID_DOWNLINK_PARAM_VALUE              0x26
+#define CONFIG_PKT_ID_DOWNLINK_BLACK_BOX                0x27
+#define CONFIG_PKT_ID_DOWNLINK_PARAM_VALUES             0x28
 #define CONFIG_PKT_ID_UPLINK_PING_REQ                   0x40
 #define CONFIG_PKT_ID_UPLINK_DATA_REQ                   0x41
 #define CONFIG_PKT_ID_UPLINK_BROADCAST_MSG              0x42
@@ -94,14 +107,34 @@
 #define CONFIG_PKT_ID_UPLINK_GET_PAYLOAD_DATA           0x4B
 #define CONFIG_PKT_ID_UPLINK_SET_PARAM                  0x4C
 #define CONFIG_PKT_ID_UPLINK_GET_PARAM                  0x4D
+#define CONFIG_PKT_ID_UPLINK_SET_PARAMS                 0x4E
+#define CONFIG_PKT_ID_UPLINK_GET_PARAMS                 0x4F
+#define CONFIG_PKT_ID_UPLINK_GET_BLACK_BOX              0x50
+
+/* Beacon */
+#define CONFIG_BEACON_ON_PING_ENABLED                   1
+
+/* TTC link */
+#define CONFIG_TTC_LINK_STRIPING_ENABLED                1
+#define CONFIG_TTC_LINK_TX_FIFO_MAX_PKTS                4
 
 /* Subsystem IDs */
 #define CONFIG_SUBSYSTEM_ID_OBDH                        0
 #define CONFIG_SUBSYSTEM_ID_TTC_1                       1
 #define CONFIG_SUBSYSTEM_ID_TTC_2                       2
 #define CONFIG_SUBSYSTEM_ID_EPS                         3
+#define CONFIG_SUBSYSTEM_ID_SPI                         4
+#define CONFIG_SUBSYSTEM_ID_I2C                         5
+#define CONFIG_SUBSYSTEM_ID_UART                        6
+#define CONFIG_SUBSYSTEM_ID_SYS_LOG                     7
+#define CONFIG_SUBSYSTEM_ID_CPU_USAGE                   8
+#define CONFIG_SUBSYSTEM_ID_STACK_MONITOR               9
+
+/* Parameters */
+#define CONFIG_PARAMS_BATCH_MAX                         30
 
 /* Payloads IDs */
+#define CONFIG_PL_ID_OBDH                               0       /* OBDH own records (CPU usage) */
 #define CONFIG_PL_ID_EDC_1                              1
 #define CONFIG_PL_ID_EDC_2                              2
 #define CONFIG_PL_ID_PAYLOAD_X                          3
@@ -119,7 +152,17 @@
 #define CONFIG_DATA_ID_TTC_1                            3
 
 /* Ports */
-#define CONFIG_SPI_PORT_0_SPEED_BPS                     1000000UL
+#define CONFIG_SPI_PORT_0_SPEED_BPS                     1000000UL   /* TTC 2.0 radios */
+#define CONFIG_SPI_FRAM_SPEED_BPS                       8000000UL   /* Maximum: SMCLK/4 = 7.99 MHz */
+#define CONFIG_SPI_NOR_SPEED_BPS                        8000000UL   /* Maximum: SMCLK/4 = 7.99 MHz */
+#define CONFIG_SPI_DMA_ENABLED                          1
+#define CONFIG_SPI_DMA_MIN_LEN                          16U
+#define CONFIG_SPI_DMA_TIMEOUT_MS                       200U
+#define CONFIG_I2C_ISR_ENABLED                          1
+#define CONFIG_I2C_ISR_TIMEOUT_MS                       100U
+#define CONFIG_BUS_STATS_ENABLED                        1
+#define CONFIG_UART_TX_BUFFER_SIZE                      256U    /* Power of two */
+#define CONFIG_UART_RX_BUFFER_SIZE                      512U    /* Power of two */
 
 /* Antenna */
 #define CONFIG_ANTENNA_INDEP_DEPLOY_BURN_TIME_SEC       10U
@@ -129,6 +172,26 @@
 
 /* Memory addresses */
 #define CONFIG_MEM_ADR_SYS_TIME                         0
+#define CONFIG_MEM_ADR_PAYLOAD_DATA_INDEX               16
+#define CONFIG_MEM_ADR_BLACK_BOX_INDEX                  32
+#define CONFIG_MEM_ADR_BLACK_BOX_START                  256
+#define CONFIG_MEM_PAYLOAD_DATA_SIZE                    0x00100000UL    /* Payload data region at the end of the NOR memory */
+
+/* Payload data */
+#define CONFIG_PAYLOAD_DATA_MAX_FRAMES_PER_TC           32U
+#define CONFIG_PAYLOAD_DATA_TX_RETRIES                  5U
+#define CONFIG_PAYLOAD_DATA_TX_RETRY_DELAY_MS           100U
+
+/* Black box */
+#define CONFIG_BLACK_BOX_MAX_FRAMES_PER_TC              16U
+
+/* CPU usage */
+#define CONFIG_CPU_USAGE_MAX_TASKS                      20U     /* At least the number of tasks (including the idle and timer tasks) */
+#define CONFIG_CPU_USAGE_NOR_LOG_ENABLED                1
+
+/* Stack monitor */
+#define CONFIG_STACK_MONITOR_LOG_STEP                   8U      /* Decrease of the minimum free stack (words) logged again */
+#define CONFIG_STACK_MONITOR_MIN_FREE                   16U     /* Free stack (words) below which the records are warnings */
 
 #endif /* CONFIG_H_ */
 
@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.8.35
+ * \version 0.10.22
  * 
  * \date 2021/10/20
  * 
@@ -56,6 +56,7 @@
 #define CONFIG_TC_KEY_GET_PAYLOAD_DATA                  "BkN&a):^fr(@(5x?"
 #define CONFIG_TC_KEY_SET_PARAMETER                     "x&veg;r[y{z{{T;7"
 #define CONFIG_TC_KEY_GET_PARAMETER                     "EB'YThpxu7,yla,m"
+#define CONFIG_TC_KEY_GET_BLACK_BOX                     "q3V!x`Hd9;Lr@e*Z"
 
 #endif /* KEYS_H_ */
 
@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.8.10
+ * \version 0.10.17
  * 
  * \date 2020/07/21
  * 
@@ -60,7 +60,7 @@ int media_init(media_t med)
 
             fram_conf.port      = SPI_PORT_0;
             fram_conf.cs_pin    = SPI_CS_5;
-            fram_conf.clock_hz  = CONFIG_SPI_PORT_0_SPEED_BPS;
+            fram_conf.clock_hz  = CONFIG_SPI_FRAM_SPEED_BPS;
             fram_conf.wp_pin    = GPIO_PIN_62;
 
             if (cy15x102qn_init(&fram_conf) == 0)
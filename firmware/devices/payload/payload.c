@@ -26,7 +26,7 @@
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * \author João Cláudio Elsen Barcellos <joaoclaudiobarcellos@gmail.com>
  * 
- * \version 0.9.9
+ * \version 0.10.15
  * 
  * \date 2021/08/15
  * 
@@ -705,4 +705,45 @@ int payload_get_data(payload_t pl, payload_data_id_t id, uint8_t *data, uint32_t
     return err;
 }
 
+int payload_get_data_stream(payload_t pl, payload_data_id_t id, uint8_t *chunk, uint16_t chunk_len, payload_stream_cb_t cb, void *arg, uint32_t *len)
+{
+    int err = -1;
+
+    *len = 0U;
+
+    if (id != PAYLOAD_EDC_ADC_SEQ)
+    {
+        sys_log_print_event_from_module(SYS_LOG_ERROR, PAYLOAD_MODULE_NAME, "Invalid data ID to stream!");
+        sys_log_new_line();
+    }
+    else
+    {
+        int16_t res = -1;
+
+        switch(pl)
+        {
+            case PAYLOAD_EDC_0:
+                res = edc_get_adc_seq_stream(edc_0_conf, chunk, chunk_len, cb, arg);
+                break;
+            case PAYLOAD_EDC_1:
+                res = edc_get_adc_seq_stream(edc_1_conf, chunk, chunk_len, cb, arg);
+                break;
+            default:
+                sys_log_print_event_from_module(SYS_LOG_ERROR, PAYLOAD_MODULE_NAME, "Invalid payload to stream data!");
+                sys_log_new_line();
+
+                break;
+        }
+
+        if (res > 0)
+        {
+            *len = (uint32_t)res;
+
+            err = 0;
+        }
+    }
+
+    return err;
+}
+
 /** \} End of payload group */
@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.9.7
+ * \version 0.10.15
  * 
  * \date 2021/08/15
  * 
@@ -63,9 +63,23 @@ typedef enum
     PAYLOAD_EDC_RAW_PTT,        /**< EDC raw PTT packet. */
     PAYLOAD_EDC_PTT,            /**< EDC PTT packet. */
     PAYLOAD_EDC_RAW_HK,         /**< EDC raw housekeeping. */
-    PAYLOAD_EDC_HK              /**< EDC housekeeping. */
+    PAYLOAD_EDC_HK,             /**< EDC housekeeping. */
+    PAYLOAD_EDC_ADC_SEQ         /**< EDC ADC sequence (stream only). */
 } payload_data_id_t;
 
+/**
+ * \brief Payload data stream callback (receives the consecutive chunks of the data).
+ *
+ * \param[in] data is the received chunk.
+ *
+ * \param[in] len is the number of bytes of the chunk.
+ *
+ * \param[in,out] arg is the argument given to payload_get_data_stream.
+ *
+ * \return The status/error code (any error aborts the stream).
+ */
+typedef int (*payload_stream_cb_t)(uint8_t *data, uint16_t len, void *arg);
+
 /**
  * \brief Payload command.
  */
@@ -173,6 +187,36 @@ int payload_write_cmd(payload_t pl, payload_cmd_t cmd);
  */
 int payload_get_data(payload_t pl, payload_data_id_t id, uint8_t *data, uint32_t *len);
 
+/**
+ * \brief Gets data from a given payload in chunks (for data too long to be stored in memory).
+ *
+ * \param[in] pl is the payload device. It can be:
+ * \parblock
+ *      -\b PAYLOAD_EDC_0
+ *      -\b PAYLOAD_EDC_1
+ *      .
+ * \endparblock
+ *
+ * \param[in] id is the data ID. It can be:
+ * \parblock
+ *      -\b PAYLOAD_EDC_ADC_SEQ
+ *      .
+ * \endparblock
+ *
+ * \param[in,out] chunk is a buffer to store each chunk.
+ *
+ * \param[in] chunk_len is the length of the chunks.
+ *
+ * \param[in] cb is the callback that receives each chunk.
+ *
+ * \param[in,out] arg is the argument of the callback.
+ *
+ * \param[in,out] len is the total number of bytes read.
+ *
+ * \return The status/error code.
+ */
+int payload_get_data_stream(payload_t pl, payload_data_id_t id, uint8_t *chunk, uint16_t chunk_len, payload_stream_cb_t cb, void *arg, uint32_t *len);
+
 #endif /* PAYLOAD_H_ */
 
 /** \} End of payload group */
@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.8.35
+ * \version 0.10.4
  * 
  * \date 2020/02/01
  * 
@@ -400,4 +400,32 @@ int ttc_leave_hibernation(ttc_e dev)
     return err;
 }
 
+int ttc_get_tx_fifo_pkts(ttc_e dev, uint8_t *pkts)
+{
+    int err = -1;
+
+    ttc_config_t ttc_config = {0};
+
+    switch(dev)
+    {
+        case TTC_0:     ttc_config = ttc_0_config;  err = 0;    break;
+        case TTC_1:     ttc_config = ttc_1_config;  err = 0;    break;
+        default:
+            sys_log_print_event_from_module(SYS_LOG_ERROR, TTC_MODULE_NAME, "Error reading the TX FIFO! Invalid device!");
+            sys_log_new_line();
+
+            break;
+    }
+
+    if (err == 0)
+    {
+        if ((sl_ttc2_check_device(ttc_config) != 0) || (sl_ttc2_read_fifo_pkts(ttc_config, SL_TTC2_TX_PKT, pkts) != 0))
+        {
+            err = -1;
+        }
+    }
+
+    return err;
+}
+
 /** \} End of ttc group */
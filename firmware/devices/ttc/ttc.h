@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.8.35
+ * \version 0.10.4
  * 
  * \date 2020/02/01
  * 
@@ -208,6 +208,25 @@ int ttc_enter_hibernation(ttc_e dev);
  */
 int ttc_leave_hibernation(ttc_e dev);
 
+/**
+ * \brief Gets the number of packets waiting in the TX FIFO of the TTC device.
+ *
+ * The device is checked before reading the FIFO, so a successful return also means that
+ * the device is present and answering.
+ *
+ * \param[in] dev is the TTC device to check. It can be:
+ * \parblock
+ *      -\b TTC_0
+ *      -\b TTC_1
+ *      .
+ * \endparblock
+ *
+ * \param[in,out] pkts is a pointer to store the number of packets in the TX FIFO.
+ *
+ * \return The status/error code.
+ */
+int ttc_get_tx_fifo_pkts(ttc_e dev, uint8_t *pkts);
+
 #endif /* TTC_H_ */
 
 /** \} End of ttc group */
@@ -0,0 +1,270 @@
+/*
+ * ttc_link.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief TTC downlink layer implementation.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.4
+ *
+ * \date 2022/11/22
+ *
+ * \addtogroup ttc_link
+ * \{
+ */
+
+#include <stdbool.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <config/config.h>
+#include <system/sys_log/sys_log.h>
+
+#include "ttc_link.h"
+
+static ttc_link_stats_t ttc_link_stats = {0};
+
+static ttc_e ttc_link_next_dev = TTC_LINK_PRIMARY_DEV;
+
+static bool ttc_link_busy_logged = false;   /* The busy event of the bulk frame ttc_link_busy_seq was logged */
+static uint16_t ttc_link_busy_seq = 0U;
+
+/**
+ * \brief Gets the other radio of the pair.
+ *
+ * \param[in] dev is the TTC device.
+ *
+ * \return The other TTC device.
+ */
+static ttc_e ttc_link_other(ttc_e dev);
+
+/**
+ * \brief Checks if a radio can accept a new frame.
+ *
+ * \param[in] dev is the TTC device to check.
+ *
+ * \param[in,out] busy is set to TRUE if the TX FIFO of the device is full.
+ *
+ * \return TRUE/FALSE if the device is present and its TX FIFO has room for a new frame.
+ */
+static bool ttc_link_is_ready(ttc_e dev, bool *busy);
+
+/**
+ * \brief Transmits a frame by the first ready radio, starting from a given one.
+ *
+ * \param[in] first is the first radio to try.
+ *
+ * \param[in] data is the frame to transmit.
+ *
+ * \param[in] len is the number of bytes of the frame.
+ *
+ * \param[in,out] used is a pointer to store the radio that transmitted the frame.
+ *
+ * \param[in,out] busy is set to TRUE if the frame was not transmitted only because the TX FIFOs
+ * were full (normal backpressure, the caller can retry later).
+ *
+ * \return The status/error code.
+ */
+static int ttc_link_transmit(ttc_e first, uint8_t *data, uint16_t len, ttc_e *used, bool *busy);
+
+int ttc_link_send(uint8_t *data, uint16_t len)
+{
+    ttc_e used = TTC_LINK_PRIMARY_DEV;
+    bool busy = false;
+
+    int err = ttc_link_transmit(TTC_LINK_PRIMARY_DEV, data, len, &used, &busy);
+
+    if (busy)
+    {
+        sys_log_print_event_from_module(SYS_LOG_WARNING, TTC_LINK_MODULE_NAME, "Frame not sent! The TX FIFOs are full!");
+        sys_log_new_line();
+    }
+
+    return err;
+}
+
+int ttc_link_send_bulk(uint8_t *data, uint16_t len, uint16_t seq_pos)
+{
+    int err = -1;
+
+    if ((uint32_t)seq_pos + 2U <= (uint32_t)len)
+    {
+        ttc_e first = TTC_LINK_PRIMARY_DEV;
+        ttc_e used = TTC_LINK_PRIMARY_DEV;
+        bool busy = false;
+        bool log_busy = false;
+
+        taskENTER_CRITICAL();
+
+        uint16_t seq = ttc_link_stats.seq++;
+
+    #if defined(CONFIG_TTC_LINK_STRIPING_ENABLED) && (CONFIG_TTC_LINK_STRIPING_ENABLED == 1)
+        first = ttc_link_next_dev;
+    #endif /* CONFIG_TTC_LINK_STRIPING_ENABLED */
+
+        taskEXIT_CRITICAL();
+
+        data[seq_pos]       = (seq >> 8) & 0xFFU;
+        data[seq_pos + 1U]  = seq & 0xFFU;
+
+        err = ttc_link_transmit(first, data, len, &used, &busy);
+
+        taskENTER_CRITICAL();
+
+        if (err == 0)
+        {
+            ttc_link_next_dev = ttc_link_other(used);
+        }
+        else if (ttc_link_stats.seq == (uint16_t)(seq + 1U))
+        {
+            /* Releases the sequence number (the ground station would count the gap as a lost frame) */
+            ttc_link_stats.seq = seq;
+        }
+        else
+        {
+            /* Another frame took the next sequence number in the meantime */
+        }
+
+        /* The retries of a frame reuse its sequence number: only the first busy event is logged */
+        if (busy && !(ttc_link_busy_logged && (ttc_link_busy_seq == seq)))
+        {
+            ttc_link_busy_logged = true;
+            ttc_link_busy_seq = seq;
+
+            log_busy = true;
+        }
+
+        taskEXIT_CRITICAL();
+
+        if (log_busy)
+        {
+            sys_log_print_event_from_module(SYS_LOG_WARNING, TTC_LINK_MODULE_NAME, "Bulk frame not sent yet! The TX FIFOs are full!");
+            sys_log_new_line();
+        }
+    }
+    else
+    {
+        sys_log_print_event_from_module(SYS_LOG_ERROR, TTC_LINK_MODULE_NAME, "Error sending a bulk frame! Invalid sequence number position!");
+        sys_log_new_line();
+    }
+
+    return err;
+}
+
+void ttc_link_get_stats(ttc_link_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+
+    *stats = ttc_link_stats;
+
+    taskEXIT_CRITICAL();
+}
+
+static ttc_e ttc_link_other(ttc_e dev)
+{
+    return (dev == TTC_0) ? TTC_1 : TTC_0;
+}
+
+static bool ttc_link_is_ready(ttc_e dev, bool *busy)
+{
+    bool res = false;
+    uint8_t pkts = UINT8_MAX;
+
+    if (ttc_get_tx_fifo_pkts(dev, &pkts) == 0)
+    {
+        if (pkts < CONFIG_TTC_LINK_TX_FIFO_MAX_PKTS)
+        {
+            res = true;
+        }
+        else
+        {
+            *busy = true;
+        }
+    }
+
+    return res;
+}
+
+static int ttc_link_transmit(ttc_e first, uint8_t *data, uint16_t len, ttc_e *used, bool *busy)
+{
+    int err = -1;
+
+    bool full = false;      /* At least one radio has a full TX FIFO */
+    bool failed = false;    /* At least one transmission failed */
+
+    ttc_e dev = first;
+
+    uint8_t i = 0;
+    for(i = 0; i < 2U; i++)
+    {
+        if (ttc_link_is_ready(dev, &full))
+        {
+            if (ttc_send(dev, data, len) == 0)
+            {
+                *used = dev;
+                err = 0;
+
+                break;
+            }
+
+            failed = true;
+        }
+
+        dev = ttc_link_other(dev);
+    }
+
+    *busy = (err != 0) && full && !failed;
+
+    taskENTER_CRITICAL();
+
+    if (err == 0)
+    {
+        ttc_link_stats.tx_pkts[dev]++;
+
+        if (i > 0U)
+        {
+            ttc_link_stats.failovers++;
+        }
+    }
+    else if (*busy)
+    {
+        ttc_link_stats.busy++;
+    }
+    else
+    {
+        ttc_link_stats.errors++;
+    }
+
+    taskEXIT_CRITICAL();
+
+    if ((err != 0) && !*busy)
+    {
+        sys_log_print_event_from_module(SYS_LOG_ERROR, TTC_LINK_MODULE_NAME, "Error sending a frame! No radio available!");
+        sys_log_new_line();
+    }
+
+    return err;
+}
+
+/** \} End of ttc_link group */
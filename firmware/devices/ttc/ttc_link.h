@@ -0,0 +1,110 @@
+/*
+ * ttc_link.h
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief TTC downlink layer definition.
+ *
+ * Selects which radio transmits each downlink frame. Single frames go through the primary
+ * radio and fail over to the other one when it is not ready. Bulk frames receive a sequence
+ * number and are striped across both radios while both are healthy, so the ground station
+ * can reassemble them in order.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.4
+ *
+ * \date 2022/11/22
+ *
+ * \defgroup ttc_link TTC Link
+ * \ingroup ttc
+ * \{
+ */
+
+#ifndef TTC_LINK_H_
+#define TTC_LINK_H_
+
+#include <stdint.h>
+
+#include "ttc.h"
+
+#define TTC_LINK_MODULE_NAME        "TTC Link"
+
+#define TTC_LINK_PRIMARY_DEV        TTC_1       /**< Radio used for single frames when it is ready. */
+
+/**
+ * \brief Downlink statistics.
+ */
+typedef struct
+{
+    uint32_t tx_pkts[2];            /**< Transmitted frames per radio (TTC_0 and TTC_1). */
+    uint32_t failovers;             /**< Frames transmitted by the secondary choice of radio. */
+    uint32_t busy;                  /**< Frames not transmitted because the TX FIFOs were full (retried later). */
+    uint32_t errors;                /**< Frames not transmitted by any radio (no radio detected or transmission failures). */
+    uint16_t seq;                   /**< Next bulk sequence number. */
+} ttc_link_stats_t;
+
+/**
+ * \brief Transmits a single downlink frame.
+ *
+ * The frame is transmitted by the primary radio, or by the other radio if the primary one is
+ * not detected, its TX FIFO is full or the transmission fails.
+ *
+ * \param[in] data is the frame to transmit.
+ *
+ * \param[in] len is the number of bytes of the frame.
+ *
+ * \return The status/error code.
+ */
+int ttc_link_send(uint8_t *data, uint16_t len);
+
+/**
+ * \brief Transmits a bulk downlink frame.
+ *
+ * A 16-bit sequence number (big-endian) is written into the frame at the given position
+ * before the transmission. Consecutive bulk frames alternate between the radios when both
+ * are ready, and fall back to the remaining radio otherwise.
+ *
+ * The sequence number is only consumed when the frame is transmitted, so a frame that is
+ * retried (e.g. while the TX FIFOs are full) keeps the same number and no gap is left.
+ *
+ * \param[in,out] data is the frame to transmit.
+ *
+ * \param[in] len is the number of bytes of the frame.
+ *
+ * \param[in] seq_pos is the position of the sequence number in the frame.
+ *
+ * \return The status/error code.
+ */
+int ttc_link_send_bulk(uint8_t *data, uint16_t len, uint16_t seq_pos);
+
+/**
+ * \brief Gets the downlink statistics.
+ *
+ * \param[in,out] stats is a pointer to store the statistics.
+ *
+ * \return None.
+ */
+void ttc_link_get_stats(ttc_link_stats_t *stats);
+
+#endif /* TTC_LINK_H_ */
+
+/** \} End of ttc_link group */
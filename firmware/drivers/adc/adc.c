@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.8.5
+ * \version 0.10.18
  * 
  * \date 2020/03/03
  * 
@@ -34,6 +34,10 @@
  */
 
 #include <stdbool.h>
+#include <stddef.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
 
 #include <hal/gpio.h>
 #include <hal/adc10_a.h>
@@ -46,9 +50,23 @@
 
 #include "adc.h"
 
+#define ADC_SEQ_FIRST_MEM       ADC12_A_MEMORY_5    /**< First memory buffer of the sequence scan. */
+#define ADC_SEQ_LAST_IE         ADC12_A_IE7         /**< Interrupt of the last memory buffer of the sequence scan. */
+
 static float adc_mref = 0.0;
 static float adc_nref = 0.0;
 
+static volatile uint32_t adc_seq_acc[ADC_SEQ_LEN] = {0UL};  /**< Sum of the samples of each channel of the sequence. */
+static volatile uint16_t adc_seq_samples = 0U;              /**< Number of complete sequences converted. */
+static TaskHandle_t adc_seq_waiting_task = NULL;
+
+/**
+ * \brief Waits the ADC core to finish an ongoing conversion.
+ *
+ * \return TRUE/FALSE if the ADC core is idle or not (timeout).
+ */
+static bool adc_wait_idle(void);
+
 int adc_init(void)
 {
     static bool adc_is_ready = false;
@@ -64,7 +82,8 @@ int adc_init(void)
 
         ADC12_A_enable(ADC12_A_BASE);
 
-        ADC12_A_setupSamplingTimer(ADC12_A_BASE, ADC12_A_CYCLEHOLD_768_CYCLES, ADC12_A_CYCLEHOLD_4_CYCLES, ADC12_A_MULTIPLESAMPLESDISABLE);
+        /* Multiple samples: the sequence scan runs from a single trigger */
+        ADC12_A_setupSamplingTimer(ADC12_A_BASE, ADC12_A_CYCLEHOLD_768_CYCLES, ADC12_A_CYCLEHOLD_4_CYCLES, ADC12_A_MULTIPLESAMPLESENABLE);
 
         /* Temperature sensor */
         ADC12_A_configureMemoryParam param = {0};
@@ -122,7 +141,33 @@ int adc_init(void)
 
         ADC12_A_configureMemory(ADC12_A_BASE, &param);
 
-        ADC12_A_clearInterrupt(ADC12_A_BASE, ADC12_A_IFG0 | ADC12_A_IFG8 | ADC12_A_IFG9 | ADC12_A_IFG10 | ADC12_A_IFG11 | ADC12_A_IFG12);
+        /* Sequence scan: current sensor, voltage sensor and temperature sensor (MEM5 to MEM7) */
+        /* The low memory buffers are used to have the same (long) sampling time in all the channels */
+        param.memoryBufferControlIndex          = ADC12_A_MEMORY_5;
+        param.inputSourceSelect                 = ADC12_A_INPUT_A3;
+        param.positiveRefVoltageSourceSelect    = ADC12_A_VREFPOS_EXT;
+        param.negativeRefVoltageSourceSelect    = ADC12_A_VREFNEG_AVSS;
+        param.endOfSequence                     = ADC12_A_NOTENDOFSEQUENCE;
+
+        ADC12_A_configureMemory(ADC12_A_BASE, &param);
+
+        param.memoryBufferControlIndex          = ADC12_A_MEMORY_6;
+        param.inputSourceSelect                 = ADC12_A_INPUT_A4;
+        param.positiveRefVoltageSourceSelect    = ADC12_A_VREFPOS_EXT;
+        param.negativeRefVoltageSourceSelect    = ADC12_A_VREFNEG_AVSS;
+        param.endOfSequence                     = ADC12_A_NOTENDOFSEQUENCE;
+
+        ADC12_A_configureMemory(ADC12_A_BASE, &param);
+
+        param.memoryBufferControlIndex          = ADC12_A_MEMORY_7;
+        param.inputSourceSelect                 = ADC12_A_INPUT_TEMPSENSOR;
+        param.positiveRefVoltageSourceSelect    = ADC12_A_VREFPOS_INT;
+        param.negativeRefVoltageSourceSelect    = ADC12_A_VREFNEG_AVSS;
+        param.endOfSequence                     = ADC12_A_ENDOFSEQUENCE;
+
+        ADC12_A_configureMemory(ADC12_A_BASE, &param);
+
+        ADC12_A_clearInterrupt(ADC12_A_BASE, ADC12_A_IFG0 | ADC12_A_IFG5 | ADC12_A_IFG6 | ADC12_A_IFG7 | ADC12_A_IFG8 | ADC12_A_IFG9 | ADC12_A_IFG10 | ADC12_A_IFG11 | ADC12_A_IFG12);
 
         uint8_t i = 0;
         for(i = 0; i < ADC_TIMEOUT_MS; i++)
@@ -164,388 +209,176 @@ int adc_init(void)
 
 int adc_read(adc_port_t port, uint16_t *val)
 {
-    uint8_t i = 0;
-    for(i=0; i<ADC_TIMEOUT_MS; i++)
-    {
-        if (!ADC12_A_isBusy(ADC12_A_BASE))
-        {
-            break;
-        }
-
-        adc_delay_ms(1);
-    }
-
     int err = -1;
 
     *val = UINT16_MAX;
 
-    if (i != ADC_TIMEOUT_MS)
+    if (port > ADC_PORT_15)
     {
-        switch(port)
-        {
-            case ADC_PORT_0:
-                ADC12_A_startConversion(ADC12_A_BASE, ADC12_A_MEMORY_0, ADC12_A_SINGLECHANNEL);
-
-                for(i=0; i<ADC_TIMEOUT_MS; i++)
-                {
-                    if (ADC12_A_getInterruptStatus(ADC12_A_BASE, ADC12_A_IFG0) > 0)
-                    {
-                        break;
-                    }
-
-                    adc_delay_ms(1);
-                }
-
-                if (i != ADC_TIMEOUT_MS)
-                {
-                    *val = ADC12_A_getResults(ADC12_A_BASE, ADC12_A_MEMORY_0);
-
-                    err = 0;
-                }
-
-                break;
-            case ADC_PORT_1:
-                ADC12_A_startConversion(ADC12_A_BASE, ADC12_A_MEMORY_1, ADC12_A_SINGLECHANNEL);
-
-                for(i=0; i<ADC_TIMEOUT_MS; i++)
-                {
-                    if (ADC12_A_getInterruptStatus(ADC12_A_BASE, ADC12_A_IFG1) > 0)
-                    {
-                        break;
-                    }
-
-                    adc_delay_ms(1);
-                }
-
-                if (i != ADC_TIMEOUT_MS)
-                {
-                    *val = ADC12_A_getResults(ADC12_A_BASE, ADC12_A_MEMORY_1);
-
-                    err = 0;
-                }
-
-                break;
-            case ADC_PORT_2:
-                ADC12_A_startConversion(ADC12_A_BASE, ADC12_A_MEMORY_2, ADC12_A_SINGLECHANNEL);
-
-                for(i=0; i<ADC_TIMEOUT_MS; i++)
-                {
-                    if (ADC12_A_getInterruptStatus(ADC12_A_BASE, ADC12_A_IFG2) > 0)
-                    {
-                        break;
-                    }
-
-                    adc_delay_ms(1);
-                }
-
-                if (i != ADC_TIMEOUT_MS)
-                {
-                    *val = ADC12_A_getResults(ADC12_A_BASE, ADC12_A_MEMORY_2);
-
-                    err = 0;
-                }
-
-                break;
-            case ADC_PORT_3:
-                ADC12_A_startConversion(ADC12_A_BASE, ADC12_A_MEMORY_3, ADC12_A_SINGLECHANNEL);
-
-                for(i=0; i<ADC_TIMEOUT_MS; i++)
-                {
-                    if (ADC12_A_getInterruptStatus(ADC12_A_BASE, ADC12_A_IFG3) > 0)
-                    {
-                        break;
-                    }
-
-                    adc_delay_ms(1);
-                }
-
-                if (i != ADC_TIMEOUT_MS)
-                {
-                    *val = ADC12_A_getResults(ADC12_A_BASE, ADC12_A_MEMORY_3);
-
-                    err = 0;
-                }
-
-                break;
-            case ADC_PORT_4:
-                ADC12_A_startConversion(ADC12_A_BASE, ADC12_A_MEMORY_4, ADC12_A_SINGLECHANNEL);
-
-                for(i=0; i<ADC_TIMEOUT_MS; i++)
-                {
-                    if (ADC12_A_getInterruptStatus(ADC12_A_BASE, ADC12_A_IFG4) > 0)
-                    {
-                        break;
-                    }
-
-                    adc_delay_ms(1);
-                }
-
-                if (i != ADC_TIMEOUT_MS)
-                {
-                    *val = ADC12_A_getResults(ADC12_A_BASE, ADC12_A_MEMORY_4);
-
-                    err = 0;
-                }
-
-                break;
-            case ADC_PORT_5:
-                ADC12_A_startConversion(ADC12_A_BASE, ADC12_A_MEMORY_5, ADC12_A_SINGLECHANNEL);
-
-                for(i=0; i<ADC_TIMEOUT_MS; i++)
-                {
-                    if (ADC12_A_getInterruptStatus(ADC12_A_BASE, ADC12_A_IFG5) > 0)
-                    {
-                        break;
-                    }
-
-                    adc_delay_ms(1);
-                }
-
-                if (i != ADC_TIMEOUT_MS)
-                {
-                    *val = ADC12_A_getResults(ADC12_A_BASE, ADC12_A_MEMORY_5);
-
-                    err = 0;
-                }
-
-                break;
-            case ADC_PORT_6:
-                ADC12_A_startConversion(ADC12_A_BASE, ADC12_A_MEMORY_6, ADC12_A_SINGLECHANNEL);
-
-                for(i=0; i<ADC_TIMEOUT_MS; i++)
-                {
-                    if (ADC12_A_getInterruptStatus(ADC12_A_BASE, ADC12_A_IFG6) > 0)
-                    {
-                        break;
-                    }
-
-                    adc_delay_ms(1);
-                }
-
-                if (i != ADC_TIMEOUT_MS)
-                {
-                    *val = ADC12_A_getResults(ADC12_A_BASE, ADC12_A_MEMORY_6);
-
-                    err = 0;
-                }
-
-                break;
-            case ADC_PORT_7:
-                ADC12_A_startConversion(ADC12_A_BASE, ADC12_A_MEMORY_7, ADC12_A_SINGLECHANNEL);
-
-                for(i=0; i<ADC_TIMEOUT_MS; i++)
-                {
-                    if (ADC12_A_getInterruptStatus(ADC12_A_BASE, ADC12_A_IFG7) > 0)
-                    {
-                        break;
-                    }
-
-                    adc_delay_ms(1);
-                }
-
-                if (i != ADC_TIMEOUT_MS)
-                {
-                    *val = ADC12_A_getResults(ADC12_A_BASE, ADC12_A_MEMORY_7);
-
-                    err = 0;
-                }
-
-                break;
-            case ADC_PORT_8:
-                ADC12_A_startConversion(ADC12_A_BASE, ADC12_A_MEMORY_8, ADC12_A_SINGLECHANNEL);
-
-                for(i=0; i<ADC_TIMEOUT_MS; i++)
-                {
-                    if (ADC12_A_getInterruptStatus(ADC12_A_BASE, ADC12_A_IFG8) > 0)
-                    {
-                        break;
-                    }
-
-                    adc_delay_ms(1);
-                }
-
-                if (i != ADC_TIMEOUT_MS)
-                {
-                    *val = ADC12_A_getResults(ADC12_A_BASE, ADC12_A_MEMORY_8);
+    #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+        sys_log_print_event_from_module(SYS_LOG_ERROR, ADC_MODULE_NAME, "Error reading the ADC port ");
+        sys_log_print_uint(port);
+        sys_log_print_msg("! Invalid port!");
+        sys_log_new_line();
+    #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+    }
+    else if (adc_wait_idle())
+    {
+        /* Each port is converted in the memory buffer with the same index */
+        uint8_t mem = ADC12_A_MEMORY_0 + port;
+        uint16_t ifg = ADC12_A_IFG0 << port;
 
-                    err = 0;
-                }
+        ADC12_A_startConversion(ADC12_A_BASE, mem, ADC12_A_SINGLECHANNEL);
 
+        uint8_t i = 0;
+        for(i=0; i<ADC_TIMEOUT_MS; i++)
+        {
+            if (ADC12_A_getInterruptStatus(ADC12_A_BASE, ifg) > 0)
+            {
                 break;
-            case ADC_PORT_9:
-                ADC12_A_startConversion(ADC12_A_BASE, ADC12_A_MEMORY_9, ADC12_A_SINGLECHANNEL);
-
-                for(i=0; i<ADC_TIMEOUT_MS; i++)
-                {
-                    if (ADC12_A_getInterruptStatus(ADC12_A_BASE, ADC12_A_IFG9) > 0)
-                    {
-                        break;
-                    }
-
-                    adc_delay_ms(1);
-                }
-
-                if (i != ADC_TIMEOUT_MS)
-                {
-                    *val = ADC12_A_getResults(ADC12_A_BASE, ADC12_A_MEMORY_9);
+            }
 
-                    err = 0;
-                }
+            adc_delay_ms(1);
+        }
 
-                break;
-            case ADC_PORT_10:
-                ADC12_A_startConversion(ADC12_A_BASE, ADC12_A_MEMORY_10, ADC12_A_SINGLECHANNEL);
+        if (i != ADC_TIMEOUT_MS)
+        {
+            *val = ADC12_A_getResults(ADC12_A_BASE, mem);
 
-                for(i=0; i<ADC_TIMEOUT_MS; i++)
-                {
-                    if (ADC12_A_getInterruptStatus(ADC12_A_BASE, ADC12_A_IFG10) > 0)
-                    {
-                        break;
-                    }
+            ADC12_A_clearInterrupt(ADC12_A_BASE, ifg);
 
-                    adc_delay_ms(1);
-                }
+            err = 0;
+        }
+    }
+    else
+    {
+        /* Timeout waiting the ADC core */
+    }
 
-                if (i != ADC_TIMEOUT_MS)
-                {
-                    *val = ADC12_A_getResults(ADC12_A_BASE, ADC12_A_MEMORY_10);
+    return err;
+}
 
-                    err = 0;
-                }
+int adc_read_seq(uint16_t *vals)
+{
+    int err = -1;
 
-                break;
-            case ADC_PORT_11:
-                ADC12_A_startConversion(ADC12_A_BASE, ADC12_A_MEMORY_11, ADC12_A_SINGLECHANNEL);
+    /* The end of the scan is signaled to the calling task, so the scheduler must be running */
+    if ((xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) && adc_wait_idle())
+    {
+        uint8_t i = 0;
+        for(i = 0; i < ADC_SEQ_LEN; i++)
+        {
+            adc_seq_acc[i] = 0UL;
+        }
 
-                for(i=0; i<ADC_TIMEOUT_MS; i++)
-                {
-                    if (ADC12_A_getInterruptStatus(ADC12_A_BASE, ADC12_A_IFG11) > 0)
-                    {
-                        break;
-                    }
+        adc_seq_samples = 0U;
 
-                    adc_delay_ms(1);
-                }
+        adc_seq_waiting_task = xTaskGetCurrentTaskHandle();
 
-                if (i != ADC_TIMEOUT_MS)
-                {
-                    *val = ADC12_A_getResults(ADC12_A_BASE, ADC12_A_MEMORY_11);
+        /* Discard any pending notification */
+        (void)ulTaskNotifyTake(pdTRUE, 0);
 
-                    err = 0;
-                }
+        ADC12_A_clearInterrupt(ADC12_A_BASE, ADC12_A_IFG5 | ADC12_A_IFG6 | ADC12_A_IFG7);
 
-                break;
-            case ADC_PORT_12:
-                ADC12_A_startConversion(ADC12_A_BASE, ADC12_A_MEMORY_12, ADC12_A_SINGLECHANNEL);
+        ADC12_A_enableInterrupt(ADC12_A_BASE, ADC_SEQ_LAST_IE);
 
-                for(i=0; i<ADC_TIMEOUT_MS; i++)
-                {
-                    if (ADC12_A_getInterruptStatus(ADC12_A_BASE, ADC12_A_IFG12) > 0)
-                    {
-                        break;
-                    }
+        /* The sequence is repeated (without new triggers) until the ISR collects all the samples */
+        ADC12_A_startConversion(ADC12_A_BASE, ADC_SEQ_FIRST_MEM, ADC12_A_REPEATED_SEQOFCHANNELS);
 
-                    adc_delay_ms(1);
-                }
+        if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ADC_TIMEOUT_MS)) > 0U)
+        {
+            /* Decimation (rounded average of the samples) */
+            for(i = 0; i < ADC_SEQ_LEN; i++)
+            {
+                vals[i] = (uint16_t)((adc_seq_acc[i] + (CONFIG_ADC_OVERSAMPLING / 2U)) / CONFIG_ADC_OVERSAMPLING);
+            }
 
-                if (i != ADC_TIMEOUT_MS)
-                {
-                    *val = ADC12_A_getResults(ADC12_A_BASE, ADC12_A_MEMORY_12);
+            err = 0;
+        }
+        else
+        {
+            ADC12_A_disableInterrupt(ADC12_A_BASE, ADC_SEQ_LAST_IE);
 
-                    err = 0;
-                }
+            ADC12_A_disableConversions(ADC12_A_BASE, ADC12_A_PREEMPTCONVERSION);
 
-                break;
-            case ADC_PORT_13:
-                ADC12_A_startConversion(ADC12_A_BASE, ADC12_A_MEMORY_13, ADC12_A_SINGLECHANNEL);
+        #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+            sys_log_print_event_from_module(SYS_LOG_ERROR, ADC_MODULE_NAME, "Timeout waiting for the sequence scan!");
+            sys_log_new_line();
+        #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+        }
 
-                for(i=0; i<ADC_TIMEOUT_MS; i++)
-                {
-                    if (ADC12_A_getInterruptStatus(ADC12_A_BASE, ADC12_A_IFG13) > 0)
-                    {
-                        break;
-                    }
+        adc_seq_waiting_task = NULL;
+    }
 
-                    adc_delay_ms(1);
-                }
+    return err;
+}
 
-                if (i != ADC_TIMEOUT_MS)
-                {
-                    *val = ADC12_A_getResults(ADC12_A_BASE, ADC12_A_MEMORY_13);
+float adc_temp_get_mref(void)
+{
+    return adc_mref;
+}
 
-                    err = 0;
-                }
+float adc_temp_get_nref(void)
+{
+    return adc_nref;
+}
 
-                break;
-            case ADC_PORT_14:
-                ADC12_A_startConversion(ADC12_A_BASE, ADC12_A_MEMORY_14, ADC12_A_SINGLECHANNEL);
+static bool adc_wait_idle(void)
+{
+    uint8_t i = 0;
+    for(i=0; i<ADC_TIMEOUT_MS; i++)
+    {
+        if (!ADC12_A_isBusy(ADC12_A_BASE))
+        {
+            break;
+        }
 
-                for(i=0; i<ADC_TIMEOUT_MS; i++)
-                {
-                    if (ADC12_A_getInterruptStatus(ADC12_A_BASE, ADC12_A_IFG14) > 0)
-                    {
-                        break;
-                    }
+        adc_delay_ms(1);
+    }
 
-                    adc_delay_ms(1);
-                }
+    return i != ADC_TIMEOUT_MS;
+}
 
-                if (i != ADC_TIMEOUT_MS)
-                {
-                    *val = ADC12_A_getResults(ADC12_A_BASE, ADC12_A_MEMORY_14);
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector=ADC12_VECTOR
+__interrupt
+#elif defined(__GNUC__)
+__attribute__((interrupt(ADC12_VECTOR)))
+#endif
+void ADC12_ISR(void)    // cppcheck-suppress misra-c2012-8.4
+{
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    uint8_t i = 0;
 
-                    err = 0;
-                }
+    switch(__even_in_range(ADC12IV, 34))
+    {
+        case 20:            /* ADC12IFG7: end of the sequence */
+            /* Reading the memory buffers also clears their flags */
+            for(i = 0; i < ADC_SEQ_LEN; i++)
+            {
+                adc_seq_acc[i] += ADC12_A_getResults(ADC12_A_BASE, ADC_SEQ_FIRST_MEM + i);
+            }
 
-                break;
-            case ADC_PORT_15:
-                ADC12_A_startConversion(ADC12_A_BASE, ADC12_A_MEMORY_15, ADC12_A_SINGLECHANNEL);
+            adc_seq_samples++;
 
-                for(i=0; i<ADC_TIMEOUT_MS; i++)
-                {
-                    if (ADC12_A_getInterruptStatus(ADC12_A_BASE, ADC12_A_IFG15) > 0)
-                    {
-                        break;
-                    }
+            if (adc_seq_samples >= CONFIG_ADC_OVERSAMPLING)
+            {
+                /* Stops the repeated sequence (the ongoing conversion is discarded) */
+                ADC12_A_disableConversions(ADC12_A_BASE, ADC12_A_PREEMPTCONVERSION);
 
-                    adc_delay_ms(1);
-                }
+                ADC12_A_disableInterrupt(ADC12_A_BASE, ADC_SEQ_LAST_IE);
 
-                if (i != ADC_TIMEOUT_MS)
+                if (adc_seq_waiting_task != NULL)
                 {
-                    *val = ADC12_A_getResults(ADC12_A_BASE, ADC12_A_MEMORY_15);
-
-                    err = 0;
+                    vTaskNotifyGiveFromISR(adc_seq_waiting_task, &higher_priority_task_woken);
                 }
+            }
 
-                break;
-            default:
-            #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
-                sys_log_print_event_from_module(SYS_LOG_ERROR, ADC_MODULE_NAME, "Error reading the ADC port ");
-                sys_log_print_uint(port);
-                sys_log_print_msg("! Invalid port!");
-                sys_log_new_line();
-            #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
-                break;
-        }
-
-        if (err == 0)
-        {
-            ADC12_A_clearInterrupt(ADC12_A_BASE, ADC12_A_IFG0 | ADC12_A_IFG8 | ADC12_A_IFG9);
-        }
+            break;
+        default:    break;
     }
 
-    return err;
-}
-
-float adc_temp_get_mref(void)
-{
-    return adc_mref;
-}
-
-float adc_temp_get_nref(void)
-{
-    return adc_nref;
+    portYIELD_FROM_ISR(higher_priority_task_woken);
 }
 
 /** \} End of adc group */
@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.7.28
+ * \version 0.10.18
  * 
  * \date 2020/03/03
  * 
@@ -47,6 +47,8 @@
 
 #define ADC_TIMEOUT_MS      100U        /**< Timeout in milliseconds. */
 
+#define ADC_SEQ_LEN         3U          /**< Number of channels of the sequence scan. */
+
 /**
  * \brief ADC ports.
  */
@@ -70,6 +72,16 @@ typedef enum
     ADC_PORT_15         /**< ADC port 15 (12-bits). */
 } adc_port_e;
 
+/**
+ * \brief Channels of the sequence scan (order of the values read with adc_read_seq).
+ */
+typedef enum
+{
+    ADC_SEQ_CH_CURRENT=0,   /**< Current sensor (same input of ADC_PORT_8). */
+    ADC_SEQ_CH_VOLTAGE,     /**< Voltage sensor (same input of ADC_PORT_9). */
+    ADC_SEQ_CH_TEMP         /**< Internal temperature sensor (same input of ADC_PORT_0). */
+} adc_seq_ch_e;
+
 /**
  * \brief ADC peripheral configuration parameters.
  */
@@ -122,6 +134,20 @@ int adc_init(void);
  */
 int adc_read(adc_port_t port, uint16_t *val);
 
+/**
+ * \brief Reads all the channels of the sequence scan at once.
+ *
+ * The channels are converted in a single burst, repeated CONFIG_ADC_OVERSAMPLING times without new
+ * triggers. The samples are accumulated in the ADC interrupt and averaged at the end, so the calling
+ * task is blocked (and woken up only once) until the last sample is available. It can only be used
+ * with the scheduler running.
+ *
+ * \param[in,out] vals is an array of ADC_SEQ_LEN positions to store the read values (in the order of adc_seq_ch_e).
+ *
+ * \return The status/error code.
+ */
+int adc_read_seq(uint16_t *vals);
+
 /**
  * \brief Gets the mref value used to calibrate the sensor temperature.
  *
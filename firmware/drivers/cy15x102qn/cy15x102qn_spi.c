@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.7.29
+ * \version 0.10.17
  * 
  * \date 2021/06/04
  * 
@@ -46,7 +46,7 @@ int cy15x102qn_spi_init(cy15x102qn_config_t *conf)
     spi_conf.speed_hz   = conf->clock_hz;
     spi_conf.mode       = CY15X102QN_SPI_MODE;
 
-    return spi_init(conf->port, spi_conf);
+    return spi_init_device(conf->port, conf->cs_pin, spi_conf);
 }
 
 int cy15x102qn_spi_write(cy15x102qn_config_t *conf, uint8_t *data, uint16_t len)
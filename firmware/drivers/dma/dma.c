@@ -0,0 +1,359 @@
+/*
+ * dma.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief DMA driver implementation.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.8
+ *
+ * \date 2022/11/26
+ *
+ * \addtogroup dma
+ * \{
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <hal/dma.h>
+#include <hal/usci_a_spi.h>
+#include <hal/usci_b_spi.h>
+
+#include <config/config.h>
+#include <system/sys_log/sys_log.h>
+
+#include "dma.h"
+
+/* Trigger sources of the MSP430F6659 (see the DMA trigger assignments table of the datasheet) */
+#define DMA_TRIGGER_UCA2RXIFG       DMA_TRIGGERSOURCE_12
+#define DMA_TRIGGER_UCA2TXIFG       DMA_TRIGGERSOURCE_13
+#define DMA_TRIGGER_UCB2RXIFG       DMA_TRIGGERSOURCE_14
+#define DMA_TRIGGER_UCB2TXIFG       DMA_TRIGGERSOURCE_15
+#define DMA_TRIGGER_UCA0RXIFG       DMA_TRIGGERSOURCE_16
+#define DMA_TRIGGER_UCA0TXIFG       DMA_TRIGGERSOURCE_17
+#define DMA_TRIGGER_UCB0RXIFG       DMA_TRIGGERSOURCE_18
+#define DMA_TRIGGER_UCB0TXIFG       DMA_TRIGGERSOURCE_19
+#define DMA_TRIGGER_UCA1RXIFG       DMA_TRIGGERSOURCE_20
+#define DMA_TRIGGER_UCA1TXIFG       DMA_TRIGGERSOURCE_21
+#define DMA_TRIGGER_UCB1RXIFG       DMA_TRIGGERSOURCE_22
+#define DMA_TRIGGER_UCB1TXIFG       DMA_TRIGGERSOURCE_23
+
+static dma_callback_t dma_callbacks[DMA_CH_NONE] = {NULL};
+
+/**
+ * \brief Configures a channel to transfer bytes between a peripheral buffer and memory.
+ *
+ * \param[in] ch is the DMA channel.
+ *
+ * \param[in] trigger is the trigger source.
+ *
+ * \param[in] src is the source address.
+ *
+ * \param[in] src_dir is the source address direction (DMA_DIRECTION_*).
+ *
+ * \param[in] dst is the destination address.
+ *
+ * \param[in] dst_dir is the destination address direction (DMA_DIRECTION_*).
+ *
+ * \param[in] len is the number of bytes to transfer.
+ *
+ * \param[in] cb is the transfer complete callback.
+ *
+ * \return The status/error code.
+ */
+static int dma_config(dma_ch_t ch, uint8_t trigger, uint32_t src, uint16_t src_dir, uint32_t dst, uint16_t dst_dir, uint16_t len, dma_callback_t cb);
+
+/**
+ * \brief Gets the HAL channel selection value of a channel.
+ *
+ * \param[in] ch is the DMA channel.
+ *
+ * \return The HAL channel selection value (DMA_CHANNEL_x).
+ */
+static uint8_t dma_get_channel(dma_ch_t ch);
+
+/**
+ * \brief Gets the base address of the USCI module of a peripheral.
+ *
+ * \param[in] periph is the peripheral.
+ *
+ * \return The base address of the USCI module.
+ */
+static uint16_t dma_get_base_address(dma_periph_t periph);
+
+int dma_config_rx(dma_ch_t ch, dma_periph_t periph, uint8_t *dst, bool inc, uint16_t len, dma_callback_t cb)
+{
+    int err = 0;
+
+    uint8_t trigger = 0;
+    uint32_t rxbuf = 0;
+    uint16_t base_address = dma_get_base_address(periph);
+
+    switch(periph)
+    {
+        case DMA_PERIPH_USCI_A0:    trigger = DMA_TRIGGER_UCA0RXIFG;   break;
+        case DMA_PERIPH_USCI_A1:    trigger = DMA_TRIGGER_UCA1RXIFG;   break;
+        case DMA_PERIPH_USCI_A2:    trigger = DMA_TRIGGER_UCA2RXIFG;   break;
+        case DMA_PERIPH_USCI_B0:    trigger = DMA_TRIGGER_UCB0RXIFG;   break;
+        case DMA_PERIPH_USCI_B1:    trigger = DMA_TRIGGER_UCB1RXIFG;   break;
+        case DMA_PERIPH_USCI_B2:    trigger = DMA_TRIGGER_UCB2RXIFG;   break;
+        default:
+        #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+            sys_log_print_event_from_module(SYS_LOG_ERROR, DMA_MODULE_NAME, "Error configuring a RX channel: Invalid peripheral!");
+            sys_log_new_line();
+        #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+            err = -1;   /* Invalid peripheral */
+
+            break;
+    }
+
+    if (err == 0)
+    {
+        if (periph <= DMA_PERIPH_USCI_A2)
+        {
+            rxbuf = USCI_A_SPI_getReceiveBufferAddressForDMA(base_address);
+        }
+        else
+        {
+            rxbuf = USCI_B_SPI_getReceiveBufferAddressForDMA(base_address);
+        }
+
+        err = dma_config(ch, trigger, rxbuf, DMA_DIRECTION_UNCHANGED, (uint32_t)(uintptr_t)dst, inc ? DMA_DIRECTION_INCREMENT : DMA_DIRECTION_UNCHANGED, len, cb);
+    }
+
+    return err;
+}
+
+int dma_config_tx(dma_ch_t ch, dma_periph_t periph, uint8_t *src, bool inc, uint16_t len, dma_callback_t cb)
+{
+    int err = 0;
+
+    uint8_t trigger = 0;
+    uint32_t txbuf = 0;
+    uint16_t base_address = dma_get_base_address(periph);
+
+    switch(periph)
+    {
+        case DMA_PERIPH_USCI_A0:    trigger = DMA_TRIGGER_UCA0TXIFG;   break;
+        case DMA_PERIPH_USCI_A1:    trigger = DMA_TRIGGER_UCA1TXIFG;   break;
+        case DMA_PERIPH_USCI_A2:    trigger = DMA_TRIGGER_UCA2TXIFG;   break;
+        case DMA_PERIPH_USCI_B0:    trigger = DMA_TRIGGER_UCB0TXIFG;   break;
+        case DMA_PERIPH_USCI_B1:    trigger = DMA_TRIGGER_UCB1TXIFG;   break;
+        case DMA_PERIPH_USCI_B2:    trigger = DMA_TRIGGER_UCB2TXIFG;   break;
+        default:
+        #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+            sys_log_print_event_from_module(SYS_LOG_ERROR, DMA_MODULE_NAME, "Error configuring a TX channel: Invalid peripheral!");
+            sys_log_new_line();
+        #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+            err = -1;   /* Invalid peripheral */
+
+            break;
+    }
+
+    if (err == 0)
+    {
+        if (periph <= DMA_PERIPH_USCI_A2)
+        {
+            txbuf = USCI_A_SPI_getTransmitBufferAddressForDMA(base_address);
+        }
+        else
+        {
+            txbuf = USCI_B_SPI_getTransmitBufferAddressForDMA(base_address);
+        }
+
+        err = dma_config(ch, trigger, (uint32_t)(uintptr_t)src, inc ? DMA_DIRECTION_INCREMENT : DMA_DIRECTION_UNCHANGED, txbuf, DMA_DIRECTION_UNCHANGED, len, cb);
+    }
+
+    return err;
+}
+
+int dma_start_tx(dma_periph_t periph)
+{
+    int err = 0;
+
+    uint16_t base_address = dma_get_base_address(periph);
+
+    switch(periph)
+    {
+        case DMA_PERIPH_USCI_A0:
+        case DMA_PERIPH_USCI_A1:
+        case DMA_PERIPH_USCI_A2:
+            /* Rising edge on UCTXIFG */
+            USCI_A_SPI_clearInterrupt(base_address, USCI_A_SPI_TRANSMIT_INTERRUPT);
+            HWREG8(base_address + OFS_UCAxIFG) |= UCTXIFG;
+            break;
+        case DMA_PERIPH_USCI_B0:
+        case DMA_PERIPH_USCI_B1:
+        case DMA_PERIPH_USCI_B2:
+            /* Rising edge on UCTXIFG */
+            USCI_B_SPI_clearInterrupt(base_address, USCI_B_SPI_TRANSMIT_INTERRUPT);
+            HWREG8(base_address + OFS_UCBxIFG) |= UCTXIFG;
+            break;
+        default:
+            err = -1;   /* Invalid peripheral */
+
+            break;
+    }
+
+    return err;
+}
+
+int dma_stop(dma_ch_t ch)
+{
+    int err = -1;
+
+    if (ch < DMA_CH_NONE)
+    {
+        DMA_disableInterrupt(dma_get_channel(ch));
+        DMA_disableTransfers(dma_get_channel(ch));
+        DMA_clearInterrupt(dma_get_channel(ch));
+
+        dma_callbacks[ch] = NULL;
+
+        err = 0;
+    }
+
+    return err;
+}
+
+static int dma_config(dma_ch_t ch, uint8_t trigger, uint32_t src, uint16_t src_dir, uint32_t dst, uint16_t dst_dir, uint16_t len, dma_callback_t cb)
+{
+    int err = -1;
+
+    if ((ch < DMA_CH_NONE) && (len > 0U))
+    {
+        uint8_t channel = dma_get_channel(ch);
+
+        DMA_disableTransfers(channel);
+
+        DMA_initParam param = {0};
+
+        param.channelSelect         = channel;
+        param.transferModeSelect    = DMA_TRANSFER_SINGLE;
+        param.transferSize          = len;
+        param.triggerSourceSelect   = trigger;
+        param.transferUnitSelect    = DMA_SIZE_SRCBYTE_DSTBYTE;
+        param.triggerTypeSelect     = DMA_TRIGGER_RISINGEDGE;
+
+        DMA_init(&param);
+
+        DMA_setSrcAddress(channel, src, src_dir);
+        DMA_setDstAddress(channel, dst, dst_dir);
+
+        dma_callbacks[ch] = cb;
+
+        DMA_clearInterrupt(channel);
+
+        if (cb != NULL)
+        {
+            DMA_enableInterrupt(channel);
+        }
+        else
+        {
+            DMA_disableInterrupt(channel);
+        }
+
+        DMA_enableTransfers(channel);
+
+        err = 0;
+    }
+    else
+    {
+    #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+        sys_log_print_event_from_module(SYS_LOG_ERROR, DMA_MODULE_NAME, "Error configuring a channel: Invalid channel or length!");
+        sys_log_new_line();
+    #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+    }
+
+    return err;
+}
+
+static uint8_t dma_get_channel(dma_ch_t ch)
+{
+    uint8_t channel = DMA_CHANNEL_0;
+
+    switch(ch)
+    {
+        case DMA_CH_0:  channel = DMA_CHANNEL_0;    break;
+        case DMA_CH_1:  channel = DMA_CHANNEL_1;    break;
+        case DMA_CH_2:  channel = DMA_CHANNEL_2;    break;
+        case DMA_CH_3:  channel = DMA_CHANNEL_3;    break;
+        case DMA_CH_4:  channel = DMA_CHANNEL_4;    break;
+        case DMA_CH_5:  channel = DMA_CHANNEL_5;    break;
+        default:                                    break;
+    }
+
+    return channel;
+}
+
+static uint16_t dma_get_base_address(dma_periph_t periph)
+{
+    uint16_t base_address = 0;
+
+    switch(periph)
+    {
+        case DMA_PERIPH_USCI_A0:    base_address = USCI_A0_BASE;    break;
+        case DMA_PERIPH_USCI_A1:    base_address = USCI_A1_BASE;    break;
+        case DMA_PERIPH_USCI_A2:    base_address = USCI_A2_BASE;    break;
+        case DMA_PERIPH_USCI_B0:    base_address = USCI_B0_BASE;    break;
+        case DMA_PERIPH_USCI_B1:    base_address = USCI_B1_BASE;    break;
+        case DMA_PERIPH_USCI_B2:    base_address = USCI_B2_BASE;    break;
+        default:                                                    break;
+    }
+
+    return base_address;
+}
+
+/* Interrupt Service Routine */
+
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector=DMA_VECTOR
+__interrupt
+#elif defined(__GNUC__)
+__attribute__((interrupt(DMA_VECTOR)))
+#endif
+void DMA_ISR(void)      // cppcheck-suppress misra-c2012-8.4
+{
+    dma_ch_t ch = DMA_CH_NONE;
+
+    /* Reading DMAIV clears the pending flag with the highest priority */
+    switch(__even_in_range(DMAIV, 16))
+    {
+        case 0:     break;                  /* No interrupts */
+        case 2:     ch = DMA_CH_0;  break;  /* DMA0IFG */
+        case 4:     ch = DMA_CH_1;  break;  /* DMA1IFG */
+        case 6:     ch = DMA_CH_2;  break;  /* DMA2IFG */
+        case 8:     ch = DMA_CH_3;  break;  /* DMA3IFG */
+        case 10:    ch = DMA_CH_4;  break;  /* DMA4IFG */
+        case 12:    ch = DMA_CH_5;  break;  /* DMA5IFG */
+        default:    break;
+    }
+
+    if ((ch != DMA_CH_NONE) && (dma_callbacks[ch] != NULL))
+    {
+        dma_callbacks[ch](ch);
+    }
+}
+
+/** \} End of dma group */
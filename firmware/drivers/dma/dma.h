@@ -0,0 +1,144 @@
+/*
+ * dma.h
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief DMA driver definition.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.8
+ *
+ * \date 2022/11/26
+ *
+ * \defgroup dma DMA
+ * \ingroup drivers
+ * \{
+ */
+
+#ifndef DMA_H_
+#define DMA_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define DMA_MODULE_NAME         "DMA"
+
+/**
+ * \brief DMA channels.
+ *
+ * The lower the channel number, the higher its priority.
+ */
+typedef enum
+{
+    DMA_CH_0=0,         /**< DMA channel 0. */
+    DMA_CH_1,           /**< DMA channel 1. */
+    DMA_CH_2,           /**< DMA channel 2. */
+    DMA_CH_3,           /**< DMA channel 3. */
+    DMA_CH_4,           /**< DMA channel 4. */
+    DMA_CH_5,           /**< DMA channel 5. */
+    DMA_CH_NONE         /**< No DMA channel. */
+} dma_ch_t;
+
+/**
+ * \brief Peripherals that can trigger DMA transfers.
+ */
+typedef enum
+{
+    DMA_PERIPH_USCI_A0=0,   /**< USCI_A0 (RXBUF/TXBUF). */
+    DMA_PERIPH_USCI_A1,     /**< USCI_A1 (RXBUF/TXBUF). */
+    DMA_PERIPH_USCI_A2,     /**< USCI_A2 (RXBUF/TXBUF). */
+    DMA_PERIPH_USCI_B0,     /**< USCI_B0 (RXBUF/TXBUF). */
+    DMA_PERIPH_USCI_B1,     /**< USCI_B1 (RXBUF/TXBUF). */
+    DMA_PERIPH_USCI_B2      /**< USCI_B2 (RXBUF/TXBUF). */
+} dma_periph_t;
+
+/**
+ * \brief Transfer complete callback (called from the DMA ISR).
+ */
+typedef void (*dma_callback_t)(dma_ch_t ch);
+
+/**
+ * \brief Configures a channel to move bytes from the RX buffer of a peripheral to memory.
+ *
+ * The channel is triggered by the RX flag of the peripheral, one byte per trigger.
+ *
+ * \param[in] ch is the DMA channel.
+ *
+ * \param[in] periph is the source peripheral.
+ *
+ * \param[in,out] dst is the destination memory.
+ *
+ * \param[in] inc is TRUE/FALSE to increment or not the destination address after each byte.
+ *
+ * \param[in] len is the number of bytes to transfer.
+ *
+ * \param[in] cb is the transfer complete callback (NULL to disable the channel interrupt).
+ *
+ * \return The status/error code.
+ */
+int dma_config_rx(dma_ch_t ch, dma_periph_t periph, uint8_t *dst, bool inc, uint16_t len, dma_callback_t cb);
+
+/**
+ * \brief Configures a channel to move bytes from memory to the TX buffer of a peripheral.
+ *
+ * The channel is triggered by the TX flag of the peripheral, one byte per trigger.
+ *
+ * \param[in] ch is the DMA channel.
+ *
+ * \param[in] periph is the destination peripheral.
+ *
+ * \param[in] src is the source memory.
+ *
+ * \param[in] inc is TRUE/FALSE to increment or not the source address after each byte.
+ *
+ * \param[in] len is the number of bytes to transfer.
+ *
+ * \param[in] cb is the transfer complete callback (NULL to disable the channel interrupt).
+ *
+ * \return The status/error code.
+ */
+int dma_config_tx(dma_ch_t ch, dma_periph_t periph, uint8_t *src, bool inc, uint16_t len, dma_callback_t cb);
+
+/**
+ * \brief Starts the transmission of a peripheral configured with dma_config_tx.
+ *
+ * The TX flag of the peripheral is already set when it is idle, so it is toggled to generate
+ * the first trigger of the TX channel.
+ *
+ * \param[in] periph is the peripheral.
+ *
+ * \return The status/error code.
+ */
+int dma_start_tx(dma_periph_t periph);
+
+/**
+ * \brief Disables a channel (and its interrupt).
+ *
+ * \param[in] ch is the DMA channel.
+ *
+ * \return The status/error code.
+ */
+int dma_stop(dma_ch_t ch);
+
+#endif /* DMA_H_ */
+
+/** \} End of dma group */
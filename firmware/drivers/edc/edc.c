@@ -26,7 +26,7 @@
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * \author Bruno Benedetti <brunobenedetti45@gmail.com>
  * 
- * \version 0.9.13
+ * \version 0.10.15
  * 
  * \date 2019/10/27
  * 
@@ -42,6 +42,63 @@
 
 #include "edc.h"
 
+#define EDC_UART_PORTS      (UART_PORT_2 + 1)
+
+/**
+ * \brief Expected answer.
+ */
+typedef struct
+{
+    edc_config_t *config;   /**< Configuration parameters of the EDC driver. */
+    uint16_t len;           /**< Number of bytes to wait for. */
+} edc_answer_t;
+
+static ready_t edc_ready[EDC_UART_PORTS] =
+{
+    READY_INIT(EDC_ANSWER_POLL_MS),
+    READY_INIT(EDC_ANSWER_POLL_MS),
+    READY_INIT(EDC_ANSWER_POLL_MS)
+};
+
+/* The chunks after the first one are not answer latencies, so they are not mixed with them */
+static ready_t edc_chunk_ready[EDC_UART_PORTS] =
+{
+    READY_INIT(EDC_ANSWER_POLL_MS),
+    READY_INIT(EDC_ANSWER_POLL_MS),
+    READY_INIT(EDC_ANSWER_POLL_MS)
+};
+
+/**
+ * \brief Waits for the answer of a command.
+ *
+ * \param[in] config is the configuration parameters of the EDC driver.
+ *
+ * \param[in] len is the length of the answer.
+ *
+ * \return The status/error code.
+ */
+static int edc_wait_answer(edc_config_t config, uint16_t len);
+
+/**
+ * \brief Waits for the next chunk of an answer being received.
+ *
+ * \param[in] config is the configuration parameters of the EDC driver.
+ *
+ * \param[in] len is the length of the chunk.
+ *
+ * \return The status/error code.
+ */
+static int edc_wait_chunk(edc_config_t config, uint16_t len);
+
+/**
+ * \brief Checks if an answer was received by the UART interface.
+ *
+ * \param[in] arg is a pointer to the expected answer (edc_answer_t).
+ *
+ * \return TRUE/FALSE if the answer is available or not.
+ */
+static bool edc_uart_answer_ready(void *arg);
+
 int edc_init(edc_config_t config)
 {
     int err = -1;
@@ -281,10 +338,7 @@ int16_t edc_get_state_pkg(edc_config_t config, uint8_t *status)
 
     if (edc_write_cmd(config, cmd) == 0)
     {
-        /* A minimum time gap of 10 ms must be forced between consecutive I2C commands */
-        edc_delay_ms(100);  /* 10 ms is not enough when using the UART interface! */
-
-        if (edc_read(config, status, EDC_FRAME_STATE_LEN) == 0)
+        if ((edc_wait_answer(config, EDC_FRAME_STATE_LEN) == 0) && (edc_read(config, status, EDC_FRAME_STATE_LEN) == 0))
         {
             if (status[0] == EDC_FRAME_ID_STATE)
             {
@@ -329,10 +383,7 @@ int16_t edc_get_ptt_pkg(edc_config_t config, uint8_t *pkg)
 
     if (edc_write_cmd(config, cmd) == 0)
     {
-        /* A minimum time gap of 10 ms must be forced between consecutive I2C commands */
-        edc_delay_ms(100);  /* 10 ms is not enough when using the UART interface! */
-
-        if (edc_read(config, pkg, EDC_FRAME_PTT_LEN) == 0)
+        if ((edc_wait_answer(config, EDC_FRAME_PTT_LEN) == 0) && (edc_read(config, pkg, EDC_FRAME_PTT_LEN) == 0))
         {
             if (pkg[0] == EDC_FRAME_ID_PTT)
             {
@@ -377,10 +428,7 @@ int16_t edc_get_hk_pkg(edc_config_t config, uint8_t *hk)
 
     if (edc_write_cmd(config, cmd) == 0)
     {
-        /* A minimum time gap of 10 ms must be forced between consecutive I2C commands */
-        edc_delay_ms(100);  /* 10 ms is not enough when using the UART interface! */
-
-        if (edc_read(config, hk, EDC_FRAME_HK_LEN) == 0)
+        if ((edc_wait_answer(config, EDC_FRAME_HK_LEN) == 0) && (edc_read(config, hk, EDC_FRAME_HK_LEN) == 0))
         {
             if (hk[0] == EDC_FRAME_ID_HK)
             {
@@ -425,10 +473,7 @@ int16_t edc_get_adc_seq(edc_config_t config, uint8_t *seq)
 
     if (edc_write_cmd(config, cmd) == 0)
     {
-        /* A minimum time gap of 10 ms must be forced between consecutive I2C commands */
-        edc_delay_ms(100);  /* 10 ms is not enough when using the UART interface! */
-
-        if (edc_read(config, seq, EDC_FRAME_ADC_SEQ_LEN) == 0)
+        if ((edc_wait_answer(config, EDC_FRAME_ADC_SEQ_LEN) == 0) && (edc_read(config, seq, EDC_FRAME_ADC_SEQ_LEN) == 0))
         {
             if (seq[0] == EDC_FRAME_ID_ADC_SEQ)
             {
@@ -463,6 +508,118 @@ int16_t edc_get_adc_seq(edc_config_t config, uint8_t *seq)
     return res;
 }
 
+int16_t edc_get_adc_seq_stream(edc_config_t config, uint8_t *chunk, uint16_t chunk_len, edc_stream_cb_t cb, void *arg)
+{
+    int16_t res = -1;
+
+    edc_cmd_t cmd = {0};
+
+    cmd.id = EDC_CMD_GET_ADC_SEQ;
+
+    if ((chunk_len == 0U) || (chunk_len > CONFIG_UART_RX_BUFFER_SIZE))
+    {
+    #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+        sys_log_print_event_from_module(SYS_LOG_ERROR, EDC_MODULE_NAME, "Error reading an ADC sequence! Invalid chunk length!");
+        sys_log_new_line();
+    #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+    }
+    else if (edc_write_cmd(config, cmd) == 0)
+    {
+        uint16_t pos = 0U;
+
+        uint8_t checksum[2] = {0U};     /* Computed XOR of the odd and even bytes */
+        uint8_t checksum_rx[2] = {0U};  /* Received checksums */
+
+        while(pos < EDC_FRAME_ADC_SEQ_LEN)
+        {
+            uint16_t len = ((EDC_FRAME_ADC_SEQ_LEN - pos) < chunk_len) ? (EDC_FRAME_ADC_SEQ_LEN - pos) : chunk_len;
+
+            int err = (pos == 0U) ? edc_wait_answer(config, len) : edc_wait_chunk(config, len);
+
+            if ((err != 0) || (edc_read(config, chunk, len) != 0))
+            {
+            #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+                sys_log_print_event_from_module(SYS_LOG_ERROR, EDC_MODULE_NAME, "Error reading an ADC sequence at byte ");
+                sys_log_print_uint(pos);
+                sys_log_print_msg("!");
+                sys_log_new_line();
+            #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+
+                break;
+            }
+
+            if ((pos == 0U) && (chunk[0] != EDC_FRAME_ID_ADC_SEQ))
+            {
+            #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+                sys_log_print_event_from_module(SYS_LOG_ERROR, EDC_MODULE_NAME, "Error reading an ADC sequence! Invalid frame ID (");
+                sys_log_print_hex(chunk[0]);
+                sys_log_print_msg(")!");
+                sys_log_new_line();
+            #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+
+                break;
+            }
+
+            uint16_t i = 0U;
+            for(i = 0U; i < len; i++)
+            {
+                uint16_t p = pos + i;
+
+                if (p < EDC_ADC_SEQ_CHECKSUM_0_POS)
+                {
+                    checksum[((p & 1U) == 1U) ? 0U : 1U] ^= chunk[i];
+                }
+                else if (p == EDC_ADC_SEQ_CHECKSUM_0_POS)
+                {
+                    checksum_rx[0] = chunk[i];
+                }
+                else if (p == EDC_ADC_SEQ_CHECKSUM_1_POS)
+                {
+                    checksum_rx[1] = chunk[i];
+                }
+                else
+                {
+                    /* Trailing byte (not covered by the checksums) */
+                }
+            }
+
+            if (cb(chunk, len, arg) != 0)
+            {
+                break;
+            }
+
+            pos += len;
+        }
+
+        if (pos == EDC_FRAME_ADC_SEQ_LEN)
+        {
+            if ((checksum[0] == checksum_rx[0]) && (checksum[1] == checksum_rx[1]))
+            {
+                res = EDC_FRAME_ADC_SEQ_LEN;
+            }
+            else
+            {
+                SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_EDC, SYS_LOG_TOK_EDC_ADC_SEQ_CHECKSUM,
+                                 ((uint32_t)checksum_rx[0] << 8) | checksum_rx[1], ((uint32_t)checksum[0] << 8) | checksum[1]);
+
+            #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+                sys_log_print_event_from_module(SYS_LOG_ERROR, EDC_MODULE_NAME, "Error reading an ADC sequence! Invalid checksum!");
+                sys_log_new_line();
+            #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+            }
+        }
+    }
+    else
+    {
+    #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+        sys_log_print_event_from_module(SYS_LOG_ERROR, EDC_MODULE_NAME, "Error writing the \"get ADC\" command!");
+        sys_log_new_line();
+    #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+    }
+
+    return res;
+}
+
 int edc_echo(edc_config_t config)
 {
     int res = -1;
@@ -475,12 +632,9 @@ int edc_echo(edc_config_t config)
     {
         if (config.interface == EDC_IF_UART)    /* The echo command just answers when using the UART interface (I think...) */
         {
-            /* A minimum time gap of 10 ms must be forced between consecutive I2C commands */
-            edc_delay_ms(100);  /* 10 ms is not enough when using the UART interface! */
-
             uint8_t echo_ans[5] = {0};
 
-            if (edc_read(config, echo_ans, EDC_FRAME_ECHO_LEN) == 0)
+            if ((edc_wait_answer(config, EDC_FRAME_ECHO_LEN) == 0) && (edc_read(config, echo_ans, EDC_FRAME_ECHO_LEN) == 0))
             {
                 uint8_t echo[4] = {'E', 'C', 'H', 'O'}; /* Expected response */
 
@@ -646,4 +800,89 @@ int edc_get_hk(edc_config_t config, edc_hk_t *hk_data)
     return err;
 }
 
+int edc_get_answer_stats(edc_config_t config, ready_stats_t *stats)
+{
+    int err = -1;
+
+    if ((uint8_t)config.uart_port < EDC_UART_PORTS)
+    {
+        ready_get_stats(&edc_ready[config.uart_port], stats);
+
+        err = 0;
+    }
+
+    return err;
+}
+
+static int edc_wait_answer(edc_config_t config, uint16_t len)
+{
+    int err = -1;
+
+    switch(config.interface)
+    {
+        case EDC_IF_UART:
+            if ((uint8_t)config.uart_port < EDC_UART_PORTS)
+            {
+                /* Longer answers can not be fully stored in the RX buffer */
+                edc_answer_t ans = {&config, (len > CONFIG_UART_RX_BUFFER_SIZE) ? CONFIG_UART_RX_BUFFER_SIZE : len};
+
+                err = ready_wait(&edc_ready[config.uart_port], EDC_ANSWER_TIMEOUT_MS + (len / EDC_UART_BYTES_PER_MS), edc_uart_answer_ready, &ans);
+
+                if (err != 0)
+                {
+                    SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_EDC, SYS_LOG_TOK_EDC_ANSWER_TIMEOUT, ans.len, config.uart_port);
+
+                #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+                    sys_log_print_event_from_module(SYS_LOG_ERROR, EDC_MODULE_NAME, "Timeout waiting for an answer!");
+                    sys_log_new_line();
+                #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+                }
+            }
+
+            break;
+        case EDC_IF_I2C:
+            /* The answer is read on demand, just the minimum gap between consecutive I2C commands must be forced */
+            edc_delay_ms(EDC_I2C_CMD_GAP_MS);
+
+            err = 0;
+
+            break;
+        default:
+        #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+            sys_log_print_event_from_module(SYS_LOG_ERROR, EDC_MODULE_NAME, "Unexpected interface!");
+            sys_log_new_line();
+        #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+            break;
+    }
+
+    return err;
+}
+
+static int edc_wait_chunk(edc_config_t config, uint16_t len)
+{
+    int err = 0;
+
+    /* Over I2C, the next chunk is read on demand */
+    if (config.interface == EDC_IF_UART)
+    {
+        err = -1;
+
+        if ((uint8_t)config.uart_port < EDC_UART_PORTS)
+        {
+            edc_answer_t ans = {&config, len};
+
+            err = ready_wait(&edc_chunk_ready[config.uart_port], EDC_ANSWER_TIMEOUT_MS + (len / EDC_UART_BYTES_PER_MS), edc_uart_answer_ready, &ans);
+        }
+    }
+
+    return err;
+}
+
+static bool edc_uart_answer_ready(void *arg)
+{
+    edc_answer_t *ans = (edc_answer_t*)arg;
+
+    return edc_uart_rx_available(*ans->config) >= (int)ans->len;
+}
+
 /** \} End of edc group */
@@ -26,7 +26,7 @@
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * \author Bruno Benedetti <brunobenedetti45@gmail.com>
  * 
- * \version 0.9.13
+ * \version 0.10.15
  * 
  * \date 2019/10/27
  * 
@@ -44,6 +44,7 @@
 #include <drivers/i2c/i2c.h>
 #include <drivers/gpio/gpio.h>
 #include <drivers/uart/uart.h>
+#include <system/ready/ready.h>
 
 #define EDC_MODULE_NAME             "EDC"
 
@@ -74,6 +75,16 @@
 #define EDC_FRAME_HK_LEN            26      /**< Housekeeping frame length. */
 #define EDC_FRAME_ECHO_LEN          4       /**< Echo frame length. */
 
+/* ADC sequence frame checksums */
+#define EDC_ADC_SEQ_CHECKSUM_0_POS  8197U   /**< Position of the XOR of all the odd bytes before the checksums. */
+#define EDC_ADC_SEQ_CHECKSUM_1_POS  8198U   /**< Position of the XOR of all the even bytes before the checksums. */
+
+/* Answer timing */
+#define EDC_ANSWER_TIMEOUT_MS       100U    /**< Hard timeout of an answer, excluding its transmission time. */
+#define EDC_ANSWER_POLL_MS          1U      /**< Period between checks of the UART RX buffer. */
+#define EDC_UART_BYTES_PER_MS       11U     /**< Transmission rate of the UART interface at 115200 bps (8N1). */
+#define EDC_I2C_CMD_GAP_MS          10U     /**< Minimum time gap between consecutive I2C commands. */
+
 /**
  * \brief EDC interfaces.
  */
@@ -95,6 +106,19 @@ typedef struct
     gpio_pin_t en_pin;                      /**< Enable pin. */
 } edc_config_t;
 
+/**
+ * \brief Stream callback (receives the consecutive chunks of a frame).
+ *
+ * \param[in] data is the received chunk.
+ *
+ * \param[in] len is the number of bytes of the chunk.
+ *
+ * \param[in,out] arg is the argument given to the stream function.
+ *
+ * \return The status/error code (any error aborts the stream).
+ */
+typedef int (*edc_stream_cb_t)(uint8_t *data, uint16_t len, void *arg);
+
 /**
  * \brief EDC command.
  */
@@ -377,6 +401,36 @@ int16_t edc_get_hk_pkg(edc_config_t config, uint8_t *hk);
  */
 int16_t edc_get_adc_seq(edc_config_t config, uint8_t *seq);
 
+/**
+ * \brief Gets the current ADC sample frame in chunks.
+ *
+ * Streaming variant of edc_get_adc_seq: the frame is read in chunks of up to chunk_len bytes,
+ * and each chunk is given to a callback as soon as it is received, so the whole frame
+ * (EDC_FRAME_ADC_SEQ_LEN bytes) never needs to be in memory.
+ *
+ * The two frame checksums are accumulated across the chunks and checked after the last one. On a
+ * mismatch, all the chunks were already given to the callback, but an error is returned, so the
+ * caller must discard them.
+ *
+ * With the I2C interface, each chunk is a separate read transfer. The user guide does not say
+ * what the EDC sends after an incomplete read: this function assumes that the next read resumes
+ * the frame where the previous one stopped. If the EDC restarts the frame instead, the checksums
+ * do not match.
+ *
+ * \param[in] config is the configuration parameters of the EDC driver.
+ *
+ * \param[in,out] chunk is a buffer to store each chunk (at least chunk_len bytes).
+ *
+ * \param[in] chunk_len is the length of the chunks (up to CONFIG_UART_RX_BUFFER_SIZE bytes).
+ *
+ * \param[in] cb is the callback that receives each chunk.
+ *
+ * \param[in,out] arg is the argument of the callback.
+ *
+ * \return The number of read bytes (-1 on error or invalid checksums).
+ */
+int16_t edc_get_adc_seq_stream(edc_config_t config, uint8_t *chunk, uint16_t chunk_len, edc_stream_cb_t cb, void *arg);
+
 /**
  * \brief Writes the string "ECHO" in the debug interface.
  *
@@ -434,6 +488,17 @@ int edc_get_ptt(edc_config_t config, edc_ptt_t *ptt_data);
  */
 int edc_get_hk(edc_config_t config, edc_hk_t *hk_data);
 
+/**
+ * \brief Gets the learned answer latency statistics of the UART interface.
+ *
+ * \param[in] config is the configuration parameters of the EDC driver.
+ *
+ * \param[in,out] stats is a pointer to store the statistics.
+ *
+ * \return The status/error code.
+ */
+int edc_get_answer_stats(edc_config_t config, ready_stats_t *stats);
+
 /**
  * \brief Initializes the I2C port.
  *
@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.9.6
+ * \version 0.10.16
  * 
  * \date 2019/12/07
  * 
@@ -33,15 +33,48 @@
  * \{
  */
 
+#include <stddef.h>
+
 #include <hal/usci_b_i2c.h>
 #include <hal/gpio.h>
 #include <hal/ucs.h>
 
 #include <config/config.h>
 #include <system/sys_log/sys_log.h>
+#include <drivers/timer/timer.h>
 
 #include "i2c.h"
 
+/**
+ * \brief Writes data to a slave polling the interrupt flags (blocking the CPU).
+ *
+ * \param[in] base_address is the base address of the USCI_B module of the port.
+ *
+ * \param[in] adr is the 7-bit slave address.
+ *
+ * \param[in] data is the data to write.
+ *
+ * \param[in] len is the number of bytes to write.
+ *
+ * \return The status/error code.
+ */
+static int i2c_write_polled(uint16_t base_address, i2c_slave_adr_t adr, uint8_t *data, uint16_t len);
+
+/**
+ * \brief Reads data from a slave polling the interrupt flags (blocking the CPU).
+ *
+ * \param[in] base_address is the base address of the USCI_B module of the port.
+ *
+ * \param[in] adr is the 7-bit slave address.
+ *
+ * \param[in,out] data is a pointer to store the read data.
+ *
+ * \param[in] len is the number of bytes to read.
+ *
+ * \return The status/error code.
+ */
+static int i2c_read_polled(uint16_t base_address, i2c_slave_adr_t adr, uint8_t *data, uint16_t len);
+
 int i2c_init(i2c_port_t port, i2c_config_t config)
 {
     int err = 0;
@@ -97,6 +130,11 @@ int i2c_init(i2c_port_t port, i2c_config_t config)
             USCI_B_I2C_initMaster(base_address, &i2c_params);
 
             USCI_B_I2C_disable(base_address);
+
+            if (i2c_mutex_create(port) != 0)
+            {
+                err = -1;
+            }
         }
     }
 
@@ -104,6 +142,16 @@ int i2c_init(i2c_port_t port, i2c_config_t config)
 }
 
 int i2c_write(i2c_port_t port, i2c_slave_adr_t adr, uint8_t *data, uint16_t len)
+{
+    return i2c_write_read(port, adr, data, len, NULL, 0U);
+}
+
+int i2c_read(i2c_port_t port, i2c_slave_adr_t adr, uint8_t *data, uint16_t len)
+{
+    return i2c_write_read(port, adr, NULL, 0U, data, len);
+}
+
+int i2c_write_read(i2c_port_t port, i2c_slave_adr_t adr, uint8_t *wd, uint16_t wlen, uint8_t *rd, uint16_t rlen)
 {
     int err = 0;
 
@@ -119,7 +167,7 @@ int i2c_write(i2c_port_t port, i2c_slave_adr_t adr, uint8_t *data, uint16_t len)
             case I2C_PORT_2:    base_address = USCI_B2_BASE;    break;
             default:
             #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
-                sys_log_print_event_from_module(SYS_LOG_ERROR, I2C_MODULE_NAME, "Invalid port during write!");
+                sys_log_print_event_from_module(SYS_LOG_ERROR, I2C_MODULE_NAME, "Invalid port during transfer!");
                 sys_log_new_line();
             #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
                 err = -1;   /* Invalid I2C port */
@@ -128,69 +176,129 @@ int i2c_write(i2c_port_t port, i2c_slave_adr_t adr, uint8_t *data, uint16_t len)
 
         if (err == 0)
         {
-            USCI_B_I2C_setSlaveAddress(base_address, adr);
+            /* The port mutex is held during the whole transfer (start to stop condition) */
+            err = i2c_mutex_take(port);
+
+        #if defined(CONFIG_BUS_STATS_ENABLED) && (CONFIG_BUS_STATS_ENABLED == 1)
+            if (err != 0)
+            {
+                i2c_stats_timeout(port);
+            }
+        #endif /* CONFIG_BUS_STATS_ENABLED */
+        }
+
+        if (err == 0)
+        {
+            bool use_isr = false;
 
-            USCI_B_I2C_setMode(base_address, USCI_B_I2C_TRANSMIT_MODE);
+        #if defined(CONFIG_BUS_STATS_ENABLED) && (CONFIG_BUS_STATS_ENABLED == 1)
+            uint32_t start_us = timer_get_us();
+        #endif /* CONFIG_BUS_STATS_ENABLED */
 
-            USCI_B_I2C_enable(base_address);
+        #if defined(CONFIG_I2C_ISR_ENABLED) && (CONFIG_I2C_ISR_ENABLED == 1)
+            use_isr = i2c_isr_available(port);
+        #endif /* CONFIG_I2C_ISR_ENABLED */
 
-            if (len == 1U)  /* Single byte */
+            if (use_isr)
             {
-                if (USCI_B_I2C_masterSendSingleByteWithTimeout(base_address, data[0], I2C_SLAVE_TIMEOUT) == STATUS_SUCCESS)
+                err = i2c_isr_transfer(port, adr, wd, wlen, rd, rlen);
+            }
+            else
+            {
+                if (wlen > 0U)
                 {
-                    /* Delay until transmission completes */
-                    while(USCI_B_I2C_isBusBusy(base_address) > 0)
-                    {
-                        ;
-                    }
+                    err = i2c_write_polled(base_address, adr, wd, wlen);
                 }
-                else
+
+                if ((err == 0) && (rlen > 0U))
+                {
+                    err = i2c_read_polled(base_address, adr, rd, rlen);
+                }
+            }
+
+        #if defined(CONFIG_BUS_STATS_ENABLED) && (CONFIG_BUS_STATS_ENABLED == 1)
+            i2c_stats_add(port, start_us, wlen + rlen, err);
+        #endif /* CONFIG_BUS_STATS_ENABLED */
+
+            i2c_mutex_give(port);
+
+            if (err != 0)
+            {
+                SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_I2C, SYS_LOG_TOK_BUS_TRANSFER_ERROR, port, adr);
+            }
+        }
+    }
+    else
+    {
+    #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+        sys_log_print_event_from_module(SYS_LOG_ERROR, I2C_MODULE_NAME, "Invalid slave address during transfer (");
+        sys_log_print_hex(adr);
+        sys_log_print_msg(")!");
+        sys_log_new_line();
+    #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+        err = -1;   /* Invalid slave address */
+    }
+
+    return err;
+}
+
+static int i2c_write_polled(uint16_t base_address, i2c_slave_adr_t adr, uint8_t *data, uint16_t len)
+{
+    int err = 0;
+
+    USCI_B_I2C_setSlaveAddress(base_address, adr);
+
+    USCI_B_I2C_setMode(base_address, USCI_B_I2C_TRANSMIT_MODE);
+
+    USCI_B_I2C_enable(base_address);
+
+    if (len == 1U)  /* Single byte */
+    {
+        if (USCI_B_I2C_masterSendSingleByteWithTimeout(base_address, data[0], I2C_SLAVE_TIMEOUT) == STATUS_SUCCESS)
+        {
+            /* Delay until transmission completes */
+            while(USCI_B_I2C_isBusBusy(base_address) > 0)
+            {
+                ;
+            }
+        }
+        else
+        {
+        #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+            sys_log_print_event_from_module(SYS_LOG_WARNING, I2C_MODULE_NAME, "Timeout reached during write!");
+            sys_log_new_line();
+        #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+            err = -1;   /* Timeout reached! */
+        }
+    }
+    else            /* Multiple bytes */
+    {
+        /* Initiate start and send first character */
+        if (USCI_B_I2C_masterSendMultiByteStartWithTimeout(base_address, data[0], I2C_SLAVE_TIMEOUT) == STATUS_SUCCESS)
+        {
+            uint16_t i = 0;
+            for(i = 1; i < len; i++)
+            {
+                if (USCI_B_I2C_masterSendMultiByteNextWithTimeout(base_address, data[i], I2C_SLAVE_TIMEOUT) != STATUS_SUCCESS)
                 {
                 #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
                     sys_log_print_event_from_module(SYS_LOG_WARNING, I2C_MODULE_NAME, "Timeout reached during write!");
                     sys_log_new_line();
                 #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
                     err = -1;   /* Timeout reached! */
+                    break;
                 }
             }
-            else            /* Multiple bytes */
+
+            if (err == 0)
             {
-                /* Initiate start and send first character */
-                if (USCI_B_I2C_masterSendMultiByteStartWithTimeout(base_address, data[0], I2C_SLAVE_TIMEOUT) == STATUS_SUCCESS)
+                /* Initiate stop only */
+                if (USCI_B_I2C_masterSendMultiByteStopWithTimeout(base_address, I2C_SLAVE_TIMEOUT) == STATUS_SUCCESS)
                 {
-                    uint16_t i = 0;
-                    for(i = 1; i < len; i++)
-                    {
-                        if (USCI_B_I2C_masterSendMultiByteNextWithTimeout(base_address, data[i], I2C_SLAVE_TIMEOUT) != STATUS_SUCCESS)
-                        {
-                        #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
-                            sys_log_print_event_from_module(SYS_LOG_WARNING, I2C_MODULE_NAME, "Timeout reached during write!");
-                            sys_log_new_line();
-                        #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
-                            err = -1;   /* Timeout reached! */
-                            break;
-                        }
-                    }
-
-                    if (err == 0)
+                    /* Delay until transmission completes */
+                    while(USCI_B_I2C_isBusBusy(base_address) > 0)
                     {
-                        /* Initiate stop only */
-                        if (USCI_B_I2C_masterSendMultiByteStopWithTimeout(base_address, I2C_SLAVE_TIMEOUT) == STATUS_SUCCESS)
-                        {
-                            /* Delay until transmission completes */
-                            while(USCI_B_I2C_isBusBusy(base_address) > 0)
-                            {
-                                ;
-                            }
-                        }
-                        else
-                        {
-                        #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
-                            sys_log_print_event_from_module(SYS_LOG_WARNING, I2C_MODULE_NAME, "Timeout reached during write!");
-                            sys_log_new_line();
-                        #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
-                            err = -1;   /* Timeout reached! */
-                        }
+                        ;
                     }
                 }
                 else
@@ -202,110 +310,75 @@ int i2c_write(i2c_port_t port, i2c_slave_adr_t adr, uint8_t *data, uint16_t len)
                     err = -1;   /* Timeout reached! */
                 }
             }
-
-            USCI_B_I2C_disable(base_address);
+        }
+        else
+        {
+        #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+            sys_log_print_event_from_module(SYS_LOG_WARNING, I2C_MODULE_NAME, "Timeout reached during write!");
+            sys_log_new_line();
+        #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+            err = -1;   /* Timeout reached! */
         }
     }
-    else
-    {
-    #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
-        sys_log_print_event_from_module(SYS_LOG_ERROR, I2C_MODULE_NAME, "Invalid slave address during write (");
-        sys_log_print_hex(adr);
-        sys_log_print_msg(")!");
-        sys_log_new_line();
-    #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
-        err = -1;   /* Invalid slave address */
-    }
+
+    USCI_B_I2C_disable(base_address);
 
     return err;
 }
 
-int i2c_read(i2c_port_t port, i2c_slave_adr_t adr, uint8_t *data, uint16_t len)
+static int i2c_read_polled(uint16_t base_address, i2c_slave_adr_t adr, uint8_t *data, uint16_t len)
 {
     int err = 0;
 
-    /* Verifies if the slave address is lesser than 7-bits */
-    if (adr <= 128U)
-    {
-        uint16_t base_address = UINT16_MAX;
+    USCI_B_I2C_setSlaveAddress(base_address, adr);
 
-        switch(port)
-        {
-            case I2C_PORT_0:    base_address = USCI_B0_BASE;    break;
-            case I2C_PORT_1:    base_address = USCI_B1_BASE;    break;
-            case I2C_PORT_2:    base_address = USCI_B2_BASE;    break;
-            default:
-            #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
-                sys_log_print_event_from_module(SYS_LOG_ERROR, I2C_MODULE_NAME, "Invalid port during read!");
-                sys_log_new_line();
-            #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
-                err = -1;   /* Invalid I2C port */
-                break;
-        }
+    USCI_B_I2C_setMode(base_address, USCI_B_I2C_RECEIVE_MODE);
 
-        if (err == 0)
-        {
-            USCI_B_I2C_setSlaveAddress(base_address, adr);
-
-            USCI_B_I2C_setMode(base_address, USCI_B_I2C_RECEIVE_MODE);
+    USCI_B_I2C_enable(base_address);
 
-            USCI_B_I2C_enable(base_address);
+    uint16_t timeout = 0;
 
-            uint16_t timeout = 0;
+    /* Starts the transmission */
+    HWREG8(base_address + OFS_UCBxCTL1) |= UCTXSTT;
 
-            /* Starts the transmission */
-            HWREG8(base_address + OFS_UCBxCTL1) |= UCTXSTT;
-
-            /* Wait Slave Address ACK */
-            while((HWREG8(base_address + OFS_UCBxCTL1) & UCTXSTT) && (timeout < I2C_SLAVE_TIMEOUT))
-            {
-                timeout++;
-            }
+    /* Wait Slave Address ACK */
+    while((HWREG8(base_address + OFS_UCBxCTL1) & UCTXSTT) && (timeout < I2C_SLAVE_TIMEOUT))
+    {
+        timeout++;
+    }
 
-            uint16_t i = 0;
-            for(i = 0; i < (len - 1U); i++)
-            {
-                /* Wait to receive data and shift data on buffer */
-                while((!(HWREG8(base_address + OFS_UCBxIFG) & UCRXIFG)) && (timeout < I2C_SLAVE_TIMEOUT))
-                {
-                    timeout++;
-                }
+    uint16_t i = 0;
+    for(i = 0; i < (len - 1U); i++)
+    {
+        /* Wait to receive data and shift data on buffer */
+        while((!(HWREG8(base_address + OFS_UCBxIFG) & UCRXIFG)) && (timeout < I2C_SLAVE_TIMEOUT))
+        {
+            timeout++;
+        }
 
-                /* Receive a byte and increment the pointer */
-                data[i] = HWREG8(base_address + OFS_UCBxRXBUF);
-            }
+        /* Receive a byte and increment the pointer */
+        data[i] = HWREG8(base_address + OFS_UCBxRXBUF);
+    }
 
-            /* Prepares to stop the transmission */
-            HWREG8(base_address + OFS_UCBxCTL1) |= UCTXSTP;
+    /* Prepares to stop the transmission */
+    HWREG8(base_address + OFS_UCBxCTL1) |= UCTXSTP;
 
-            /* Wait to receive data and shift data on buffer */
-            while((!(HWREG8(base_address + OFS_UCBxIFG) & UCRXIFG)) && (timeout < I2C_SLAVE_TIMEOUT))
-            {
-                timeout++;
-            }
+    /* Wait to receive data and shift data on buffer */
+    while((!(HWREG8(base_address + OFS_UCBxIFG) & UCRXIFG)) && (timeout < I2C_SLAVE_TIMEOUT))
+    {
+        timeout++;
+    }
 
-            /* Receive a byte and increment the pointer */
-            data[i] = HWREG8(base_address + OFS_UCBxRXBUF);
+    /* Receive a byte and increment the pointer */
+    data[i] = HWREG8(base_address + OFS_UCBxRXBUF);
 
-            if (timeout > I2C_SLAVE_TIMEOUT)
-            {
-            #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
-                sys_log_print_event_from_module(SYS_LOG_WARNING, I2C_MODULE_NAME, "Timeout reached during read!");
-                sys_log_new_line();
-            #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
-                err = -1;   /* Timeout reached! */
-            }
-        }
-    }
-    else
+    if (timeout >= I2C_SLAVE_TIMEOUT)
     {
     #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
-        sys_log_print_event_from_module(SYS_LOG_ERROR, I2C_MODULE_NAME, "Invalid slave address during read (");
-        sys_log_print_hex(adr);
-        sys_log_print_msg(")!");
+        sys_log_print_event_from_module(SYS_LOG_WARNING, I2C_MODULE_NAME, "Timeout reached during read!");
         sys_log_new_line();
     #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
-        err = -1;   /* Invalid slave address */
+        err = -1;   /* Timeout reached! */
     }
 
     return err;
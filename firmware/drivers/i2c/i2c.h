@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.7.41
+ * \version 0.10.16
  * 
  * \date 2019/12/07
  * 
@@ -38,9 +38,14 @@
 #define I2C_H_
 
 #include <stdint.h>
+#include <stdbool.h>
+
+#include <libs/stats/bus_stats.h>
 
 #define I2C_MODULE_NAME         "I2C"
 
+#define I2C_MUTEX_WAIT_TIME_MS  100U    /**< Wait time to take the mutex of a port in milliseconds. */
+
 #define I2C_SLAVE_TIMEOUT       10000U
 
 /**
@@ -61,6 +66,16 @@ typedef struct
     uint32_t speed_hz;  /**< Transfer rate in bps (available values: 100 or 400 kbps). */
 } i2c_config_t;
 
+/**
+ * \brief I2C bus usage statistics.
+ */
+typedef struct
+{
+    uint32_t transactions;  /**< Number of transfers. */
+    uint32_t contentions;   /**< Number of transfers that had to wait for the port. */
+    uint32_t timeouts;      /**< Number of transfers aborted waiting for the port. */
+} i2c_bus_stats_t;
+
 /**
  * \brief I2C slave 7-bit address.
  */
@@ -122,6 +137,148 @@ int i2c_write(i2c_port_t port, i2c_slave_adr_t adr, uint8_t *data, uint16_t len)
  */
 int i2c_read(i2c_port_t port, i2c_slave_adr_t adr, uint8_t *data, uint16_t len);
 
+/**
+ * \brief Writes and then reads data from a given I2C port and address (combined transaction).
+ *
+ * The read phase starts with a repeated start condition, without releasing the bus. When
+ * the interrupt-driven transfers are not available, a stop condition is sent between the
+ * two phases.
+ *
+ * \param[in] port is the I2C port. It can be:
+ * \parblock
+ *      -\b I2C_PORT_0
+ *      -\b I2C_PORT_1
+ *      -\b I2C_PORT_2
+ * \endparblock
+ *
+ * \param[in] adr is the 7-bit slave address.
+ *
+ * \param[in] wd is the data to write.
+ *
+ * \param[in] wlen is the number of bytes to write.
+ *
+ * \param[in,out] rd is a pointer to store the read data.
+ *
+ * \param[in] rlen is the number of bytes to read.
+ *
+ * \return The status/error code.
+ */
+int i2c_write_read(i2c_port_t port, i2c_slave_adr_t adr, uint8_t *wd, uint16_t wlen, uint8_t *rd, uint16_t rlen);
+
+/**
+ * \brief Creates the mutex of a I2C port.
+ *
+ * \param[in] port is the I2C port.
+ *
+ * \return The status/error code.
+ */
+int i2c_mutex_create(i2c_port_t port);
+
+/**
+ * \brief Takes the mutex of a I2C port.
+ *
+ * \param[in] port is the I2C port.
+ *
+ * \return The status/error code.
+ */
+int i2c_mutex_take(i2c_port_t port);
+
+/**
+ * \brief Gives the mutex of a I2C port back.
+ *
+ * \param[in] port is the I2C port.
+ *
+ * \return The status/error code.
+ */
+int i2c_mutex_give(i2c_port_t port);
+
+/**
+ * \brief Gets the usage statistics of a I2C port.
+ *
+ * \param[in] port is the I2C port.
+ *
+ * \param[in,out] stats is a pointer to store the statistics.
+ *
+ * \return None.
+ */
+void i2c_mutex_get_stats(i2c_port_t port, i2c_bus_stats_t *stats);
+
+/**
+ * \brief Checks if the interrupt-driven transfers can be used in a I2C port.
+ *
+ * \param[in] port is the I2C port.
+ *
+ * \return TRUE/FALSE if the interrupt-driven transfers are available or not.
+ */
+bool i2c_isr_available(i2c_port_t port);
+
+/**
+ * \brief Executes an interrupt-driven transaction, blocking the calling task until it ends.
+ *
+ * The port mutex must be held by the caller.
+ *
+ * \param[in] port is the I2C port.
+ *
+ * \param[in] adr is the 7-bit slave address.
+ *
+ * \param[in] wd is the data to write.
+ *
+ * \param[in] wlen is the number of bytes to write (0 for a read-only transaction).
+ *
+ * \param[in,out] rd is a pointer to store the read data.
+ *
+ * \param[in] rlen is the number of bytes to read (0 for a write-only transaction).
+ *
+ * \return The status/error code.
+ */
+int i2c_isr_transfer(i2c_port_t port, i2c_slave_adr_t adr, uint8_t *wd, uint16_t wlen, uint8_t *rd, uint16_t rlen);
+
+/**
+ * \brief Records a transfer in the transaction statistics of a port.
+ *
+ * It must be called by the holder of the port mutex.
+ *
+ * \param[in] port is the I2C port.
+ *
+ * \param[in] start_us is the timestamp of the beginning of the transfer (timer_get_us).
+ *
+ * \param[in] len is the number of transferred bytes (written and read).
+ *
+ * \param[in] err is the status/error code of the transfer.
+ *
+ * \return None.
+ */
+void i2c_stats_add(i2c_port_t port, uint32_t start_us, uint16_t len, int err);
+
+/**
+ * \brief Accounts a transfer aborted waiting for the port mutex.
+ *
+ * \param[in] port is the I2C port.
+ *
+ * \return None.
+ */
+void i2c_stats_timeout(i2c_port_t port);
+
+/**
+ * \brief Gets the transaction statistics of a I2C port.
+ *
+ * \param[in] port is the I2C port.
+ *
+ * \param[in,out] stats is a pointer to store the statistics.
+ *
+ * \return The status/error code.
+ */
+int i2c_stats_get(i2c_port_t port, bus_stats_t *stats);
+
+/**
+ * \brief Clears the transaction statistics of a I2C port.
+ *
+ * \param[in] port is the I2C port.
+ *
+ * \return The status/error code.
+ */
+int i2c_stats_reset(i2c_port_t port);
+
 #endif /* I2C_H_ */
 
 /** \} End of i2c group */
@@ -0,0 +1,341 @@
+/*
+ * i2c_isr.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Interrupt-driven I2C master implementation.
+ *
+ * The bytes of a transaction are moved by the USCI_B interrupt routine of the port, while the
+ * calling task is blocked on its notification. A transaction can have a write phase, a read
+ * phase, or both (write-then-read with a repeated start condition).
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.9
+ *
+ * \date 2022/11/27
+ *
+ * \defgroup i2c_isr ISR
+ * \ingroup i2c
+ * \{
+ */
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#include <hal/usci_b_i2c.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <config/config.h>
+#include <system/sys_log/sys_log.h>
+
+#include "i2c.h"
+
+#define I2C_ISR_PORTS           (I2C_PORT_2 + 1)
+
+#define I2C_ISR_INTERRUPTS      (USCI_B_I2C_TRANSMIT_INTERRUPT | USCI_B_I2C_RECEIVE_INTERRUPT | USCI_B_I2C_NAK_INTERRUPT | USCI_B_I2C_ARBITRATIONLOST_INTERRUPT)
+
+/**
+ * \brief Transaction in progress in a port.
+ */
+typedef struct
+{
+    uint8_t *wd;                /**< Data to write. */
+    uint16_t wlen;              /**< Number of bytes to write. */
+    uint8_t *rd;                /**< Buffer to store the read data. */
+    uint16_t rlen;              /**< Number of bytes to read. */
+    volatile uint16_t tx_idx;   /**< Number of bytes already written. */
+    volatile uint16_t rx_idx;   /**< Number of bytes already read. */
+    volatile bool error;        /**< NACK or arbitration lost. */
+    TaskHandle_t task;          /**< Task waiting for the end of the transaction. */
+} i2c_isr_xfer_t;
+
+static const uint16_t i2c_isr_base_address[I2C_ISR_PORTS] = {USCI_B0_BASE, USCI_B1_BASE, USCI_B2_BASE};
+
+static i2c_isr_xfer_t i2c_isr_xfer[I2C_ISR_PORTS] = {0};
+
+/**
+ * \brief Starts the read phase of a transaction (start or repeated start condition in receive mode).
+ *
+ * The stop condition is requested by the RX interrupts, also for a single byte read.
+ *
+ * \param[in] base_address is the base address of the USCI_B module.
+ *
+ * \return None.
+ */
+static void i2c_isr_start_rx(uint16_t base_address);
+
+/**
+ * \brief Common interrupt handler of the USCI_B ports.
+ *
+ * \param[in] port is the I2C port of the interrupt.
+ *
+ * \return None.
+ */
+static void i2c_isr_handler(i2c_port_t port);
+
+bool i2c_isr_available(i2c_port_t port)
+{
+    bool res = false;
+
+    if ((uint8_t)port < I2C_ISR_PORTS)
+    {
+        /* The completion is signaled to the calling task, so the scheduler must be running */
+        if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)
+        {
+            res = true;
+        }
+    }
+
+    return res;
+}
+
+int i2c_isr_transfer(i2c_port_t port, i2c_slave_adr_t adr, uint8_t *wd, uint16_t wlen, uint8_t *rd, uint16_t rlen)
+{
+    int err = -1;
+
+    if (i2c_isr_available(port) && ((wlen > 0U) || (rlen > 0U)))
+    {
+        uint16_t base_address = i2c_isr_base_address[port];
+        i2c_isr_xfer_t *xfer = &i2c_isr_xfer[port];
+
+        xfer->wd        = wd;
+        xfer->wlen      = wlen;
+        xfer->rd        = rd;
+        xfer->rlen      = rlen;
+        xfer->tx_idx    = 0U;
+        xfer->rx_idx    = 0U;
+        xfer->error     = false;
+        xfer->task      = xTaskGetCurrentTaskHandle();
+
+        /* Discard any pending notification */
+        (void)ulTaskNotifyTake(pdTRUE, 0);
+
+        USCI_B_I2C_setSlaveAddress(base_address, adr);
+
+        /* Leaving the reset state clears the interrupt enable bits */
+        USCI_B_I2C_enable(base_address);
+
+        USCI_B_I2C_clearInterrupt(base_address, I2C_ISR_INTERRUPTS);
+        USCI_B_I2C_enableInterrupt(base_address, USCI_B_I2C_NAK_INTERRUPT | USCI_B_I2C_ARBITRATIONLOST_INTERRUPT);
+
+        if (wlen > 0U)
+        {
+            USCI_B_I2C_setMode(base_address, USCI_B_I2C_TRANSMIT_MODE);
+
+            USCI_B_I2C_enableInterrupt(base_address, USCI_B_I2C_TRANSMIT_INTERRUPT);
+
+            /* The first TX interrupt comes with the start condition */
+            HWREG8(base_address + OFS_UCBxCTL1) |= UCTXSTT;
+        }
+        else
+        {
+            i2c_isr_start_rx(base_address);
+        }
+
+        if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CONFIG_I2C_ISR_TIMEOUT_MS)) > 0U)
+        {
+            if (xfer->error)
+            {
+            #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+                sys_log_print_event_from_module(SYS_LOG_WARNING, I2C_MODULE_NAME, "NACK received from slave ");
+                sys_log_print_hex(adr);
+                sys_log_print_msg("!");
+                sys_log_new_line();
+            #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+            }
+            else
+            {
+                err = 0;
+            }
+        }
+        else
+        {
+        #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+            sys_log_print_event_from_module(SYS_LOG_WARNING, I2C_MODULE_NAME, "Timeout reached during transfer!");
+            sys_log_new_line();
+        #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+
+            /* Releases the bus */
+            HWREG8(base_address + OFS_UCBxCTL1) |= UCTXSTP;
+        }
+
+        USCI_B_I2C_disableInterrupt(base_address, I2C_ISR_INTERRUPTS);
+
+        /* Wait for the stop condition (at most one byte time) */
+        uint16_t timeout = 0U;
+        while(((HWREG8(base_address + OFS_UCBxCTL1) & UCTXSTP) > 0U) && (timeout < I2C_SLAVE_TIMEOUT))
+        {
+            timeout++;
+        }
+
+        USCI_B_I2C_disable(base_address);
+
+        xfer->task = NULL;
+    }
+
+    return err;
+}
+
+static void i2c_isr_start_rx(uint16_t base_address)
+{
+    HWREG8(base_address + OFS_UCBxCTL1) &= ~UCTR;
+
+    USCI_B_I2C_enableInterrupt(base_address, USCI_B_I2C_RECEIVE_INTERRUPT);
+
+    HWREG8(base_address + OFS_UCBxCTL1) |= UCTXSTT;
+}
+
+static void i2c_isr_handler(i2c_port_t port)
+{
+    uint16_t base_address = i2c_isr_base_address[port];
+    i2c_isr_xfer_t *xfer = &i2c_isr_xfer[port];
+
+    bool done = false;
+
+    /* Reading UCBxIV clears the pending flag with the highest priority */
+    switch(__even_in_range(HWREG16(base_address + OFS_UCBxIV), 12))
+    {
+        case 0:     break;      /* No interrupts */
+        case 2:                 /* ALIFG */
+            xfer->error = true;
+            done = true;
+            break;
+        case 4:                 /* NACKIFG */
+            HWREG8(base_address + OFS_UCBxCTL1) |= UCTXSTP;
+            xfer->error = true;
+            done = true;
+            break;
+        case 6:     break;      /* STTIFG (slave mode only) */
+        case 8:     break;      /* STPIFG (slave mode only) */
+        case 10:                /* RXIFG */
+            if ((xfer->rlen == 1U) && (xfer->rx_idx == 0U))
+            {
+                /* Single byte: the bus is held until UCBxRXBUF is read, so the NACK and the stop are sent right away (after the second byte, if any, which is discarded) */
+                HWREG8(base_address + OFS_UCBxCTL1) |= UCTXSTP;
+            }
+
+            if (xfer->rx_idx < xfer->rlen)
+            {
+                xfer->rd[xfer->rx_idx] = HWREG8(base_address + OFS_UCBxRXBUF);
+                xfer->rx_idx++;
+            }
+            else
+            {
+                /* Unexpected byte */
+                (void)HWREG8(base_address + OFS_UCBxRXBUF);
+            }
+
+            if (xfer->rx_idx == (xfer->rlen - 1U))
+            {
+                /* The stop is sent after the next (last) byte */
+                HWREG8(base_address + OFS_UCBxCTL1) |= UCTXSTP;
+            }
+            else if (xfer->rx_idx >= xfer->rlen)
+            {
+                done = true;
+            }
+            else
+            {
+                /* Still receiving */
+            }
+
+            break;
+        case 12:                /* TXIFG */
+            if (xfer->tx_idx < xfer->wlen)
+            {
+                HWREG8(base_address + OFS_UCBxTXBUF) = xfer->wd[xfer->tx_idx];
+                xfer->tx_idx++;
+            }
+            else
+            {
+                USCI_B_I2C_disableInterrupt(base_address, USCI_B_I2C_TRANSMIT_INTERRUPT);
+
+                if (xfer->rlen > 0U)
+                {
+                    /* Repeated start */
+                    i2c_isr_start_rx(base_address);
+                }
+                else
+                {
+                    HWREG8(base_address + OFS_UCBxCTL1) |= UCTXSTP;
+                    USCI_B_I2C_clearInterrupt(base_address, USCI_B_I2C_TRANSMIT_INTERRUPT);
+                    done = true;
+                }
+            }
+
+            break;
+        default:    break;
+    }
+
+    if (done)
+    {
+        BaseType_t higher_priority_task_woken = pdFALSE;
+
+        USCI_B_I2C_disableInterrupt(base_address, I2C_ISR_INTERRUPTS);
+
+        if (xfer->task != NULL)
+        {
+            vTaskNotifyGiveFromISR(xfer->task, &higher_priority_task_woken);
+        }
+
+        portYIELD_FROM_ISR(higher_priority_task_woken);
+    }
+}
+
+/* Interrupt Service Routines */
+
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector=USCI_B0_VECTOR
+__interrupt
+#elif defined(__GNUC__)
+__attribute__((interrupt(USCI_B0_VECTOR)))
+#endif
+void USCI_B0_ISR(void)  // cppcheck-suppress misra-c2012-8.4
+{
+    i2c_isr_handler(I2C_PORT_0);
+}
+
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector=USCI_B1_VECTOR
+__interrupt
+#elif defined(__GNUC__)
+__attribute__((interrupt(USCI_B1_VECTOR)))
+#endif
+void USCI_B1_ISR(void)  // cppcheck-suppress misra-c2012-8.4
+{
+    i2c_isr_handler(I2C_PORT_1);
+}
+
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector=USCI_B2_VECTOR
+__interrupt
+#elif defined(__GNUC__)
+__attribute__((interrupt(USCI_B2_VECTOR)))
+#endif
+void USCI_B2_ISR(void)  // cppcheck-suppress misra-c2012-8.4
+{
+    i2c_isr_handler(I2C_PORT_2);
+}
+
+/** \} End of i2c_isr group */
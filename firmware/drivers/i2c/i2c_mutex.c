@@ -0,0 +1,160 @@
+/*
+ * i2c_mutex.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief I2C ports mutex implementation.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.7
+ *
+ * \date 2022/11/25
+ *
+ * \defgroup i2c_mutex Mutex
+ * \ingroup i2c
+ * \{
+ */
+
+#include <FreeRTOS.h>
+#include <task.h>
+#include <semphr.h>
+
+#include <config/config.h>
+#include <system/sys_log/sys_log.h>
+
+#include "i2c.h"
+
+#define I2C_MUTEX_PORTS         (I2C_PORT_2 + 1)
+
+static SemaphoreHandle_t i2c_mutex[I2C_MUTEX_PORTS] = {NULL};
+
+static i2c_bus_stats_t i2c_bus_stats[I2C_MUTEX_PORTS] = {0};
+
+int i2c_mutex_create(i2c_port_t port)
+{
+    int err = -1;
+
+    if ((uint8_t)port < I2C_MUTEX_PORTS)
+    {
+        if (i2c_mutex[port] == NULL)
+        {
+            /* Mutex type semaphore (with priority inheritance) */
+            i2c_mutex[port] = xSemaphoreCreateMutex();
+        }
+
+        if (i2c_mutex[port] == NULL)
+        {
+        #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+            sys_log_print_event_from_module(SYS_LOG_ERROR, I2C_MODULE_NAME, "Error creating the mutex of port ");
+            sys_log_print_uint(port);
+            sys_log_print_msg("!");
+            sys_log_new_line();
+        #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+        }
+        else
+        {
+            err = 0;
+        }
+    }
+
+    return err;
+}
+
+int i2c_mutex_take(i2c_port_t port)
+{
+    int err = -1;
+
+    if (((uint8_t)port < I2C_MUTEX_PORTS) && (i2c_mutex[port] != NULL))
+    {
+        if (xSemaphoreTake(i2c_mutex[port], 0) == pdTRUE)
+        {
+            err = 0;
+        }
+        else
+        {
+            taskENTER_CRITICAL();
+
+            i2c_bus_stats[port].contentions++;
+
+            taskEXIT_CRITICAL();
+
+            /* The port is in use by another task: wait I2C_MUTEX_WAIT_TIME_MS ms for it to become free */
+            if (xSemaphoreTake(i2c_mutex[port], pdMS_TO_TICKS(I2C_MUTEX_WAIT_TIME_MS)) == pdTRUE)
+            {
+                err = 0;
+            }
+            else
+            {
+                taskENTER_CRITICAL();
+
+                i2c_bus_stats[port].timeouts++;
+
+                taskEXIT_CRITICAL();
+
+                SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_I2C, SYS_LOG_TOK_BUS_PORT_TIMEOUT, port, 0);
+
+            #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+                sys_log_print_event_from_module(SYS_LOG_ERROR, I2C_MODULE_NAME, "Timeout waiting for port ");
+                sys_log_print_uint(port);
+                sys_log_print_msg("!");
+                sys_log_new_line();
+            #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+            }
+        }
+
+        if (err == 0)
+        {
+            /* Only the mutex holder updates this counter */
+            i2c_bus_stats[port].transactions++;
+        }
+    }
+
+    return err;
+}
+
+int i2c_mutex_give(i2c_port_t port)
+{
+    int err = -1;
+
+    if (((uint8_t)port < I2C_MUTEX_PORTS) && (i2c_mutex[port] != NULL))
+    {
+        xSemaphoreGive(i2c_mutex[port]);
+
+        err = 0;
+    }
+
+    return err;
+}
+
+void i2c_mutex_get_stats(i2c_port_t port, i2c_bus_stats_t *stats)
+{
+    if ((uint8_t)port < I2C_MUTEX_PORTS)
+    {
+        taskENTER_CRITICAL();
+
+        *stats = i2c_bus_stats[port];
+
+        taskEXIT_CRITICAL();
+    }
+}
+
+/** \} End of i2c_mutex group */
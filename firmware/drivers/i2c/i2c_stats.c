@@ -0,0 +1,112 @@
+/*
+ * i2c_stats.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief I2C transaction statistics implementation.
+ *
+ * A transaction is a whole transfer (from the start to the stop condition).
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.16
+ *
+ * \date 2022/12/04
+ *
+ * \defgroup i2c_stats Statistics
+ * \ingroup i2c
+ * \{
+ */
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <drivers/timer/timer.h>
+
+#include "i2c.h"
+
+#define I2C_STATS_PORTS         (I2C_PORT_2 + 1)
+
+static bus_stats_t i2c_stats[I2C_STATS_PORTS] = {0};
+
+void i2c_stats_add(i2c_port_t port, uint32_t start_us, uint16_t len, int err)
+{
+    if ((uint8_t)port < I2C_STATS_PORTS)
+    {
+        uint32_t dur_us = timer_get_us() - start_us;
+
+        taskENTER_CRITICAL();
+
+        bus_stats_add(&i2c_stats[port], dur_us, len, err != 0);
+
+        taskEXIT_CRITICAL();
+    }
+}
+
+void i2c_stats_timeout(i2c_port_t port)
+{
+    if ((uint8_t)port < I2C_STATS_PORTS)
+    {
+        taskENTER_CRITICAL();
+
+        bus_stats_add_timeout(&i2c_stats[port]);
+
+        taskEXIT_CRITICAL();
+    }
+}
+
+int i2c_stats_get(i2c_port_t port, bus_stats_t *stats)
+{
+    int err = -1;
+
+    if ((uint8_t)port < I2C_STATS_PORTS)
+    {
+        taskENTER_CRITICAL();
+
+        *stats = i2c_stats[port];
+
+        taskEXIT_CRITICAL();
+
+        err = 0;
+    }
+
+    return err;
+}
+
+int i2c_stats_reset(i2c_port_t port)
+{
+    int err = -1;
+
+    if ((uint8_t)port < I2C_STATS_PORTS)
+    {
+        taskENTER_CRITICAL();
+
+        bus_stats_reset(&i2c_stats[port]);
+
+        taskEXIT_CRITICAL();
+
+        err = 0;
+    }
+
+    return err;
+}
+
+/** \} End of i2c_stats group */
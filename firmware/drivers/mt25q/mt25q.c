@@ -391,35 +391,40 @@ int mt25q_die_erase(mt25q_sector_t die)
 
                 if (mt25q_spi_select() == 0)
                 {
+                    int spi_err = -1;
+
                     /* Write the erase command */
                     if (mt25q_spi_write_only(&cmd, 1) == 0)
                     {
                         /* Write the address */
                         if (mt25q_spi_write_only(adr_arr, mt25q_fdo.num_adr_byte) == 0)
                         {
-                            if (mt25q_spi_unselect() == 0)
+                            spi_err = 0;
+                        }
+                    }
+
+                    /* Always deselects, also releasing the SPI port (even after a failed transfer) */
+                    if ((mt25q_spi_unselect() == 0) && (spi_err == 0))
+                    {
+                        /* Wait till complete */
+                        for(i = 0; i < MT25Q_SECTOR_ERASE_TIMEOUT_MS; i++)
+                        {
+                            if (!mt25q_is_busy())
                             {
-                                /* Wait till complete */
-                                for(i = 0; i < MT25Q_SECTOR_ERASE_TIMEOUT_MS; i++)
-                                {
-                                    if (!mt25q_is_busy())
-                                    {
-                                        break;
-                                    }
+                                break;
+                            }
 
-                                    mt25q_delay_ms(1);
-                                }
+                            mt25q_delay_ms(1);
+                        }
 
-                                uint8_t flag = 0;
-                                if (mt25q_read_flag_status_register(&flag) == 0)
+                        uint8_t flag = 0;
+                        if (mt25q_read_flag_status_register(&flag) == 0)
+                        {
+                            if (mt25q_clear_flag_status_register() == 0)
+                            {
+                                if (i < MT25Q_SECTOR_ERASE_TIMEOUT_MS)
                                 {
-                                    if (mt25q_clear_flag_status_register() == 0)
-                                    {
-                                        if (i < MT25Q_SECTOR_ERASE_TIMEOUT_MS)
-                                        {
-                                            err = 0;
-                                        }
-                                    }
+                                    err = 0;
                                 }
                             }
                         }
@@ -472,35 +477,40 @@ int mt25q_sector_erase(mt25q_sector_t sector)
 
                 if (mt25q_spi_select() == 0)
                 {
+                    int spi_err = -1;
+
                     /* Write the erase command */
                     if (mt25q_spi_write_only(&cmd, 1) == 0)
                     {
                         /* Write the address */
                         if (mt25q_spi_write_only(adr_arr, mt25q_fdo.num_adr_byte) == 0)
                         {
-                            if (mt25q_spi_unselect() == 0)
+                            spi_err = 0;
+                        }
+                    }
+
+                    /* Always deselects, also releasing the SPI port (even after a failed transfer) */
+                    if ((mt25q_spi_unselect() == 0) && (spi_err == 0))
+                    {
+                        /* Wait till complete */
+                        for(i = 0; i < MT25Q_SECTOR_ERASE_TIMEOUT_MS; i++)
+                        {
+                            if (!mt25q_is_busy())
                             {
-                                /* Wait till complete */
-                                for(i = 0; i < MT25Q_SECTOR_ERASE_TIMEOUT_MS; i++)
-                                {
-                                    if (!mt25q_is_busy())
-                                    {
-                                        break;
-                                    }
+                                break;
+                            }
 
-                                    mt25q_delay_ms(1);
-                                }
+                            mt25q_delay_ms(1);
+                        }
 
-                                uint8_t flag = 0;
-                                if (mt25q_read_flag_status_register(&flag) == 0)
+                        uint8_t flag = 0;
+                        if (mt25q_read_flag_status_register(&flag) == 0)
+                        {
+                            if (mt25q_clear_flag_status_register() == 0)
+                            {
+                                if (i < MT25Q_SECTOR_ERASE_TIMEOUT_MS)
                                 {
-                                    if (mt25q_clear_flag_status_register() == 0)
-                                    {
-                                        if (i < MT25Q_SECTOR_ERASE_TIMEOUT_MS)
-                                        {
-                                            err = 0;
-                                        }
-                                    }
+                                    err = 0;
                                 }
                             }
                         }
@@ -553,35 +563,40 @@ int mt25q_sub_sector_erase(mt25q_sector_t sub)
 
                 if (mt25q_spi_select() == 0)
                 {
+                    int spi_err = -1;
+
                     /* Write the erase command */
                     if (mt25q_spi_write_only(&cmd, 1) == 0)
                     {
                         /* Write the address */
                         if (mt25q_spi_write_only(adr_arr, mt25q_fdo.num_adr_byte) == 0)
                         {
-                            if (mt25q_spi_unselect() == 0)
+                            spi_err = 0;
+                        }
+                    }
+
+                    /* Always deselects, also releasing the SPI port (even after a failed transfer) */
+                    if ((mt25q_spi_unselect() == 0) && (spi_err == 0))
+                    {
+                        /* Wait till complete */
+                        for(i = 0; i < MT25Q_SECTOR_ERASE_TIMEOUT_MS; i++)
+                        {
+                            if (!mt25q_is_busy())
                             {
-                                /* Wait till complete */
-                                for(i = 0; i < MT25Q_SECTOR_ERASE_TIMEOUT_MS; i++)
-                                {
-                                    if (!mt25q_is_busy())
-                                    {
-                                        break;
-                                    }
+                                break;
+                            }
 
-                                    mt25q_delay_ms(1);
-                                }
+                            mt25q_delay_ms(1);
+                        }
 
-                                uint8_t flag = 0;
-                                if (mt25q_read_flag_status_register(&flag) == 0)
+                        uint8_t flag = 0;
+                        if (mt25q_read_flag_status_register(&flag) == 0)
+                        {
+                            if (mt25q_clear_flag_status_register() == 0)
+                            {
+                                if (i < MT25Q_SECTOR_ERASE_TIMEOUT_MS)
                                 {
-                                    if (mt25q_clear_flag_status_register() == 0)
-                                    {
-                                        if (i < MT25Q_SECTOR_ERASE_TIMEOUT_MS)
-                                        {
-                                            err = 0;
-                                        }
-                                    }
+                                    err = 0;
                                 }
                             }
                         }
@@ -679,6 +694,8 @@ int mt25q_read(uint32_t adr, uint8_t *data, uint16_t len)
 
         if (mt25q_spi_select() == 0)
         {
+            int spi_err = -1;
+
             /* Write the READ command */
             if (mt25q_spi_write_only(&cmd, 1) == 0)
             {
@@ -688,13 +705,16 @@ int mt25q_read(uint32_t adr, uint8_t *data, uint16_t len)
                     /* Read the data */
                     if (mt25q_spi_read_only(data, len) == 0)
                     {
-                        if (mt25q_spi_unselect() == 0)
-                        {
-                            err = 0;
-                        }
+                        spi_err = 0;
                     }
                 }
             }
+
+            /* Always deselects, also releasing the SPI port (even after a failed transfer) */
+            if ((mt25q_spi_unselect() == 0) && (spi_err == 0))
+            {
+                err = 0;
+            }
         }
     }
 
@@ -793,6 +813,8 @@ static int mt25q_gen_program(uint32_t adr, uint8_t *data, uint32_t len, uint8_t
 
             if (mt25q_spi_select() == 0)
             {
+                int spi_err = -1;
+
                 /* Write the PROGRAM command */
                 if (mt25q_spi_write_only(&cmd, 1) == 0)
                 {
@@ -802,33 +824,36 @@ static int mt25q_gen_program(uint32_t adr, uint8_t *data, uint32_t len, uint8_t
                         /* Write the data */
                         if (mt25q_spi_write_only(data, len) == 0)
                         {
-                            if (mt25q_spi_unselect() == 0)
-                            {
-                                /* Wait till complete */
-                                uint16_t i = 0;
-                                for(i = 0; i < MT25Q_PROGRAM_TIMEOUT_MS; i++)
-                                {
-                                    if (!mt25q_is_busy())
-                                    {
-                                        break;
-                                    }
+                            spi_err = 0;
+                        }
+                    }
+                }
 
-                                    mt25q_delay_ms(1);
-                                }
+                /* Always deselects, also releasing the SPI port (even after a failed transfer) */
+                if ((mt25q_spi_unselect() == 0) && (spi_err == 0))
+                {
+                    /* Wait till complete */
+                    uint16_t i = 0;
+                    for(i = 0; i < MT25Q_PROGRAM_TIMEOUT_MS; i++)
+                    {
+                        if (!mt25q_is_busy())
+                        {
+                            break;
+                        }
 
-                                uint8_t flag = 0;
-                                if (mt25q_read_flag_status_register(&flag) == 0)
+                        mt25q_delay_ms(1);
+                    }
+
+                    uint8_t flag = 0;
+                    if (mt25q_read_flag_status_register(&flag) == 0)
+                    {
+                        if (mt25q_clear_flag_status_register() == 0)
+                        {
+                            if (((flag & MT25Q_REG_FLAG_STATUS_PROGRAM) == 0U) && ((flag & MT25Q_REG_FLAG_STATUS_PROTECTION) == 0U))
+                            {
+                                if (i < MT25Q_PROGRAM_TIMEOUT_MS)
                                 {
-                                    if (mt25q_clear_flag_status_register() == 0)
-                                    {
-                                        if (((flag & MT25Q_REG_FLAG_STATUS_PROGRAM) == 0U) && ((flag & MT25Q_REG_FLAG_STATUS_PROTECTION) == 0U))
-                                        {
-                                            if (i < MT25Q_PROGRAM_TIMEOUT_MS)
-                                            {
-                                                err = 0;
-                                            }
-                                        }
-                                    }
+                                    err = 0;
                                 }
                             }
                         }
@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.7.42
+ * \version 0.10.17
  * 
  * \date 2019/11/15
  * 
@@ -40,7 +40,7 @@
 
 #define MT25Q_SPI_PORT          SPI_PORT_0
 #define MT25Q_SPI_MODE          SPI_MODE_0
-#define MT25Q_SPI_CLK_HZ        CONFIG_SPI_PORT_0_SPEED_BPS
+#define MT25Q_SPI_CLK_HZ        CONFIG_SPI_NOR_SPEED_BPS
 #define MT25Q_SPI_CS_PIN        SPI_CS_2
 
 int mt25q_spi_init(void)
@@ -50,7 +50,7 @@ int mt25q_spi_init(void)
     conf.speed_hz   = MT25Q_SPI_CLK_HZ;
     conf.mode       = MT25Q_SPI_MODE;
 
-    return spi_init(MT25Q_SPI_PORT, conf);
+    return spi_init_device(MT25Q_SPI_PORT, MT25Q_SPI_CS_PIN, conf);
 }
 
 int mt25q_spi_write(uint8_t *data, uint16_t len)
@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.9.6
+ * \version 0.10.14
  * 
  * \date 2020/02/05
  * 
@@ -33,13 +33,188 @@
  * \{
  */
 
+#include <stddef.h>
 #include <stdbool.h>
+#include <string.h>
 
 #include "sl_eps2.h"
 
 #define SL_EPS2_CRC8_INITIAL_VALUE          0U      /**< CRC8-CCITT initial value. */
 #define SL_EPS2_CRC8_POLYNOMIAL             0x07U   /**< CRC8-CCITT polynomial. */
 
+#define SL_EPS2_BLOCK_FRAME_LEN(n)          (1U + (4U * (n)) + 1U)  /**< Address + n registers + CRC-8. */
+
+#define SL_EPS2_DATA_FIRST_REG              SL_EPS2_REG_TIME_COUNTER_MS     /**< First register of sl_eps2_data_t. */
+#define SL_EPS2_DATA_LAST_REG               SL_EPS2_REG_BAT_HEATER_2_MODE   /**< Last register of sl_eps2_data_t. */
+
+/**
+ * \brief Location of a register value in the data structure.
+ */
+typedef struct
+{
+    uint8_t reg;        /**< Register address. */
+    uint8_t offset;     /**< Offset of the field in sl_eps2_data_t. */
+    uint8_t size;       /**< Size of the field in bytes. */
+} sl_eps2_data_field_t;
+
+#define SL_EPS2_DATA_FIELD(reg, field)      {(reg), (uint8_t)offsetof(sl_eps2_data_t, field), (uint8_t)sizeof(((sl_eps2_data_t *)0)->field)}
+
+/**
+ * \brief Register to sl_eps2_data_t field map (the hardware and firmware versions are not part of it).
+ */
+static const sl_eps2_data_field_t sl_eps2_data_map[] =
+{
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_TIME_COUNTER_MS,             time_counter),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_UC_TEMPERATURE_K,            temperature_uc),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_CURRENT_MA,                  current),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_LAST_RESET_CAUSE,            last_reset_cause),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_RESET_COUNTER,               reset_counter),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_SOLAR_PANEL_MY_PX_VOLT_MV,   solar_panel_voltage_my_px),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_SOLAR_PANEL_MX_PZ_VOLT_MV,   solar_panel_voltage_mx_pz),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_SOLAR_PANEL_MZ_PY_VOLT_MV,   solar_panel_voltage_mz_py),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_SOLAR_PANEL_MY_CUR_MA,       solar_panel_current_my),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_SOLAR_PANEL_PY_CUR_MA,       solar_panel_current_py),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_SOLAR_PANEL_MX_CUR_MA,       solar_panel_current_mx),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_SOLAR_PANEL_PX_CUR_MA,       solar_panel_current_px),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_SOLAR_PANEL_MZ_CUR_MA,       solar_panel_current_mz),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_SOLAR_PANEL_PZ_CUR_MA,       solar_panel_current_pz),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_MPPT_1_DUTY_CYCLE,           mppt_1_duty_cycle),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_MPPT_2_DUTY_CYCLE,           mppt_2_duty_cycle),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_MPPT_3_DUTY_CYCLE,           mppt_3_duty_cycle),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_SOLAR_PANEL_TOTAL_VOLT_MV,   solar_panel_output_voltage),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_MAIN_POWER_BUS_VOLT_MV,      main_power_bus_voltage),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_RTD0_TEMP_K,                 rtd_0_temperature),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_RTD1_TEMP_K,                 rtd_1_temperature),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_RTD2_TEMP_K,                 rtd_2_temperature),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_RTD3_TEMP_K,                 rtd_3_temperature),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_RTD4_TEMP_K,                 rtd_4_temperature),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_RTD5_TEMP_K,                 rtd_5_temperature),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_RTD6_TEMP_K,                 rtd_6_temperature),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_BATTERY_VOLT_MV,             battery_voltage),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_BATTERY_CUR_MA,              battery_current),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_BATTERY_AVEG_CUR_MA,         battery_average_current),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_BATTERY_ACC_CUR_MA,          battery_acc_current),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_BATTERY_CHARGE_MAH,          battery_charge),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_BAT_MONITOR_TEMP_K,          battery_monitor_temperature),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_BAT_MONITOR_STATUS,          battery_monitor_status),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_BAT_MONITOR_PROTECTION,      battery_monitor_protection),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_BAT_MONITOR_CYCLE_COUNTER,   battery_monitor_cycle_counter),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_BAT_MONITOR_RAAC_MAH,        raac),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_BAT_MONITOR_RSAC_MAH,        rsac),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_BAT_MONITOR_RARC_PERC,       rarc),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_BAT_MONITOR_RSRC_PERC,       rsrc),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_BAT_HEATER_1_DUTY_CYCLE,     battery_heater_1_duty_cycle),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_BAT_HEATER_2_DUTY_CYCLE,     battery_heater_2_duty_cycle),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_MPPT_1_MODE,                 mppt_1_mode),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_MPPT_2_MODE,                 mppt_2_mode),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_MPPT_3_MODE,                 mppt_3_mode),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_BAT_HEATER_1_MODE,           battery_heater_1_mode),
+    SL_EPS2_DATA_FIELD(SL_EPS2_REG_BAT_HEATER_2_MODE,           battery_heater_2_mode)
+};
+
+/**
+ * \brief Answer of the last block read (too big for the stack of the calling tasks).
+ */
+static uint8_t sl_eps2_block_buf[SL_EPS2_BLOCK_FRAME_LEN(SL_EPS2_BLOCK_READ_MAX_REGS)] = {0};
+
+/**
+ * \brief Consecutive data block requests without a valid answer (the block read is not used after SL_EPS2_BLOCK_READ_MAX_ERRORS).
+ */
+static uint8_t sl_eps2_block_errors = 0;
+
+/**
+ * \brief Data reads by register since the last block read probe.
+ */
+static uint8_t sl_eps2_block_skipped = 0;
+
+/**
+ * \brief Pending answer of a read request.
+ */
+typedef struct
+{
+    sl_eps2_config_t *config;   /**< Configuration parameters of the driver. */
+    uint8_t *buf;               /**< Buffer to store the answer. */
+    uint8_t len;                /**< Length of the answer. */
+    uint8_t adr;                /**< Requested register address (first byte of the answer). */
+    int err;                    /**< Error reading the I2C bus. */
+} sl_eps2_answer_t;
+
+static ready_t sl_eps2_ready = READY_INIT(SL_EPS2_ANSWER_POLL_MS);
+
+/**
+ * \brief Waits for and reads the answer of a read request.
+ *
+ * \param[in] config is a structure with the configuration parameters of the driver.
+ *
+ * \param[in] adr is the requested register address.
+ *
+ * \param[in,out] buf is a buffer to store the answer.
+ *
+ * \param[in] len is the length of the answer (including the CRC-8 byte).
+ *
+ * \param[in] min_delay_ms is the time the EPS takes to prepare the answer (no read before it).
+ *
+ * \return The status/error code.
+ */
+static int sl_eps2_read_answer(sl_eps2_config_t config, uint8_t adr, uint8_t *buf, uint8_t len, uint8_t min_delay_ms);
+
+/**
+ * \brief Checks if a pending answer is ready and reads it.
+ *
+ * While the answer is being prepared, the first byte read is not the requested address. Only this
+ * byte is polled, and the whole answer is read once it matches.
+ *
+ * \param[in,out] arg is a pointer to the pending answer (sl_eps2_answer_t).
+ *
+ * \return TRUE/FALSE if the answer is ready (or the bus failed) or not.
+ */
+static bool sl_eps2_answer_ready(void *arg);
+
+/**
+ * \brief Reads a sequence of registers to the block read buffer.
+ *
+ * \param[in] config is a structure with the configuration parameters of the driver.
+ *
+ * \param[in] adr is the address of the first register to read.
+ *
+ * \param[in] n is the number of registers to read.
+ *
+ * \return The status/error code (-2 if the request was written but no valid answer was read).
+ */
+static int sl_eps2_read_block_raw(sl_eps2_config_t config, uint8_t adr, uint8_t n);
+
+/**
+ * \brief Gets a register value from the block read buffer.
+ *
+ * \param[in] i is the position of the register in the last block read.
+ *
+ * \return The register value.
+ */
+static uint32_t sl_eps2_block_reg(uint8_t i);
+
+/**
+ * \brief Reads all the EPS variables and parameters one register at a time.
+ *
+ * \param[in] config is a structure with the configuration parameters of the driver.
+ *
+ * \param[in,out] data is a pointer to store the read EPS data.
+ *
+ * \return The number of registers that could not be read.
+ */
+static int sl_eps2_read_data_by_reg(sl_eps2_config_t config, sl_eps2_data_t *data);
+
+/**
+ * \brief Checks if the data must be read with a block read.
+ *
+ * After SL_EPS2_BLOCK_READ_MAX_ERRORS consecutive block requests without a valid answer (a
+ * firmware without the block read command), the block read is only probed again once every
+ * SL_EPS2_BLOCK_READ_RETRY_PERIOD reads, since a new EPS firmware can be loaded without a reset
+ * of the OBDH.
+ *
+ * \return TRUE/FALSE if the block read must be used or not.
+ */
+static bool sl_eps2_use_block_read(void);
+
 /**
  * \brief Computes the CRC-8 of a sequence of bytes.
  *
@@ -68,6 +243,10 @@ int sl_eps2_init(sl_eps2_config_t config)
 {
     int err = 0;
 
+    /* A new EPS firmware may have been loaded: probes the block read again */
+    sl_eps2_block_errors = 0U;
+    sl_eps2_block_skipped = 0U;
+
     if (sl_eps2_i2c_init(config) != 0)
     {
         err = -1;   /* Error initializing the I2C port */
@@ -121,40 +300,136 @@ int sl_eps2_write_reg(sl_eps2_config_t config, uint8_t adr, uint32_t val)
 
 int sl_eps2_read_reg(sl_eps2_config_t config, uint8_t adr, uint32_t *val)
 {
-
-    int err = 0;
+    int err = -1;
 
     uint8_t buf[1 + 4 + 1] = {0};
 
     buf[0] = adr;
     buf[1] = sl_eps2_crc8(buf, 1);
 
-    if (sl_eps2_i2c_write(config, buf, 2U) != TCA4311A_READY)
+    if (sl_eps2_i2c_write(config, buf, 2U) == TCA4311A_READY)
     {
-        err = -1;
+        err = sl_eps2_read_answer(config, adr, buf, 6U, SL_EPS2_ANSWER_MIN_DELAY_MS);
     }
 
-    sl_eps2_delay_ms(50);
+    *val = ((uint32_t)buf[1] << 24) |
+           ((uint32_t)buf[2] << 16) |
+           ((uint32_t)buf[3] << 8)  |
+           ((uint32_t)buf[4] << 0);
 
-    if (sl_eps2_i2c_read(config, buf, 6U) != TCA4311A_READY)
+    return err;
+}
+
+int sl_eps2_read_block(sl_eps2_config_t config, uint8_t adr, uint8_t n, uint32_t *val)
+{
+    int err = -1;
+
+    if (sl_eps2_read_block_raw(config, adr, n) == 0)
     {
-        err = -1;
+        err = 0;
+
+        uint8_t i = 0U;
+        for(i = 0U; i < n; i++)
+        {
+            val[i] = sl_eps2_block_reg(i);
+        }
+    }
+
+    return err;
+}
+
+void sl_eps2_get_answer_stats(ready_stats_t *stats)
+{
+    ready_get_stats(&sl_eps2_ready, stats);
+}
+
+int sl_eps2_read_data(sl_eps2_config_t config, sl_eps2_data_t *data)
+{
+    int err_counter = 0;
+
+    int err = -1;
+
+    if (sl_eps2_use_block_read())
+    {
+        err = sl_eps2_read_block_raw(config, SL_EPS2_DATA_FIRST_REG, SL_EPS2_DATA_LAST_REG - SL_EPS2_DATA_FIRST_REG + 1U);
+
+        if (err == 0)
+        {
+            sl_eps2_block_errors = 0U;
+        }
+        else if ((err == -2) && (sl_eps2_block_errors < SL_EPS2_BLOCK_READ_MAX_ERRORS))
+        {
+            /* No valid answer to a request the EPS received: a firmware without the block read command, or a corrupted answer */
+            sl_eps2_block_errors++;
+        }
+        else
+        {
+            /* I2C error or block read still not supported */
+        }
     }
 
-    if (!sl_eps2_check_crc(buf, 5U, buf[5]))
+    if (err == 0)
     {
-        err = -1;
+        uint8_t i = 0U;
+        for(i = 0U; i < (sizeof(sl_eps2_data_map) / sizeof(sl_eps2_data_field_t)); i++)
+        {
+            sl_eps2_data_field_t field = sl_eps2_data_map[i];
+
+            uint32_t val = sl_eps2_block_reg(field.reg - SL_EPS2_DATA_FIRST_REG);
+
+            uint8_t *dst = (uint8_t*)data + field.offset;
+
+            switch(field.size)
+            {
+                case sizeof(uint8_t):
+                {
+                    uint8_t val8 = (uint8_t)val;
+                    memcpy(dst, &val8, sizeof(uint8_t));
+                    break;
+                }
+                case sizeof(uint16_t):
+                {
+                    uint16_t val16 = (uint16_t)val;
+                    memcpy(dst, &val16, sizeof(uint16_t));
+                    break;
+                }
+                default:
+                    memcpy(dst, &val, sizeof(uint32_t));
+                    break;
+            }
+        }
+    }
+    else
+    {
+        err_counter = sl_eps2_read_data_by_reg(config, data);
     }
 
-    *val = ((uint32_t)buf[1] << 24) |
-           ((uint32_t)buf[2] << 16) |
-           ((uint32_t)buf[3] << 8)  |
-           ((uint32_t)buf[4] << 0);
+    return err_counter;
+}
 
-    return err;
+static bool sl_eps2_use_block_read(void)
+{
+    bool res = false;
+
+    if (sl_eps2_block_errors < SL_EPS2_BLOCK_READ_MAX_ERRORS)
+    {
+        res = true;
+    }
+    else if (++sl_eps2_block_skipped >= SL_EPS2_BLOCK_READ_RETRY_PERIOD)
+    {
+        sl_eps2_block_skipped = 0U;
+
+        res = true;
+    }
+    else
+    {
+        /* Reads by register */
+    }
+
+    return res;
 }
 
-int sl_eps2_read_data(sl_eps2_config_t config, sl_eps2_data_t *data)
+static int sl_eps2_read_data_by_reg(sl_eps2_config_t config, sl_eps2_data_t *data)
 {
     int err_counter = 0;
 
@@ -1006,6 +1281,90 @@ int sl_eps2_get_heater_mode(sl_eps2_config_t config, uint8_t heater, uint8_t *va
     return res;
 }
 
+static int sl_eps2_read_block_raw(sl_eps2_config_t config, uint8_t adr, uint8_t n)
+{
+    int err = -1;
+
+    if ((n > 0U) && (((uint16_t)adr + n) <= SL_EPS2_BLOCK_READ_MAX_REGS))
+    {
+        uint8_t req[1 + 1 + 1] = {0};
+
+        req[0] = adr;
+        req[1] = n;
+        req[2] = sl_eps2_crc8(req, 2);
+
+        if (sl_eps2_i2c_write(config, req, 3U) == TCA4311A_READY)
+        {
+            if (sl_eps2_read_answer(config, adr, sl_eps2_block_buf, SL_EPS2_BLOCK_FRAME_LEN(n), SL_EPS2_BLOCK_ANSWER_MIN_DELAY_MS) == 0)
+            {
+                err = 0;
+            }
+            else
+            {
+                err = -2;
+            }
+        }
+    }
+
+    return err;
+}
+
+static int sl_eps2_read_answer(sl_eps2_config_t config, uint8_t adr, uint8_t *buf, uint8_t len, uint8_t min_delay_ms)
+{
+    int err = -1;
+
+    sl_eps2_answer_t ans = {&config, buf, len, adr, 0};
+
+    /* The answer of the previous request can echo the same address, so it is not polled before the EPS prepared the new one */
+    sl_eps2_delay_ms(min_delay_ms);
+
+    if ((ready_wait(&sl_eps2_ready, SL_EPS2_ANSWER_TIMEOUT_MS, sl_eps2_answer_ready, &ans) == 0) && (ans.err == 0))
+    {
+        if (sl_eps2_check_crc(buf, len - 1U, buf[len - 1U]))
+        {
+            err = 0;
+        }
+    }
+
+    return err;
+}
+
+static bool sl_eps2_answer_ready(void *arg)
+{
+    sl_eps2_answer_t *ans = (sl_eps2_answer_t*)arg;
+
+    bool res = true;
+
+    if (sl_eps2_i2c_read(*ans->config, ans->buf, 1U) != TCA4311A_READY)
+    {
+        ans->err = -1;
+    }
+    else
+    {
+        res = (ans->buf[0] == ans->adr);
+
+        if (res)
+        {
+            if (sl_eps2_i2c_read(*ans->config, ans->buf, ans->len) != TCA4311A_READY)
+            {
+                ans->err = -1;
+            }
+        }
+    }
+
+    return res;
+}
+
+static uint32_t sl_eps2_block_reg(uint8_t i)
+{
+    uint8_t *reg = &sl_eps2_block_buf[1U + (4U * i)];
+
+    return ((uint32_t)reg[0] << 24) |
+           ((uint32_t)reg[1] << 16) |
+           ((uint32_t)reg[2] << 8)  |
+           ((uint32_t)reg[3] << 0);
+}
+
 static uint8_t sl_eps2_crc8(uint8_t *data, uint8_t len)
 {
     uint8_t crc = SL_EPS2_CRC8_INITIAL_VALUE;
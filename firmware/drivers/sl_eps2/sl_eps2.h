@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.8.12
+ * \version 0.10.14
  * 
  * \date 2020/02/01
  * 
@@ -40,6 +40,7 @@
 #include <stdint.h>
 
 #include <drivers/tca4311a/tca4311a.h>
+#include <system/ready/ready.h>
 
 #define SL_EPS2_MODULE_NAME                     "SpaceLab EPS 2.0"
 
@@ -47,6 +48,14 @@
 
 #define SL_EPS2_DEVICE_ID                       0xEEE2U /**< EPS 2.0 device ID. */
 
+#define SL_EPS2_BLOCK_READ_MAX_REGS             49U     /**< Maximum number of registers of a block read (all registers). */
+#define SL_EPS2_BLOCK_READ_MAX_ERRORS           3U      /**< Consecutive block requests without a valid answer before reading the data by register. */
+#define SL_EPS2_BLOCK_READ_RETRY_PERIOD         30U     /**< Data reads by register before probing the block read again. */
+#define SL_EPS2_ANSWER_TIMEOUT_MS               50U     /**< Hard timeout of the answer of a read request in milliseconds. */
+#define SL_EPS2_ANSWER_POLL_MS                  2U      /**< Period between reads of a pending answer in milliseconds. */
+#define SL_EPS2_ANSWER_MIN_DELAY_MS             5U      /**< Delay before the first read of a register answer in milliseconds (the previous answer is still there). */
+#define SL_EPS2_BLOCK_ANSWER_MIN_DELAY_MS       12U     /**< Delay before the first read of a block answer in milliseconds (the EPS takes about 10 ms to prepare it). */
+
 /* EPS 2.0 registers */
 #define SL_EPS2_REG_TIME_COUNTER_MS             0       /**< Time counter in millseconds. */
 #define SL_EPS2_REG_UC_TEMPERATURE_K            1       /**< Temperature of the uC in K. */
@@ -305,9 +314,49 @@ int sl_eps2_write_reg(sl_eps2_config_t config, uint8_t adr, uint32_t val);
  */
 int sl_eps2_read_reg(sl_eps2_config_t config, uint8_t adr, uint32_t *val);
 
+/**
+ * \brief Reads a sequence of contiguous registers from the EPS module in a single transaction.
+ *
+ * The request is the first register address, the number of registers and a CRC-8 (3 bytes). The
+ * answer is the first register address, the value of each register (4 bytes, MSB first) and a
+ * single CRC-8 of the whole frame.
+ *
+ * The protocol has no sequence number: until the new answer is ready, the EPS keeps sending the
+ * previous one, which has a valid CRC-8 and can echo the same address. Because of that, the answer
+ * is only polled after SL_EPS2_BLOCK_ANSWER_MIN_DELAY_MS, the time the EPS takes to prepare it.
+ *
+ * \note This function is not reentrant (the answer is stored in a static buffer).
+ *
+ * \param[in] config is a structure with the configuration parameters of the driver.
+ *
+ * \param[in] adr is the address of the first register to read.
+ *
+ * \param[in] n is the number of registers to read (up to SL_EPS2_BLOCK_READ_MAX_REGS).
+ *
+ * \param[in,out] val is an array to store the n read values.
+ *
+ * \return The status/error code.
+ */
+int sl_eps2_read_block(sl_eps2_config_t config, uint8_t adr, uint8_t n, uint32_t *val);
+
+/**
+ * \brief Gets the learned latency statistics of the read requests answers.
+ *
+ * \param[in,out] stats is a pointer to store the statistics.
+ *
+ * \return None.
+ */
+void sl_eps2_get_answer_stats(ready_stats_t *stats);
+
 /**
  * \brief Reads all the EPS variables and parameters.
  *
+ * The registers are read with a single block read. If it fails (ex.: an EPS firmware without
+ * block read support), the registers are read one by one. After SL_EPS2_BLOCK_READ_MAX_ERRORS
+ * consecutive block requests without a valid answer, the registers are read one by one, and the
+ * block read is probed again once every SL_EPS2_BLOCK_READ_RETRY_PERIOD calls (or at the next
+ * sl_eps2_init call).
+ *
  * \param[in] config is a structure with the configuration parameters of the driver.
  *
  * \param[in,out] data is a pointe to store the read EPS data.
@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.8.13
+ * \version 0.10.13
  * 
  * \date 2021/05/12
  * 
@@ -33,6 +33,7 @@
  * \{
  */
 
+#include <stddef.h>
 #include <string.h>
 
 #include <config/config.h>
@@ -40,6 +41,108 @@
 
 #include "sl_ttc2.h"
 
+#define SL_TTC2_BLOCK_HEADER_LEN            3U      /**< Command ID + first address + number of registers. */
+#define SL_TTC2_BLOCK_FRAME_LEN(n)          (SL_TTC2_BLOCK_HEADER_LEN + (4U * (n)) + 2U)    /**< Header + n registers + CRC-16. */
+
+#define SL_TTC2_HK_FIRST_REG                SL_TTC2_REG_TIME_COUNTER        /**< First register of sl_ttc2_hk_data_t. */
+#define SL_TTC2_HK_LAST_REG                 SL_TTC2_REG_RX_PACKET_COUNTER   /**< Last register of sl_ttc2_hk_data_t. */
+
+/**
+ * \brief Location of a register value in the housekeeping data structure.
+ */
+typedef struct
+{
+    uint8_t reg;        /**< Register address. */
+    uint8_t offset;     /**< Offset of the field in sl_ttc2_hk_data_t. */
+    uint8_t size;       /**< Size of the field in bytes. */
+} sl_ttc2_hk_field_t;
+
+#define SL_TTC2_HK_FIELD(reg, field)        {(reg), (uint8_t)offsetof(sl_ttc2_hk_data_t, field), (uint8_t)sizeof(((sl_ttc2_hk_data_t *)0)->field)}
+
+/**
+ * \brief Register to sl_ttc2_hk_data_t field map (the TX enable register is not part of it).
+ */
+static const sl_ttc2_hk_field_t sl_ttc2_hk_map[] =
+{
+    SL_TTC2_HK_FIELD(SL_TTC2_REG_TIME_COUNTER,              time_counter),
+    SL_TTC2_HK_FIELD(SL_TTC2_REG_RESET_COUNTER,             reset_counter),
+    SL_TTC2_HK_FIELD(SL_TTC2_REG_LAST_RESET_CAUSE,          last_reset_cause),
+    SL_TTC2_HK_FIELD(SL_TTC2_REG_INPUT_VOLTAGE_MCU,         voltage_mcu),
+    SL_TTC2_HK_FIELD(SL_TTC2_REG_INPUT_CURRENT_MCU,         current_mcu),
+    SL_TTC2_HK_FIELD(SL_TTC2_REG_TEMPERATURE_MCU,           temperature_mcu),
+    SL_TTC2_HK_FIELD(SL_TTC2_REG_INPUT_VOLTAGE_RADIO,       voltage_radio),
+    SL_TTC2_HK_FIELD(SL_TTC2_REG_INPUT_CURRENT_RADIO,       current_radio),
+    SL_TTC2_HK_FIELD(SL_TTC2_REG_TEMPERATURE_RADIO,         temperature_radio),
+    SL_TTC2_HK_FIELD(SL_TTC2_REG_LAST_VALID_TC,             last_valid_tc),
+    SL_TTC2_HK_FIELD(SL_TTC2_REG_RSSI_LAST_VALID_TC,        rssi_last_valid_tc),
+    SL_TTC2_HK_FIELD(SL_TTC2_REG_TEMPERATURE_ANTENNA,       temperature_antenna),
+    SL_TTC2_HK_FIELD(SL_TTC2_REG_ANTENNA_STATUS,            antenna_status),
+    SL_TTC2_HK_FIELD(SL_TTC2_REG_ANTENNA_DEPLOYMENT_STATUS, deployment_status),
+    SL_TTC2_HK_FIELD(SL_TTC2_REG_ANTENNA_DEP_HIB_STATUS,    hibernation_status),
+    SL_TTC2_HK_FIELD(SL_TTC2_REG_TX_PACKET_COUNTER,         tx_packet_counter),
+    SL_TTC2_HK_FIELD(SL_TTC2_REG_RX_PACKET_COUNTER,         rx_packet_counter)
+};
+
+/* Block read frames (too big for the stack of the calling tasks) */
+static uint8_t sl_ttc2_block_wbuf[SL_TTC2_BLOCK_FRAME_LEN(SL_TTC2_BLOCK_READ_MAX_REGS)] = {0};
+static uint8_t sl_ttc2_block_rbuf[SL_TTC2_BLOCK_FRAME_LEN(SL_TTC2_BLOCK_READ_MAX_REGS)] = {0};
+
+/**
+ * \brief Consecutive invalid block answers of each radio (the block read is not used after SL_TTC2_BLOCK_READ_MAX_ERRORS).
+ */
+static uint8_t sl_ttc2_block_errors[SL_TTC2_RADIO_1 + 1] = {0};
+
+/**
+ * \brief Housekeeping data reads by register of each radio since the last block read probe.
+ */
+static uint8_t sl_ttc2_block_skipped[SL_TTC2_RADIO_1 + 1] = {0};
+
+/**
+ * \brief Checks if the housekeeping data of a radio must be read with a block read.
+ *
+ * After SL_TTC2_BLOCK_READ_MAX_ERRORS consecutive invalid answers (a firmware without the block
+ * read command), the block read is only probed again once every SL_TTC2_BLOCK_READ_RETRY_PERIOD
+ * reads, since a new TTC firmware can be loaded without a reset of the OBDH.
+ *
+ * \param[in] id is the radio ID.
+ *
+ * \return TRUE/FALSE if the block read must be used or not.
+ */
+static bool sl_ttc2_use_block_read(uint8_t id);
+
+/**
+ * \brief Reads a sequence of registers to the block read buffer.
+ *
+ * \param[in] config is a structure with the configuration parameters of the driver.
+ *
+ * \param[in] adr is the address of the first register to read.
+ *
+ * \param[in] n is the number of registers to read.
+ *
+ * \return The status/error code (-2 if the transfer was done but the answer is not valid).
+ */
+static int sl_ttc2_read_block_raw(sl_ttc2_config_t config, uint8_t adr, uint8_t n);
+
+/**
+ * \brief Gets a register value from the block read buffer.
+ *
+ * \param[in] i is the position of the register in the last block read.
+ *
+ * \return The register value.
+ */
+static uint32_t sl_ttc2_block_reg(uint8_t i);
+
+/**
+ * \brief Reads all the TTC variables and parameters one register at a time.
+ *
+ * \param[in] config is a structure with the configuration parameters of the driver.
+ *
+ * \param[in,out] data is a pointer to store the read TTC data.
+ *
+ * \return The number of registers that could not be read.
+ */
+static int sl_ttc2_read_hk_data_by_reg(sl_ttc2_config_t config, sl_ttc2_hk_data_t *data);
+
 /**
  * \brief Computes the CRC-16 of a sequence of bytes.
  *
@@ -68,6 +171,13 @@ int sl_ttc2_init(sl_ttc2_config_t config)
 {
     int err = -1;
 
+    if (config.id <= SL_TTC2_RADIO_1)
+    {
+        /* A new TTC firmware may have been loaded: probes the block read again */
+        sl_ttc2_block_errors[config.id] = 0U;
+        sl_ttc2_block_skipped[config.id] = 0U;
+    }
+
     if (sl_ttc2_spi_init(config) == 0)
     {
         sl_ttc2_delay_ms(10);
@@ -90,7 +200,7 @@ int sl_ttc2_init(sl_ttc2_config_t config)
 
 int sl_ttc2_check_device(sl_ttc2_config_t config)
 {
-    int err = 0;
+    int err = -1;
 
     uint16_t id = UINT16_MAX;
 
@@ -98,6 +208,8 @@ int sl_ttc2_check_device(sl_ttc2_config_t config)
     {
         uint16_t ref_id = 0;
 
+        err = 0;
+
         if (config.id == SL_TTC2_RADIO_0)
         {
             ref_id = SL_TTC2_DEVICE_ID_RADIO_0;
@@ -209,10 +321,117 @@ int sl_ttc2_read_reg(sl_ttc2_config_t config, uint8_t adr, uint32_t *val)
     return err;
 }
 
+int sl_ttc2_read_block(sl_ttc2_config_t config, uint8_t adr, uint8_t n, uint32_t *val)
+{
+    int err = -1;
+
+    if (sl_ttc2_read_block_raw(config, adr, n) == 0)
+    {
+        err = 0;
+
+        uint8_t i = 0U;
+        for(i = 0U; i < n; i++)
+        {
+            val[i] = sl_ttc2_block_reg(i);
+        }
+    }
+
+    return err;
+}
+
 int sl_ttc2_read_hk_data(sl_ttc2_config_t config, sl_ttc2_hk_data_t *data)
 {
     int err_counter = 0;
 
+    int err = -1;
+
+    if (sl_ttc2_use_block_read(config.id))
+    {
+        err = sl_ttc2_read_block_raw(config, SL_TTC2_HK_FIRST_REG, SL_TTC2_HK_LAST_REG - SL_TTC2_HK_FIRST_REG + 1U);
+
+        if (err == 0)
+        {
+            sl_ttc2_block_errors[config.id] = 0U;
+        }
+        else if ((err == -2) && (sl_ttc2_block_errors[config.id] < SL_TTC2_BLOCK_READ_MAX_ERRORS))
+        {
+            /* Invalid answer to a complete transfer: a firmware without the block read command, or a corrupted answer */
+            sl_ttc2_block_errors[config.id]++;
+        }
+        else
+        {
+            /* SPI error or block read still not supported */
+        }
+    }
+
+    if (err == 0)
+    {
+        uint8_t i = 0U;
+        for(i = 0U; i < (sizeof(sl_ttc2_hk_map) / sizeof(sl_ttc2_hk_field_t)); i++)
+        {
+            sl_ttc2_hk_field_t field = sl_ttc2_hk_map[i];
+
+            uint32_t val = sl_ttc2_block_reg(field.reg - SL_TTC2_HK_FIRST_REG);
+
+            uint8_t *dst = (uint8_t*)data + field.offset;
+
+            switch(field.size)
+            {
+                case sizeof(uint8_t):
+                {
+                    uint8_t val8 = (uint8_t)val;
+                    memcpy(dst, &val8, sizeof(uint8_t));
+                    break;
+                }
+                case sizeof(uint16_t):
+                {
+                    uint16_t val16 = (uint16_t)val;
+                    memcpy(dst, &val16, sizeof(uint16_t));
+                    break;
+                }
+                default:
+                    memcpy(dst, &val, sizeof(uint32_t));
+                    break;
+            }
+        }
+    }
+    else
+    {
+        err_counter = sl_ttc2_read_hk_data_by_reg(config, data);
+    }
+
+    return err_counter;
+}
+
+static bool sl_ttc2_use_block_read(uint8_t id)
+{
+    bool res = false;
+
+    if (id <= SL_TTC2_RADIO_1)
+    {
+        if (sl_ttc2_block_errors[id] < SL_TTC2_BLOCK_READ_MAX_ERRORS)
+        {
+            res = true;
+        }
+        else if (++sl_ttc2_block_skipped[id] >= SL_TTC2_BLOCK_READ_RETRY_PERIOD)
+        {
+            sl_ttc2_block_skipped[id] = 0U;
+
+            res = true;
+        }
+        else
+        {
+            /* Reads by register */
+        }
+    }
+
+    return res;
+}
+
+static int sl_ttc2_read_hk_data_by_reg(sl_ttc2_config_t config, sl_ttc2_hk_data_t *data)
+{
+    int err_counter = 0;
+
     /* Time counter */
     if (sl_ttc2_read_time_counter(config, &(data->time_counter)) != 0)
     {
@@ -679,6 +898,67 @@ int sl_ttc2_read_packet(sl_ttc2_config_t config, uint8_t *data, uint16_t *len)
     return err;
 }
 
+static int sl_ttc2_read_block_raw(sl_ttc2_config_t config, uint8_t adr, uint8_t n)
+{
+    int err = -1;
+
+    if ((n > 0U) && (((uint16_t)adr + n) <= SL_TTC2_BLOCK_READ_MAX_REGS))
+    {
+        uint16_t len = SL_TTC2_BLOCK_FRAME_LEN(n);
+
+        /* Command ID */
+        sl_ttc2_block_wbuf[0] = SL_TTC2_CMD_READ_BLOCK;
+
+        /* First register address */
+        sl_ttc2_block_wbuf[1] = adr;
+
+        /* Number of registers */
+        sl_ttc2_block_wbuf[2] = n;
+
+        /* Registers data + Checksum */
+        if (sl_ttc2_spi_transfer(config, sl_ttc2_block_wbuf, sl_ttc2_block_rbuf, len) == 0)
+        {
+            if ((sl_ttc2_block_rbuf[0] == SL_TTC2_CMD_READ_BLOCK) && (sl_ttc2_block_rbuf[1] == adr) && (sl_ttc2_block_rbuf[2] == n) &&
+                sl_ttc2_check_crc(sl_ttc2_block_rbuf, len - 2U, ((uint16_t)sl_ttc2_block_rbuf[len - 2U] << 8) | (uint16_t)sl_ttc2_block_rbuf[len - 1U]))
+            {
+                err = 0;
+            }
+            else
+            {
+                err = -2;
+
+            #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+                sys_log_print_event_from_module(SYS_LOG_ERROR, SL_TTC2_MODULE_NAME, "Error reading the registers block ");
+                sys_log_print_hex(adr);
+                sys_log_print_msg("! Invalid data!");
+                sys_log_new_line();
+            #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+            }
+        }
+        else
+        {
+        #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+            sys_log_print_event_from_module(SYS_LOG_ERROR, SL_TTC2_MODULE_NAME, "Error reading the registers block ");
+            sys_log_print_hex(adr);
+            sys_log_print_msg("! Error during SPI transfer!");
+            sys_log_new_line();
+        #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+        }
+    }
+
+    return err;
+}
+
+static uint32_t sl_ttc2_block_reg(uint8_t i)
+{
+    uint8_t *reg = &sl_ttc2_block_rbuf[SL_TTC2_BLOCK_HEADER_LEN + (4U * i)];
+
+    return ((uint32_t)reg[0] << 24) |
+           ((uint32_t)reg[1] << 16) |
+           ((uint32_t)reg[2] << 8)  |
+           ((uint32_t)reg[3] << 0);
+}
+
 static uint16_t sl_ttc2_crc16(uint8_t *data, uint16_t len)
 {
     uint8_t x;
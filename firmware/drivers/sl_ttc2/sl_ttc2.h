@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.8.13
+ * \version 0.10.13
  * 
  * \date 2021/05/12
  * 
@@ -54,6 +54,11 @@
 #define SL_TTC2_CMD_WRITE_REG                   2       /**< Write register command. */
 #define SL_TTC2_CMD_TRANSMIT_PKT                3       /**< Transmit packet command. */
 #define SL_TTC2_CMD_RECEIVE_PKT                 4       /**< Receive packet command. */
+#define SL_TTC2_CMD_READ_BLOCK                  5       /**< Read a sequence of registers command. */
+
+#define SL_TTC2_BLOCK_READ_MAX_REGS             24U     /**< Maximum number of registers of a block read (all registers). */
+#define SL_TTC2_BLOCK_READ_MAX_ERRORS           3U      /**< Consecutive invalid block answers before reading the housekeeping data by register. */
+#define SL_TTC2_BLOCK_READ_RETRY_PERIOD         30U     /**< Housekeeping data reads by register before probing the block read again. */
 
 /* TTC 2.0 Registers */
 #define SL_TTC2_REG_DEVICE_ID                   0       /**< Device ID (0xCC2A or 0xCC2B). */
@@ -228,9 +233,35 @@ int sl_ttc2_write_reg(sl_ttc2_config_t config, uint8_t adr, uint32_t val);
  */
 int sl_ttc2_read_reg(sl_ttc2_config_t config, uint8_t adr, uint32_t *val);
 
+/**
+ * \brief Reads a sequence of contiguous registers from the TTC module in a single transaction.
+ *
+ * The frame is the command ID, the first register address, the number of registers, the value
+ * of each register (4 bytes, MSB first) and a single CRC-16 of the whole frame.
+ *
+ * \note This function is not reentrant (the frame is stored in a static buffer).
+ *
+ * \param[in] config is a structure with the configuration parameters of the driver.
+ *
+ * \param[in] adr is the address of the first register to read.
+ *
+ * \param[in] n is the number of registers to read (up to SL_TTC2_BLOCK_READ_MAX_REGS).
+ *
+ * \param[in,out] val is an array to store the n read values.
+ *
+ * \return The status/error code.
+ */
+int sl_ttc2_read_block(sl_ttc2_config_t config, uint8_t adr, uint8_t n, uint32_t *val);
+
 /**
  * \brief Reads all the TTC variables and parameters.
  *
+ * The registers are read with a single block read. If it fails (ex.: a TTC firmware without
+ * block read support), the registers are read one by one. After SL_TTC2_BLOCK_READ_MAX_ERRORS
+ * consecutive invalid answers to block requests, the registers of the radio are read one by one,
+ * and the block read is probed again once every SL_TTC2_BLOCK_READ_RETRY_PERIOD calls (or at the
+ * next sl_ttc2_init call).
+ *
  * \param[in] config is a structure with the configuration parameters of the driver.
  *
  * \param[in,out] data is a pointer to store the read TTC data.
@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.8.13
+ * \version 0.10.17
  * 
  * \date 2021/10/13
  * 
@@ -40,7 +40,7 @@
 
 int sl_ttc2_spi_init(sl_ttc2_config_t config)
 {
-    return spi_init(config.port, config.port_config);
+    return spi_init_device(config.port, config.cs_pin, config.port_config);
 }
 
 int sl_ttc2_spi_write(sl_ttc2_config_t config, uint8_t *data, uint16_t len)
@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.9.16
+ * \version 0.10.17
  * 
  * \date 2019/12/07
  * 
@@ -33,6 +33,8 @@
  * \{
  */
 
+#include <stddef.h>
+
 #include <hal/usci_a_spi.h>
 #include <hal/usci_b_spi.h>
 #include <hal/gpio.h>
@@ -42,9 +44,13 @@
 #include <system/sys_log/sys_log.h>
 
 #include <drivers/gpio/gpio.h>
+#include <drivers/timer/timer.h>
 
 #include "spi.h"
 
+#define SPI_PORTS               (SPI_PORT_5 + 1)
+#define SPI_PROFILES            (SPI_CS_9 + 1)
+
 static bool spi_port_0_is_open = false;
 static bool spi_port_1_is_open = false;
 static bool spi_port_2_is_open = false;
@@ -52,6 +58,21 @@ static bool spi_port_3_is_open = false;
 static bool spi_port_4_is_open = false;
 static bool spi_port_5_is_open = false;
 
+/**
+ * \brief Device profile.
+ */
+typedef struct
+{
+    bool registered;            /**< TRUE if a device was registered in the chip select. */
+    spi_port_t port;            /**< Port of the device. */
+    spi_config_t config;        /**< Configuration used by the device. */
+} spi_profile_t;
+
+static spi_profile_t spi_profiles[SPI_PROFILES] = {0};
+
+/* Only the holder of the port mutex changes the configuration of a port */
+static spi_config_t spi_port_config[SPI_PORTS] = {0};
+
 /**
  * \brief Checks if a SPI port is already initialized or not.
  *
@@ -61,6 +82,65 @@ static bool spi_port_5_is_open = false;
  */
 static bool spi_check_port(spi_port_t port);
 
+/**
+ * \brief Sets the state of a chip select pin.
+ *
+ * \param[in] port is the SPI port of the device.
+ *
+ * \param[in] cs is the chip select pin of the device.
+ *
+ * \param[in] active is TRUE/FALSE to select/unselect the SPI device.
+ *
+ * \return The status/error code.
+ */
+static int spi_set_cs(spi_port_t port, spi_cs_t cs, bool active);
+
+/**
+ * \brief Transfers data to/from the selected device, using DMA when it is worth it.
+ *
+ * Transfers shorter than CONFIG_SPI_DMA_MIN_LEN bytes, or in ports without DMA, are done
+ * byte by byte (polling the interrupt flags).
+ *
+ * \param[in] port is the SPI port.
+ *
+ * \param[in] base_address is the base address of the USCI module of the port.
+ *
+ * \param[in] wd is the data to write (NULL to transmit zeros).
+ *
+ * \param[in,out] rd is a pointer to store the read data (NULL to discard the read data).
+ *
+ * \param[in] len is the number of bytes to transfer.
+ *
+ * \return The status/error code.
+ */
+static int spi_transfer_data(spi_port_t port, uint16_t base_address, uint8_t *wd, uint8_t *rd, uint16_t len);
+
+/**
+ * \brief Programs the USCI module of a port (clock, mode and bit order).
+ *
+ * \param[in] port is the SPI port.
+ *
+ * \param[in] base_address is the base address of the USCI module of the port.
+ *
+ * \param[in] config is the new configuration of the port.
+ *
+ * \return The status/error code.
+ */
+static int spi_configure(spi_port_t port, uint16_t base_address, spi_config_t config);
+
+/**
+ * \brief Applies the profile of a device to its port, if it differs from the current configuration.
+ *
+ * It must be called by the holder of the port mutex, before selecting the device.
+ *
+ * \param[in] port is the SPI port.
+ *
+ * \param[in] cs is the chip select of the device.
+ *
+ * \return The status/error code.
+ */
+static int spi_apply_profile(spi_port_t port, spi_cs_t cs);
+
 static int spi_setup_gpio(spi_port_t port)
 {
     int err = 0;
@@ -122,6 +202,61 @@ int spi_select_slave(spi_port_t port, spi_cs_t cs, bool active)
 {
     int err = 0;
 
+    if (cs == SPI_CS_NONE)
+    {
+        /* Transfer inside a transaction already opened by the caller */
+        err = spi_set_cs(port, cs, active);
+    }
+    else if (active)
+    {
+        /* The port mutex is held from the selection to the deselection of the device */
+        err = spi_mutex_take(port);
+
+        if (err == 0)
+        {
+            err = spi_apply_profile(port, cs);
+
+            if (err == 0)
+            {
+                err = spi_set_cs(port, cs, true);
+            }
+
+            if (err != 0)
+            {
+                spi_mutex_give(port);
+            }
+        #if defined(CONFIG_BUS_STATS_ENABLED) && (CONFIG_BUS_STATS_ENABLED == 1)
+            else
+            {
+                spi_stats_begin(port, cs);
+            }
+        #endif /* CONFIG_BUS_STATS_ENABLED */
+        }
+    #if defined(CONFIG_BUS_STATS_ENABLED) && (CONFIG_BUS_STATS_ENABLED == 1)
+        else
+        {
+            spi_stats_timeout(port, cs);
+        }
+    #endif /* CONFIG_BUS_STATS_ENABLED */
+    }
+    else
+    {
+        err = spi_set_cs(port, cs, false);
+
+    #if defined(CONFIG_BUS_STATS_ENABLED) && (CONFIG_BUS_STATS_ENABLED == 1)
+        spi_stats_end(port);
+    #endif /* CONFIG_BUS_STATS_ENABLED */
+
+        spi_mutex_give(port);
+    }
+
+    return err;
+}
+
+static int spi_set_cs(spi_port_t port, spi_cs_t cs, bool active)
+{
+    int err = 0;
+
     switch(port)
     {
         case SPI_PORT_0:
@@ -203,111 +338,7 @@ int spi_init(spi_port_t port, spi_config_t config)
         {
             if (spi_setup_gpio(port) == 0)
             {
-                if ((port == SPI_PORT_0) || (port == SPI_PORT_1) || (port == SPI_PORT_2))
-                {
-                    USCI_A_SPI_initMasterParam spi_params;
-
-                    spi_params.selectClockSource        = USCI_A_SPI_CLOCKSOURCE_SMCLK;
-                    spi_params.clockSourceFrequency     = UCS_getSMCLK();
-                    spi_params.desiredSpiClock          = config.speed_hz;
-                    spi_params.msbFirst                 = USCI_A_SPI_MSB_FIRST;
-
-                    /* SPI mode */
-                    switch(config.mode)
-                    {
-                        case SPI_MODE_0:
-                            spi_params.clockPhase       = USCI_A_SPI_PHASE_DATA_CAPTURED_ONFIRST_CHANGED_ON_NEXT;
-                            spi_params.clockPolarity    = USCI_A_SPI_CLOCKPOLARITY_INACTIVITY_LOW;
-                            break;
-                        case SPI_MODE_1:
-                            spi_params.clockPhase       = USCI_A_SPI_PHASE_DATA_CHANGED_ONFIRST_CAPTURED_ON_NEXT;
-                            spi_params.clockPolarity    = USCI_A_SPI_CLOCKPOLARITY_INACTIVITY_LOW;
-                            break;
-                        case SPI_MODE_2:
-                            spi_params.clockPhase       = USCI_A_SPI_PHASE_DATA_CAPTURED_ONFIRST_CHANGED_ON_NEXT;
-                            spi_params.clockPolarity    = USCI_A_SPI_CLOCKPOLARITY_INACTIVITY_HIGH;
-                            break;
-                        case SPI_MODE_3:
-                            spi_params.clockPhase       = USCI_A_SPI_PHASE_DATA_CHANGED_ONFIRST_CAPTURED_ON_NEXT;
-                            spi_params.clockPolarity    = USCI_A_SPI_CLOCKPOLARITY_INACTIVITY_HIGH;
-                            break;
-                        default:
-                        #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
-                            sys_log_print_event_from_module(SYS_LOG_ERROR, SPI_MODULE_NAME, "Error during initialization: Invalid mode!");
-                            sys_log_new_line();
-                        #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
-                            err = -1;   /* Invalid SPI mode */
-
-                            break;
-                    }
-
-                    if (USCI_A_SPI_initMaster(base_address, &spi_params) == STATUS_SUCCESS)
-                    {
-                        USCI_A_SPI_enable(base_address);
-                    }
-                    else
-                    {
-                    #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
-                        sys_log_print_event_from_module(SYS_LOG_ERROR, SPI_MODULE_NAME, "Error configuring as master!");
-                        sys_log_new_line();
-                    #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
-                        err = -1;   /* Error initializing the SPI port */
-                    }
-                }
-                else
-                {
-                    USCI_B_SPI_initMasterParam spi_params;
-
-                    spi_params.selectClockSource        = USCI_B_SPI_CLOCKSOURCE_SMCLK;
-                    spi_params.clockSourceFrequency     = UCS_getSMCLK();
-                    spi_params.desiredSpiClock          = config.speed_hz;
-                    spi_params.msbFirst                 = USCI_B_SPI_LSB_FIRST;
-
-                    /* SPI mode */
-                    switch(config.mode)
-                    {
-                        case SPI_MODE_0:
-                            spi_params.clockPhase       = USCI_B_SPI_PHASE_DATA_CHANGED_ONFIRST_CAPTURED_ON_NEXT;
-                            spi_params.clockPolarity    = USCI_B_SPI_CLOCKPOLARITY_INACTIVITY_LOW;
-                            break;
-                        case SPI_MODE_1:
-                            spi_params.clockPhase       = USCI_B_SPI_PHASE_DATA_CAPTURED_ONFIRST_CHANGED_ON_NEXT;
-                            spi_params.clockPolarity    = USCI_B_SPI_CLOCKPOLARITY_INACTIVITY_LOW;
-                            break;
-                        case SPI_MODE_2:
-                            spi_params.clockPhase       = USCI_B_SPI_PHASE_DATA_CHANGED_ONFIRST_CAPTURED_ON_NEXT;
-                            spi_params.clockPolarity    = USCI_B_SPI_CLOCKPOLARITY_INACTIVITY_HIGH;
-                            break;
-                        case SPI_MODE_3:
-                            spi_params.clockPhase       = USCI_B_SPI_PHASE_DATA_CAPTURED_ONFIRST_CHANGED_ON_NEXT;
-                            spi_params.clockPolarity    = USCI_B_SPI_CLOCKPOLARITY_INACTIVITY_HIGH;
-                            break;
-                        default:
-                        #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
-                            sys_log_print_event_from_module(SYS_LOG_ERROR, SPI_MODULE_NAME, "Error during initialization: Invalid mode!");
-                            sys_log_new_line();
-                        #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
-                            err = -1;   /* Invalid SPI mode */
-
-                            break;
-                    }
-
-                    if (err == 0)
-                    {
-                        if (USCI_B_SPI_initMaster(base_address, &spi_params) == STATUS_SUCCESS)
-                        {
-                            USCI_B_SPI_enable(base_address);
-                        }
-                        else
-                        {
-                        #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
-                            sys_log_print_event_from_module(SYS_LOG_ERROR, SPI_MODULE_NAME, "Error configuring as master!");
-                            sys_log_new_line();
-                        #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
-                            err = -1;   /* Error initializing the SPI port */
-                        }
-                    }
-                }
+                err = spi_configure(port, base_address, config);
 
                 switch(port)
                 {
@@ -319,6 +350,11 @@ int spi_init(spi_port_t port, spi_config_t config)
                     case SPI_PORT_5:    spi_port_5_is_open = true;  break;
                     default:                                        break;
                 }
+
+                if (spi_mutex_create(port) != 0)
+                {
+                    err = -1;
+                }
             }
             else
             {
@@ -330,6 +366,168 @@ int spi_init(spi_port_t port, spi_config_t config)
     return err;
 }
 
+int spi_init_device(spi_port_t port, spi_cs_t cs, spi_config_t config)
+{
+    int err = -1;
+
+    if ((uint8_t)cs < SPI_PROFILES)
+    {
+        /* The first device initializes the port with its own configuration */
+        err = spi_init(port, config);
+
+        if (err == 0)
+        {
+            spi_profiles[cs].port       = port;
+            spi_profiles[cs].config     = config;
+            spi_profiles[cs].registered = true;
+        }
+    }
+    else
+    {
+    #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+        sys_log_print_event_from_module(SYS_LOG_ERROR, SPI_MODULE_NAME, "Error registering a device: Invalid CS pin!");
+        sys_log_new_line();
+    #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+    }
+
+    return err;
+}
+
+static int spi_apply_profile(spi_port_t port, spi_cs_t cs)
+{
+    int err = 0;
+
+    if (((uint8_t)cs < SPI_PROFILES) && spi_profiles[cs].registered && (spi_profiles[cs].port == port))
+    {
+        spi_config_t *cur = &spi_port_config[port];
+        spi_config_t *prof = &spi_profiles[cs].config;
+
+        /* The USCI is only reprogrammed when the device uses a different configuration */
+        if ((cur->speed_hz != prof->speed_hz) || (cur->mode != prof->mode) || (cur->bit_order != prof->bit_order))
+        {
+            uint16_t base_address = 0;
+
+            switch(port)
+            {
+                case SPI_PORT_0:    base_address = USCI_A0_BASE;    break;
+                case SPI_PORT_1:    base_address = USCI_A1_BASE;    break;
+                case SPI_PORT_2:    base_address = USCI_A2_BASE;    break;
+                case SPI_PORT_3:    base_address = USCI_B0_BASE;    break;
+                case SPI_PORT_4:    base_address = USCI_B1_BASE;    break;
+                case SPI_PORT_5:    base_address = USCI_B2_BASE;    break;
+                default:            err = -1;                       break;
+            }
+
+            if (err == 0)
+            {
+                err = spi_configure(port, base_address, *prof);
+            }
+        }
+    }
+
+    return err;
+}
+
+static int spi_configure(spi_port_t port, uint16_t base_address, spi_config_t config)
+{
+    int err = 0;
+
+    /* UCCKPH = 1 captures the data on the first clock edge (clock phase 0) */
+    bool ckph = false;
+    bool ckpl = false;
+
+    switch(config.mode)
+    {
+        case SPI_MODE_0:    ckph = true;    ckpl = false;   break;
+        case SPI_MODE_1:    ckph = false;   ckpl = false;   break;
+        case SPI_MODE_2:    ckph = true;    ckpl = true;    break;
+        case SPI_MODE_3:    ckph = false;   ckpl = true;    break;
+        default:
+        #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+            sys_log_print_event_from_module(SYS_LOG_ERROR, SPI_MODULE_NAME, "Error during configuration: Invalid mode!");
+            sys_log_new_line();
+        #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+            err = -1;   /* Invalid SPI mode */
+
+            break;
+    }
+
+    if (config.speed_hz == 0UL)
+    {
+    #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+        sys_log_print_event_from_module(SYS_LOG_ERROR, SPI_MODULE_NAME, "Error during configuration: Invalid speed!");
+        sys_log_new_line();
+    #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+        err = -1;   /* Invalid SPI speed */
+    }
+
+    if (err == 0)
+    {
+        bool res = false;
+
+        uint32_t smclk_hz = UCS_getSMCLK();
+
+        /* The HAL truncates SMCLK/speed, giving a clock above the requested one (ex.: 31981568/8000000 = 3, 10.66 MHz) */
+        uint32_t prescaler = (smclk_hz + config.speed_hz - 1UL) / config.speed_hz;
+
+        /* Requesting SMCLK/prescaler makes the HAL use the rounded up prescaler */
+        uint32_t clock_hz = smclk_hz / prescaler;
+
+        if ((port == SPI_PORT_0) || (port == SPI_PORT_1) || (port == SPI_PORT_2))
+        {
+            USCI_A_SPI_initMasterParam spi_params;
+
+            spi_params.selectClockSource        = USCI_A_SPI_CLOCKSOURCE_SMCLK;
+            spi_params.clockSourceFrequency     = smclk_hz;
+            spi_params.desiredSpiClock          = clock_hz;
+            spi_params.msbFirst                 = (config.bit_order == SPI_BIT_ORDER_LSB_FIRST) ? USCI_A_SPI_LSB_FIRST : USCI_A_SPI_MSB_FIRST;
+            spi_params.clockPhase               = ckph ? USCI_A_SPI_PHASE_DATA_CAPTURED_ONFIRST_CHANGED_ON_NEXT : USCI_A_SPI_PHASE_DATA_CHANGED_ONFIRST_CAPTURED_ON_NEXT;
+            spi_params.clockPolarity            = ckpl ? USCI_A_SPI_CLOCKPOLARITY_INACTIVITY_HIGH : USCI_A_SPI_CLOCKPOLARITY_INACTIVITY_LOW;
+
+            /* The initialization keeps the USCI in reset until it is enabled again */
+            res = USCI_A_SPI_initMaster(base_address, &spi_params) == STATUS_SUCCESS;
+
+            if (res)
+            {
+                USCI_A_SPI_enable(base_address);
+            }
+        }
+        else
+        {
+            USCI_B_SPI_initMasterParam spi_params;
+
+            spi_params.selectClockSource        = USCI_B_SPI_CLOCKSOURCE_SMCLK;
+            spi_params.clockSourceFrequency     = smclk_hz;
+            spi_params.desiredSpiClock          = clock_hz;
+            spi_params.msbFirst                 = (config.bit_order == SPI_BIT_ORDER_LSB_FIRST) ? USCI_B_SPI_LSB_FIRST : USCI_B_SPI_MSB_FIRST;
+            spi_params.clockPhase               = ckph ? USCI_B_SPI_PHASE_DATA_CAPTURED_ONFIRST_CHANGED_ON_NEXT : USCI_B_SPI_PHASE_DATA_CHANGED_ONFIRST_CAPTURED_ON_NEXT;
+            spi_params.clockPolarity            = ckpl ? USCI_B_SPI_CLOCKPOLARITY_INACTIVITY_HIGH : USCI_B_SPI_CLOCKPOLARITY_INACTIVITY_LOW;
+
+            res = USCI_B_SPI_initMaster(base_address, &spi_params) == STATUS_SUCCESS;
+
+            if (res)
+            {
+                USCI_B_SPI_enable(base_address);
+            }
+        }
+
+        if (res)
+        {
+            spi_port_config[port] = config;
+        }
+        else
+        {
+        #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+            sys_log_print_event_from_module(SYS_LOG_ERROR, SPI_MODULE_NAME, "Error configuring as master!");
+            sys_log_new_line();
+        #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+            err = -1;   /* Error initializing the SPI port */
+        }
+    }
+
+    return err;
+}
+
 static void spi_write_byte(uint16_t base_address, uint8_t byte)
 {
     if ((base_address == USCI_A0_BASE) || (base_address == USCI_A1_BASE) || (base_address == USCI_A2_BASE))
@@ -429,14 +627,13 @@ int spi_write(spi_port_t port, spi_cs_t cs, uint8_t *data, uint16_t len)
             if (spi_select_slave(port, cs, true) == 0)
             {
                 /* Write data */
-                uint16_t i = 0;
-                for(i = 0; i < len; i++)
-                {
-                    uint8_t dummy = spi_transfer_byte(base_address, data[i]);
-                }
+                err = spi_transfer_data(port, base_address, data, NULL, len);
 
                 /* Disable the CS pin */
-                err = spi_select_slave(port, cs, false);
+                if (spi_select_slave(port, cs, false) != 0)
+                {
+                    err = -1;
+                }
             }
             else
             {
@@ -490,14 +687,13 @@ int spi_read(spi_port_t port, spi_cs_t cs, uint8_t *data, uint16_t len)
             if (spi_select_slave(port, cs, true) == 0)
             {
                 /* Read data */
-                uint16_t i = 0;
-                for(i = 0; i < len; i++)
-                {
-                    data[i] = spi_transfer_byte(base_address, 0);
-                }
+                err = spi_transfer_data(port, base_address, NULL, data, len);
 
                 /* Disable the CS pin */
-                err = spi_select_slave(port, cs, false);
+                if (spi_select_slave(port, cs, false) != 0)
+                {
+                    err = -1;
+                }
             }
             else
             {
@@ -544,14 +740,13 @@ int spi_transfer(spi_port_t port, spi_cs_t cs, uint8_t *wd, uint8_t *rd, uint16_
             if (spi_select_slave(port, cs, true) == 0)
             {
                 /* Transfer data (write and read) */
-                uint16_t i = 0;
-                for(i = 0; i < len; i++)
-                {
-                    rd[i] = spi_transfer_byte(base_address, wd[i]);
-                }
+                err = spi_transfer_data(port, base_address, wd, rd, len);
 
                 /* Disable the CS pin */
-                err = spi_select_slave(port, cs, false);
+                if (spi_select_slave(port, cs, false) != 0)
+                {
+                    err = -1;
+                }
             }
             else
             {
@@ -573,6 +768,45 @@ int spi_transfer(spi_port_t port, spi_cs_t cs, uint8_t *wd, uint8_t *rd, uint16_
     return err;
 }
 
+static int spi_transfer_data(spi_port_t port, uint16_t base_address, uint8_t *wd, uint8_t *rd, uint16_t len)
+{
+    int err = 0;
+
+    bool use_dma = false;
+
+#if defined(CONFIG_BUS_STATS_ENABLED) && (CONFIG_BUS_STATS_ENABLED == 1)
+    uint32_t start_us = timer_get_us();
+#endif /* CONFIG_BUS_STATS_ENABLED */
+
+#if defined(CONFIG_SPI_DMA_ENABLED) && (CONFIG_SPI_DMA_ENABLED == 1)
+    use_dma = (len >= CONFIG_SPI_DMA_MIN_LEN) && spi_dma_available(port);
+#endif /* CONFIG_SPI_DMA_ENABLED */
+
+    if (use_dma)
+    {
+        err = spi_dma_transfer(port, wd, rd, len);
+    }
+    else
+    {
+        uint16_t i = 0;
+        for(i = 0; i < len; i++)
+        {
+            uint8_t rb = spi_transfer_byte(base_address, (wd == NULL) ? 0U : wd[i]);
+
+            if (rd != NULL)
+            {
+                rd[i] = rb;
+            }
+        }
+    }
+
+#if defined(CONFIG_BUS_STATS_ENABLED) && (CONFIG_BUS_STATS_ENABLED == 1)
+    spi_stats_transfer(port, start_us, len, err);
+#endif /* CONFIG_BUS_STATS_ENABLED */
+
+    return err;
+}
+
 bool spi_check_port(spi_port_t port)
 {
     bool state = false;
@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.7.33
+ * \version 0.10.17
  * 
  * \date 2019/12/07
  * 
@@ -40,8 +40,12 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include <libs/stats/bus_stats.h>
+
 #define SPI_MODULE_NAME         "SPI"
 
+#define SPI_MUTEX_WAIT_TIME_MS  100U    /**< Wait time to take the mutex of a port in milliseconds. */
+
 /**
  * \brief SPI ports.
  */
@@ -84,15 +88,35 @@ typedef enum
     SPI_MODE_3          /**< SPI mode 3 (Clock Polarity = 1, Clock Phase = 1). */
 } spi_mode_t;
 
+/**
+ * \brief SPI bit orders.
+ */
+typedef enum
+{
+    SPI_BIT_ORDER_MSB_FIRST=0,  /**< Most significant bit first. */
+    SPI_BIT_ORDER_LSB_FIRST     /**< Least significant bit first. */
+} spi_bit_order_t;
+
 /**
  * \brief SPI bus configuration parameters.
  */
 typedef struct
 {
-    uint32_t speed_hz;  /**< Transfer rate in Hertz. */
-    spi_mode_t mode;    /**< SPI mode (0, 1, 2 or 3). */
+    uint32_t speed_hz;          /**< Maximum transfer rate in Hertz (the fastest SMCLK division not above it is used). */
+    spi_mode_t mode;            /**< SPI mode (0, 1, 2 or 3). */
+    spi_bit_order_t bit_order;  /**< Bit order (MSB first by default). */
 } spi_config_t;
 
+/**
+ * \brief SPI bus usage statistics.
+ */
+typedef struct
+{
+    uint32_t transactions;  /**< Number of chip-select transactions. */
+    uint32_t contentions;   /**< Number of chip-select transactions that had to wait for the port. */
+    uint32_t timeouts;      /**< Number of chip-select transactions aborted waiting for the port. */
+} spi_bus_stats_t;
+
 /**
  * \brief SPI port initialization.
  *
@@ -110,9 +134,33 @@ typedef struct
  */
 int spi_init(spi_port_t port, spi_config_t config);
 
+/**
+ * \brief Initializes the port of a device and registers the configuration (profile) of the device.
+ *
+ * The first device of a port initializes it. After that, the port is reprogrammed by
+ * spi_select_slave every time a device with a different configuration is selected, so
+ * each device runs at its own clock rate and mode.
+ *
+ * \param[in] port is the SPI port of the device.
+ *
+ * \param[in] cs is the chip select of the device (SPI_CS_0 to SPI_CS_9).
+ *
+ * \param[in] config is the configuration used by the device.
+ *
+ * \return The status/error code.
+ */
+int spi_init_device(spi_port_t port, spi_cs_t cs, spi_config_t config);
+
 /**
  * \brief Selects or unselects an SPI device.
  *
+ * Selecting a device takes the mutex of its port, which is only given back when the device is
+ * unselected. This way, a whole chip-select transaction is atomic in relation to the other
+ * tasks using the same port. SPI_CS_NONE does not change the mutex state.
+ *
+ * If the device was registered with spi_init_device, the port is reprogrammed with its
+ * configuration (only when it differs from the current one) before the selection.
+ *
  * \param[in] port is the SPI port of the device to select. It can be:
  * \parblock
  *      -\b SPI_PORT_0
@@ -250,6 +298,168 @@ int spi_read(spi_port_t port, spi_cs_t cs, uint8_t *data, uint16_t len);
  */
 int spi_transfer(spi_port_t port, spi_cs_t cs, uint8_t *wd, uint8_t *rd, uint16_t len);
 
+/**
+ * \brief Creates the mutex of a SPI port.
+ *
+ * \param[in] port is the SPI port.
+ *
+ * \return The status/error code.
+ */
+int spi_mutex_create(spi_port_t port);
+
+/**
+ * \brief Takes the mutex of a SPI port.
+ *
+ * \param[in] port is the SPI port.
+ *
+ * \return The status/error code.
+ */
+int spi_mutex_take(spi_port_t port);
+
+/**
+ * \brief Gives the mutex of a SPI port back.
+ *
+ * \param[in] port is the SPI port.
+ *
+ * \return The status/error code.
+ */
+int spi_mutex_give(spi_port_t port);
+
+/**
+ * \brief Gets the usage statistics of a SPI port.
+ *
+ * \param[in] port is the SPI port.
+ *
+ * \param[in,out] stats is a pointer to store the statistics.
+ *
+ * \return None.
+ */
+void spi_mutex_get_stats(spi_port_t port, spi_bus_stats_t *stats);
+
+/**
+ * \brief Checks if DMA transfers can be used in a SPI port.
+ *
+ * \param[in] port is the SPI port.
+ *
+ * \return TRUE/FALSE if the port has DMA channels assigned and the scheduler is running.
+ */
+bool spi_dma_available(spi_port_t port);
+
+/**
+ * \brief Transfers data over a SPI port using DMA (full-duplex operation).
+ *
+ * The calling task is blocked until the end of the transfer (or CONFIG_SPI_DMA_TIMEOUT_MS),
+ * and its notification value is used to signal the completion. The device must be already
+ * selected.
+ *
+ * \param[in] port is the SPI port.
+ *
+ * \param[in] wd is the data to write (NULL to transmit dummy bytes).
+ *
+ * \param[in,out] rd is a pointer to store the read data (NULL to discard the read data).
+ *
+ * \param[in] len is the number of bytes to transfer.
+ *
+ * \return The status/error code.
+ */
+int spi_dma_transfer(spi_port_t port, uint8_t *wd, uint8_t *rd, uint16_t len);
+
+/**
+ * \brief Starts the statistics of a chip-select transaction.
+ *
+ * It must be called by the holder of the port mutex, right after the selection of the device.
+ *
+ * \param[in] port is the SPI port.
+ *
+ * \param[in] cs is the selected chip select.
+ *
+ * \return None.
+ */
+void spi_stats_begin(spi_port_t port, spi_cs_t cs);
+
+/**
+ * \brief Accounts a data transfer.
+ *
+ * Inside a chip-select transaction, the bytes and the error are added to the transaction.
+ * Otherwise (SPI_CS_NONE transfers without an open transaction), the transfer is recorded
+ * as a transaction of the port.
+ *
+ * \param[in] port is the SPI port.
+ *
+ * \param[in] start_us is the timestamp of the beginning of the transfer (timer_get_us).
+ *
+ * \param[in] len is the number of transferred bytes.
+ *
+ * \param[in] err is the status/error code of the transfer.
+ *
+ * \return None.
+ */
+void spi_stats_transfer(spi_port_t port, uint32_t start_us, uint16_t len, int err);
+
+/**
+ * \brief Ends the statistics of a chip-select transaction (right before giving the port mutex).
+ *
+ * The transaction is recorded in the statistics of its chip select and of the port.
+ *
+ * \param[in] port is the SPI port.
+ *
+ * \return None.
+ */
+void spi_stats_end(spi_port_t port);
+
+/**
+ * \brief Accounts a transaction aborted waiting for the port mutex.
+ *
+ * \param[in] port is the SPI port.
+ *
+ * \param[in] cs is the chip select of the aborted transaction.
+ *
+ * \return None.
+ */
+void spi_stats_timeout(spi_port_t port, spi_cs_t cs);
+
+/**
+ * \brief Gets the transaction statistics of a SPI port (all its chip selects).
+ *
+ * \param[in] port is the SPI port.
+ *
+ * \param[in,out] stats is a pointer to store the statistics.
+ *
+ * \return The status/error code.
+ */
+int spi_stats_get_port(spi_port_t port, bus_stats_t *stats);
+
+/**
+ * \brief Gets the transaction statistics of a chip select.
+ *
+ * Only the port 0 has chip select pins, so each chip select is a single device.
+ *
+ * \param[in] cs is the chip select (SPI_CS_0 to SPI_CS_9).
+ *
+ * \param[in,out] stats is a pointer to store the statistics.
+ *
+ * \return The status/error code.
+ */
+int spi_stats_get_cs(spi_cs_t cs, bus_stats_t *stats);
+
+/**
+ * \brief Clears the transaction statistics of a SPI port.
+ *
+ * \param[in] port is the SPI port.
+ *
+ * \return The status/error code.
+ */
+int spi_stats_reset_port(spi_port_t port);
+
+/**
+ * \brief Clears the transaction statistics of a chip select.
+ *
+ * \param[in] cs is the chip select (SPI_CS_0 to SPI_CS_9).
+ *
+ * \return The status/error code.
+ */
+int spi_stats_reset_cs(spi_cs_t cs);
+
 #endif /* SPI_H_ */
 
 /** \} End of spi group */
@@ -0,0 +1,162 @@
+/*
+ * spi_dma.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief SPI DMA transfers implementation.
+ *
+ * Each transfer uses two DMA channels: one moving the received bytes from RXBUF to memory
+ * (higher priority, to never lose a received byte), and one feeding TXBUF. The calling task
+ * is blocked on its notification until the RX channel interrupt signals the end of the transfer.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.8
+ *
+ * \date 2022/11/26
+ *
+ * \defgroup spi_dma DMA
+ * \ingroup spi
+ * \{
+ */
+
+#include <stddef.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <config/config.h>
+#include <system/sys_log/sys_log.h>
+#include <drivers/dma/dma.h>
+
+#include "spi.h"
+
+#define SPI_DMA_PORTS           (SPI_PORT_5 + 1)
+
+/**
+ * \brief DMA resources of a SPI port.
+ */
+typedef struct
+{
+    dma_ch_t rx_ch;             /**< Channel used to read RXBUF. */
+    dma_ch_t tx_ch;             /**< Channel used to write TXBUF. */
+    dma_periph_t periph;        /**< USCI module of the port. */
+} spi_dma_port_t;
+
+/* All the SPI devices (radios, NOR and FRAM) are on port 0 */
+static const spi_dma_port_t spi_dma_ports[SPI_DMA_PORTS] =
+{
+    {DMA_CH_0,      DMA_CH_1,       DMA_PERIPH_USCI_A0},    /* SPI_PORT_0 */
+    {DMA_CH_NONE,   DMA_CH_NONE,    DMA_PERIPH_USCI_A1},    /* SPI_PORT_1 */
+    {DMA_CH_NONE,   DMA_CH_NONE,    DMA_PERIPH_USCI_A2},    /* SPI_PORT_2 */
+    {DMA_CH_NONE,   DMA_CH_NONE,    DMA_PERIPH_USCI_B0},    /* SPI_PORT_3 */
+    {DMA_CH_NONE,   DMA_CH_NONE,    DMA_PERIPH_USCI_B1},    /* SPI_PORT_4 */
+    {DMA_CH_NONE,   DMA_CH_NONE,    DMA_PERIPH_USCI_B2}     /* SPI_PORT_5 */
+};
+
+static TaskHandle_t spi_dma_waiting_task[SPI_DMA_PORTS] = {NULL};
+
+static uint8_t spi_dma_dummy_tx = 0x00U;    /**< Byte transmitted during read-only transfers. */
+static uint8_t spi_dma_dummy_rx = 0x00U;    /**< Sink of the received bytes during write-only transfers. */
+
+/**
+ * \brief Transfer complete callback (called from the DMA ISR).
+ *
+ * \param[in] ch is the channel that completed the transfer.
+ *
+ * \return None.
+ */
+static void spi_dma_complete(dma_ch_t ch);
+
+bool spi_dma_available(spi_port_t port)
+{
+    bool res = false;
+
+    if ((uint8_t)port < SPI_DMA_PORTS)
+    {
+        /* The completion is signaled to the calling task, so the scheduler must be running */
+        if ((spi_dma_ports[port].rx_ch != DMA_CH_NONE) && (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING))
+        {
+            res = true;
+        }
+    }
+
+    return res;
+}
+
+int spi_dma_transfer(spi_port_t port, uint8_t *wd, uint8_t *rd, uint16_t len)
+{
+    int err = -1;
+
+    if (spi_dma_available(port) && (len > 0U))
+    {
+        spi_dma_port_t dp = spi_dma_ports[port];
+
+        spi_dma_waiting_task[port] = xTaskGetCurrentTaskHandle();
+
+        /* Discard any pending notification */
+        (void)ulTaskNotifyTake(pdTRUE, 0);
+
+        if ((dma_config_rx(dp.rx_ch, dp.periph, (rd == NULL) ? &spi_dma_dummy_rx : rd, rd != NULL, len, spi_dma_complete) == 0) &&
+            (dma_config_tx(dp.tx_ch, dp.periph, (wd == NULL) ? &spi_dma_dummy_tx : wd, wd != NULL, len, NULL) == 0) &&
+            (dma_start_tx(dp.periph) == 0))
+        {
+            if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CONFIG_SPI_DMA_TIMEOUT_MS)) > 0U)
+            {
+                err = 0;
+            }
+            else
+            {
+                SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_SPI, SYS_LOG_TOK_BUS_DMA_TIMEOUT, port, len);
+
+            #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+                sys_log_print_event_from_module(SYS_LOG_ERROR, SPI_MODULE_NAME, "Timeout waiting for a DMA transfer!");
+                sys_log_new_line();
+            #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+            }
+        }
+
+        dma_stop(dp.rx_ch);
+        dma_stop(dp.tx_ch);
+
+        spi_dma_waiting_task[port] = NULL;
+    }
+
+    return err;
+}
+
+static void spi_dma_complete(dma_ch_t ch)
+{
+    BaseType_t higher_priority_task_woken = pdFALSE;
+
+    uint8_t i = 0;
+    for(i = 0; i < SPI_DMA_PORTS; i++)
+    {
+        if ((spi_dma_ports[i].rx_ch == ch) && (spi_dma_waiting_task[i] != NULL))
+        {
+            vTaskNotifyGiveFromISR(spi_dma_waiting_task[i], &higher_priority_task_woken);
+        }
+    }
+
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/** \} End of spi_dma group */
@@ -0,0 +1,160 @@
+/*
+ * spi_mutex.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief SPI ports mutex implementation.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.7
+ *
+ * \date 2022/11/25
+ *
+ * \defgroup spi_mutex Mutex
+ * \ingroup spi
+ * \{
+ */
+
+#include <FreeRTOS.h>
+#include <task.h>
+#include <semphr.h>
+
+#include <config/config.h>
+#include <system/sys_log/sys_log.h>
+
+#include "spi.h"
+
+#define SPI_MUTEX_PORTS         (SPI_PORT_5 + 1)
+
+static SemaphoreHandle_t spi_mutex[SPI_MUTEX_PORTS] = {NULL};
+
+static spi_bus_stats_t spi_bus_stats[SPI_MUTEX_PORTS] = {0};
+
+int spi_mutex_create(spi_port_t port)
+{
+    int err = -1;
+
+    if ((uint8_t)port < SPI_MUTEX_PORTS)
+    {
+        if (spi_mutex[port] == NULL)
+        {
+            /* Mutex type semaphore (with priority inheritance) */
+            spi_mutex[port] = xSemaphoreCreateMutex();
+        }
+
+        if (spi_mutex[port] == NULL)
+        {
+        #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+            sys_log_print_event_from_module(SYS_LOG_ERROR, SPI_MODULE_NAME, "Error creating the mutex of port ");
+            sys_log_print_uint(port);
+            sys_log_print_msg("!");
+            sys_log_new_line();
+        #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+        }
+        else
+        {
+            err = 0;
+        }
+    }
+
+    return err;
+}
+
+int spi_mutex_take(spi_port_t port)
+{
+    int err = -1;
+
+    if (((uint8_t)port < SPI_MUTEX_PORTS) && (spi_mutex[port] != NULL))
+    {
+        if (xSemaphoreTake(spi_mutex[port], 0) == pdTRUE)
+        {
+            err = 0;
+        }
+        else
+        {
+            taskENTER_CRITICAL();
+
+            spi_bus_stats[port].contentions++;
+
+            taskEXIT_CRITICAL();
+
+            /* The port is in use by another task: wait SPI_MUTEX_WAIT_TIME_MS ms for it to become free */
+            if (xSemaphoreTake(spi_mutex[port], pdMS_TO_TICKS(SPI_MUTEX_WAIT_TIME_MS)) == pdTRUE)
+            {
+                err = 0;
+            }
+            else
+            {
+                taskENTER_CRITICAL();
+
+                spi_bus_stats[port].timeouts++;
+
+                taskEXIT_CRITICAL();
+
+                SYS_LOG_DEFERRED(SYS_LOG_ERROR, SYS_LOG_MODULE_SPI, SYS_LOG_TOK_BUS_PORT_TIMEOUT, port, 0);
+
+            #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+                sys_log_print_event_from_module(SYS_LOG_ERROR, SPI_MODULE_NAME, "Timeout waiting for port ");
+                sys_log_print_uint(port);
+                sys_log_print_msg("!");
+                sys_log_new_line();
+            #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+            }
+        }
+
+        if (err == 0)
+        {
+            /* Only the mutex holder updates this counter */
+            spi_bus_stats[port].transactions++;
+        }
+    }
+
+    return err;
+}
+
+int spi_mutex_give(spi_port_t port)
+{
+    int err = -1;
+
+    if (((uint8_t)port < SPI_MUTEX_PORTS) && (spi_mutex[port] != NULL))
+    {
+        xSemaphoreGive(spi_mutex[port]);
+
+        err = 0;
+    }
+
+    return err;
+}
+
+void spi_mutex_get_stats(spi_port_t port, spi_bus_stats_t *stats)
+{
+    if ((uint8_t)port < SPI_MUTEX_PORTS)
+    {
+        taskENTER_CRITICAL();
+
+        *stats = spi_bus_stats[port];
+
+        taskEXIT_CRITICAL();
+    }
+}
+
+/** \} End of spi_mutex group */
@@ -0,0 +1,218 @@
+/*
+ * spi_stats.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief SPI transaction statistics implementation.
+ *
+ * A transaction lasts from the selection to the deselection of a device, so its duration
+ * is the time the port is held (all the transfers of the transaction and the gaps between them).
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.16
+ *
+ * \date 2022/12/04
+ *
+ * \defgroup spi_stats Statistics
+ * \ingroup spi
+ * \{
+ */
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <drivers/timer/timer.h>
+
+#include "spi.h"
+
+#define SPI_STATS_PORTS         (SPI_PORT_5 + 1)
+#define SPI_STATS_CS            (SPI_CS_9 + 1)
+
+/**
+ * \brief Chip-select transaction in progress.
+ */
+typedef struct
+{
+    bool open;                  /**< TRUE if a device is selected. */
+    spi_cs_t cs;                /**< Selected chip select. */
+    uint32_t start_us;          /**< Timestamp of the selection. */
+    uint32_t bytes;             /**< Bytes transferred so far. */
+    bool error;                 /**< TRUE if any transfer failed. */
+} spi_stats_xact_t;
+
+/* Only the holder of the port mutex changes the transaction of a port */
+static spi_stats_xact_t spi_stats_xact[SPI_STATS_PORTS] = {0};
+
+static bus_stats_t spi_stats_port[SPI_STATS_PORTS] = {0};
+
+static bus_stats_t spi_stats_cs[SPI_STATS_CS] = {0};
+
+void spi_stats_begin(spi_port_t port, spi_cs_t cs)
+{
+    if (((uint8_t)port < SPI_STATS_PORTS) && ((uint8_t)cs < SPI_STATS_CS))
+    {
+        spi_stats_xact_t *xact = &spi_stats_xact[port];
+
+        xact->cs        = cs;
+        xact->bytes     = 0UL;
+        xact->error     = false;
+        xact->start_us  = timer_get_us();
+        xact->open      = true;
+    }
+}
+
+void spi_stats_transfer(spi_port_t port, uint32_t start_us, uint16_t len, int err)
+{
+    if ((uint8_t)port < SPI_STATS_PORTS)
+    {
+        spi_stats_xact_t *xact = &spi_stats_xact[port];
+
+        if (xact->open)
+        {
+            xact->bytes += len;
+
+            if (err != 0)
+            {
+                xact->error = true;
+            }
+        }
+        else
+        {
+            uint32_t dur_us = timer_get_us() - start_us;
+
+            taskENTER_CRITICAL();
+
+            bus_stats_add(&spi_stats_port[port], dur_us, len, err != 0);
+
+            taskEXIT_CRITICAL();
+        }
+    }
+}
+
+void spi_stats_end(spi_port_t port)
+{
+    if ((uint8_t)port < SPI_STATS_PORTS)
+    {
+        spi_stats_xact_t *xact = &spi_stats_xact[port];
+
+        if (xact->open)
+        {
+            uint32_t dur_us = timer_get_us() - xact->start_us;
+
+            taskENTER_CRITICAL();
+
+            bus_stats_add(&spi_stats_cs[xact->cs], dur_us, xact->bytes, xact->error);
+            bus_stats_add(&spi_stats_port[port], dur_us, xact->bytes, xact->error);
+
+            taskEXIT_CRITICAL();
+
+            xact->open = false;
+        }
+    }
+}
+
+void spi_stats_timeout(spi_port_t port, spi_cs_t cs)
+{
+    if (((uint8_t)port < SPI_STATS_PORTS) && ((uint8_t)cs < SPI_STATS_CS))
+    {
+        taskENTER_CRITICAL();
+
+        bus_stats_add_timeout(&spi_stats_cs[cs]);
+        bus_stats_add_timeout(&spi_stats_port[port]);
+
+        taskEXIT_CRITICAL();
+    }
+}
+
+int spi_stats_get_port(spi_port_t port, bus_stats_t *stats)
+{
+    int err = -1;
+
+    if ((uint8_t)port < SPI_STATS_PORTS)
+    {
+        taskENTER_CRITICAL();
+
+        *stats = spi_stats_port[port];
+
+        taskEXIT_CRITICAL();
+
+        err = 0;
+    }
+
+    return err;
+}
+
+int spi_stats_get_cs(spi_cs_t cs, bus_stats_t *stats)
+{
+    int err = -1;
+
+    if ((uint8_t)cs < SPI_STATS_CS)
+    {
+        taskENTER_CRITICAL();
+
+        *stats = spi_stats_cs[cs];
+
+        taskEXIT_CRITICAL();
+
+        err = 0;
+    }
+
+    return err;
+}
+
+int spi_stats_reset_port(spi_port_t port)
+{
+    int err = -1;
+
+    if ((uint8_t)port < SPI_STATS_PORTS)
+    {
+        taskENTER_CRITICAL();
+
+        bus_stats_reset(&spi_stats_port[port]);
+
+        taskEXIT_CRITICAL();
+
+        err = 0;
+    }
+
+    return err;
+}
+
+int spi_stats_reset_cs(spi_cs_t cs)
+{
+    int err = -1;
+
+    if ((uint8_t)cs < SPI_STATS_CS)
+    {
+        taskENTER_CRITICAL();
+
+        bus_stats_reset(&spi_stats_cs[cs]);
+
+        taskEXIT_CRITICAL();
+
+        err = 0;
+    }
+
+    return err;
+}
+
+/** \} End of spi_stats group */
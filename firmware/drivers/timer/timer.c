@@ -0,0 +1,123 @@
+/*
+ * timer.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Free-running timer driver implementation.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.16
+ *
+ * \date 2022/12/04
+ *
+ * \addtogroup timer
+ * \{
+ */
+
+#include <hal/timer_a.h>
+#include <hal/ucs.h>
+
+#include <config/config.h>
+#include <system/sys_log/sys_log.h>
+
+#include "timer.h"
+
+#define TIMER_SMCLK_HZ          32000000UL  /**< Nominal SMCLK frequency (divided by 32 to count microseconds). */
+#define TIMER_SMCLK_TOL_HZ      320000UL    /**< Accepted SMCLK deviation (1 %, the FLL gives 976 x 32768 = 31981568 Hz). */
+
+static volatile uint16_t timer_overflows = 0U;
+
+int timer_init(void)
+{
+    int err = 0;
+
+    uint32_t smclk_hz = UCS_getSMCLK();
+
+    /* The tick is SMCLK/32 (0.06 % slow with the FLL output), close enough for durations and CPU loads */
+    if ((smclk_hz >= (TIMER_SMCLK_HZ - TIMER_SMCLK_TOL_HZ)) && (smclk_hz <= (TIMER_SMCLK_HZ + TIMER_SMCLK_TOL_HZ)))
+    {
+        Timer_A_initContinuousModeParam timer_params = {0};
+
+        timer_params.clockSource                = TIMER_A_CLOCKSOURCE_SMCLK;
+        timer_params.clockSourceDivider         = TIMER_A_CLOCKSOURCE_DIVIDER_32;
+        timer_params.timerInterruptEnable_TAIE  = TIMER_A_TAIE_INTERRUPT_ENABLE;
+        timer_params.timerClear                 = TIMER_A_DO_CLEAR;
+        timer_params.startTimer                 = true;
+
+        timer_overflows = 0U;
+
+        Timer_A_initContinuousMode(TIMER_A1_BASE, &timer_params);
+    }
+    else
+    {
+    #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+        sys_log_print_event_from_module(SYS_LOG_ERROR, TIMER_MODULE_NAME, "Error during initialization: Invalid SMCLK frequency!");
+        sys_log_new_line();
+    #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+        err = -1;
+    }
+
+    return err;
+}
+
+uint32_t timer_get_us(void)
+{
+    uint16_t ovf = 0U;
+    uint16_t cnt = 0U;
+
+    /* Retry if the overflow ISR ran between the two reads */
+    do
+    {
+        ovf = timer_overflows;
+
+        /* The timer clock is synchronous to MCLK, so the counter can be read directly */
+        cnt = HWREG16(TIMER_A1_BASE + OFS_TAxR);
+    } while(ovf != timer_overflows);
+
+    /* Overflow not handled yet (interrupts disabled): the counter already wrapped */
+    if (((HWREG16(TIMER_A1_BASE + OFS_TAxCTL) & TAIFG) > 0U) && (cnt < 0x8000U))
+    {
+        ovf++;
+    }
+
+    return ((uint32_t)ovf << 16) | cnt;
+}
+
+#if defined(__TI_COMPILER_VERSION__) || defined(__IAR_SYSTEMS_ICC__)
+#pragma vector=TIMER1_A1_VECTOR
+__interrupt
+#elif defined(__GNUC__)
+__attribute__((interrupt(TIMER1_A1_VECTOR)))
+#endif
+void TIMER1_A1_ISR(void)    // cppcheck-suppress misra-c2012-8.4
+{
+    /* Reading TA1IV clears the highest priority pending flag */
+    switch(__even_in_range(TA1IV, 14))
+    {
+        case 14:            /* TAIFG */
+            timer_overflows++;
+            break;
+        default:    break;
+    }
+}
+
+/** \} End of timer group */
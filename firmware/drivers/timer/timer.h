@@ -0,0 +1,70 @@
+/*
+ * timer.h
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Free-running timer driver definition.
+ *
+ * The Timer_A1 runs in continuous mode from the SMCLK, counting microseconds. The 16-bit
+ * counter is extended to 32 bits with an overflow interrupt, so the timestamps wrap after
+ * about 71 minutes (differences between timestamps are still valid across the wrap).
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.16
+ *
+ * \date 2022/12/04
+ *
+ * \defgroup timer Timer
+ * \ingroup drivers
+ * \{
+ */
+
+#ifndef TIMER_H_
+#define TIMER_H_
+
+#include <stdint.h>
+
+#define TIMER_MODULE_NAME       "Timer"
+
+#define TIMER_TICK_HZ           1000000UL   /**< Counting frequency in Hertz. */
+
+/**
+ * \brief Initializes and starts the free-running timer.
+ *
+ * The SMCLK must be already configured (32 MHz, within 1 %).
+ *
+ * \return The status/error code.
+ */
+int timer_init(void);
+
+/**
+ * \brief Gets the current timestamp.
+ *
+ * It can be called from tasks, ISRs or critical sections.
+ *
+ * \return The timestamp in microseconds.
+ */
+uint32_t timer_get_us(void);
+
+#endif /* TIMER_H_ */
+
+/** \} End of timer group */
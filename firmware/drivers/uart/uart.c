@@ -26,7 +26,7 @@
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * \author Miguel Boing <miguelboing13@gmail.com>
  *
- * \version 0.9.2
+ * \version 0.10.16
  * 
  * \date 2019/12/07
  * 
@@ -37,24 +37,43 @@
 #include <hal/usci_a_uart.h>
 #include <hal/gpio.h>
 
+#include <FreeRTOS.h>
+#include <task.h>
+
 #include <config/config.h>
 #include <system/sys_log/sys_log.h>
-#include <libs/containers/queue.h>
+#include <libs/containers/ring.h>
+#include <drivers/timer/timer.h>
 
 #include "uart.h"
 
-static queue_t uart_port_0_rx_buffer;
-static queue_t uart_port_1_rx_buffer;
-static queue_t uart_port_2_rx_buffer;
+#define UART_PORTS              (UART_PORT_2 + 1)
+
+#define UART_RX_EMPTY_BYTE      0xFFU   /**< Value of the requested bytes not received yet. */
+
+/* RX buffers (producer: ISR, consumer: task) */
+RING_DEFINE(uart_port_0_rx_buffer, CONFIG_UART_RX_BUFFER_SIZE);
+RING_DEFINE(uart_port_1_rx_buffer, CONFIG_UART_RX_BUFFER_SIZE);
+RING_DEFINE(uart_port_2_rx_buffer, CONFIG_UART_RX_BUFFER_SIZE);
+
+/* TX buffers (producer: task, consumer: ISR) */
+RING_DEFINE(uart_port_0_tx_buffer, CONFIG_UART_TX_BUFFER_SIZE);
+RING_DEFINE(uart_port_1_tx_buffer, CONFIG_UART_TX_BUFFER_SIZE);
+RING_DEFINE(uart_port_2_tx_buffer, CONFIG_UART_TX_BUFFER_SIZE);
+
+static ring_t * const uart_rx_buffer[UART_PORTS] = {&uart_port_0_rx_buffer, &uart_port_1_rx_buffer, &uart_port_2_rx_buffer};
+static ring_t * const uart_tx_buffer[UART_PORTS] = {&uart_port_0_tx_buffer, &uart_port_1_tx_buffer, &uart_port_2_tx_buffer};
 
 /**
- * \brief Reads the MTU value of a given UART RX buffer.
+ * \brief Common interrupt handler of the UART ports.
+ *
+ * \param[in] port is the UART port of the interrupt.
  *
- * \param[in,out] uart_rx_buffer is the UART RX buffer to get the MTU size.
+ * \param[in] base_address is the base address of the USCI_A module of the port.
  *
- * \return The MTU of the given RX buffer.
+ * \return None.
  */
-static uint16_t uart_read_mtu(queue_t *uart_rx_buffer);
+static void uart_isr_handler(uart_port_t port, uint16_t base_address);
 
 /**
  * \brief Reads the RX ISR buffer.
@@ -158,7 +177,7 @@ int uart_init(uart_port_t port, uart_config_t config)
 
             GPIO_setAsPeripheralModuleFunctionInputPin(GPIO_PORT_P2, GPIO_PIN4 + GPIO_PIN5);
 
-            queue_init(&uart_port_0_rx_buffer);
+            ring_clear(&uart_port_0_rx_buffer);
 
             break;
         case UART_PORT_1:
@@ -166,7 +185,7 @@ int uart_init(uart_port_t port, uart_config_t config)
 
             GPIO_setAsPeripheralModuleFunctionInputPin(GPIO_PORT_P8, GPIO_PIN2 + GPIO_PIN3);
 
-            queue_init(&uart_port_1_rx_buffer);
+            ring_clear(&uart_port_1_rx_buffer);
 
             break;
         case UART_PORT_2:
@@ -174,7 +193,7 @@ int uart_init(uart_port_t port, uart_config_t config)
 
             GPIO_setAsPeripheralModuleFunctionInputPin(GPIO_PORT_P9, GPIO_PIN2 + GPIO_PIN3);
 
-            queue_init(&uart_port_2_rx_buffer);
+            ring_clear(&uart_port_2_rx_buffer);
 
             break;
         default:
@@ -196,6 +215,11 @@ int uart_init(uart_port_t port, uart_config_t config)
         err = -1;
     }
 
+    if (err == 0)
+    {
+        ring_clear(uart_tx_buffer[port]);
+    }
+
     USCI_A_UART_enable(base_address);
 
     return err;
@@ -223,10 +247,87 @@ int uart_write(uart_port_t port, uint8_t *data, uint16_t len)
 
     if (err == 0)
     {
+    #if defined(CONFIG_BUS_STATS_ENABLED) && (CONFIG_BUS_STATS_ENABLED == 1)
+        uint32_t start_us = timer_get_us();
+    #endif /* CONFIG_BUS_STATS_ENABLED */
+
+        BaseType_t scheduler_state = xTaskGetSchedulerState();
+
         uint16_t i = 0U;
-        for(i = 0U; i < len; i++)
+
+        if (scheduler_state == taskSCHEDULER_NOT_STARTED)
+        {
+            /* The interrupts are only enabled after the scheduler starts: polled transmission */
+            for(i = 0U; i < len; i++)
+            {
+                USCI_A_UART_transmitData(base_address, data[i]);
+            }
+        }
+        else
+        {
+            ring_t *buf = uart_tx_buffer[port];
+
+            i = ring_push_n(buf, data, len);
+
+            while(i < len)
+            {
+                /* Buffer full: wait for the ISR to make room */
+                USCI_A_UART_enableInterrupt(base_address, USCI_A_UART_TRANSMIT_INTERRUPT);
+
+                if (scheduler_state == taskSCHEDULER_RUNNING)
+                {
+                    vTaskDelay(1U);
+                }
+
+                i += ring_push_n(buf, &data[i], len - i);
+            }
+
+            /* The TX flag is already set, so the ISR starts right away (if not already running) */
+            USCI_A_UART_enableInterrupt(base_address, USCI_A_UART_TRANSMIT_INTERRUPT);
+        }
+
+    #if defined(CONFIG_BUS_STATS_ENABLED) && (CONFIG_BUS_STATS_ENABLED == 1)
+        uart_stats_add(port, UART_DIR_TX, start_us, len, false);
+    #endif /* CONFIG_BUS_STATS_ENABLED */
+    }
+
+    return err;
+}
+
+int uart_tx_flush(uart_port_t port)
+{
+    int err = 0;
+
+    uint16_t base_address;
+
+    switch(port)
+    {
+        case UART_PORT_0:   base_address = USCI_A0_BASE;    break;
+        case UART_PORT_1:   base_address = USCI_A1_BASE;    break;
+        case UART_PORT_2:   base_address = USCI_A2_BASE;    break;
+        default:
+        #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+            sys_log_print_event_from_module(SYS_LOG_ERROR, UART_MODULE_NAME, "Error flushing the TX buffer: Invalid port!");
+            sys_log_new_line();
+        #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+            err = -1;
+            break;
+    }
+
+    if (err == 0)
+    {
+        while(!ring_empty(uart_tx_buffer[port]))
         {
-            USCI_A_UART_transmitData(base_address, data[i]);
+            if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)
+            {
+                vTaskDelay(1U);
+            }
+        }
+
+        /* Wait for the last byte to leave the shift register */
+        while(USCI_A_UART_queryStatusFlags(base_address, USCI_A_UART_BUSY) > 0U)
+        {
+            ;
         }
     }
 
@@ -255,7 +356,17 @@ int uart_read(uart_port_t port, uint8_t *data, uint16_t len)
 
     if (err == 0)
     {
+    #if defined(CONFIG_BUS_STATS_ENABLED) && (CONFIG_BUS_STATS_ENABLED == 1)
+        uint32_t start_us = timer_get_us();
+
+        bool underrun = ring_size(uart_rx_buffer[port]) < len;
+    #endif /* CONFIG_BUS_STATS_ENABLED */
+
         err = uart_read_isr_rx_buffer(port, data, len);
+
+    #if defined(CONFIG_BUS_STATS_ENABLED) && (CONFIG_BUS_STATS_ENABLED == 1)
+        uart_stats_add(port, UART_DIR_RX, start_us, len, underrun || (err != 0));
+    #endif /* CONFIG_BUS_STATS_ENABLED */
     }
 
     return err;
@@ -321,86 +432,49 @@ int uart_read_isr_rx_buffer(uart_port_t port, uint8_t *data, uint16_t len)
 {
     int err = 0;
 
-    uint16_t num_bytes = len;
-
-    uint16_t i = 0U;
-
-    switch(port)
+    if ((uint8_t)port < UART_PORTS)
     {
-        case UART_PORT_0:
-            if (num_bytes > uart_read_mtu(&uart_port_0_rx_buffer))
-            {
-            #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
-                sys_log_print_event_from_module(SYS_LOG_WARNING, UART_MODULE_NAME, "Port 0: Read size is bigger than RX buffer size!");
-                sys_log_new_line();
-            #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
-                num_bytes = uart_read_mtu(&uart_port_0_rx_buffer);
-            }
-
-            for(i = 0U; i < num_bytes; i++)
-            {
-                data[i] = queue_pop_front(&uart_port_0_rx_buffer);
-            }
-
-            break;
-        case UART_PORT_1:
-            if (num_bytes > uart_read_mtu(&uart_port_1_rx_buffer))
-            {
-            #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
-                sys_log_print_event_from_module(SYS_LOG_WARNING, UART_MODULE_NAME, "Port 1: Read size is bigger than RX buffer size!");
-                sys_log_new_line();
-            #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
-                num_bytes = uart_read_mtu(&uart_port_1_rx_buffer);
-            }
-
-            for(i = 0U; i < num_bytes; i++)
-            {
-                data[i] = queue_pop_front(&uart_port_1_rx_buffer);
-            }
-
-            break;
-        case UART_PORT_2:
-            if (num_bytes > uart_read_mtu(&uart_port_2_rx_buffer))
-            {
-            #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
-                sys_log_print_event_from_module(SYS_LOG_WARNING, UART_MODULE_NAME, "Port 2: Read size is bigger than RX buffer size!");
-                sys_log_new_line();
-            #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
-                num_bytes = uart_read_mtu(&uart_port_2_rx_buffer);
-            }
-
-            for(i = 0U; i < num_bytes; i++)
-            {
-                data[i] = queue_pop_front(&uart_port_2_rx_buffer);
-            }
-
-            break;
-        default:
+        if (len > ring_capacity(uart_rx_buffer[port]))
+        {
         #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
-            sys_log_print_event_from_module(SYS_LOG_ERROR, UART_MODULE_NAME, "Error during reading isr rx buffer: Invalid port!");
+            sys_log_print_event_from_module(SYS_LOG_WARNING, UART_MODULE_NAME, "Port ");
+            sys_log_print_uint(port);
+            sys_log_print_msg(": Read size is bigger than RX buffer size!");
             sys_log_new_line();
         #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
-            err = -1;
-            break;
+            len = ring_capacity(uart_rx_buffer[port]);
+        }
+
+        /* At most two memcpy calls */
+        uint16_t i = ring_pop_n(uart_rx_buffer[port], data, len);
+
+        /* Requested bytes not received yet */
+        for(; i < len; i++)
+        {
+            data[i] = UART_RX_EMPTY_BYTE;
+        }
+    }
+    else
+    {
+    #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
+        sys_log_print_event_from_module(SYS_LOG_ERROR, UART_MODULE_NAME, "Error during reading isr rx buffer: Invalid port!");
+        sys_log_new_line();
+    #endif /* CONFIG_DRIVERS_DEBUG_ENABLED */
+        err = -1;
     }
 
     return err;
 }
 
-static uint16_t uart_read_mtu(queue_t *uart_rx_buffer)
-{
-    return queue_length(uart_rx_buffer);
-}
-
 uint16_t uart_read_available(uart_port_t port)
 {
     uint16_t available_bytes = 0U;
 
     switch(port)
     {
-        case UART_PORT_0:   available_bytes = queue_size(&uart_port_0_rx_buffer);  break;
-        case UART_PORT_1:   available_bytes = queue_size(&uart_port_1_rx_buffer);  break;
-        case UART_PORT_2:   available_bytes = queue_size(&uart_port_2_rx_buffer);  break;
+        case UART_PORT_0:   available_bytes = ring_size(&uart_port_0_rx_buffer);   break;
+        case UART_PORT_1:   available_bytes = ring_size(&uart_port_1_rx_buffer);   break;
+        case UART_PORT_2:   available_bytes = ring_size(&uart_port_2_rx_buffer);   break;
         default:
         #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
             sys_log_print_event_from_module(SYS_LOG_ERROR, UART_MODULE_NAME, "Error during reading buffer available bytes: Invalid port!");
@@ -418,9 +492,9 @@ int uart_flush(uart_port_t port)
 
     switch(port)
     {
-        case UART_PORT_0:   queue_clear(&uart_port_0_rx_buffer);   break;
-        case UART_PORT_1:   queue_clear(&uart_port_1_rx_buffer);   break;
-        case UART_PORT_2:   queue_clear(&uart_port_2_rx_buffer);   break;
+        case UART_PORT_0:   ring_clear(&uart_port_0_rx_buffer);    break;
+        case UART_PORT_1:   ring_clear(&uart_port_1_rx_buffer);    break;
+        case UART_PORT_2:   ring_clear(&uart_port_2_rx_buffer);    break;
         default:
         #if defined(CONFIG_DRIVERS_DEBUG_ENABLED) && (CONFIG_DRIVERS_DEBUG_ENABLED == 1)
             sys_log_print_event_from_module(SYS_LOG_ERROR, UART_MODULE_NAME, "Error flushing the RX buffer: Invalid port!");
@@ -433,36 +507,52 @@ int uart_flush(uart_port_t port)
     return err;
 }
 
+static void uart_isr_handler(uart_port_t port, uint16_t base_address)
+{
+    if (USCI_A_UART_getInterruptStatus(base_address, USCI_A_UART_RECEIVE_INTERRUPT_FLAG) == USCI_A_UART_RECEIVE_INTERRUPT_FLAG)
+    {
+        /* The byte is dropped if the buffer is full */
+        (void)ring_push(uart_rx_buffer[port], USCI_A_UART_receiveData(base_address));
+        USCI_A_UART_clearInterrupt(base_address, USCI_A_UART_RECEIVE_INTERRUPT_FLAG);
+    }
+
+    /* The TX flag is set whenever TXBUF is empty, so it only matters while the TX interrupt is enabled */
+    if (((HWREG8(base_address + OFS_UCAxIE) & UCTXIE) > 0U) &&
+        (USCI_A_UART_getInterruptStatus(base_address, USCI_A_UART_TRANSMIT_INTERRUPT_FLAG) == USCI_A_UART_TRANSMIT_INTERRUPT_FLAG))
+    {
+        uint8_t byte = 0U;
+
+        if (ring_pop(uart_tx_buffer[port], &byte))
+        {
+            /* Writing TXBUF clears the TX flag */
+            USCI_A_UART_transmitData(base_address, byte);
+        }
+        else
+        {
+            /* Nothing else to transmit */
+            USCI_A_UART_disableInterrupt(base_address, USCI_A_UART_TRANSMIT_INTERRUPT);
+        }
+    }
+}
+
 /* Interrupt Service Routines */
 
 #pragma vector=USCI_A0_VECTOR
 __interrupt void USCI_A0_ISR(void) // cppcheck-suppress misra-c2012-8.4
 {
-    if (USCI_A_UART_getInterruptStatus(USCI_A0_BASE, USCI_A_UART_RECEIVE_INTERRUPT_FLAG) == USCI_A_UART_RECEIVE_INTERRUPT_FLAG)
-    {
-        queue_push_back(&uart_port_0_rx_buffer, USCI_A_UART_receiveData(USCI_A0_BASE));
-        USCI_A_UART_clearInterrupt(USCI_A0_BASE, USCI_A_UART_RECEIVE_INTERRUPT_FLAG);
-    }
+    uart_isr_handler(UART_PORT_0, USCI_A0_BASE);
 }
 
 #pragma vector=USCI_A1_VECTOR
 __interrupt void USCI_A1_ISR(void) // cppcheck-suppress misra-c2012-8.4
 {
-    if (USCI_A_UART_getInterruptStatus(USCI_A1_BASE, USCI_A_UART_RECEIVE_INTERRUPT_FLAG) == USCI_A_UART_RECEIVE_INTERRUPT_FLAG)
-    {
-        queue_push_back(&uart_port_1_rx_buffer, USCI_A_UART_receiveData(USCI_A1_BASE));
-        USCI_A_UART_clearInterrupt(USCI_A1_BASE, USCI_A_UART_RECEIVE_INTERRUPT_FLAG);
-    }
+    uart_isr_handler(UART_PORT_1, USCI_A1_BASE);
 }
 
 #pragma vector=USCI_A2_VECTOR
 __interrupt void USCI_A2_ISR(void) // cppcheck-suppress misra-c2012-8.4
 {
-    if (USCI_A_UART_getInterruptStatus(USCI_A2_BASE, USCI_A_UART_RECEIVE_INTERRUPT_FLAG) == USCI_A_UART_RECEIVE_INTERRUPT_FLAG)
-    {
-        queue_push_back(&uart_port_2_rx_buffer, USCI_A_UART_receiveData(USCI_A2_BASE));
-        USCI_A_UART_clearInterrupt(USCI_A2_BASE, USCI_A_UART_RECEIVE_INTERRUPT_FLAG);
-    }
+    uart_isr_handler(UART_PORT_2, USCI_A2_BASE);
 }
 
 /** \} End of uart group */
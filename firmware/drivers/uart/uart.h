@@ -26,7 +26,7 @@
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * \author Miguel Boing <miguelboing13@gmail.com>
  * 
- * \version 0.9.2
+ * \version 0.10.16
  * 
  * \date 2019/12/07
  * 
@@ -39,6 +39,9 @@
 #define UART_H_
 
 #include <stdint.h>
+#include <stdbool.h>
+
+#include <libs/stats/bus_stats.h>
 
 #define UART_MODULE_NAME    "UART"
 
@@ -71,6 +74,15 @@ typedef enum
     UART_TWO_STOP_BITS      /**< Two stop bits. */
 } uart_stop_bits_e;
 
+/**
+ * \brief Transfer directions.
+ */
+typedef enum
+{
+    UART_DIR_TX=0,          /**< Transmission (uart_write). */
+    UART_DIR_RX             /**< Reception (uart_read). */
+} uart_dir_e;
+
 /**
  * \brief UART port configuration parameters.
  */
@@ -108,6 +120,10 @@ int uart_init(uart_port_t port, uart_config_t config);
 /**
  * \brief Writes data to a given UART port.
  *
+ * After the scheduler starts, the data is copied to the TX buffer of the port and
+ * transmitted by the TX interrupt: the function only blocks if the buffer is full. The
+ * writers of the same port must be serialized (ex.: by the sys_log mutex).
+ *
  * \param[in] port is the UART port to write. It can be:
  * \parblock
  *      -\b UART_PORT_0
@@ -124,6 +140,21 @@ int uart_init(uart_port_t port, uart_config_t config);
  */
 int uart_write(uart_port_t port, uint8_t *data, uint16_t len);
 
+/**
+ * \brief Waits until all the data in the TX buffer of a given port is transmitted.
+ *
+ * \param[in] port is the UART port to flush. It can be:
+ * \parblock
+ *      -\b UART_PORT_0
+ *      -\b UART_PORT_1
+ *      -\b UART_PORT_2
+ *      .
+ * \endparblock
+ *
+ * \return The status/error code.
+ */
+int uart_tx_flush(uart_port_t port);
+
 /**
  * \brief Reads data from a given UART port.
  *
@@ -203,6 +234,47 @@ uint16_t uart_read_available(uart_port_t port);
  */
 int uart_flush(uart_port_t port);
 
+/**
+ * \brief Records a write or read call in the transaction statistics of a port.
+ *
+ * \param[in] port is the UART port.
+ *
+ * \param[in] dir is the direction (UART_DIR_TX or UART_DIR_RX).
+ *
+ * \param[in] start_us is the timestamp of the beginning of the call (timer_get_us).
+ *
+ * \param[in] len is the number of transferred bytes.
+ *
+ * \param[in] error is TRUE/FALSE if the call failed or not (reads: not enough received bytes).
+ *
+ * \return None.
+ */
+void uart_stats_add(uart_port_t port, uart_dir_e dir, uint32_t start_us, uint16_t len, bool error);
+
+/**
+ * \brief Gets the transaction statistics of a UART port.
+ *
+ * \param[in] port is the UART port.
+ *
+ * \param[in] dir is the direction (UART_DIR_TX or UART_DIR_RX).
+ *
+ * \param[in,out] stats is a pointer to store the statistics.
+ *
+ * \return The status/error code.
+ */
+int uart_stats_get(uart_port_t port, uart_dir_e dir, bus_stats_t *stats);
+
+/**
+ * \brief Clears the transaction statistics of a UART port.
+ *
+ * \param[in] port is the UART port.
+ *
+ * \param[in] dir is the direction (UART_DIR_TX or UART_DIR_RX).
+ *
+ * \return The status/error code.
+ */
+int uart_stats_reset(uart_port_t port, uart_dir_e dir);
+
 #endif /* UART_H_ */
 
 /** \} End of uart group */
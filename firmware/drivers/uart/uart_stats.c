@@ -0,0 +1,102 @@
+/*
+ * uart_stats.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief UART transaction statistics implementation.
+ *
+ * Each write and read call is a transaction. The duration of a write is the time to queue
+ * the data in the TX buffer (including the waits for room), so it grows when the port is saturated.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.16
+ *
+ * \date 2022/12/04
+ *
+ * \defgroup uart_stats Statistics
+ * \ingroup uart
+ * \{
+ */
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <drivers/timer/timer.h>
+
+#include "uart.h"
+
+#define UART_STATS_PORTS        (UART_PORT_2 + 1)
+#define UART_STATS_DIRS         (UART_DIR_RX + 1)
+
+static bus_stats_t uart_stats[UART_STATS_PORTS][UART_STATS_DIRS] = {0};
+
+void uart_stats_add(uart_port_t port, uart_dir_e dir, uint32_t start_us, uint16_t len, bool error)
+{
+    if ((port < UART_STATS_PORTS) && ((uint8_t)dir < UART_STATS_DIRS))
+    {
+        uint32_t dur_us = timer_get_us() - start_us;
+
+        taskENTER_CRITICAL();
+
+        bus_stats_add(&uart_stats[port][dir], dur_us, len, error);
+
+        taskEXIT_CRITICAL();
+    }
+}
+
+int uart_stats_get(uart_port_t port, uart_dir_e dir, bus_stats_t *stats)
+{
+    int err = -1;
+
+    if ((port < UART_STATS_PORTS) && ((uint8_t)dir < UART_STATS_DIRS))
+    {
+        taskENTER_CRITICAL();
+
+        *stats = uart_stats[port][dir];
+
+        taskEXIT_CRITICAL();
+
+        err = 0;
+    }
+
+    return err;
+}
+
+int uart_stats_reset(uart_port_t port, uart_dir_e dir)
+{
+    int err = -1;
+
+    if ((port < UART_STATS_PORTS) && ((uint8_t)dir < UART_STATS_DIRS))
+    {
+        taskENTER_CRITICAL();
+
+        bus_stats_reset(&uart_stats[port][dir]);
+
+        taskEXIT_CRITICAL();
+
+        err = 0;
+    }
+
+    return err;
+}
+
+/** \} End of uart_stats group */
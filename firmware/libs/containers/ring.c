@@ -0,0 +1,219 @@
+/*
+ * ring.c
+ * 
+ * Copyright The OBDH 2.0 Contributors.
+ * 
+ * This file is part of OBDH 2.0.
+ * 
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief Ring buffer implementation.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.11
+ *
+ * \date 2022/11/29
+ *
+ * \addtogroup ring
+ * \{
+ */
+
+#include <string.h>
+
+#include "ring.h"
+
+/**
+ * \brief Compiler barrier.
+ *
+ * The storage is not volatile, so without it the compiler may move the copy of the data past the
+ * index update that publishes it (or releases its positions) to the other side.
+ */
+#if defined(__GNUC__)
+#define RING_COMPILER_BARRIER()         __asm__ __volatile__ ("" ::: "memory")
+#else
+#define RING_COMPILER_BARRIER()         __asm(" nop")   /* The TI compiler does not optimize across __asm statements */
+#endif
+
+int ring_init(ring_t *ring, uint8_t *storage, uint16_t capacity)
+{
+    int err = -1;
+
+    if ((capacity > 0U) && ((capacity & (capacity - 1U)) == 0U) && (capacity <= RING_MAX_CAPACITY))
+    {
+        ring->data  = storage;
+        ring->mask  = capacity - 1U;
+        ring->head  = 0U;
+        ring->tail  = 0U;
+
+        err = 0;
+    }
+
+    return err;
+}
+
+uint16_t ring_capacity(const ring_t *ring)
+{
+    return (uint16_t)(ring->mask + 1U);
+}
+
+uint16_t ring_size(const ring_t *ring)
+{
+    return (uint16_t)(ring->head - ring->tail);
+}
+
+uint16_t ring_free(const ring_t *ring)
+{
+    return (uint16_t)(ring_capacity(ring) - ring_size(ring));
+}
+
+bool ring_empty(const ring_t *ring)
+{
+    return (ring->head == ring->tail);
+}
+
+bool ring_full(const ring_t *ring)
+{
+    return (ring_size(ring) == ring_capacity(ring));
+}
+
+bool ring_push(ring_t *ring, uint8_t byte)
+{
+    bool res = false;
+
+    uint16_t head = ring->head;
+
+    if ((uint16_t)(head - ring->tail) < ring_capacity(ring))
+    {
+        ring->data[head & ring->mask] = byte;
+
+        RING_COMPILER_BARRIER();
+
+        /* The byte is only visible to the consumer after the head update */
+        ring->head = head + 1U;
+
+        res = true;
+    }
+
+    return res;
+}
+
+bool ring_pop(ring_t *ring, uint8_t *byte)
+{
+    bool res = false;
+
+    uint16_t tail = ring->tail;
+
+    if (ring->head != tail)
+    {
+        *byte = ring->data[tail & ring->mask];
+
+        RING_COMPILER_BARRIER();
+
+        /* The position is only released to the producer after the tail update */
+        ring->tail = tail + 1U;
+
+        res = true;
+    }
+
+    return res;
+}
+
+uint16_t ring_push_n(ring_t *ring, const uint8_t *data, uint16_t len)
+{
+    uint16_t head = ring->head;
+
+    uint16_t n = ring_capacity(ring) - (uint16_t)(head - ring->tail);
+
+    if (len < n)
+    {
+        n = len;
+    }
+
+    if (n > 0U)
+    {
+        uint16_t idx = head & ring->mask;
+
+        /* Contiguous space until the end of the storage */
+        uint16_t first = ring_capacity(ring) - idx;
+
+        if (first > n)
+        {
+            first = n;
+        }
+
+        (void)memcpy(&ring->data[idx], data, first);
+
+        if (n > first)
+        {
+            /* Wrap around */
+            (void)memcpy(ring->data, &data[first], n - first);
+        }
+
+        RING_COMPILER_BARRIER();
+
+        ring->head = head + n;
+    }
+
+    return n;
+}
+
+uint16_t ring_pop_n(ring_t *ring, uint8_t *data, uint16_t len)
+{
+    uint16_t tail = ring->tail;
+
+    uint16_t n = (uint16_t)(ring->head - tail);
+
+    if (len < n)
+    {
+        n = len;
+    }
+
+    if (n > 0U)
+    {
+        uint16_t idx = tail & ring->mask;
+
+        /* Contiguous data until the end of the storage */
+        uint16_t first = ring_capacity(ring) - idx;
+
+        if (first > n)
+        {
+            first = n;
+        }
+
+        (void)memcpy(data, &ring->data[idx], first);
+
+        if (n > first)
+        {
+            /* Wrap around */
+            (void)memcpy(&data[first], ring->data, n - first);
+        }
+
+        RING_COMPILER_BARRIER();
+
+        ring->tail = tail + n;
+    }
+
+    return n;
+}
+
+void ring_clear(ring_t *ring)
+{
+    ring->tail = ring->head;
+}
+
+/** \} End of ring group */
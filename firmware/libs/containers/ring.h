@@ -0,0 +1,199 @@
+/*
+ * ring.h
+ * 
+ * Copyright The OBDH 2.0 Contributors.
+ * 
+ * This file is part of OBDH 2.0.
+ * 
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief Ring buffer definition.
+ *
+ * Lock-free single-producer/single-consumer byte ring. The producer only writes the head
+ * index and the consumer only writes the tail index, so one side can run in an ISR without
+ * critical sections (16-bit accesses are atomic in the MSP430). The indexes are free-running:
+ * the capacity must be a power of two, up to 32768 bytes.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.11
+ *
+ * \date 2022/11/29
+ *
+ * \defgroup ring Ring
+ * \ingroup containers
+ * \{
+ */
+
+#ifndef RING_H_
+#define RING_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define RING_MAX_CAPACITY       32768U  /**< Maximum capacity in bytes. */
+
+/**
+ * \brief Ring buffer.
+ */
+typedef struct
+{
+    uint8_t *data;                      /**< Storage (capacity bytes). */
+    uint16_t mask;                      /**< Capacity - 1. */
+    volatile uint16_t head;             /**< Write index (only changed by the producer). */
+    volatile uint16_t tail;             /**< Read index (only changed by the consumer). */
+} ring_t;
+
+/**
+ * \brief Static initializer of a ring (without the capacity check).
+ *
+ * \param[in] storage is the storage array.
+ *
+ * \param[in] capacity is the size of the storage array (power of two).
+ */
+#define RING_INIT(storage, capacity)    {(storage), (uint16_t)((capacity) - 1U), 0U, 0U}
+
+/**
+ * \brief Defines a ring with its storage, checking the capacity at compile time.
+ *
+ * \param[in] name is the name of the ring_t variable.
+ *
+ * \param[in] capacity is the capacity in bytes (power of two, up to RING_MAX_CAPACITY).
+ */
+#define RING_DEFINE(name, capacity)                                                                                 \
+    typedef char name##_capacity_check[((((capacity) & ((capacity) - 1U)) == 0U) && ((capacity) <= RING_MAX_CAPACITY)) ? 1 : -1];  \
+    static uint8_t name##_storage[(capacity)];                                                                      \
+    static ring_t name = RING_INIT(name##_storage, (capacity))
+
+/**
+ * \brief Ring initialization with an external storage.
+ *
+ * \param[in,out] ring is a pointer to the ring.
+ *
+ * \param[in] storage is the storage array.
+ *
+ * \param[in] capacity is the size of the storage array (power of two, up to RING_MAX_CAPACITY).
+ *
+ * \return The status/error code.
+ */
+int ring_init(ring_t *ring, uint8_t *storage, uint16_t capacity);
+
+/**
+ * \brief Returns the capacity of a ring.
+ *
+ * \param[in] ring is a pointer to the ring.
+ *
+ * \return The capacity in bytes.
+ */
+uint16_t ring_capacity(const ring_t *ring);
+
+/**
+ * \brief Returns the number of bytes stored in a ring.
+ *
+ * \param[in] ring is a pointer to the ring.
+ *
+ * \return The number of stored bytes.
+ */
+uint16_t ring_size(const ring_t *ring);
+
+/**
+ * \brief Returns the number of free positions of a ring.
+ *
+ * \param[in] ring is a pointer to the ring.
+ *
+ * \return The number of free bytes.
+ */
+uint16_t ring_free(const ring_t *ring);
+
+/**
+ * \brief Checks if a ring is empty.
+ *
+ * \param[in] ring is a pointer to the ring.
+ *
+ * \return TRUE/FALSE if the ring is empty or not.
+ */
+bool ring_empty(const ring_t *ring);
+
+/**
+ * \brief Checks if a ring is full.
+ *
+ * \param[in] ring is a pointer to the ring.
+ *
+ * \return TRUE/FALSE if the ring is full or not.
+ */
+bool ring_full(const ring_t *ring);
+
+/**
+ * \brief Pushes a byte (producer side).
+ *
+ * \param[in,out] ring is a pointer to the ring.
+ *
+ * \param[in] byte is the byte to push.
+ *
+ * \return TRUE/FALSE if the byte was pushed or not (ring full).
+ */
+bool ring_push(ring_t *ring, uint8_t byte);
+
+/**
+ * \brief Pops a byte (consumer side).
+ *
+ * \param[in,out] ring is a pointer to the ring.
+ *
+ * \param[in,out] byte is a pointer to store the popped byte.
+ *
+ * \return TRUE/FALSE if a byte was popped or not (ring empty).
+ */
+bool ring_pop(ring_t *ring, uint8_t *byte);
+
+/**
+ * \brief Pushes a block of bytes (producer side), with at most two memcpy calls.
+ *
+ * \param[in,out] ring is a pointer to the ring.
+ *
+ * \param[in] data is the data to push.
+ *
+ * \param[in] len is the number of bytes to push.
+ *
+ * \return The number of pushed bytes (less than len if the ring gets full).
+ */
+uint16_t ring_push_n(ring_t *ring, const uint8_t *data, uint16_t len);
+
+/**
+ * \brief Pops a block of bytes (consumer side), with at most two memcpy calls.
+ *
+ * \param[in,out] ring is a pointer to the ring.
+ *
+ * \param[in,out] data is a pointer to store the popped bytes.
+ *
+ * \param[in] len is the maximum number of bytes to pop.
+ *
+ * \return The number of popped bytes (less than len if the ring gets empty).
+ */
+uint16_t ring_pop_n(ring_t *ring, uint8_t *data, uint16_t len);
+
+/**
+ * \brief Discards all the stored bytes (consumer side).
+ *
+ * \param[in,out] ring is a pointer to the ring.
+ *
+ * \return None.
+ */
+void ring_clear(ring_t *ring);
+
+#endif /* RING_H_ */
+
+/** \} End of ring group */
@@ -0,0 +1,172 @@
+/*
+ * fmt.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Number formatter implementation.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.21
+ *
+ * \date 2022/12/09
+ *
+ * \addtogroup fmt
+ * \{
+ */
+
+#include "fmt.h"
+
+#define FMT_POW10_LEN       9U
+
+/* Powers of ten used by the subtractive conversion (at most 9 subtractions per digit) */
+static const uint32_t fmt_pow10[FMT_POW10_LEN] =
+{
+    1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL, 10000UL, 1000UL, 100UL, 10UL
+};
+
+static const char fmt_hex_digits[16] =
+{
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+};
+
+uint8_t fmt_uint(char *buf, uint32_t val)
+{
+    uint8_t len = 0U;
+    uint32_t rem = val;
+
+    uint8_t i = 0U;
+    for(i = 0U; i < FMT_POW10_LEN; i++)
+    {
+        char digit = '0';
+
+        while(rem >= fmt_pow10[i])
+        {
+            rem -= fmt_pow10[i];
+            digit++;
+        }
+
+        /* Skips the leading zeros */
+        if ((digit != '0') || (len > 0U))
+        {
+            buf[len] = digit;
+            len++;
+        }
+    }
+
+    buf[len] = (char)('0' + (uint8_t)rem);
+    len++;
+
+    return len;
+}
+
+uint8_t fmt_int(char *buf, int32_t val)
+{
+    uint8_t len = 0U;
+    uint32_t mag = (uint32_t)val;
+
+    if (val < 0)
+    {
+        buf[0] = '-';
+        len++;
+
+        mag = 0UL - mag;    /* Also valid for INT32_MIN */
+    }
+
+    return len + fmt_uint(&buf[len], mag);
+}
+
+uint8_t fmt_hex(char *buf, uint32_t val)
+{
+    uint8_t digits = 2U;
+
+    if (val > 0x00FFFFFFUL)
+    {
+        digits = 8U;
+    }
+    else if (val > 0x0000FFFFUL)
+    {
+        digits = 6U;
+    }
+    else if (val > 0x000000FFUL)
+    {
+        digits = 4U;
+    }
+    else
+    {
+        /* One byte */
+    }
+
+    buf[0] = '0';
+    buf[1] = 'x';
+
+    uint8_t i = 0U;
+    for(i = 0U; i < digits; i++)
+    {
+        buf[2U + i] = fmt_hex_digits[(val >> (4U * (digits - 1U - i))) & 0x0FUL];
+    }
+
+    return 2U + digits;
+}
+
+uint8_t fmt_q(char *buf, int32_t val, uint8_t frac_bits, uint8_t digits)
+{
+    uint8_t len = 0U;
+    uint32_t mag = (uint32_t)val;
+
+    uint8_t fb = (frac_bits > FMT_Q_MAX_FRAC_BITS) ? FMT_Q_MAX_FRAC_BITS : frac_bits;
+    uint8_t dig = (digits > FMT_Q_MAX_DIGITS) ? FMT_Q_MAX_DIGITS : digits;
+
+    if (val < 0)
+    {
+        buf[0] = '-';
+        len++;
+
+        mag = 0UL - mag;
+    }
+
+    uint32_t mask = (1UL << fb) - 1UL;
+    uint32_t frac = mag & mask;
+
+    len += fmt_uint(&buf[len], mag >> fb);
+
+    if (dig > 0U)
+    {
+        buf[len] = '.';
+        len++;
+
+        uint8_t i = 0U;
+        for(i = 0U; i < dig; i++)
+        {
+            /* frac < 2^28, so frac*10 fits in 32 bits */
+            frac = (frac << 3) + (frac << 1);
+
+            buf[len] = (char)('0' + (uint8_t)(frac >> fb));
+            len++;
+
+            frac &= mask;
+        }
+    }
+
+    return len;
+}
+
+/** \} End of fmt group */
@@ -0,0 +1,110 @@
+/*
+ * fmt.h
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Number formatter definition.
+ *
+ * The numbers are written as ASCII text into a caller buffer, without a null terminator, and
+ * the functions return the number of written characters. Only additions, subtractions and
+ * shifts are used: the MSP430 has no hardware divider, so each 32-bit division of the usual
+ * "% 10" conversion is a library call.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.21
+ *
+ * \date 2022/12/09
+ *
+ * \defgroup fmt Format
+ * \ingroup format
+ * \{
+ */
+
+#ifndef FMT_H_
+#define FMT_H_
+
+#include <stdint.h>
+
+#define FMT_UINT_MAX_LEN        10U     /**< Maximum length of an unsigned integer (4294967295). */
+#define FMT_INT_MAX_LEN         11U     /**< Maximum length of a signed integer (-2147483648). */
+#define FMT_HEX_MAX_LEN         10U     /**< Maximum length of a hexadecimal integer (0xFFFFFFFF). */
+#define FMT_Q_MAX_FRAC_BITS     28U     /**< Maximum number of fractional bits of a fixed-point number. */
+#define FMT_Q_MAX_DIGITS        9U      /**< Maximum number of decimal places of a fixed-point number. */
+#define FMT_Q_MAX_LEN           (FMT_INT_MAX_LEN + 1U + FMT_Q_MAX_DIGITS)   /**< Maximum length of a fixed-point number. */
+
+/**
+ * \brief Writes an unsigned integer in decimal.
+ *
+ * \param[in,out] buf is the buffer to write the text (at least FMT_UINT_MAX_LEN bytes).
+ *
+ * \param[in] val is the value to write.
+ *
+ * \return The number of written characters.
+ */
+uint8_t fmt_uint(char *buf, uint32_t val);
+
+/**
+ * \brief Writes a signed integer in decimal.
+ *
+ * \param[in,out] buf is the buffer to write the text (at least FMT_INT_MAX_LEN bytes).
+ *
+ * \param[in] val is the value to write.
+ *
+ * \return The number of written characters.
+ */
+uint8_t fmt_int(char *buf, int32_t val);
+
+/**
+ * \brief Writes an unsigned integer in hexadecimal.
+ *
+ * The value is written with the "0x" prefix and uppercase digits, using the minimum number of
+ * bytes (2, 4, 6 or 8 digits). Example: 0x65 = "0x65", 0x1234 = "0x1234", 0x10000 = "0x010000".
+ *
+ * \param[in,out] buf is the buffer to write the text (at least FMT_HEX_MAX_LEN bytes).
+ *
+ * \param[in] val is the value to write.
+ *
+ * \return The number of written characters.
+ */
+uint8_t fmt_hex(char *buf, uint32_t val);
+
+/**
+ * \brief Writes a fixed-point number (Q format) in decimal.
+ *
+ * The written value is val/2^frac_bits, with the decimal places truncated. Example: val = 411,
+ * frac_bits = 8 and digits = 3 gives "1.605" (411/256 = 1.60546875).
+ *
+ * \param[in,out] buf is the buffer to write the text (at least FMT_Q_MAX_LEN bytes).
+ *
+ * \param[in] val is the fixed-point value.
+ *
+ * \param[in] frac_bits is the number of fractional bits of the value (up to FMT_Q_MAX_FRAC_BITS).
+ *
+ * \param[in] digits is the number of decimal places to write (up to FMT_Q_MAX_DIGITS, 0 = no decimal point).
+ *
+ * \return The number of written characters.
+ */
+uint8_t fmt_q(char *buf, int32_t val, uint8_t frac_bits, uint8_t digits);
+
+#endif /* FMT_H_ */
+
+/** \} End of fmt group */
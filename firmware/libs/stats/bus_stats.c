@@ -0,0 +1,109 @@
+/*
+ * bus_stats.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Bus transaction statistics implementation.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.16
+ *
+ * \date 2022/12/04
+ *
+ * \addtogroup bus_stats
+ * \{
+ */
+
+#include <string.h>
+
+#include "bus_stats.h"
+
+uint8_t bus_stats_bin(uint32_t dur_us)
+{
+    uint8_t bin = 0U;
+
+    uint32_t d = dur_us >> BUS_STATS_HIST_SHIFT;
+
+    while((d > 1UL) && (bin < (BUS_STATS_HIST_BINS - 1U)))
+    {
+        d >>= 1;
+        bin++;
+    }
+
+    return bin;
+}
+
+void bus_stats_add(bus_stats_t *stats, uint32_t dur_us, uint32_t bytes, bool error)
+{
+    uint8_t bin = bus_stats_bin(dur_us);
+
+    stats->transactions++;
+    stats->bytes += bytes;
+
+    if (error)
+    {
+        stats->errors++;
+    }
+
+    if (stats->hist[bin] < UINT16_MAX)
+    {
+        stats->hist[bin]++;
+    }
+}
+
+void bus_stats_add_timeout(bus_stats_t *stats)
+{
+    stats->timeouts++;
+}
+
+void bus_stats_reset(bus_stats_t *stats)
+{
+    (void)memset(stats, 0, sizeof(bus_stats_t));
+}
+
+int bus_stats_get_field(const bus_stats_t *stats, uint8_t field, uint32_t *val)
+{
+    int err = 0;
+
+    switch(field)
+    {
+        case BUS_STATS_FIELD_TRANSACTIONS:  *val = stats->transactions;     break;
+        case BUS_STATS_FIELD_BYTES:         *val = stats->bytes;            break;
+        case BUS_STATS_FIELD_ERRORS:        *val = stats->errors;           break;
+        case BUS_STATS_FIELD_TIMEOUTS:      *val = stats->timeouts;         break;
+        default:
+            if (field < BUS_STATS_FIELDS)
+            {
+                *val = stats->hist[field - BUS_STATS_FIELD_HIST];
+            }
+            else
+            {
+                err = -1;   /* Invalid field */
+            }
+
+            break;
+    }
+
+    return err;
+}
+
+/** \} End of bus_stats group */
@@ -0,0 +1,129 @@
+/*
+ * bus_stats.h
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Bus transaction statistics definition.
+ *
+ * Counters and a log2 duration histogram of the transactions of a bus channel (a port or
+ * a chip-select). Bin 0 counts the transactions shorter than 16 us, bin k (1 to 10) the
+ * ones from 2^(k+3) us to 2^(k+4) us, and the last bin the ones of 16.384 ms or more.
+ *
+ * The functions are not reentrant: the callers serialize the access to each channel.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.16
+ *
+ * \date 2022/12/04
+ *
+ * \defgroup bus_stats Bus Statistics
+ * \ingroup stats
+ * \{
+ */
+
+#ifndef BUS_STATS_H_
+#define BUS_STATS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define BUS_STATS_HIST_BINS             12U     /**< Number of bins of the duration histogram. */
+#define BUS_STATS_HIST_SHIFT            3U      /**< log2 of half of the upper limit of the first bin (16 us). */
+
+/* Fields (parameter IDs) of a channel */
+#define BUS_STATS_FIELD_TRANSACTIONS    0U      /**< Number of transactions. */
+#define BUS_STATS_FIELD_BYTES           1U      /**< Number of transferred bytes. */
+#define BUS_STATS_FIELD_ERRORS          2U      /**< Number of transactions with errors. */
+#define BUS_STATS_FIELD_TIMEOUTS        3U      /**< Number of transactions aborted waiting for the bus. */
+#define BUS_STATS_FIELD_HIST            4U      /**< First bin of the histogram. */
+#define BUS_STATS_FIELDS                (BUS_STATS_FIELD_HIST + BUS_STATS_HIST_BINS)
+
+/**
+ * \brief Statistics of a bus channel.
+ */
+typedef struct
+{
+    uint32_t transactions;                  /**< Number of transactions. */
+    uint32_t bytes;                         /**< Number of transferred bytes. */
+    uint32_t errors;                        /**< Number of transactions with errors. */
+    uint32_t timeouts;                      /**< Number of transactions aborted waiting for the bus. */
+    uint16_t hist[BUS_STATS_HIST_BINS];     /**< Duration histogram (saturated counters). */
+} bus_stats_t;
+
+/**
+ * \brief Computes the histogram bin of a transaction duration.
+ *
+ * \param[in] dur_us is the duration in microseconds.
+ *
+ * \return The bin index (0 to BUS_STATS_HIST_BINS-1).
+ */
+uint8_t bus_stats_bin(uint32_t dur_us);
+
+/**
+ * \brief Records a completed transaction.
+ *
+ * \param[in,out] stats is the statistics of the channel.
+ *
+ * \param[in] dur_us is the duration of the transaction in microseconds.
+ *
+ * \param[in] bytes is the number of transferred bytes.
+ *
+ * \param[in] error is TRUE/FALSE if the transaction failed or not.
+ *
+ * \return None.
+ */
+void bus_stats_add(bus_stats_t *stats, uint32_t dur_us, uint32_t bytes, bool error);
+
+/**
+ * \brief Records a transaction aborted waiting for the bus.
+ *
+ * \param[in,out] stats is the statistics of the channel.
+ *
+ * \return None.
+ */
+void bus_stats_add_timeout(bus_stats_t *stats);
+
+/**
+ * \brief Clears the statistics of a channel.
+ *
+ * \param[in,out] stats is the statistics of the channel.
+ *
+ * \return None.
+ */
+void bus_stats_reset(bus_stats_t *stats);
+
+/**
+ * \brief Reads a field of the statistics of a channel.
+ *
+ * \param[in] stats is the statistics of the channel.
+ *
+ * \param[in] field is the field ID (BUS_STATS_FIELD_*, or BUS_STATS_FIELD_HIST + bin).
+ *
+ * \param[in,out] val is a pointer to store the field value.
+ *
+ * \return The status/error code.
+ */
+int bus_stats_get_field(const bus_stats_t *stats, uint8_t field, uint32_t *val);
+
+#endif /* BUS_STATS_H_ */
+
+/** \} End of bus_stats group */
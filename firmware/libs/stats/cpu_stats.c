@@ -0,0 +1,91 @@
+/*
+ * cpu_stats.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ * \brief Task CPU usage statistics implementation.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.24
+ *
+ * \date 2022/12/12
+ *
+ * \addtogroup cpu_stats
+ * \{
+ */
+
+#include "cpu_stats.h"
+
+void cpu_stats_update(cpu_stats_t *stats, uint32_t counter, uint32_t window)
+{
+    uint32_t delta = counter - stats->counter;
+
+    stats->counter = counter;
+
+    stats->run_time_ms += delta / 1000UL;
+    stats->run_time_us += (uint16_t)(delta % 1000UL);
+
+    if (stats->run_time_us >= 1000U)
+    {
+        stats->run_time_ms++;
+        stats->run_time_us -= 1000U;
+    }
+
+    /* Without 64-bit products (costly in a 16-bit CPU without hardware divider) */
+    uint32_t load = 0UL;
+
+    if (window == 0UL)
+    {
+        /* First sample */
+    }
+    else if (delta >= window)
+    {
+        load = CPU_STATS_LOAD_FULL;
+    }
+    else if (window >= CPU_STATS_LOAD_FULL)
+    {
+        load = delta / (window / CPU_STATS_LOAD_FULL);
+    }
+    else
+    {
+        load = (delta * CPU_STATS_LOAD_FULL) / window;
+    }
+
+    stats->load = (load > CPU_STATS_LOAD_FULL) ? CPU_STATS_LOAD_FULL : (uint16_t)load;
+}
+
+int cpu_stats_get_field(const cpu_stats_t *stats, uint8_t field, uint32_t *val)
+{
+    int err = 0;
+
+    switch(field)
+    {
+        case CPU_STATS_FIELD_LOAD:      *val = stats->load;             break;
+        case CPU_STATS_FIELD_RUN_TIME:  *val = stats->run_time_ms;      break;
+        default:                        err = -1;                       break;  /* Invalid field */
+    }
+
+    return err;
+}
+
+/** \} End of cpu_stats group */
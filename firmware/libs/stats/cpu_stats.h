@@ -0,0 +1,94 @@
+/*
+ * cpu_stats.h
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ * \brief Task CPU usage statistics definition.
+ *
+ * The statistics of a task are computed from the run time counter of the scheduler (in
+ * microseconds), sampled periodically. Only the differences between samples are used, so
+ * the 32-bit counters can wrap (about 71 minutes) as long as the sampling period is shorter.
+ *
+ * The functions are not reentrant: the callers serialize the access to each task entry.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.24
+ *
+ * \date 2022/12/12
+ *
+ * \defgroup cpu_stats CPU Statistics
+ * \ingroup stats
+ * \{
+ */
+
+#ifndef CPU_STATS_H_
+#define CPU_STATS_H_
+
+#include <stdint.h>
+
+#define CPU_STATS_LOAD_FULL             10000U  /**< Load of a task that used the whole window (100.00 %). */
+
+/* Fields (parameter IDs) of a task */
+#define CPU_STATS_FIELD_LOAD            0U      /**< CPU usage in the last window (0.01 %). */
+#define CPU_STATS_FIELD_RUN_TIME        1U      /**< Total run time in milliseconds. */
+
+/**
+ * \brief CPU statistics of a task.
+ */
+typedef struct
+{
+    uint32_t counter;                       /**< Run time counter of the last sample in microseconds. */
+    uint32_t run_time_ms;                   /**< Total run time in milliseconds. */
+    uint16_t run_time_us;                   /**< Remainder of the total run time in microseconds (0 to 999). */
+    uint16_t load;                          /**< CPU usage in the last window (0.01 %). */
+} cpu_stats_t;
+
+/**
+ * \brief Updates the statistics of a task with a new sample.
+ *
+ * \param[in,out] stats is the statistics of the task.
+ *
+ * \param[in] counter is the run time counter of the task in microseconds.
+ *
+ * \param[in] window is the total time elapsed since the previous sample in microseconds.
+ *
+ * \return None.
+ */
+void cpu_stats_update(cpu_stats_t *stats, uint32_t counter, uint32_t window);
+
+/**
+ * \brief Reads a field of the statistics of a task.
+ *
+ * \param[in] stats is the statistics of the task.
+ *
+ * \param[in] field is the field ID (CPU_STATS_FIELD_*).
+ *
+ * \param[in,out] val is a pointer to store the field value.
+ *
+ * \return The status/error code.
+ */
+int cpu_stats_get_field(const cpu_stats_t *stats, uint8_t field, uint32_t *val);
+
+#endif /* CPU_STATS_H_ */
+
+/** \} End of cpu_stats group */
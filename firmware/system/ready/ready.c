@@ -0,0 +1,133 @@
+/*
+ * ready.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Ready wait implementation.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.14
+ *
+ * \date 2022/12/02
+ *
+ * \addtogroup ready
+ * \{
+ */
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include "ready.h"
+
+/**
+ * \brief Updates the latency statistics of a device with a new answer.
+ *
+ * \param[in,out] rdy is the ready wait state of the device.
+ *
+ * \param[in] latency_ms is the latency of the answer in milliseconds.
+ *
+ * \return None.
+ */
+static void ready_update_stats(ready_t *rdy, uint16_t latency_ms);
+
+int ready_wait(ready_t *rdy, uint16_t timeout_ms, ready_check_t check, void *arg)
+{
+    int err = -1;
+
+    TickType_t start = xTaskGetTickCount();
+
+    /* No answer is expected before the shortest latency already observed */
+    if ((rdy->stats.count > 0U) && (rdy->stats.min_ms > 0U))
+    {
+        vTaskDelay(pdMS_TO_TICKS(rdy->stats.min_ms));
+    }
+
+    while(1)
+    {
+        uint32_t elapsed_ms = ((uint32_t)(xTaskGetTickCount() - start) * 1000UL) / configTICK_RATE_HZ;
+
+        if (check(arg))
+        {
+            ready_update_stats(rdy, (elapsed_ms > UINT16_MAX) ? UINT16_MAX : (uint16_t)elapsed_ms);
+
+            err = 0;
+
+            break;
+        }
+
+        if (elapsed_ms >= timeout_ms)
+        {
+            taskENTER_CRITICAL();
+
+            rdy->stats.timeouts++;
+
+            taskEXIT_CRITICAL();
+
+            break;
+        }
+
+        vTaskDelay(pdMS_TO_TICKS(rdy->poll_ms));
+    }
+
+    return err;
+}
+
+void ready_get_stats(ready_t *rdy, ready_stats_t *stats)
+{
+    taskENTER_CRITICAL();
+
+    *stats = rdy->stats;
+
+    taskEXIT_CRITICAL();
+}
+
+static void ready_update_stats(ready_t *rdy, uint16_t latency_ms)
+{
+    taskENTER_CRITICAL();
+
+    if (rdy->stats.count == 0U)
+    {
+        rdy->stats.min_ms = latency_ms;
+        rdy->stats.max_ms = latency_ms;
+        rdy->stats.avg_ms = latency_ms;
+    }
+    else
+    {
+        if (latency_ms < rdy->stats.min_ms)
+        {
+            rdy->stats.min_ms = latency_ms;
+        }
+
+        if (latency_ms > rdy->stats.max_ms)
+        {
+            rdy->stats.max_ms = latency_ms;
+        }
+
+        rdy->stats.avg_ms = (uint16_t)((int32_t)rdy->stats.avg_ms + (((int32_t)latency_ms - (int32_t)rdy->stats.avg_ms) / 8L));
+    }
+
+    rdy->stats.count++;
+
+    taskEXIT_CRITICAL();
+}
+
+/** \} End of ready group */
@@ -0,0 +1,112 @@
+/*
+ * ready.h
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Ready wait definition.
+ *
+ * Instead of sleeping a fixed worst-case time after a command, the answer of a device is polled
+ * (with a task yield between polls) until it is ready or a hard timeout expires. The latency of
+ * each device is learned: the first poll is only done after the shortest latency observed so far.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.14
+ *
+ * \date 2022/12/02
+ *
+ * \defgroup ready Ready Wait
+ * \ingroup system
+ * \{
+ */
+
+#ifndef READY_H_
+#define READY_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * \brief Latency statistics of a device.
+ */
+typedef struct
+{
+    uint32_t count;             /**< Number of answers received. */
+    uint32_t timeouts;          /**< Number of answers not received before the timeout. */
+    uint16_t min_ms;            /**< Shortest latency in milliseconds. */
+    uint16_t max_ms;            /**< Longest latency in milliseconds. */
+    uint16_t avg_ms;            /**< Average latency in milliseconds (EWMA, 1/8 weight). */
+} ready_stats_t;
+
+/**
+ * \brief Ready wait state of a device.
+ */
+typedef struct
+{
+    uint16_t poll_ms;           /**< Period between polls in milliseconds. */
+    ready_stats_t stats;        /**< Learned latency statistics. */
+} ready_t;
+
+/**
+ * \brief Static initializer of a ready_t.
+ *
+ * \param[in] poll_ms is the period between polls in milliseconds.
+ */
+#define READY_INIT(poll_ms)     {(poll_ms), {0UL, 0UL, 0U, 0U, 0U}}
+
+/**
+ * \brief Ready check callback.
+ *
+ * \param[in,out] arg is the argument given to ready_wait.
+ *
+ * \return TRUE/FALSE if the answer is ready or not.
+ */
+typedef bool (*ready_check_t)(void *arg);
+
+/**
+ * \brief Waits until the answer of a device is ready.
+ *
+ * \param[in,out] rdy is the ready wait state of the device.
+ *
+ * \param[in] timeout_ms is the hard timeout in milliseconds.
+ *
+ * \param[in] check is the callback that checks if the answer is ready.
+ *
+ * \param[in,out] arg is the argument of the callback.
+ *
+ * \return The status/error code.
+ */
+int ready_wait(ready_t *rdy, uint16_t timeout_ms, ready_check_t check, void *arg);
+
+/**
+ * \brief Gets the latency statistics of a device.
+ *
+ * \param[in] rdy is the ready wait state of the device.
+ *
+ * \param[in,out] stats is a pointer to store the statistics.
+ *
+ * \return None.
+ */
+void ready_get_stats(ready_t *rdy, ready_stats_t *stats);
+
+#endif /* READY_H_ */
+
+/** \} End of ready group */
@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.7.25
+ * \version 0.10.21
  * 
  * \date 2019/11/03
  * 
@@ -33,16 +33,45 @@
  * \{
  */
 
-#include <math.h>
+#include <stdbool.h>
+#include <string.h>
 
 #include <FreeRTOS.h>
 #include <task.h>
 
 #include <version.h>
+#include <libs/format/fmt.h>
 
 #include "sys_log.h"
 #include "sys_log_config.h"
 
+/* The current text event is filtered (only changed by the holder of the log mutex) */
+static bool sys_log_muted = false;
+
+/**
+ * \brief Prints the header of an event (time, module name and color of the type).
+ *
+ * \param[in] type is the type of event.
+ *
+ * \param[in] time is the timestamp of the event in milliseconds.
+ *
+ * \param[in] module is the module name.
+ *
+ * \return None.
+ */
+static void sys_log_print_header(uint8_t type, uint32_t time, const char *module);
+
+/**
+ * \brief Writes a sequence of bytes to the log output, unless the current event is filtered.
+ *
+ * \param[in] data is the sequence of bytes to write.
+ *
+ * \param[in] len is the number of bytes to write.
+ *
+ * \return None.
+ */
+static void sys_log_write(const uint8_t *data, uint16_t len);
+
 int sys_log_init(void)
 {
     int err = -1;
@@ -87,6 +116,11 @@ int sys_log_init(void)
     return err;
 }
 
+void sys_log_flush(void)
+{
+    sys_log_uart_flush();
+}
+
 void sys_log_set_color(uint8_t color)
 {
     switch(color)
@@ -112,6 +146,9 @@ void sys_log_print_event(uint8_t type, const char *event)
 {
     int err = sys_log_mutex_take();
 
+    /* The rest of the event (until sys_log_new_line()) is muted too */
+    sys_log_muted = !SYS_LOG_ENABLED(type, SYS_LOG_MODULE_SYSTEM);
+
     sys_log_print_system_time();
     sys_log_print_msg(" ");
 
@@ -130,7 +167,28 @@ void sys_log_print_event_from_module(uint8_t type, const char *module, const cha
 {
     int err = sys_log_mutex_take();
 
-    sys_log_print_system_time();
+    /* The rest of the event (until sys_log_new_line()) is muted too */
+    sys_log_muted = !SYS_LOG_ENABLED(type, sys_log_module_id(module));
+
+    sys_log_print_header(type, xTaskGetTickCount(), module);
+
+    sys_log_print_msg(event);
+}
+
+void sys_log_print_event_from_module_at(uint8_t type, uint32_t time, const char *module, const char *event)
+{
+    int err = sys_log_mutex_take();
+
+    sys_log_muted = false;
+
+    sys_log_print_header(type, time, module);
+
+    sys_log_print_msg(event);
+}
+
+static void sys_log_print_header(uint8_t type, uint32_t time, const char *module)
+{
+    sys_log_print_time(time);
 
     sys_log_set_color(SYS_LOG_MODULE_NAME_COLOR);
     sys_log_print_msg(" ");
@@ -145,24 +203,54 @@ void sys_log_print_event_from_module(uint8_t type, const char *module, const cha
         case SYS_LOG_ERROR:     sys_log_set_color(SYS_LOG_ERROR_COLOR);     break;
         default:                                                            break;
     }
+}
 
-    sys_log_print_msg(event);
+const char *sys_log_module_name(uint8_t module)
+{
+    static const char *const names[SYS_LOG_MODULES] =
+    {
+    #define SYS_LOG_MODULE(id, name)    name,
+    #include "sys_log_modules.def"
+    #undef SYS_LOG_MODULE
+    };
+
+    return (module < SYS_LOG_MODULES) ? names[module] : names[SYS_LOG_MODULE_SYSTEM];
+}
+
+uint8_t sys_log_module_id(const char *name)
+{
+    uint8_t module = SYS_LOG_MODULE_SYSTEM;
+
+    uint8_t i = 0;
+    for(i = 0; i < SYS_LOG_MODULES; i++)
+    {
+        if (strcmp(sys_log_module_name(i), name) == 0)
+        {
+            module = i;
+            break;
+        }
+    }
+
+    return module;
 }
 
 void sys_log_print_msg(const char *msg)
 {
-    uint16_t i = 0;
-    while(msg[i] != '\0')
+    uint16_t len = 0;
+    while(msg[len] != '\0')
     {
-        sys_log_print_byte(msg[i]);
-        i++;
+        len++;
     }
+
+    sys_log_write((const uint8_t*)msg, len);
 }
 
 void sys_log_new_line(void)
 {
-    sys_log_reset_color();
-    sys_log_print_msg("\n\r");
+    sys_log_print_msg("\033" "[0m" "\n\r");
+
+    sys_log_muted = false;
+
     int err = sys_log_mutex_give();
 }
 
@@ -184,106 +272,69 @@ void sys_log_print_digit(uint8_t digit)
 
 void sys_log_print_str(char *str)
 {
-    uint16_t i = 0;
-    while(str[i] != '\0')
-    {
-        sys_log_print_byte(str[i]);
-        i++;
-    }
+    sys_log_print_msg(str);
 }
 
 void sys_log_print_uint(uint32_t uint)
 {
-    uint32_t uint_buf = uint;
+    char buf[FMT_UINT_MAX_LEN];
 
-    if (uint == 0U)
-    {
-        sys_log_print_digit(0);
-    }
-    else
-    {
-        uint8_t uint_str[10] = {0};     /* 32-bits = decimal with 10 digits */
-
-        uint8_t digits = log10(uint) + 1;
-
-        uint8_t i = 0;
-        for(i = 0; i < digits; ++i)
-        {
-            uint_str[i] = uint_buf % 10U;
-
-            uint_buf /= 10U;
-        }
-
-        uint8_t j = 0;
-        for(j = i; j > 0U; j--)
-        {
-            sys_log_print_digit(uint_str[j-1U]);
-        }
-    }
+    sys_log_write((const uint8_t*)buf, fmt_uint(buf, uint));
 }
 
 void sys_log_print_int(int32_t sint)
 {
-    int32_t sint_buf = sint;
-
-    if (sint_buf < 0)
-    {
-        sint_buf = abs(sint);
-        sys_log_print_msg("-");
-    }
+    char buf[FMT_INT_MAX_LEN];
 
-    sys_log_print_uint((uint32_t)sint_buf);
+    sys_log_write((const uint8_t*)buf, fmt_int(buf, sint));
 }
 
 void sys_log_print_hex(uint32_t hex)
 {
-    sys_log_print_msg("0x");
-    
-    if (hex > 0x00FFFFFFU)
-    {
-        sys_log_print_digit((uint8_t)(hex >> 28) & 0x0FU);
-        sys_log_print_digit((uint8_t)(hex >> 24) & 0x0FU);
-    }
-
-    if (hex > 0x0000FFFFU)
-    {
-        sys_log_print_digit((uint8_t)(hex >> 20) & 0x0FU);
-        sys_log_print_digit((uint8_t)(hex >> 16) & 0x0FU);
-    }
-
-    if (hex > 0x000000FFU)
-    {
-        sys_log_print_digit((uint8_t)(hex >> 12) & 0x0FU);
-        sys_log_print_digit((uint8_t)(hex >> 8) & 0x0FU);
-    }
+    char buf[FMT_HEX_MAX_LEN];
 
-    sys_log_print_digit((uint8_t)(hex >> 4) & 0x0FU);
-    sys_log_print_digit((uint8_t)(hex & 0x0FU));
+    sys_log_write((const uint8_t*)buf, fmt_hex(buf, hex));
 }
 
 void sys_log_dump_hex(uint8_t *data, uint16_t len)
 {
+    char buf[SYS_LOG_DUMP_HEX_CHUNK * 6U];  /* "0xHH, " per byte */
+    uint16_t buf_len = 0;
+
     uint16_t i = 0;
     for(i = 0; i < len; i++)
     {
-        sys_log_print_hex(data[i]);
+        buf_len += fmt_hex(&buf[buf_len], data[i]);
 
         if (i < (len-1U))
         {
-            sys_log_print_msg(", ");
+            buf[buf_len] = ',';
+            buf[buf_len + 1U] = ' ';
+            buf_len += 2U;
+        }
+
+        /* Flushes when the buffer is full or at the last byte */
+        if ((buf_len > (sizeof(buf) - 6U)) || (i == (len-1U)))
+        {
+            sys_log_write((const uint8_t*)buf, buf_len);
+            buf_len = 0;
         }
     }
 }
 
 void sys_log_print_float(float flt, uint8_t digits)
 {
-    float flt_pos = 0.0;
+    char buf[FMT_INT_MAX_LEN + 1U + FMT_Q_MAX_DIGITS];
+    uint8_t dig = (digits > FMT_Q_MAX_DIGITS) ? FMT_Q_MAX_DIGITS : digits;
 
-    if (flt < 0.0)
-    {
-        sys_log_print_msg("-");
+    float flt_pos = (flt < 0.0f) ? -flt : flt;
+
+    uint8_t len = 0;
 
-        flt_pos = abs(flt);
+    if (flt < 0.0f)
+    {
+        buf[len] = '-';
+        len++;
     }
 
     /* Extract integer part */
@@ -292,28 +343,63 @@ void sys_log_print_float(float flt, uint8_t digits)
     /* Extract floating part */
     float fpart = flt_pos - (float)ipart;
 
-    /* Print integer part */
-    sys_log_print_uint(ipart);
+    len += fmt_uint(&buf[len], ipart);
+
+    buf[len] = '.';
+    len++;
+
+    /* Print the floating part digit by digit (no pow() and keeps the leading zeros) */
+    uint8_t i = 0;
+    for(i = 0; i < dig; i++)
+    {
+        fpart *= 10.0f;
+
+        uint8_t d = (uint8_t)fpart;
 
-    /* Print decimal point */
-    sys_log_print_msg(".");
+        buf[len] = (char)('0' + d);
+        len++;
+
+        fpart -= (float)d;
+    }
+
+    sys_log_write((const uint8_t*)buf, len);
+}
+
+void sys_log_print_q(int32_t val, uint8_t frac_bits, uint8_t digits)
+{
+    char buf[FMT_Q_MAX_LEN];
 
-    /* Print floating part */
-    sys_log_print_uint((uint32_t)(fpart*pow(10, digits)));
+    sys_log_write((const uint8_t*)buf, fmt_q(buf, val, frac_bits, digits));
 }
 
 void sys_log_print_byte(uint8_t byte)
 {
-    sys_log_uart_write_byte(byte);
+    if (!sys_log_muted)
+    {
+        sys_log_uart_write_byte(byte);
+    }
 }
 
 void sys_log_print_system_time(void)
 {
+    sys_log_print_time(xTaskGetTickCount());    /* System time in milliseconds */
+}
+
+void sys_log_print_time(uint32_t time)
+{
+    char buf[2U + FMT_UINT_MAX_LEN + 2U];   /* "[ " + time + " ]" */
+    uint8_t len = 0;
+
+    buf[0] = '[';
+    buf[1] = ' ';
+    len = 2U + fmt_uint(&buf[2], time);
+    buf[len] = ' ';
+    buf[len + 1U] = ']';
+    len += 2U;
+
     sys_log_set_color(SYS_LOG_SYSTEM_TIME_COLOR);
 
-    sys_log_print_msg("[ ");
-    sys_log_print_uint(xTaskGetTickCount());    /* System time in milliseconds */
-    sys_log_print_msg(" ]");
+    sys_log_write((const uint8_t*)buf, len);
 
     sys_log_reset_color();
 }
@@ -391,4 +477,12 @@ void sys_log_print_firmware_version(void)
     sys_log_print_msg(FIRMWARE_VERSION);
 }
 
+static void sys_log_write(const uint8_t *data, uint16_t len)
+{
+    if (!sys_log_muted)
+    {
+        sys_log_uart_write(data, len);
+    }
+}
+
 /** \} End of sys_log group */
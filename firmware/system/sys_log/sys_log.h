@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.7.25
+ * \version 0.10.23
  * 
  * \date 2019/11/03
  * 
@@ -39,6 +39,8 @@
 
 #include <stdint.h>
 
+#include <config/config.h>
+
 /**
  * \brief Event types.
  */
@@ -49,6 +51,73 @@ typedef enum
     SYS_LOG_ERROR               /**< Error message. */
 } sys_log_event_type_e;
 
+#define SYS_LOG_LEVEL_OFF           3U      /**< Module level that disables all the events of a module. */
+
+#define SYS_LOG_FRAME_SYNC          0xA5U   /**< First byte of a tokenized log frame (never used in the text messages). */
+#define SYS_LOG_FRAME_LEN           18U     /**< Length of a tokenized log frame in bytes. */
+
+#define SYS_LOG_BLACK_BOX_RECORD_LEN    16U     /**< Length of a black box record in bytes. */
+
+/**
+ * \brief Modules IDs (generated from sys_log_modules.def).
+ */
+typedef enum
+{
+#define SYS_LOG_MODULE(id, name)    id,
+#include "sys_log_modules.def"
+#undef SYS_LOG_MODULE
+    SYS_LOG_MODULES                         /**< Number of modules. */
+} sys_log_module_e;
+
+/**
+ * \brief Minimum event type of each module (SYS_LOG_INFO to SYS_LOG_LEVEL_OFF), indexed by module ID.
+ */
+extern volatile uint8_t sys_log_levels[SYS_LOG_MODULES];
+
+/**
+ * \brief Checks if the events of a given type and module are enabled.
+ *
+ * Types below CONFIG_SYS_LOG_LEVEL are a constant false (the guarded code is removed by the
+ * compiler), and the rest are filtered by the runtime level of the module. The text events are
+ * also filtered inside sys_log_print_event_from_module(), so this check is only needed to skip
+ * the formatting cost (and the system log mutex) of the disabled events:
+ * \code
+ * if (SYS_LOG_ENABLED(SYS_LOG_INFO, SYS_LOG_MODULE_READ_EDC))
+ * {
+ *     sys_log_print_event_from_module(SYS_LOG_INFO, TASK_READ_EDC_NAME, "...");
+ *     sys_log_new_line();
+ * }
+ * \endcode
+ *
+ * \param[in] type is the event type.
+ *
+ * \param[in] module is the module ID (sys_log_module_e).
+ */
+#define SYS_LOG_ENABLED(type, module)   (((type) >= CONFIG_SYS_LOG_LEVEL) && ((uint8_t)(type) >= sys_log_levels[(module)]))
+
+/**
+ * \brief Logs a deferred event if it is enabled (see SYS_LOG_ENABLED and sys_log_deferred()).
+ */
+#define SYS_LOG_DEFERRED(type, module, token, arg0, arg1)                   \
+    do                                                                      \
+    {                                                                       \
+        if (SYS_LOG_ENABLED((type), (module)))                              \
+        {                                                                   \
+            sys_log_deferred((type), (module), (token), (arg0), (arg1));    \
+        }                                                                   \
+    } while(0)
+
+/**
+ * \brief Log tokens IDs (generated from sys_log_tokens.def).
+ */
+typedef enum
+{
+#define SYS_LOG_TOKEN(id, fmt)      id,
+#include "sys_log_tokens.def"
+#undef SYS_LOG_TOKEN
+    SYS_LOG_TOKENS                          /**< Number of tokens. */
+} sys_log_token_e;
+
 /**
  * \brief System log text colors list.
  */
@@ -71,6 +140,16 @@ typedef enum
  */
 int sys_log_init(void);
 
+/**
+ * \brief Waits until all the pending log messages are transmitted.
+ *
+ * Must be called before a software reset, since the reset discards the messages that are still
+ * in the TX buffer of the UART port.
+ *
+ * \return None.
+ */
+void sys_log_flush(void);
+
 /**
  * \brief Sets the foreground color for the next log message.
  *
@@ -103,6 +182,9 @@ void sys_log_reset_color(void);
 /**
  * \brief Prints a general event.
  *
+ * The event is filtered by the level of the module SYS_LOG_MODULE_SYSTEM (see
+ * sys_log_print_event_from_module()).
+ *
  * \param[in] type is the type of event. It can be:
  * \parblock
  *      -\b SYS_LOG_INFO
@@ -120,6 +202,10 @@ void sys_log_print_event(uint8_t type, const char *event);
 /**
  * \brief Prints an event from a system module.
  *
+ * The event is filtered by the level of the module with the given name (sys_log_module_id()).
+ * A filtered event prints nothing until the sys_log_new_line() call that ends it, so the
+ * values printed after the event text are filtered too.
+ *
  * \param[in] type is the type of event. It can be:
  * \parblock
  *      -\b SYS_LOG_INFO
@@ -136,6 +222,205 @@ void sys_log_print_event(uint8_t type, const char *event);
  */
 void sys_log_print_event_from_module(uint8_t type, const char *module, const char *event);
 
+/**
+ * \brief Prints an event from a system module with a given timestamp.
+ *
+ * The event is not filtered (it is used to print the deferred records, filtered when logged).
+ *
+ * \param[in] type is the type of event. It can be:
+ * \parblock
+ *      -\b SYS_LOG_INFO
+ *      -\b SYS_LOG_WARNING
+ *      -\b SYS_LOG_ERROR
+ *      .
+ * \endparblock
+ *
+ * \param[in] time is the timestamp of the event in milliseconds.
+ *
+ * \param[in] module is the module name.
+ *
+ * \param[in] event is the event text.
+ *
+ * \return None.
+ */
+void sys_log_print_event_from_module_at(uint8_t type, uint32_t time, const char *module, const char *event);
+
+/**
+ * \brief Gets the name of a module.
+ *
+ * \param[in] module is the module ID (sys_log_module_e).
+ *
+ * \return A pointer to the module name.
+ */
+const char *sys_log_module_name(uint8_t module);
+
+/**
+ * \brief Gets the ID of a module from its name.
+ *
+ * \param[in] name is the module name (as in sys_log_modules.def).
+ *
+ * \return The module ID, or SYS_LOG_MODULE_SYSTEM if there is no module with the given name
+ * (the drivers and devices).
+ */
+uint8_t sys_log_module_id(const char *name);
+
+/**
+ * \brief Logs an event without formatting or transmitting it (deferred logging).
+ *
+ * A compact binary record is stored in a ring and rendered later by sys_log_deferred_flush(),
+ * so the caller does not wait for the UART or for the system log mutex. The event text is given
+ * by a token of sys_log_tokens.def.
+ *
+ * If the deferred logging is disabled (CONFIG_SYS_LOG_DEFERRED_ENABLED), the event is printed
+ * immediately. It can only be called from tasks (not from ISRs).
+ *
+ * \param[in] type is the type of event. It can be:
+ * \parblock
+ *      -\b SYS_LOG_INFO
+ *      -\b SYS_LOG_WARNING
+ *      -\b SYS_LOG_ERROR
+ *      .
+ * \endparblock
+ *
+ * \param[in] module is the module ID (sys_log_module_e).
+ *
+ * \param[in] token is the token ID of the event text (sys_log_token_e).
+ *
+ * \param[in] arg0 is the first argument (ignored if not used by the token format).
+ *
+ * \param[in] arg1 is the second argument (ignored if not used by the token format).
+ *
+ * \return None.
+ */
+void sys_log_deferred(uint8_t type, uint8_t module, uint16_t token, uint32_t arg0, uint32_t arg1);
+
+/**
+ * \brief Prints a tokenized event.
+ *
+ * With CONFIG_SYS_LOG_TOKENIZED_ENABLED, the event is sent as a binary frame of
+ * SYS_LOG_FRAME_LEN bytes (decoded on the host with the sys_log_decoder tool):
+ * \code
+ * | sync (0xA5) | time (4) | token (2) | module (1) | type (1) | arg0 (4) | arg1 (4) | xor (1) |
+ * \endcode
+ * The multibyte fields are little-endian, and the last byte is the XOR of the bytes between the
+ * sync byte and itself. Otherwise the token format is rendered as text.
+ *
+ * \param[in] type is the type of event (SYS_LOG_INFO, SYS_LOG_WARNING or SYS_LOG_ERROR).
+ *
+ * \param[in] time is the timestamp of the event in milliseconds.
+ *
+ * \param[in] module is the module ID (sys_log_module_e).
+ *
+ * \param[in] token is the token ID of the event text (sys_log_token_e).
+ *
+ * \param[in] arg0 is the first argument.
+ *
+ * \param[in] arg1 is the second argument.
+ *
+ * \return None.
+ */
+void sys_log_print_token(uint8_t type, uint32_t time, uint8_t module, uint16_t token, uint32_t arg0, uint32_t arg1);
+
+/**
+ * \brief Renders the pending deferred log records over the UART port.
+ *
+ * The records are also stored in the black box (CONFIG_SYS_LOG_BLACK_BOX_ENABLED). It should
+ * be called by a low priority task.
+ *
+ * \return The number of rendered records.
+ */
+uint16_t sys_log_deferred_flush(void);
+
+/**
+ * \brief Initializes the black box (persistent event log in the FRAM memory).
+ *
+ * Loads the position of the ring from the FRAM memory (the ring starts empty if no valid
+ * position is found). The FRAM memory must be already initialized.
+ *
+ * \return The status/error code.
+ */
+int sys_log_black_box_init(void);
+
+/**
+ * \brief Stores an event in the black box.
+ *
+ * Each event is a record of SYS_LOG_BLACK_BOX_RECORD_LEN bytes (big-endian fields):
+ * \code
+ * | time (4) | module (1) | type (1) | token (2) | arg0 (4) | arg1 (4) |
+ * \endcode
+ * The time is the system time (seconds, see system_get_time()), so the records can be dated
+ * after a reset.
+ * When the ring is full, the oldest record is overwritten. The deferred records are stored
+ * by sys_log_deferred_flush(), so this function must only be called from a single task.
+ *
+ * \param[in] type is the type of event (SYS_LOG_INFO, SYS_LOG_WARNING or SYS_LOG_ERROR).
+ *
+ * \param[in] time is the system time of the event in seconds.
+ *
+ * \param[in] module is the module ID (sys_log_module_e).
+ *
+ * \param[in] token is the token ID of the event (sys_log_token_e).
+ *
+ * \param[in] arg0 is the first argument.
+ *
+ * \param[in] arg1 is the second argument.
+ *
+ * \return None.
+ */
+void sys_log_black_box_write(uint8_t type, uint32_t time, uint8_t module, uint16_t token, uint32_t arg0, uint32_t arg1);
+
+/**
+ * \brief Gets the sequence number of the oldest record stored in the black box.
+ *
+ * \return The sequence number of the oldest record.
+ */
+uint32_t sys_log_black_box_first(void);
+
+/**
+ * \brief Gets the sequence number of the next record of the black box.
+ *
+ * The stored records are the ones in [sys_log_black_box_first(), sys_log_black_box_next()).
+ *
+ * \return The sequence number of the next record.
+ */
+uint32_t sys_log_black_box_next(void);
+
+/**
+ * \brief Reads a sequence of records from the black box.
+ *
+ * \param[in] seq is the sequence number of the first record to read.
+ *
+ * \param[in,out] data is a buffer to store the records (n*SYS_LOG_BLACK_BOX_RECORD_LEN bytes).
+ *
+ * \param[in] n is the number of records to read.
+ *
+ * \return The status/error code (-1 if any of the records is not stored).
+ */
+int sys_log_black_box_read(uint32_t seq, uint8_t *data, uint16_t n);
+
+/**
+ * \brief Sets the runtime level of a module.
+ *
+ * \param[in] module is the module ID (sys_log_module_e).
+ *
+ * \param[in] level is the minimum event type to log (SYS_LOG_INFO, SYS_LOG_WARNING,
+ * SYS_LOG_ERROR or SYS_LOG_LEVEL_OFF).
+ *
+ * \return The status/error code.
+ */
+int sys_log_set_level(uint8_t module, uint8_t level);
+
+/**
+ * \brief Gets the runtime level of a module.
+ *
+ * \param[in] module is the module ID (sys_log_module_e).
+ *
+ * \param[in,out] level is a pointer to store the level of the module.
+ *
+ * \return The status/error code.
+ */
+int sys_log_get_level(uint8_t module, uint8_t *level);
+
 /**
  * \brief Prints a message over the system log module.
  * 
@@ -225,6 +510,23 @@ void sys_log_dump_hex(uint8_t *data, uint16_t len);
  */
 void sys_log_print_float(float flt, uint8_t digits);
 
+/**
+ * \brief Prints a fixed-point number (Q format) over the system log module.
+ *
+ * Example:
+ *      - val = 411, frac_bits = 8, digits = 3
+ *      - Output = "1.605"
+ *
+ * \param[in] val is the fixed-point value.
+ *
+ * \param[in] frac_bits is the number of fractional bits of the value (up to 28).
+ *
+ * \param[in] digits is the number of decimal places to print (truncated, up to 9).
+ *
+ * \return None.
+ */
+void sys_log_print_q(int32_t val, uint8_t frac_bits, uint8_t digits);
+
 /**
  * \brief Prints a raw byte over the system log module.
  * 
@@ -241,6 +543,15 @@ void sys_log_print_byte(uint8_t byte);
  */
 void sys_log_print_system_time(void);
 
+/**
+ * \brief Prints a timestamp in the same format of the system time.
+ *
+ * \param[in] time is the timestamp in milliseconds.
+ *
+ * \return None.
+ */
+void sys_log_print_time(uint32_t time);
+
 /**
  * \brief Prints the license text and genreal firmware information.
  *
@@ -286,6 +597,24 @@ int sys_log_uart_init(void);
  */
 void sys_log_uart_write_byte(uint8_t byte);
 
+/**
+ * \brief Writes a sequence of bytes over the UART port.
+ *
+ * \param[in] data is the array of bytes to write.
+ *
+ * \param[in] len is the number of bytes to write.
+ *
+ * \return None.
+ */
+void sys_log_uart_write(const uint8_t *data, uint16_t len);
+
+/**
+ * \brief Waits until all the bytes written to the UART port are transmitted.
+ *
+ * \return None.
+ */
+void sys_log_uart_flush(void);
+
 /**
  * \brief Creates a mutex to use the system log module.
  *
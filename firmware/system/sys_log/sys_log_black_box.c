@@ -0,0 +1,250 @@
+/*
+ * sys_log_black_box.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief System log black box implementation.
+ *
+ * The events are kept in a ring of fixed-size records in the FRAM memory, addressed by a
+ * 32-bit sequence number (the slot of a record is its sequence number modulo the number of
+ * records). The sequence number of the next record is saved in the FRAM after each record, so
+ * the ring survives resets. The FRAM has no erase operation and a virtually unlimited write
+ * endurance, so each event costs only two short SPI writes.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.22
+ *
+ * \date 2022/12/10
+ *
+ * \defgroup sys_log_black_box Black Box
+ * \ingroup sys_log
+ * \{
+ */
+
+#include <stdbool.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <devices/media/media.h>
+
+#include "sys_log.h"
+#include "sys_log_config.h"
+
+#if defined(CONFIG_SYS_LOG_BLACK_BOX_ENABLED) && (CONFIG_SYS_LOG_BLACK_BOX_ENABLED == 1)
+
+#define SYS_LOG_BLACK_BOX_MASK      (CONFIG_SYS_LOG_BLACK_BOX_RECORDS - 1UL)
+
+/* The number of records must be a power of two (the MSP430 has no hardware divider) */
+typedef char sys_log_black_box_records_check[((CONFIG_SYS_LOG_BLACK_BOX_RECORDS & SYS_LOG_BLACK_BOX_MASK) == 0UL) ? 1 : -1];
+
+static volatile uint32_t sys_log_black_box_seq = 0UL;   /**< Sequence number of the next record. */
+static bool sys_log_black_box_ready = false;
+
+/**
+ * \brief Writes an unsigned integer in big-endian.
+ *
+ * \param[in,out] buf is the buffer to write the value.
+ *
+ * \param[in] val is the value to write.
+ *
+ * \param[in] len is the number of bytes to write.
+ *
+ * \return None.
+ */
+static void sys_log_black_box_put_be(uint8_t *buf, uint32_t val, uint8_t len);
+
+/**
+ * \brief Reads an unsigned integer in big-endian.
+ *
+ * \param[in] buf is the buffer with the value.
+ *
+ * \return The read value (4 bytes).
+ */
+static uint32_t sys_log_black_box_get_be(const uint8_t *buf);
+
+/**
+ * \brief Saves the sequence number of the next record in the FRAM memory.
+ *
+ * \param[in] seq is the sequence number to save.
+ *
+ * \return The status/error code.
+ */
+static int sys_log_black_box_save_index(uint32_t seq);
+
+#endif /* CONFIG_SYS_LOG_BLACK_BOX_ENABLED */
+
+int sys_log_black_box_init(void)
+{
+    int err = 0;
+
+#if defined(CONFIG_SYS_LOG_BLACK_BOX_ENABLED) && (CONFIG_SYS_LOG_BLACK_BOX_ENABLED == 1)
+    uint8_t buf[SYS_LOG_BLACK_BOX_INDEX_LEN] = {0};
+
+    if (media_read(MEDIA_FRAM, CONFIG_MEM_ADR_BLACK_BOX_INDEX, buf, SYS_LOG_BLACK_BOX_INDEX_LEN) == 0)
+    {
+        uint32_t seq = sys_log_black_box_get_be(&buf[1]);
+
+        /* The sequence number is stored with its complement to detect invalid or torn writes */
+        if ((buf[0] == SYS_LOG_BLACK_BOX_MEM_ID) && ((seq ^ sys_log_black_box_get_be(&buf[5])) == UINT32_MAX))
+        {
+            sys_log_black_box_seq = seq;
+        }
+        else
+        {
+            sys_log_black_box_seq = 0UL;
+
+            err = sys_log_black_box_save_index(0UL);
+        }
+
+        sys_log_black_box_ready = true;
+    }
+    else
+    {
+        err = -1;
+    }
+#endif /* CONFIG_SYS_LOG_BLACK_BOX_ENABLED */
+
+    return err;
+}
+
+void sys_log_black_box_write(uint8_t type, uint32_t time, uint8_t module, uint16_t token, uint32_t arg0, uint32_t arg1)
+{
+#if defined(CONFIG_SYS_LOG_BLACK_BOX_ENABLED) && (CONFIG_SYS_LOG_BLACK_BOX_ENABLED == 1)
+    if (sys_log_black_box_ready)
+    {
+        uint8_t rec[SYS_LOG_BLACK_BOX_RECORD_LEN] = {0};
+
+        sys_log_black_box_put_be(&rec[0], time, 4U);
+        rec[4] = module;
+        rec[5] = type;
+        sys_log_black_box_put_be(&rec[6], token, 2U);
+        sys_log_black_box_put_be(&rec[8], arg0, 4U);
+        sys_log_black_box_put_be(&rec[12], arg1, 4U);
+
+        /* Single writer (the log flush task), so the sequence number can be read without a critical section */
+        uint32_t seq = sys_log_black_box_seq;
+        uint32_t adr = CONFIG_MEM_ADR_BLACK_BOX_START + ((seq & SYS_LOG_BLACK_BOX_MASK) * SYS_LOG_BLACK_BOX_RECORD_LEN);
+
+        if (media_write(MEDIA_FRAM, adr, rec, SYS_LOG_BLACK_BOX_RECORD_LEN) == 0)
+        {
+            taskENTER_CRITICAL();
+
+            sys_log_black_box_seq = seq + 1UL;
+
+            taskEXIT_CRITICAL();
+
+            (void)sys_log_black_box_save_index(seq + 1UL);
+        }
+    }
+#endif /* CONFIG_SYS_LOG_BLACK_BOX_ENABLED */
+}
+
+uint32_t sys_log_black_box_next(void)
+{
+    uint32_t seq = 0UL;
+
+#if defined(CONFIG_SYS_LOG_BLACK_BOX_ENABLED) && (CONFIG_SYS_LOG_BLACK_BOX_ENABLED == 1)
+    /* 32-bit read in a 16-bit CPU */
+    taskENTER_CRITICAL();
+
+    seq = sys_log_black_box_seq;
+
+    taskEXIT_CRITICAL();
+#endif /* CONFIG_SYS_LOG_BLACK_BOX_ENABLED */
+
+    return seq;
+}
+
+uint32_t sys_log_black_box_first(void)
+{
+    uint32_t seq = 0UL;
+
+#if defined(CONFIG_SYS_LOG_BLACK_BOX_ENABLED) && (CONFIG_SYS_LOG_BLACK_BOX_ENABLED == 1)
+    uint32_t next = sys_log_black_box_next();
+
+    seq = (next > CONFIG_SYS_LOG_BLACK_BOX_RECORDS) ? (next - CONFIG_SYS_LOG_BLACK_BOX_RECORDS) : 0UL;
+#endif /* CONFIG_SYS_LOG_BLACK_BOX_ENABLED */
+
+    return seq;
+}
+
+int sys_log_black_box_read(uint32_t seq, uint8_t *data, uint16_t n)
+{
+    int err = -1;
+
+#if defined(CONFIG_SYS_LOG_BLACK_BOX_ENABLED) && (CONFIG_SYS_LOG_BLACK_BOX_ENABLED == 1)
+    if ((n > 0U) && (n <= CONFIG_SYS_LOG_BLACK_BOX_RECORDS) && (seq >= sys_log_black_box_first()) && ((seq + n) <= sys_log_black_box_next()))
+    {
+        uint32_t slot = seq & SYS_LOG_BLACK_BOX_MASK;
+
+        /* Records until the end of the ring (the rest is read from the beginning) */
+        uint16_t first_n = ((slot + n) > CONFIG_SYS_LOG_BLACK_BOX_RECORDS) ? (uint16_t)(CONFIG_SYS_LOG_BLACK_BOX_RECORDS - slot) : n;
+
+        err = media_read(MEDIA_FRAM, CONFIG_MEM_ADR_BLACK_BOX_START + (slot * SYS_LOG_BLACK_BOX_RECORD_LEN), data, first_n * SYS_LOG_BLACK_BOX_RECORD_LEN);
+
+        if ((err == 0) && (first_n < n))
+        {
+            err = media_read(MEDIA_FRAM, CONFIG_MEM_ADR_BLACK_BOX_START, &data[first_n * SYS_LOG_BLACK_BOX_RECORD_LEN], (n - first_n) * SYS_LOG_BLACK_BOX_RECORD_LEN);
+        }
+
+        /* The oldest records can be overwritten by the log flush task during the read */
+        if ((err == 0) && (seq < sys_log_black_box_first()))
+        {
+            err = -1;
+        }
+    }
+#endif /* CONFIG_SYS_LOG_BLACK_BOX_ENABLED */
+
+    return err;
+}
+
+#if defined(CONFIG_SYS_LOG_BLACK_BOX_ENABLED) && (CONFIG_SYS_LOG_BLACK_BOX_ENABLED == 1)
+
+static void sys_log_black_box_put_be(uint8_t *buf, uint32_t val, uint8_t len)
+{
+    uint8_t i = 0U;
+    for(i = 0U; i < len; i++)
+    {
+        buf[i] = (uint8_t)(val >> (8U * (len - 1U - i)));
+    }
+}
+
+static uint32_t sys_log_black_box_get_be(const uint8_t *buf)
+{
+    return ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) | ((uint32_t)buf[2] << 8) | (uint32_t)buf[3];
+}
+
+static int sys_log_black_box_save_index(uint32_t seq)
+{
+    uint8_t buf[SYS_LOG_BLACK_BOX_INDEX_LEN] = {0};
+
+    buf[0] = SYS_LOG_BLACK_BOX_MEM_ID;
+    sys_log_black_box_put_be(&buf[1], seq, 4U);
+    sys_log_black_box_put_be(&buf[5], ~seq, 4U);
+
+    return media_write(MEDIA_FRAM, CONFIG_MEM_ADR_BLACK_BOX_INDEX, buf, SYS_LOG_BLACK_BOX_INDEX_LEN);
+}
+
+#endif /* CONFIG_SYS_LOG_BLACK_BOX_ENABLED */
+
+/** \} End of sys_log_black_box group */
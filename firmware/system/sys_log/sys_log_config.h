@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.3.11
+ * \version 0.10.22
  * 
  * \date 22/02/2019
  * 
@@ -50,6 +50,16 @@
 /* Mutex config. */
 #define SYS_LOG_MUTEX_WAIT_TIME_MS      100
 
+/* Deferred mode */
+#define SYS_LOG_DEFERRED_MAX_ARGS       2
+
+/* Bytes of each UART write of sys_log_dump_hex() */
+#define SYS_LOG_DUMP_HEX_CHUNK          16U
+
+/* Black box */
+#define SYS_LOG_BLACK_BOX_MEM_ID        0xB0U   /* First byte of a valid black box index in the FRAM */
+#define SYS_LOG_BLACK_BOX_INDEX_LEN     9U      /* ID + next sequence number + its complement */
+
 /* Log messages colors */
 #define SYS_LOG_SYSTEM_TIME_COLOR       SYS_LOG_COLOR_GREEN
 #define SYS_LOG_MODULE_NAME_COLOR       SYS_LOG_COLOR_MAGENTA
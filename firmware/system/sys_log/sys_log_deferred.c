@@ -0,0 +1,171 @@
+/*
+ * sys_log_deferred.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief System log deferred mode implementation.
+ *
+ * The events are stored as fixed-size binary records in a ring of slots. A producer only
+ * reserves its slot inside a critical section (a few instructions, no mutex), fills it, and
+ * marks it as ready. The consumer (a low priority task) renders the ready records in order.
+ * When the ring is full, the new records are dropped and counted. The rendered records are also
+ * stored in the black box, so the FRAM writes are out of the producers path too.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.22
+ *
+ * \date 2022/12/07
+ *
+ * \defgroup sys_log_deferred Deferred
+ * \ingroup sys_log
+ * \{
+ */
+
+#include <stdbool.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#include <system/system.h>
+
+#include "sys_log.h"
+#include "sys_log_config.h"
+
+#if defined(CONFIG_SYS_LOG_DEFERRED_ENABLED) && (CONFIG_SYS_LOG_DEFERRED_ENABLED == 1)
+
+#define SYS_LOG_DEFERRED_MASK       (CONFIG_SYS_LOG_DEFERRED_RECORDS - 1U)
+
+/* The number of records must be a power of two */
+typedef char sys_log_deferred_records_check[((CONFIG_SYS_LOG_DEFERRED_RECORDS & SYS_LOG_DEFERRED_MASK) == 0U) ? 1 : -1];
+
+/**
+ * \brief Deferred log record.
+ */
+typedef struct
+{
+    uint32_t time;                                  /**< Timestamp in milliseconds (since the boot). */
+    sys_time_t sys_time;                            /**< System time in seconds (stored in the black box). */
+    uint32_t args[SYS_LOG_DEFERRED_MAX_ARGS];       /**< Arguments. */
+    uint16_t token;                                 /**< Token ID of the event text. */
+    uint8_t module;                                 /**< Module ID. */
+    uint8_t type;                                   /**< Event type. */
+    bool ready;                                     /**< The record is complete (set by the producer, cleared by the consumer). */
+} sys_log_record_t;
+
+static volatile sys_log_record_t sys_log_records[CONFIG_SYS_LOG_DEFERRED_RECORDS];
+
+static volatile uint16_t sys_log_head = 0U;         /**< Next slot to reserve (producers). */
+static volatile uint16_t sys_log_tail = 0U;         /**< Next slot to render (consumer). */
+static volatile uint16_t sys_log_dropped = 0U;      /**< Records dropped since the last flush. */
+
+#endif /* CONFIG_SYS_LOG_DEFERRED_ENABLED */
+
+void sys_log_deferred(uint8_t type, uint8_t module, uint16_t token, uint32_t arg0, uint32_t arg1)
+{
+#if defined(CONFIG_SYS_LOG_DEFERRED_ENABLED) && (CONFIG_SYS_LOG_DEFERRED_ENABLED == 1)
+    bool reserved = false;
+    uint16_t slot = 0U;
+
+    taskENTER_CRITICAL();
+
+    if ((uint16_t)(sys_log_head - sys_log_tail) < CONFIG_SYS_LOG_DEFERRED_RECORDS)
+    {
+        slot = sys_log_head & SYS_LOG_DEFERRED_MASK;
+
+        sys_log_head++;
+
+        reserved = true;
+    }
+    else
+    {
+        sys_log_dropped++;
+    }
+
+    taskEXIT_CRITICAL();
+
+    if (reserved)
+    {
+        volatile sys_log_record_t *rec = &sys_log_records[slot];
+
+        rec->time       = xTaskGetTickCount();
+        rec->sys_time   = system_get_time();
+        rec->token      = token;
+        rec->args[0]    = arg0;
+        rec->args[1]    = arg1;
+        rec->module     = module;
+        rec->type       = type;
+        rec->ready      = true;
+    }
+#else
+    uint32_t time = xTaskGetTickCount();
+
+    sys_log_print_token(type, time, module, token, arg0, arg1);
+
+    sys_log_black_box_write(type, system_get_time(), module, token, arg0, arg1);
+#endif /* CONFIG_SYS_LOG_DEFERRED_ENABLED */
+}
+
+uint16_t sys_log_deferred_flush(void)
+{
+    uint16_t cnt = 0U;
+
+#if defined(CONFIG_SYS_LOG_DEFERRED_ENABLED) && (CONFIG_SYS_LOG_DEFERRED_ENABLED == 1)
+    /* Only the records reserved before the flush: the black box writes can log bus errors too */
+    uint16_t head = sys_log_head;
+
+    /* A reserved slot that is not ready yet stops the flush (it is rendered in the next call) */
+    while((sys_log_tail != head) && sys_log_records[sys_log_tail & SYS_LOG_DEFERRED_MASK].ready)
+    {
+        sys_log_record_t rec = sys_log_records[sys_log_tail & SYS_LOG_DEFERRED_MASK];
+
+        /* Releases the slot before rendering, so the producers are not blocked by the UART */
+        sys_log_records[sys_log_tail & SYS_LOG_DEFERRED_MASK].ready = false;
+        sys_log_tail++;
+
+        sys_log_print_token(rec.type, rec.time, rec.module, rec.token, rec.args[0], rec.args[1]);
+
+        sys_log_black_box_write(rec.type, rec.sys_time, rec.module, rec.token, rec.args[0], rec.args[1]);
+
+        cnt++;
+    }
+
+    if (sys_log_dropped > 0U)
+    {
+        uint16_t dropped = 0U;
+
+        taskENTER_CRITICAL();
+
+        dropped = sys_log_dropped;
+        sys_log_dropped = 0U;
+
+        taskEXIT_CRITICAL();
+
+        sys_log_print_token(SYS_LOG_WARNING, xTaskGetTickCount(), SYS_LOG_MODULE_SYSTEM, SYS_LOG_TOK_RECORDS_DROPPED, dropped, 0);
+
+        sys_log_black_box_write(SYS_LOG_WARNING, system_get_time(), SYS_LOG_MODULE_SYSTEM, SYS_LOG_TOK_RECORDS_DROPPED, dropped, 0);
+    }
+#endif /* CONFIG_SYS_LOG_DEFERRED_ENABLED */
+
+    return cnt;
+}
+
+/** \} End of sys_log_deferred group */
@@ -0,0 +1,76 @@
+/*
+ * sys_log_level.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief System log levels implementation.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.23
+ *
+ * \date 2022/12/11
+ *
+ * \defgroup sys_log_level Level
+ * \ingroup sys_log
+ * \{
+ */
+
+#include "sys_log.h"
+#include "sys_log_config.h"
+
+/* A single byte per module: read and written without a critical section */
+volatile uint8_t sys_log_levels[SYS_LOG_MODULES] =
+{
+#define SYS_LOG_MODULE(id, name)    CONFIG_SYS_LOG_DEFAULT_LEVEL,
+#include "sys_log_modules.def"
+#undef SYS_LOG_MODULE
+};
+
+int sys_log_set_level(uint8_t module, uint8_t level)
+{
+    int err = -1;
+
+    if ((module < SYS_LOG_MODULES) && (level <= SYS_LOG_LEVEL_OFF))
+    {
+        sys_log_levels[module] = level;
+
+        err = 0;
+    }
+
+    return err;
+}
+
+int sys_log_get_level(uint8_t module, uint8_t *level)
+{
+    int err = -1;
+
+    if (module < SYS_LOG_MODULES)
+    {
+        *level = sys_log_levels[module];
+
+        err = 0;
+    }
+
+    return err;
+}
+
+/** \} End of sys_log_level group */
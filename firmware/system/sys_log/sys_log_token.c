@@ -0,0 +1,162 @@
+/*
+ * sys_log_token.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief System log tokenized messages implementation.
+ *
+ * With CONFIG_SYS_LOG_TOKENIZED_ENABLED, the text of the tokens is not compiled in the firmware:
+ * only the IDs are sent, and the strings are kept by the host decoder (tests/tools).
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.20
+ *
+ * \date 2022/12/08
+ *
+ * \defgroup sys_log_token Token
+ * \ingroup sys_log
+ * \{
+ */
+
+#include "sys_log.h"
+#include "sys_log_config.h"
+
+#if defined(CONFIG_SYS_LOG_TOKENIZED_ENABLED) && (CONFIG_SYS_LOG_TOKENIZED_ENABLED == 1)
+
+/**
+ * \brief Writes an unsigned integer in little-endian.
+ *
+ * \param[in,out] buf is the buffer to write the value.
+ *
+ * \param[in] val is the value to write.
+ *
+ * \param[in] len is the number of bytes to write.
+ *
+ * \return None.
+ */
+static void sys_log_token_put_le(uint8_t *buf, uint32_t val, uint8_t len);
+
+#else
+
+/**
+ * \brief Prints the text of a token.
+ *
+ * \param[in] token is the token ID.
+ *
+ * \param[in] arg0 is the first argument of the token format.
+ *
+ * \param[in] arg1 is the second argument of the token format.
+ *
+ * \return None.
+ */
+static void sys_log_token_print_fmt(uint16_t token, uint32_t arg0, uint32_t arg1);
+
+#endif /* CONFIG_SYS_LOG_TOKENIZED_ENABLED */
+
+void sys_log_print_token(uint8_t type, uint32_t time, uint8_t module, uint16_t token, uint32_t arg0, uint32_t arg1)
+{
+#if defined(CONFIG_SYS_LOG_TOKENIZED_ENABLED) && (CONFIG_SYS_LOG_TOKENIZED_ENABLED == 1)
+    uint8_t frame[SYS_LOG_FRAME_LEN] = {0U};
+
+    frame[0] = SYS_LOG_FRAME_SYNC;
+    sys_log_token_put_le(&frame[1], time, 4U);
+    sys_log_token_put_le(&frame[5], token, 2U);
+    frame[7] = module;
+    frame[8] = type;
+    sys_log_token_put_le(&frame[9], arg0, 4U);
+    sys_log_token_put_le(&frame[13], arg1, 4U);
+
+    uint8_t i = 0U;
+    for(i = 1U; i < (SYS_LOG_FRAME_LEN - 1U); i++)
+    {
+        frame[SYS_LOG_FRAME_LEN - 1U] ^= frame[i];
+    }
+
+    int err = sys_log_mutex_take();
+
+    sys_log_uart_write(frame, SYS_LOG_FRAME_LEN);
+
+    if (err == 0)
+    {
+        (void)sys_log_mutex_give();
+    }
+#else
+    sys_log_print_event_from_module_at(type, time, sys_log_module_name(module), "");
+    sys_log_token_print_fmt(token, arg0, arg1);
+    sys_log_new_line();
+#endif /* CONFIG_SYS_LOG_TOKENIZED_ENABLED */
+}
+
+#if defined(CONFIG_SYS_LOG_TOKENIZED_ENABLED) && (CONFIG_SYS_LOG_TOKENIZED_ENABLED == 1)
+
+static void sys_log_token_put_le(uint8_t *buf, uint32_t val, uint8_t len)
+{
+    uint8_t i = 0U;
+    for(i = 0U; i < len; i++)
+    {
+        buf[i] = (uint8_t)(val >> (8U * i));
+    }
+}
+
+#else
+
+static void sys_log_token_print_fmt(uint16_t token, uint32_t arg0, uint32_t arg1)
+{
+    static const char *const fmts[SYS_LOG_TOKENS] =
+    {
+    #define SYS_LOG_TOKEN(id, fmt)      fmt,
+    #include "sys_log_tokens.def"
+    #undef SYS_LOG_TOKEN
+    };
+
+    const uint32_t args[SYS_LOG_DEFERRED_MAX_ARGS] = {arg0, arg1};
+    const char *fmt = (token < SYS_LOG_TOKENS) ? fmts[token] : "Unknown token!";
+
+    uint8_t arg = 0U;
+    uint16_t i = 0U;
+
+    while(fmt[i] != '\0')
+    {
+        if ((fmt[i] == '%') && (fmt[i + 1U] != '\0'))
+        {
+            i++;
+
+            switch(fmt[i])
+            {
+                case 'u':   sys_log_print_uint((arg < SYS_LOG_DEFERRED_MAX_ARGS) ? args[arg] : 0UL);            arg++;  break;
+                case 'd':   sys_log_print_int((arg < SYS_LOG_DEFERRED_MAX_ARGS) ? (int32_t)args[arg] : 0L);     arg++;  break;
+                case 'x':   sys_log_print_hex((arg < SYS_LOG_DEFERRED_MAX_ARGS) ? args[arg] : 0UL);             arg++;  break;
+                default:    sys_log_print_byte((uint8_t)fmt[i]);                                                        break;
+            }
+        }
+        else
+        {
+            sys_log_print_byte((uint8_t)fmt[i]);
+        }
+
+        i++;
+    }
+}
+
+#endif /* CONFIG_SYS_LOG_TOKENIZED_ENABLED */
+
+/** \} End of sys_log_token group */
@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.7.25
+ * \version 0.10.21
  * 
  * \date 2019/11/03
  * 
@@ -55,4 +55,14 @@ void sys_log_uart_write_byte(uint8_t byte)
     uart_write(UART_PORT_2, &byte, 1);
 }
 
+void sys_log_uart_write(const uint8_t *data, uint16_t len)
+{
+    uart_write(UART_PORT_2, (uint8_t*)data, len);    /* The UART driver does not change the data */
+}
+
+void sys_log_uart_flush(void)
+{
+    (void)uart_tx_flush(UART_PORT_2);
+}
+
 /** \} End of sys_log_uart group */
@@ -50,7 +50,7 @@
 
 #define MEDIA_FRAM_SPI_PORT         SPI_PORT_0
 #define MEDIA_FRAM_SPI_CS_PIN       SPI_CS_5
-#define MEDIA_FRAM_SPI_CLOCK_HZ     1000000UL
+#define MEDIA_FRAM_SPI_CLOCK_HZ     8000000UL
 #define MEDIA_FRAM_WP_PIN           GPIO_PIN_62
 
 unsigned int generate_random(unsigned int l, unsigned int r);
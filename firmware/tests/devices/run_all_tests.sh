@@ -7,6 +7,7 @@
 ./media_unit_test
 ./payload_unit_test
 ./temp_sensor_unit_test
+./ttc_link_unit_test
 ./ttc_unit_test
 ./voltage_sensor_unit_test
 ./watchdog_unit_test
@@ -0,0 +1,221 @@
+/*
+ * ttc_link_test.c
+ * 
+ * Copyright The OBDH 2.0 Contributors.
+ * 
+ * This file is part of OBDH 2.0.
+ * 
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief Unit test of the TTC link layer.
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 0.10.4
+ * 
+ * \date 2022/11/22
+ * 
+ * \defgroup ttc_link_unit_test TTC Link
+ * \ingroup tests
+ * \{
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <float.h>
+#include <cmocka.h>
+
+#include <config/config.h>
+#include <devices/ttc/ttc_link.h>
+
+#define TTC_LINK_TEST_FRAME_LEN     20U
+#define TTC_LINK_TEST_SEQ_POS       8U
+
+static void expect_ready(ttc_e dev, uint8_t pkts, int err)
+{
+    expect_value(__wrap_ttc_get_tx_fifo_pkts, dev, dev);
+
+    will_return(__wrap_ttc_get_tx_fifo_pkts, pkts);
+    will_return(__wrap_ttc_get_tx_fifo_pkts, err);
+}
+
+static void expect_send(ttc_e dev, uint8_t *data, uint16_t len, int err)
+{
+    expect_value(__wrap_ttc_send, dev, dev);
+    expect_memory(__wrap_ttc_send, data, (void*)data, len);
+    expect_value(__wrap_ttc_send, len, len);
+
+    will_return(__wrap_ttc_send, err);
+}
+
+static void ttc_link_send_test(void **state)
+{
+    uint8_t frame[TTC_LINK_TEST_FRAME_LEN] = {0};
+    ttc_link_stats_t stats = {0};
+
+    /* Primary radio ready */
+    expect_ready(TTC_LINK_PRIMARY_DEV, 0, 0);
+    expect_send(TTC_LINK_PRIMARY_DEV, frame, sizeof(frame), 0);
+
+    assert_return_code(ttc_link_send(frame, sizeof(frame)), 0);
+
+    /* Primary radio with a full TX FIFO */
+    expect_ready(TTC_LINK_PRIMARY_DEV, CONFIG_TTC_LINK_TX_FIFO_MAX_PKTS, 0);
+    expect_ready(TTC_0, 0, 0);
+    expect_send(TTC_0, frame, sizeof(frame), 0);
+
+    assert_return_code(ttc_link_send(frame, sizeof(frame)), 0);
+
+    /* Primary radio not detected */
+    expect_ready(TTC_LINK_PRIMARY_DEV, 0, -1);
+    expect_ready(TTC_0, 0, 0);
+    expect_send(TTC_0, frame, sizeof(frame), 0);
+
+    assert_return_code(ttc_link_send(frame, sizeof(frame)), 0);
+
+    /* Primary radio failing to transmit */
+    expect_ready(TTC_LINK_PRIMARY_DEV, 0, 0);
+    expect_send(TTC_LINK_PRIMARY_DEV, frame, sizeof(frame), -1);
+    expect_ready(TTC_0, 0, 0);
+    expect_send(TTC_0, frame, sizeof(frame), 0);
+
+    assert_return_code(ttc_link_send(frame, sizeof(frame)), 0);
+
+    /* Primary radio not detected and the other one with a full TX FIFO (busy, not an error) */
+    expect_ready(TTC_LINK_PRIMARY_DEV, 0, -1);
+    expect_ready(TTC_0, CONFIG_TTC_LINK_TX_FIFO_MAX_PKTS, 0);
+
+    assert_int_equal(ttc_link_send(frame, sizeof(frame)), -1);
+
+    /* No radio available */
+    expect_ready(TTC_LINK_PRIMARY_DEV, 0, -1);
+    expect_ready(TTC_0, 0, -1);
+
+    assert_int_equal(ttc_link_send(frame, sizeof(frame)), -1);
+
+    /* Full TX FIFO and a transmission failure */
+    expect_ready(TTC_LINK_PRIMARY_DEV, CONFIG_TTC_LINK_TX_FIFO_MAX_PKTS, 0);
+    expect_ready(TTC_0, 0, 0);
+    expect_send(TTC_0, frame, sizeof(frame), -1);
+
+    assert_int_equal(ttc_link_send(frame, sizeof(frame)), -1);
+
+    ttc_link_get_stats(&stats);
+
+    assert_int_equal(stats.tx_pkts[TTC_1], 1);
+    assert_int_equal(stats.tx_pkts[TTC_0], 3);
+    assert_int_equal(stats.failovers, 3);
+    assert_int_equal(stats.busy, 1);
+    assert_int_equal(stats.errors, 2);
+}
+
+static void ttc_link_send_bulk_test(void **state)
+{
+    uint8_t frame[TTC_LINK_TEST_FRAME_LEN] = {0};
+    ttc_link_stats_t stats = {0};
+
+    ttc_link_get_stats(&stats);
+
+    uint16_t seq = stats.seq;
+    uint32_t busy = stats.busy;
+
+    /* Invalid sequence number position */
+    assert_int_equal(ttc_link_send_bulk(frame, sizeof(frame), sizeof(frame) - 1U), -1);
+
+    /* Both radios ready: the frames alternate between them */
+    ttc_e dev = TTC_LINK_PRIMARY_DEV;
+
+    uint8_t i = 0;
+    for(i = 0; i < 4U; i++)
+    {
+        frame[TTC_LINK_TEST_SEQ_POS]        = (seq >> 8) & 0xFFU;
+        frame[TTC_LINK_TEST_SEQ_POS + 1U]   = seq & 0xFFU;
+
+        expect_ready(dev, 0, 0);
+        expect_send(dev, frame, sizeof(frame), 0);
+
+        assert_return_code(ttc_link_send_bulk(frame, sizeof(frame), TTC_LINK_TEST_SEQ_POS), 0);
+
+        seq++;
+
+        dev = (dev == TTC_0) ? TTC_1 : TTC_0;
+    }
+
+    /* The expected radio is busy: the frame goes through the other one, which stays next */
+    frame[TTC_LINK_TEST_SEQ_POS]        = (seq >> 8) & 0xFFU;
+    frame[TTC_LINK_TEST_SEQ_POS + 1U]   = seq & 0xFFU;
+
+    expect_ready(dev, CONFIG_TTC_LINK_TX_FIFO_MAX_PKTS, 0);
+    expect_ready((dev == TTC_0) ? TTC_1 : TTC_0, 0, 0);
+    expect_send((dev == TTC_0) ? TTC_1 : TTC_0, frame, sizeof(frame), 0);
+
+    assert_return_code(ttc_link_send_bulk(frame, sizeof(frame), TTC_LINK_TEST_SEQ_POS), 0);
+
+    seq++;
+
+    frame[TTC_LINK_TEST_SEQ_POS]        = (seq >> 8) & 0xFFU;
+    frame[TTC_LINK_TEST_SEQ_POS + 1U]   = seq & 0xFFU;
+
+    expect_ready(dev, 0, 0);
+    expect_send(dev, frame, sizeof(frame), 0);
+
+    assert_return_code(ttc_link_send_bulk(frame, sizeof(frame), TTC_LINK_TEST_SEQ_POS), 0);
+
+    ttc_link_get_stats(&stats);
+
+    assert_int_equal(stats.seq, (uint16_t)(seq + 1U));
+
+    /* Both radios busy: the sequence number is not consumed, and the retry uses it */
+    seq++;
+    dev = (dev == TTC_0) ? TTC_1 : TTC_0;
+
+    expect_ready(dev, CONFIG_TTC_LINK_TX_FIFO_MAX_PKTS, 0);
+    expect_ready((dev == TTC_0) ? TTC_1 : TTC_0, CONFIG_TTC_LINK_TX_FIFO_MAX_PKTS, 0);
+
+    assert_int_equal(ttc_link_send_bulk(frame, sizeof(frame), TTC_LINK_TEST_SEQ_POS), -1);
+
+    ttc_link_get_stats(&stats);
+
+    assert_int_equal(stats.seq, seq);
+    assert_int_equal(stats.busy, busy + 1U);
+
+    frame[TTC_LINK_TEST_SEQ_POS]        = (seq >> 8) & 0xFFU;
+    frame[TTC_LINK_TEST_SEQ_POS + 1U]   = seq & 0xFFU;
+
+    expect_ready(dev, 0, 0);
+    expect_send(dev, frame, sizeof(frame), 0);
+
+    assert_return_code(ttc_link_send_bulk(frame, sizeof(frame), TTC_LINK_TEST_SEQ_POS), 0);
+
+    ttc_link_get_stats(&stats);
+
+    assert_int_equal(stats.seq, (uint16_t)(seq + 1U));
+}
+
+int main(void)
+{
+    const struct CMUnitTest ttc_link_tests[] = {
+        cmocka_unit_test(ttc_link_send_test),
+        cmocka_unit_test(ttc_link_send_bulk_test),
+    };
+
+    return cmocka_run_group_tests(ttc_link_tests, NULL, NULL);
+}
+
+/** \} End of ttc_link_test group */
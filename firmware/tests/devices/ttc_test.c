@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.8.35
+ * \version 0.10.4
  * 
  * \date 2021/08/06
  * 
@@ -585,6 +585,65 @@ static void ttc_leave_hibernation_test(void **state)
     }
 }
 
+static void ttc_get_tx_fifo_pkts_test(void **state)
+{
+    ttc_e ttc_dev = 0;
+    for(ttc_dev=0; ttc_dev<UINT8_MAX; ttc_dev++)
+    {
+        uint8_t pkts = UINT8_MAX;
+        uint8_t test_pkts = generate_random(0, UINT8_MAX-1);
+
+        if (ttc_dev == TTC_0)
+        {
+            expect_value(__wrap_sl_ttc2_check_device, config.port, TTC_0_SPI_PORT);
+            expect_value(__wrap_sl_ttc2_check_device, config.cs_pin, TTC_0_SPI_CS_PIN);
+            expect_value(__wrap_sl_ttc2_check_device, config.port_config.speed_hz, TTC_0_SPI_CLOCK_HZ);
+            expect_value(__wrap_sl_ttc2_check_device, config.port_config.mode, TTC_0_SPI_MODE);
+            expect_value(__wrap_sl_ttc2_check_device, config.id, TTC_0_ID);
+
+            will_return(__wrap_sl_ttc2_check_device, 0);
+
+            expect_value(__wrap_sl_ttc2_read_fifo_pkts, config.port, TTC_0_SPI_PORT);
+            expect_value(__wrap_sl_ttc2_read_fifo_pkts, config.cs_pin, TTC_0_SPI_CS_PIN);
+            expect_value(__wrap_sl_ttc2_read_fifo_pkts, config.port_config.speed_hz, TTC_0_SPI_CLOCK_HZ);
+            expect_value(__wrap_sl_ttc2_read_fifo_pkts, config.port_config.mode, TTC_0_SPI_MODE);
+            expect_value(__wrap_sl_ttc2_read_fifo_pkts, config.id, TTC_0_ID);
+        }
+        else if (ttc_dev == TTC_1)
+        {
+            expect_value(__wrap_sl_ttc2_check_device, config.port, TTC_1_SPI_PORT);
+            expect_value(__wrap_sl_ttc2_check_device, config.cs_pin, TTC_1_SPI_CS_PIN);
+            expect_value(__wrap_sl_ttc2_check_device, config.port_config.speed_hz, TTC_1_SPI_CLOCK_HZ);
+            expect_value(__wrap_sl_ttc2_check_device, config.port_config.mode, TTC_1_SPI_MODE);
+            expect_value(__wrap_sl_ttc2_check_device, config.id, TTC_1_ID);
+
+            will_return(__wrap_sl_ttc2_check_device, 0);
+
+            expect_value(__wrap_sl_ttc2_read_fifo_pkts, config.port, TTC_1_SPI_PORT);
+            expect_value(__wrap_sl_ttc2_read_fifo_pkts, config.cs_pin, TTC_1_SPI_CS_PIN);
+            expect_value(__wrap_sl_ttc2_read_fifo_pkts, config.port_config.speed_hz, TTC_1_SPI_CLOCK_HZ);
+            expect_value(__wrap_sl_ttc2_read_fifo_pkts, config.port_config.mode, TTC_1_SPI_MODE);
+            expect_value(__wrap_sl_ttc2_read_fifo_pkts, config.id, TTC_1_ID);
+        }
+        else
+        {
+            assert_int_equal(ttc_get_tx_fifo_pkts(ttc_dev, &pkts), -1);
+
+            continue;
+        }
+
+        expect_value(__wrap_sl_ttc2_read_fifo_pkts, pkt, SL_TTC2_TX_PKT);
+
+        will_return(__wrap_sl_ttc2_read_fifo_pkts, test_pkts);
+
+        will_return(__wrap_sl_ttc2_read_fifo_pkts, 0);
+
+        assert_return_code(ttc_get_tx_fifo_pkts(ttc_dev, &pkts), 0);
+
+        assert_int_equal(pkts, test_pkts);
+    }
+}
+
 int main(void)
 {
     const struct CMUnitTest ttc_tests[] = {
@@ -597,6 +656,7 @@ int main(void)
         cmocka_unit_test(ttc_avail_test),
         cmocka_unit_test(ttc_enter_hibernation_test),
         cmocka_unit_test(ttc_leave_hibernation_test),
+        cmocka_unit_test(ttc_get_tx_fifo_pkts_test),
     };
 
     return cmocka_run_group_tests(ttc_tests, NULL, NULL);
@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.7.11
+ * \version 0.10.17
  * 
  * \date 2021/08/29
  * 
@@ -62,11 +62,12 @@ unsigned int generate_random(unsigned int l, unsigned int r);
 static void cy15x102qn_init_test(void **state)
 {
     /* SPI init */
-    expect_value(__wrap_spi_init, port, CY15X102QN_SPI_PORT);
-    expect_value(__wrap_spi_init, config.speed_hz, CY15X102QN_SPI_CLOCK_HZ);
-    expect_value(__wrap_spi_init, config.mode, CY15X102QN_SPI_MODE);
+    expect_value(__wrap_spi_init_device, port, CY15X102QN_SPI_PORT);
+    expect_value(__wrap_spi_init_device, cs, CY15X102QN_SPI_CS);
+    expect_value(__wrap_spi_init_device, config.speed_hz, CY15X102QN_SPI_CLOCK_HZ);
+    expect_value(__wrap_spi_init_device, config.mode, CY15X102QN_SPI_MODE);
 
-    will_return(__wrap_spi_init, 0);
+    will_return(__wrap_spi_init_device, 0);
 
     /* GPIO init */
     expect_value(__wrap_gpio_init, pin, CY15X102QN_GPIO_WP_PIN);
@@ -742,11 +743,12 @@ static void cy15x102qn_hibernate_mode_test(void **state)
 
 static void cy15x102qn_spi_init_test(void **state)
 {
-    expect_value(__wrap_spi_init, port, CY15X102QN_SPI_PORT);
-    expect_value(__wrap_spi_init, config.speed_hz, CY15X102QN_SPI_CLOCK_HZ);
-    expect_value(__wrap_spi_init, config.mode, CY15X102QN_SPI_MODE);
+    expect_value(__wrap_spi_init_device, port, CY15X102QN_SPI_PORT);
+    expect_value(__wrap_spi_init_device, cs, CY15X102QN_SPI_CS);
+    expect_value(__wrap_spi_init_device, config.speed_hz, CY15X102QN_SPI_CLOCK_HZ);
+    expect_value(__wrap_spi_init_device, config.mode, CY15X102QN_SPI_MODE);
 
-    will_return(__wrap_spi_init, 0);
+    will_return(__wrap_spi_init_device, 0);
 
     assert_return_code(cy15x102qn_spi_init(&conf), 0);
 }
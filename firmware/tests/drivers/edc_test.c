@@ -26,7 +26,7 @@
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * \author Bruno Benedetti <brunobenedetti45@gmail.com> 
  *
- * \version 0.9.13
+ * \version 0.10.15
  * 
  * \date 2021/09/01
  * 
@@ -43,6 +43,7 @@
 #include <cmocka.h>
 
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #include <drivers/i2c/i2c.h>
@@ -67,6 +68,12 @@ edc_config_t conf = {0};
 
 unsigned int generate_random(unsigned int l, unsigned int r);
 
+#define EDC_TEST_CHUNK_LEN          512
+
+static uint8_t stream_buf[8200] = {0};
+
+static int stream_cb(uint8_t *data, uint16_t len, void *arg);
+
 static void edc_init_test(void **state)
 {
     conf.interface = EDC_IF_I2C;
@@ -157,6 +164,11 @@ static void edc_init_test(void **state)
 
     will_return(__wrap_uart_write, 0);
 
+    /* Wait for the answer */
+    expect_value (__wrap_uart_read_available, port, EDC_UART_PORT);
+
+    will_return(__wrap_uart_read_available, 9);
+
     /* UART read available */
     expect_value (__wrap_uart_read_available, port, EDC_UART_PORT);
 
@@ -659,6 +671,11 @@ static void edc_check_device_test(void **state)
 
     will_return(__wrap_uart_write, 0);
 
+    /* Wait for the answer */
+    expect_value (__wrap_uart_read_available, port, EDC_UART_PORT);
+
+    will_return(__wrap_uart_read_available, 9);
+
     /* UART read available */
     expect_value (__wrap_uart_read_available, port, EDC_UART_PORT);
 
@@ -903,6 +920,11 @@ static void edc_get_state_pkg_test(void **state)
 
     will_return(__wrap_uart_write, 0);
 
+    /* Wait for the answer */
+    expect_value (__wrap_uart_read_available, port, EDC_UART_PORT);
+
+    will_return(__wrap_uart_read_available, 9);
+
     /* UART read available */
     expect_value (__wrap_uart_read_available, port, EDC_UART_PORT);
 
@@ -985,6 +1007,11 @@ static void edc_get_ptt_pkg_test(void **state)
 
     will_return(__wrap_uart_write, 0);
 
+    /* Wait for the answer */
+    expect_value (__wrap_uart_read_available, port, EDC_UART_PORT);
+
+    will_return(__wrap_uart_read_available, 49);
+
     /* UART read available */
     expect_value (__wrap_uart_read_available, port, EDC_UART_PORT);
 
@@ -1067,6 +1094,11 @@ static void edc_get_hk_pkg_test(void **state)
 
     will_return(__wrap_uart_write, 0);
 
+    /* Wait for the answer */
+    expect_value (__wrap_uart_read_available, port, EDC_UART_PORT);
+
+    will_return(__wrap_uart_read_available, 26);
+
     /* UART read available */
     expect_value (__wrap_uart_read_available, port, EDC_UART_PORT);
 
@@ -1149,6 +1181,11 @@ static void edc_get_adc_seq_test(void **state)
 
     will_return(__wrap_uart_write, 0);
 
+    /* Wait for the answer */
+    expect_value (__wrap_uart_read_available, port, EDC_UART_PORT);
+
+    will_return(__wrap_uart_read_available, 8200);
+
     /* UART read available */
     expect_value (__wrap_uart_read_available, port, EDC_UART_PORT);
 
@@ -1175,6 +1212,183 @@ static void edc_get_adc_seq_test(void **state)
     }
 }
 
+static void edc_get_adc_seq_stream_test(void **state)
+{
+    /* Write command */
+    uint8_t cmd[3] = {0x34, 0, 0};
+
+    conf.interface = EDC_IF_I2C;
+
+    expect_value(__wrap_i2c_write, port, EDC_I2C_PORT);
+    expect_value(__wrap_i2c_write, adr, EDC_I2C_ADR);
+    expect_memory(__wrap_i2c_write, data, (void*)&cmd, 3);
+    expect_value(__wrap_i2c_write, len, 3);
+
+    will_return(__wrap_i2c_write, 0);
+
+    /* Read (one I2C transfer per chunk) */
+    uint8_t data[8200] = {0xFF};
+
+    data[0] = 0x33;
+
+    uint16_t i = 0;
+    for(i=1; i<8200; i++)
+    {
+        data[i] = generate_random(0, 255);
+    }
+
+    /* Checksums (XOR of the odd and even bytes) */
+    data[8197] = 0;
+    data[8198] = 0;
+
+    for(i=0; i<8197; i++)
+    {
+        data[(i % 2 == 1) ? 8197 : 8198] ^= data[i];
+    }
+
+    uint16_t pos = 0;
+    for(pos=0; pos<8200; pos+=EDC_TEST_CHUNK_LEN)
+    {
+        uint16_t len = ((8200 - pos) < EDC_TEST_CHUNK_LEN) ? (8200 - pos) : EDC_TEST_CHUNK_LEN;
+
+        expect_value(__wrap_i2c_read, port, EDC_I2C_PORT);
+        expect_value(__wrap_i2c_read, adr, EDC_I2C_ADR);
+        expect_value(__wrap_i2c_read, len, len);
+
+        for(i=0; i<len; i++)
+        {
+            will_return(__wrap_i2c_read, data[pos + i]);
+        }
+
+        will_return(__wrap_i2c_read, 0);
+    }
+
+    uint8_t chunk[EDC_TEST_CHUNK_LEN] = {0};
+
+    pos = 0;
+    memset(stream_buf, 0xFF, sizeof(stream_buf));
+
+    assert_int_equal(edc_get_adc_seq_stream(conf, chunk, EDC_TEST_CHUNK_LEN, stream_cb, &pos), 8200);
+    assert_int_equal(pos, 8200);
+    assert_memory_equal(stream_buf, data, 8200);
+
+    conf.interface = EDC_IF_UART;
+
+    /* UART flush */
+    expect_value (__wrap_uart_flush, port, EDC_UART_PORT);
+
+    will_return(__wrap_uart_flush, 0);
+
+    /* UART Write */
+    expect_value (__wrap_uart_write, port, EDC_UART_PORT);
+    expect_memory(__wrap_uart_write, data, (void*)&cmd, 3);
+    expect_value (__wrap_uart_write, len, 3);
+
+    will_return(__wrap_uart_write, 0);
+
+    for(pos=0; pos<8200; pos+=EDC_TEST_CHUNK_LEN)
+    {
+        uint16_t len = ((8200 - pos) < EDC_TEST_CHUNK_LEN) ? (8200 - pos) : EDC_TEST_CHUNK_LEN;
+
+        /* Wait for the chunk */
+        expect_value (__wrap_uart_read_available, port, EDC_UART_PORT);
+
+        will_return(__wrap_uart_read_available, len);
+
+        /* UART read available */
+        expect_value (__wrap_uart_read_available, port, EDC_UART_PORT);
+
+        will_return(__wrap_uart_read_available, len);
+
+        /* UART read */
+        expect_value(__wrap_uart_read, port, EDC_UART_PORT);
+        expect_value(__wrap_uart_read, len, len);
+
+        for(i=0; i<len; i++)
+        {
+            will_return(__wrap_uart_read, data[pos + i]);
+        }
+
+        will_return(__wrap_uart_read, 0);
+    }
+
+    pos = 0;
+    memset(stream_buf, 0xFF, sizeof(stream_buf));
+
+    assert_int_equal(edc_get_adc_seq_stream(conf, chunk, EDC_TEST_CHUNK_LEN, stream_cb, &pos), 8200);
+    assert_int_equal(pos, 8200);
+    assert_memory_equal(stream_buf, data, 8200);
+
+    /* Wrong checksum (the whole frame is still streamed) */
+    conf.interface = EDC_IF_I2C;
+
+    data[8198] ^= 0xFF;
+
+    expect_value(__wrap_i2c_write, port, EDC_I2C_PORT);
+    expect_value(__wrap_i2c_write, adr, EDC_I2C_ADR);
+    expect_memory(__wrap_i2c_write, data, (void*)&cmd, 3);
+    expect_value(__wrap_i2c_write, len, 3);
+
+    will_return(__wrap_i2c_write, 0);
+
+    for(pos=0; pos<8200; pos+=EDC_TEST_CHUNK_LEN)
+    {
+        uint16_t len = ((8200 - pos) < EDC_TEST_CHUNK_LEN) ? (8200 - pos) : EDC_TEST_CHUNK_LEN;
+
+        expect_value(__wrap_i2c_read, port, EDC_I2C_PORT);
+        expect_value(__wrap_i2c_read, adr, EDC_I2C_ADR);
+        expect_value(__wrap_i2c_read, len, len);
+
+        for(i=0; i<len; i++)
+        {
+            will_return(__wrap_i2c_read, data[pos + i]);
+        }
+
+        will_return(__wrap_i2c_read, 0);
+    }
+
+    pos = 0;
+
+    assert_int_equal(edc_get_adc_seq_stream(conf, chunk, EDC_TEST_CHUNK_LEN, stream_cb, &pos), -1);
+    assert_int_equal(pos, 8200);
+
+    /* EDC restarting the frame on every I2C read (the chunks do not continue the frame) */
+    data[8198] ^= 0xFF;
+
+    expect_value(__wrap_i2c_write, port, EDC_I2C_PORT);
+    expect_value(__wrap_i2c_write, adr, EDC_I2C_ADR);
+    expect_memory(__wrap_i2c_write, data, (void*)&cmd, 3);
+    expect_value(__wrap_i2c_write, len, 3);
+
+    will_return(__wrap_i2c_write, 0);
+
+    for(pos=0; pos<8200; pos+=EDC_TEST_CHUNK_LEN)
+    {
+        uint16_t len = ((8200 - pos) < EDC_TEST_CHUNK_LEN) ? (8200 - pos) : EDC_TEST_CHUNK_LEN;
+
+        expect_value(__wrap_i2c_read, port, EDC_I2C_PORT);
+        expect_value(__wrap_i2c_read, adr, EDC_I2C_ADR);
+        expect_value(__wrap_i2c_read, len, len);
+
+        for(i=0; i<len; i++)
+        {
+            will_return(__wrap_i2c_read, data[i]);
+        }
+
+        will_return(__wrap_i2c_read, 0);
+    }
+
+    pos = 0;
+
+    assert_int_equal(edc_get_adc_seq_stream(conf, chunk, EDC_TEST_CHUNK_LEN, stream_cb, &pos), -1);
+    assert_int_equal(pos, 8200);
+
+    conf.interface = EDC_IF_UART;
+
+    /* Invalid chunk length */
+    assert_int_equal(edc_get_adc_seq_stream(conf, chunk, 0, stream_cb, &pos), -1);
+}
+
 static void edc_echo_test(void **state)
 {
     uint8_t cmd = 0xF0;
@@ -1204,6 +1418,11 @@ static void edc_echo_test(void **state)
 
     will_return(__wrap_uart_write, 0);
 
+    /* Wait for the answer */
+    expect_value (__wrap_uart_read_available, port, EDC_UART_PORT);
+
+    will_return(__wrap_uart_read_available, 4);
+
     /* UART read available */
     expect_value (__wrap_uart_read_available, port, EDC_UART_PORT);
 
@@ -1313,6 +1532,11 @@ static void edc_get_state_test(void **state)
 
     will_return(__wrap_uart_write, 0);
 
+    /* Wait for the answer */
+    expect_value (__wrap_uart_read_available, port, EDC_UART_PORT);
+
+    will_return(__wrap_uart_read_available, 9);
+
     /* UART read available */
     expect_value (__wrap_uart_read_available, port, EDC_UART_PORT);
 
@@ -1410,6 +1634,11 @@ static void edc_get_ptt_test(void **state)
 
     will_return(__wrap_uart_write, 0);
 
+    /* Wait for the answer */
+    expect_value (__wrap_uart_read_available, port, EDC_UART_PORT);
+
+    will_return(__wrap_uart_read_available, 49);
+
     /* UART read available */
     expect_value (__wrap_uart_read_available, port, EDC_UART_PORT);
 
@@ -1518,6 +1747,11 @@ static void edc_get_hk_test(void **state)
 
     will_return(__wrap_uart_write, 0);
 
+    /* Wait for the answer */
+    expect_value (__wrap_uart_read_available, port, EDC_UART_PORT);
+
+    will_return(__wrap_uart_read_available, 26);
+
     /* UART read available */
     expect_value (__wrap_uart_read_available, port, EDC_UART_PORT);
 
@@ -1738,6 +1972,7 @@ int main(void)
         cmocka_unit_test(edc_get_ptt_pkg_test),
         cmocka_unit_test(edc_get_hk_pkg_test),
         cmocka_unit_test(edc_get_adc_seq_test),
+        cmocka_unit_test(edc_get_adc_seq_stream_test),
         cmocka_unit_test(edc_echo_test),
         cmocka_unit_test(edc_calc_checksum_test),
         cmocka_unit_test(edc_get_state_test),
@@ -1763,4 +1998,15 @@ unsigned int generate_random(unsigned int l, unsigned int r)
     return (rand() % (r - l + 1)) + l;
 }
 
+static int stream_cb(uint8_t *data, uint16_t len, void *arg)
+{
+    uint16_t *pos = (uint16_t*)arg;
+
+    memcpy(&stream_buf[*pos], data, len);
+
+    *pos += len;
+
+    return 0;
+}
+
 /** \} End of edc_test group */
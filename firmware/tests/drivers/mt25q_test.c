@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.7.20
+ * \version 0.10.17
  * 
  * \date 2021/09/05
  * 
@@ -49,7 +49,7 @@
 
 #define MT25Q_SPI_PORT              SPI_PORT_0
 #define MT25Q_SPI_CS_PIN            SPI_CS_2
-#define MT25Q_SPI_CLOCK_HZ          1000000UL
+#define MT25Q_SPI_CLOCK_HZ          8000000UL
 #define MT25Q_SPI_MODE              SPI_MODE_0
 #define MT25Q_GPIO_HOLD_PIN         GPIO_PIN_26
 #define MT25Q_GPIO_RESET_PIN        GPIO_PIN_27
@@ -59,11 +59,12 @@ unsigned int generate_random(unsigned int l, unsigned int r);
 static void mt25q_init_test(void **state)
 {
     /* SPI init */
-//    expect_value(__wrap_spi_init, port, MT25Q_SPI_PORT);
-//    expect_value(__wrap_spi_init, config.speed_hz, MT25Q_SPI_CLOCK_HZ);
-//    expect_value(__wrap_spi_init, config.mode, MT25Q_SPI_MODE);
+//    expect_value(__wrap_spi_init_device, port, MT25Q_SPI_PORT);
+//    expect_value(__wrap_spi_init_device, cs, MT25Q_SPI_CS_PIN);
+//    expect_value(__wrap_spi_init_device, config.speed_hz, MT25Q_SPI_CLOCK_HZ);
+//    expect_value(__wrap_spi_init_device, config.mode, MT25Q_SPI_MODE);
 //
-//    will_return(__wrap_spi_init, 0);
+//    will_return(__wrap_spi_init_device, 0);
 
     /* GPIO init */
 //    expect_value(__wrap_gpio_init, pin, MT25Q_GPIO_HOLD_PIN);
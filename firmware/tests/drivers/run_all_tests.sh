@@ -8,3 +8,4 @@
 ./sl_eps2_unit_test
 ./mt25q_unit_test
 ./sl_ttc2_unit_test
+./spi_dma_unit_test
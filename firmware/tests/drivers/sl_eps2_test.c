@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.9.6
+ * \version 0.10.12
  * 
  * \date 2021/09/02
  * 
@@ -42,11 +42,15 @@
 #include <cmocka.h>
 
 #include <stdlib.h>
+#include <stdbool.h>
 
 #include <drivers/i2c/i2c.h>
 #include <drivers/gpio/gpio.h>
 #include <drivers/sl_eps2/sl_eps2.h>
 
+#include <FreeRTOS.h>
+#include <task.h>
+
 #define SL_EPS2_I2C_PORT        I2C_PORT_1
 #define SL_EPS2_I2C_CLOCK_HZ    100000UL
 #define SL_EPS2_I2C_EN_PIN      GPIO_PIN_17
@@ -61,6 +65,10 @@ uint8_t crc8(uint8_t *data, uint8_t len);
 
 void read_reg(uint8_t adr, uint32_t val);
 
+void read_block(uint8_t adr, uint8_t n, uint32_t *val, bool valid_crc);
+
+void read_data_by_reg_i2c_error(void);
+
 static void sl_eps2_init_test(void **state)
 {
     /* I2C initialization */
@@ -158,6 +166,25 @@ static void sl_eps2_read_reg_test(void **state)
 
     will_return(__wrap_tca4311a_enable, 0);
 
+    /* I2C read (address echo poll) */
+    expect_value(__wrap_tca4311a_read, config.i2c_port, SL_EPS2_I2C_PORT);
+    expect_value(__wrap_tca4311a_read, config.i2c_config.speed_hz, SL_EPS2_I2C_CLOCK_HZ);
+    expect_value(__wrap_tca4311a_read, config.en_pin, SL_EPS2_I2C_EN_PIN);
+    expect_value(__wrap_tca4311a_read, config.ready_pin, SL_EPS2_I2C_RDY_PIN);
+    expect_value(__wrap_tca4311a_read, adr, SL_EPS2_I2C_ADR);
+    expect_value(__wrap_tca4311a_read, len, 1);
+
+    will_return(__wrap_tca4311a_read, adr);
+    will_return(__wrap_tca4311a_read, 0);
+
+    /* I2C enable */
+    expect_value(__wrap_tca4311a_enable, config.i2c_port, SL_EPS2_I2C_PORT);
+    expect_value(__wrap_tca4311a_enable, config.i2c_config.speed_hz, SL_EPS2_I2C_CLOCK_HZ);
+    expect_value(__wrap_tca4311a_enable, config.en_pin, SL_EPS2_I2C_EN_PIN);
+    expect_value(__wrap_tca4311a_enable, config.ready_pin, SL_EPS2_I2C_RDY_PIN);
+
+    will_return(__wrap_tca4311a_enable, 0);
+
     /* I2C read */
     expect_value(__wrap_tca4311a_read, config.i2c_port, SL_EPS2_I2C_PORT);
     expect_value(__wrap_tca4311a_read, config.i2c_config.speed_hz, SL_EPS2_I2C_CLOCK_HZ);
@@ -190,147 +217,187 @@ static void sl_eps2_read_reg_test(void **state)
     assert_int_equal(data[4], (val >> 0) & 0xFF);
 }
 
+static void sl_eps2_read_block_test(void **state)
+{
+    uint32_t val[SL_EPS2_BLOCK_READ_MAX_REGS] = {0};
+    uint32_t res[SL_EPS2_BLOCK_READ_MAX_REGS] = {0};
+
+    uint8_t adr = generate_random(0, SL_EPS2_BLOCK_READ_MAX_REGS - 1);
+    uint8_t n = generate_random(1, SL_EPS2_BLOCK_READ_MAX_REGS - adr);
+
+    uint8_t i = 0;
+    for(i = 0; i < n; i++)
+    {
+        val[i] = generate_random(0, UINT32_MAX-1);
+    }
+
+    read_block(adr, n, val, true);
+
+    TickType_t start = xTaskGetTickCount();
+
+    assert_return_code(sl_eps2_read_block(conf, adr, n, res), 0);
+
+    /* The answer is not polled before the EPS prepared it (the previous answer is still there), 1 ms of rounding */
+    assert_true((xTaskGetTickCount() - start) >= (SL_EPS2_BLOCK_ANSWER_MIN_DELAY_MS - 1U));
+
+    assert_memory_equal(val, res, n * sizeof(uint32_t));
+
+    /* Wrong CRC */
+    read_block(adr, n, val, false);
+
+    assert_int_equal(sl_eps2_read_block(conf, adr, n, res), -1);
+
+    /* Out of range */
+    assert_int_equal(sl_eps2_read_block(conf, 0, SL_EPS2_BLOCK_READ_MAX_REGS + 1, res), -1);
+    assert_int_equal(sl_eps2_read_block(conf, SL_EPS2_REG_DEVICE_ID, 2, res), -1);
+    assert_int_equal(sl_eps2_read_block(conf, 0, 0, res), -1);
+}
+
 static void sl_eps2_read_data_test(void **state)
 {
     sl_eps2_data_t data_val = {0};
 
+    uint32_t regs[48] = {0};
+
     data_val.time_counter = generate_random(0, UINT32_MAX-1);
-    read_reg(0, data_val.time_counter);
+    regs[0] = data_val.time_counter;
 
     data_val.temperature_uc = generate_random(0, UINT16_MAX);
-    read_reg(1, (uint32_t)data_val.temperature_uc);
+    regs[1] = (uint32_t)data_val.temperature_uc;
 
     data_val.current = generate_random(0, UINT16_MAX);
-    read_reg(2, (uint32_t)data_val.current);
+    regs[2] = (uint32_t)data_val.current;
 
     data_val.last_reset_cause = generate_random(0, UINT8_MAX);
-    read_reg(3, (uint32_t)data_val.last_reset_cause);
+    regs[3] = (uint32_t)data_val.last_reset_cause;
 
     data_val.reset_counter = generate_random(0, UINT16_MAX);
-    read_reg(4, (uint32_t)data_val.reset_counter);
+    regs[4] = (uint32_t)data_val.reset_counter;
 
     data_val.solar_panel_voltage_my_px = generate_random(0, UINT16_MAX);
-    read_reg(5, (uint32_t)data_val.solar_panel_voltage_my_px);
+    regs[5] = (uint32_t)data_val.solar_panel_voltage_my_px;
 
     data_val.solar_panel_voltage_mx_pz = generate_random(0, UINT16_MAX);
-    read_reg(6, (uint32_t)data_val.solar_panel_voltage_mx_pz);
+    regs[6] = (uint32_t)data_val.solar_panel_voltage_mx_pz;
 
     data_val.solar_panel_voltage_mz_py = generate_random(0, UINT16_MAX);
-    read_reg(7, (uint32_t)data_val.solar_panel_voltage_mz_py);
+    regs[7] = (uint32_t)data_val.solar_panel_voltage_mz_py;
 
     data_val.solar_panel_output_voltage = generate_random(0, UINT16_MAX);
-    read_reg(17, (uint32_t)data_val.solar_panel_output_voltage);
+    regs[17] = (uint32_t)data_val.solar_panel_output_voltage;
 
     data_val.solar_panel_current_my = generate_random(0, UINT16_MAX);
-    read_reg(8, (uint32_t)data_val.solar_panel_current_my);
+    regs[8] = (uint32_t)data_val.solar_panel_current_my;
 
     data_val.solar_panel_current_py = generate_random(0, UINT16_MAX);
-    read_reg(9, (uint32_t)data_val.solar_panel_current_py);
+    regs[9] = (uint32_t)data_val.solar_panel_current_py;
 
     data_val.solar_panel_current_mx = generate_random(0, UINT16_MAX);
-    read_reg(10, (uint32_t)data_val.solar_panel_current_mx);
+    regs[10] = (uint32_t)data_val.solar_panel_current_mx;
 
     data_val.solar_panel_current_px = generate_random(0, UINT16_MAX);
-    read_reg(11, (uint32_t)data_val.solar_panel_current_px);
+    regs[11] = (uint32_t)data_val.solar_panel_current_px;
 
     data_val.solar_panel_current_mz = generate_random(0, UINT16_MAX);
-    read_reg(12, (uint32_t)data_val.solar_panel_current_mz);
+    regs[12] = (uint32_t)data_val.solar_panel_current_mz;
 
     data_val.solar_panel_current_pz = generate_random(0, UINT16_MAX);
-    read_reg(13, (uint32_t)data_val.solar_panel_current_pz);
+    regs[13] = (uint32_t)data_val.solar_panel_current_pz;
 
     data_val.mppt_1_duty_cycle = generate_random(0, UINT8_MAX);
-    read_reg(14, (uint32_t)data_val.mppt_1_duty_cycle);
+    regs[14] = (uint32_t)data_val.mppt_1_duty_cycle;
 
     data_val.mppt_2_duty_cycle = generate_random(0, UINT8_MAX);
-    read_reg(15, (uint32_t)data_val.mppt_2_duty_cycle);
+    regs[15] = (uint32_t)data_val.mppt_2_duty_cycle;
 
     data_val.mppt_3_duty_cycle = generate_random(0, UINT8_MAX);
-    read_reg(16, (uint32_t)data_val.mppt_3_duty_cycle);
+    regs[16] = (uint32_t)data_val.mppt_3_duty_cycle;
 
     data_val.main_power_bus_voltage = generate_random(0, UINT16_MAX);
-    read_reg(18, (uint32_t)data_val.main_power_bus_voltage);
+    regs[18] = (uint32_t)data_val.main_power_bus_voltage;
 
     data_val.rtd_0_temperature = generate_random(0, UINT16_MAX);
-    read_reg(19, (uint32_t)data_val.rtd_0_temperature);
+    regs[19] = (uint32_t)data_val.rtd_0_temperature;
 
     data_val.rtd_1_temperature = generate_random(0, UINT16_MAX);
-    read_reg(20, (uint32_t)data_val.rtd_1_temperature);
+    regs[20] = (uint32_t)data_val.rtd_1_temperature;
 
     data_val.rtd_2_temperature = generate_random(0, UINT16_MAX);
-    read_reg(21, (uint32_t)data_val.rtd_2_temperature);
+    regs[21] = (uint32_t)data_val.rtd_2_temperature;
 
     data_val.rtd_3_temperature = generate_random(0, UINT16_MAX);
-    read_reg(22, (uint32_t)data_val.rtd_3_temperature);
+    regs[22] = (uint32_t)data_val.rtd_3_temperature;
 
     data_val.rtd_4_temperature = generate_random(0, UINT16_MAX);
-    read_reg(23, (uint32_t)data_val.rtd_4_temperature);
+    regs[23] = (uint32_t)data_val.rtd_4_temperature;
 
     data_val.rtd_5_temperature = generate_random(0, UINT16_MAX);
-    read_reg(24, (uint32_t)data_val.rtd_5_temperature);
+    regs[24] = (uint32_t)data_val.rtd_5_temperature;
 
     data_val.rtd_6_temperature = generate_random(0, UINT16_MAX);
-    read_reg(25, (uint32_t)data_val.rtd_6_temperature);
+    regs[25] = (uint32_t)data_val.rtd_6_temperature;
 
     data_val.battery_voltage = generate_random(0, UINT16_MAX);
-    read_reg(26, (uint32_t)data_val.battery_voltage);
+    regs[26] = (uint32_t)data_val.battery_voltage;
 
     data_val.battery_current = generate_random(0, UINT16_MAX);
-    read_reg(27, (uint32_t)data_val.battery_current);
+    regs[27] = (uint32_t)data_val.battery_current;
 
     data_val.battery_average_current = generate_random(0, UINT16_MAX);
-    read_reg(28, (uint32_t)data_val.battery_average_current);
+    regs[28] = (uint32_t)data_val.battery_average_current;
 
     data_val.battery_acc_current = generate_random(0, UINT16_MAX);
-    read_reg(29, (uint32_t)data_val.battery_acc_current);
+    regs[29] = (uint32_t)data_val.battery_acc_current;
 
     data_val.battery_charge = generate_random(0, UINT16_MAX);
-    read_reg(30, (uint32_t)data_val.battery_charge);
+    regs[30] = (uint32_t)data_val.battery_charge;
 
     data_val.battery_monitor_temperature = generate_random(0, UINT16_MAX);
-    read_reg(31, (uint32_t)data_val.battery_monitor_temperature);
+    regs[31] = (uint32_t)data_val.battery_monitor_temperature;
 
     data_val.battery_monitor_status = generate_random(0, UINT8_MAX);
-    read_reg(32, (uint32_t)data_val.battery_monitor_status);
+    regs[32] = (uint32_t)data_val.battery_monitor_status;
 
     data_val.battery_monitor_protection = generate_random(0, UINT8_MAX);
-    read_reg(33, (uint32_t)data_val.battery_monitor_protection);
+    regs[33] = (uint32_t)data_val.battery_monitor_protection;
 
     data_val.battery_monitor_cycle_counter = generate_random(0, UINT8_MAX);
-    read_reg(34, (uint32_t)data_val.battery_monitor_cycle_counter);
+    regs[34] = (uint32_t)data_val.battery_monitor_cycle_counter;
 
     data_val.raac = generate_random(0, UINT16_MAX);
-    read_reg(35, (uint32_t)data_val.raac);
+    regs[35] = (uint32_t)data_val.raac;
 
     data_val.rsac = generate_random(0, UINT16_MAX);
-    read_reg(36, (uint32_t)data_val.rsac);
+    regs[36] = (uint32_t)data_val.rsac;
 
     data_val.rarc = generate_random(0, UINT8_MAX);
-    read_reg(37, (uint32_t)data_val.rarc);
+    regs[37] = (uint32_t)data_val.rarc;
 
     data_val.rsrc = generate_random(0, UINT8_MAX);
-    read_reg(38, (uint32_t)data_val.rsrc);
+    regs[38] = (uint32_t)data_val.rsrc;
 
     data_val.battery_heater_1_duty_cycle = generate_random(0, UINT8_MAX);
-    read_reg(39, (uint32_t)data_val.battery_heater_1_duty_cycle);
+    regs[39] = (uint32_t)data_val.battery_heater_1_duty_cycle;
 
     data_val.battery_heater_2_duty_cycle = generate_random(0, UINT8_MAX);
-    read_reg(40, (uint32_t)data_val.battery_heater_2_duty_cycle);
+    regs[40] = (uint32_t)data_val.battery_heater_2_duty_cycle;
 
     data_val.mppt_1_mode = generate_random(0, UINT8_MAX);
-    read_reg(43, (uint32_t)data_val.mppt_1_mode);
+    regs[43] = (uint32_t)data_val.mppt_1_mode;
 
     data_val.mppt_2_mode = generate_random(0, UINT8_MAX);
-    read_reg(44, (uint32_t)data_val.mppt_2_mode);
+    regs[44] = (uint32_t)data_val.mppt_2_mode;
 
     data_val.mppt_3_mode = generate_random(0, UINT8_MAX);
-    read_reg(45, (uint32_t)data_val.mppt_3_mode);
+    regs[45] = (uint32_t)data_val.mppt_3_mode;
 
     data_val.battery_heater_1_mode = generate_random(0, UINT8_MAX);
-    read_reg(46, (uint32_t)data_val.battery_heater_1_mode);
+    regs[46] = (uint32_t)data_val.battery_heater_1_mode;
 
     data_val.battery_heater_2_mode = generate_random(0, UINT8_MAX);
-    read_reg(47, (uint32_t)data_val.battery_heater_2_mode);
+    regs[47] = (uint32_t)data_val.battery_heater_2_mode;
+
+    read_block(0, 48, regs, true);
 
     sl_eps2_data_t data_res = {0};
 
@@ -384,6 +451,58 @@ static void sl_eps2_read_data_test(void **state)
     assert_int_equal(data_val.battery_heater_2_mode,            data_res.battery_heater_2_mode);
 }
 
+static void sl_eps2_read_data_fallback_test(void **state)
+{
+    uint32_t regs[48] = {0};
+
+    uint8_t i = 0;
+    for(i = 0; i < 48; i++)
+    {
+        regs[i] = generate_random(0, UINT8_MAX);
+    }
+
+    sl_eps2_data_t data_res = {0};
+
+    /* A single invalid answer does not disable the block read (the registers are read one by one, with I2C errors) */
+    read_block(0, 48, regs, false);
+    read_data_by_reg_i2c_error();
+
+    assert_true(sl_eps2_read_data(conf, &data_res) > 0);
+
+    read_block(0, 48, regs, true);
+
+    assert_return_code(sl_eps2_read_data(conf, &data_res), 0);
+
+    /* Consecutive invalid answers */
+    for(i = 0; i < SL_EPS2_BLOCK_READ_MAX_ERRORS; i++)
+    {
+        read_block(0, 48, regs, false);
+        read_data_by_reg_i2c_error();
+
+        assert_true(sl_eps2_read_data(conf, &data_res) > 0);
+    }
+
+    /* Reads by register until the next probe of the block read */
+    for(i = 0; i < (SL_EPS2_BLOCK_READ_RETRY_PERIOD - 1); i++)
+    {
+        read_data_by_reg_i2c_error();
+
+        assert_true(sl_eps2_read_data(conf, &data_res) > 0);
+    }
+
+    /* Block read supported again */
+    read_block(0, 48, regs, true);
+
+    assert_return_code(sl_eps2_read_data(conf, &data_res), 0);
+
+    read_block(0, 48, regs, true);
+
+    assert_return_code(sl_eps2_read_data(conf, &data_res), 0);
+
+    assert_int_equal(regs[0], data_res.time_counter);
+    assert_int_equal(regs[47], data_res.battery_heater_2_mode);
+}
+
 static void sl_eps2_read_time_counter_test(void **state)
 {
     uint32_t val = generate_random(0, UINT32_MAX-1);
@@ -948,7 +1067,9 @@ int main(void)
         cmocka_unit_test(sl_eps2_check_device_test),
         cmocka_unit_test(sl_eps2_write_reg_test),
         cmocka_unit_test(sl_eps2_read_reg_test),
+        cmocka_unit_test(sl_eps2_read_block_test),
         cmocka_unit_test(sl_eps2_read_data_test),
+        cmocka_unit_test(sl_eps2_read_data_fallback_test),
         cmocka_unit_test(sl_eps2_read_time_counter_test),
         cmocka_unit_test(sl_eps2_read_temp_test),
         cmocka_unit_test(sl_eps2_read_current_test),
@@ -1041,6 +1162,25 @@ void read_reg(uint8_t adr, uint32_t val)
 
     will_return(__wrap_tca4311a_enable, 0);
 
+    /* I2C read (address echo poll) */
+    expect_value(__wrap_tca4311a_read, config.i2c_port, SL_EPS2_I2C_PORT);
+    expect_value(__wrap_tca4311a_read, config.i2c_config.speed_hz, SL_EPS2_I2C_CLOCK_HZ);
+    expect_value(__wrap_tca4311a_read, config.en_pin, SL_EPS2_I2C_EN_PIN);
+    expect_value(__wrap_tca4311a_read, config.ready_pin, SL_EPS2_I2C_RDY_PIN);
+    expect_value(__wrap_tca4311a_read, adr, SL_EPS2_I2C_ADR);
+    expect_value(__wrap_tca4311a_read, len, 1);
+
+    will_return(__wrap_tca4311a_read, adr);
+    will_return(__wrap_tca4311a_read, 0);
+
+    /* I2C enable */
+    expect_value(__wrap_tca4311a_enable, config.i2c_port, SL_EPS2_I2C_PORT);
+    expect_value(__wrap_tca4311a_enable, config.i2c_config.speed_hz, SL_EPS2_I2C_CLOCK_HZ);
+    expect_value(__wrap_tca4311a_enable, config.en_pin, SL_EPS2_I2C_EN_PIN);
+    expect_value(__wrap_tca4311a_enable, config.ready_pin, SL_EPS2_I2C_RDY_PIN);
+
+    will_return(__wrap_tca4311a_enable, 0);
+
     /* I2C read */
     expect_value(__wrap_tca4311a_read, config.i2c_port, SL_EPS2_I2C_PORT);
     expect_value(__wrap_tca4311a_read, config.i2c_config.speed_hz, SL_EPS2_I2C_CLOCK_HZ);
@@ -1065,4 +1205,105 @@ void read_reg(uint8_t adr, uint32_t val)
     will_return(__wrap_tca4311a_read, 0);
 }
 
+void read_block(uint8_t adr, uint8_t n, uint32_t *val, bool valid_crc)
+{
+    uint8_t data[256] = {UINT8_MAX};
+
+    data[0] = adr;
+    data[1] = n;
+    data[2] = crc8(data, 2);
+
+    /* I2C enable */
+    expect_value(__wrap_tca4311a_enable, config.i2c_port, SL_EPS2_I2C_PORT);
+    expect_value(__wrap_tca4311a_enable, config.i2c_config.speed_hz, SL_EPS2_I2C_CLOCK_HZ);
+    expect_value(__wrap_tca4311a_enable, config.en_pin, SL_EPS2_I2C_EN_PIN);
+    expect_value(__wrap_tca4311a_enable, config.ready_pin, SL_EPS2_I2C_RDY_PIN);
+
+    will_return(__wrap_tca4311a_enable, 0);
+
+    /* I2C write */
+    expect_value(__wrap_tca4311a_write, config.i2c_port, SL_EPS2_I2C_PORT);
+    expect_value(__wrap_tca4311a_write, config.i2c_config.speed_hz, SL_EPS2_I2C_CLOCK_HZ);
+    expect_value(__wrap_tca4311a_write, config.en_pin, SL_EPS2_I2C_EN_PIN);
+    expect_value(__wrap_tca4311a_write, config.ready_pin, SL_EPS2_I2C_RDY_PIN);
+    expect_value(__wrap_tca4311a_write, adr, SL_EPS2_I2C_ADR);
+    expect_memory(__wrap_tca4311a_write, data, (void*)data, 3);
+    expect_value(__wrap_tca4311a_write, len, 3);
+
+    will_return(__wrap_tca4311a_write, 0);
+
+    /* I2C enable */
+    expect_value(__wrap_tca4311a_enable, config.i2c_port, SL_EPS2_I2C_PORT);
+    expect_value(__wrap_tca4311a_enable, config.i2c_config.speed_hz, SL_EPS2_I2C_CLOCK_HZ);
+    expect_value(__wrap_tca4311a_enable, config.en_pin, SL_EPS2_I2C_EN_PIN);
+    expect_value(__wrap_tca4311a_enable, config.ready_pin, SL_EPS2_I2C_RDY_PIN);
+
+    will_return(__wrap_tca4311a_enable, 0);
+
+    /* I2C read (address echo poll) */
+    expect_value(__wrap_tca4311a_read, config.i2c_port, SL_EPS2_I2C_PORT);
+    expect_value(__wrap_tca4311a_read, config.i2c_config.speed_hz, SL_EPS2_I2C_CLOCK_HZ);
+    expect_value(__wrap_tca4311a_read, config.en_pin, SL_EPS2_I2C_EN_PIN);
+    expect_value(__wrap_tca4311a_read, config.ready_pin, SL_EPS2_I2C_RDY_PIN);
+    expect_value(__wrap_tca4311a_read, adr, SL_EPS2_I2C_ADR);
+    expect_value(__wrap_tca4311a_read, len, 1);
+
+    will_return(__wrap_tca4311a_read, adr);
+    will_return(__wrap_tca4311a_read, 0);
+
+    /* I2C enable */
+    expect_value(__wrap_tca4311a_enable, config.i2c_port, SL_EPS2_I2C_PORT);
+    expect_value(__wrap_tca4311a_enable, config.i2c_config.speed_hz, SL_EPS2_I2C_CLOCK_HZ);
+    expect_value(__wrap_tca4311a_enable, config.en_pin, SL_EPS2_I2C_EN_PIN);
+    expect_value(__wrap_tca4311a_enable, config.ready_pin, SL_EPS2_I2C_RDY_PIN);
+
+    will_return(__wrap_tca4311a_enable, 0);
+
+    /* I2C read */
+    uint16_t len = 1 + 4 * n + 1;
+
+    expect_value(__wrap_tca4311a_read, config.i2c_port, SL_EPS2_I2C_PORT);
+    expect_value(__wrap_tca4311a_read, config.i2c_config.speed_hz, SL_EPS2_I2C_CLOCK_HZ);
+    expect_value(__wrap_tca4311a_read, config.en_pin, SL_EPS2_I2C_EN_PIN);
+    expect_value(__wrap_tca4311a_read, config.ready_pin, SL_EPS2_I2C_RDY_PIN);
+    expect_value(__wrap_tca4311a_read, adr, SL_EPS2_I2C_ADR);
+    expect_value(__wrap_tca4311a_read, len, len);
+
+    data[0] = adr;
+
+    uint16_t i = 0;
+    for(i=0; i<n; i++)
+    {
+        data[1 + 4 * i] = (val[i] >> 24) & 0xFF;
+        data[2 + 4 * i] = (val[i] >> 16) & 0xFF;
+        data[3 + 4 * i] = (val[i] >> 8) & 0xFF;
+        data[4 + 4 * i] = (val[i] >> 0) & 0xFF;
+    }
+
+    data[len - 1] = crc8(data, len - 1);
+
+    if (!valid_crc)
+    {
+        data[len - 1] ^= 0xFF;
+    }
+
+    for(i=0; i<len; i++)
+    {
+        will_return(__wrap_tca4311a_read, data[i]);
+    }
+
+    will_return(__wrap_tca4311a_read, 0);
+}
+
+void read_data_by_reg_i2c_error(void)
+{
+    /* 46 register read requests, each one with 10 attempts to enable the I2C bus */
+    expect_value_count(__wrap_tca4311a_enable, config.i2c_port, SL_EPS2_I2C_PORT, 46 * 10);
+    expect_value_count(__wrap_tca4311a_enable, config.i2c_config.speed_hz, SL_EPS2_I2C_CLOCK_HZ, 46 * 10);
+    expect_value_count(__wrap_tca4311a_enable, config.en_pin, SL_EPS2_I2C_EN_PIN, 46 * 10);
+    expect_value_count(__wrap_tca4311a_enable, config.ready_pin, SL_EPS2_I2C_RDY_PIN, 46 * 10);
+
+    will_return_count(__wrap_tca4311a_enable, -1, 46 * 10);
+}
+
 /** \} End of sl_eps2_test group */
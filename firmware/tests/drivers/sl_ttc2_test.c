@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.7.19
+ * \version 0.10.17
  * 
  * \date 2021/09/08
  * 
@@ -42,6 +42,7 @@
 #include <cmocka.h>
 
 #include <stdlib.h>
+#include <stdbool.h>
 
 #include <drivers/spi/spi.h>
 #include <drivers/sl_ttc2/sl_ttc2.h>
@@ -59,14 +60,19 @@ uint16_t crc16_ccitt(uint8_t *data, uint16_t len);
 
 void read_adr(uint8_t adr, uint32_t val);
 
+void read_block(uint8_t adr, uint8_t n, uint32_t *val, bool valid_crc);
+
+void read_hk_by_reg(uint32_t *regs);
+
 static void sl_ttc2_init_test(void **state)
 {
     /* SPI init */
-    expect_value(__wrap_spi_init, port, SL_TTC2_SPI_PORT);
-    expect_value(__wrap_spi_init, config.speed_hz, SL_TTC2_SPI_CLOCK_HZ);
-    expect_value(__wrap_spi_init, config.mode, SL_TTC2_SPI_MODE);
+    expect_value(__wrap_spi_init_device, port, SL_TTC2_SPI_PORT);
+    expect_value(__wrap_spi_init_device, cs, SL_TTC2_SPI_CS);
+    expect_value(__wrap_spi_init_device, config.speed_hz, SL_TTC2_SPI_CLOCK_HZ);
+    expect_value(__wrap_spi_init_device, config.mode, SL_TTC2_SPI_MODE);
 
-    will_return(__wrap_spi_init, 0);
+    will_return(__wrap_spi_init_device, 0);
 
     /* SPI transfer */
     uint8_t cmd[8] = {0};
@@ -205,60 +211,95 @@ static void sl_ttc2_read_reg_test(void **state)
     assert_int_equal(res, val);
 }
 
+static void sl_ttc2_read_block_test(void **state)
+{
+    uint32_t val[SL_TTC2_BLOCK_READ_MAX_REGS] = {0};
+    uint32_t res[SL_TTC2_BLOCK_READ_MAX_REGS] = {0};
+
+    uint8_t adr = generate_random(0, SL_TTC2_BLOCK_READ_MAX_REGS - 1);
+    uint8_t n = generate_random(1, SL_TTC2_BLOCK_READ_MAX_REGS - adr);
+
+    uint8_t i = 0;
+    for(i = 0; i < n; i++)
+    {
+        val[i] = generate_random(0, UINT32_MAX-1);
+    }
+
+    read_block(adr, n, val, true);
+
+    assert_return_code(sl_ttc2_read_block(conf, adr, n, res), 0);
+
+    assert_memory_equal(val, res, n * sizeof(uint32_t));
+
+    /* Wrong CRC */
+    read_block(adr, n, val, false);
+
+    assert_int_equal(sl_ttc2_read_block(conf, adr, n, res), -1);
+
+    /* Out of range */
+    assert_int_equal(sl_ttc2_read_block(conf, 0, SL_TTC2_BLOCK_READ_MAX_REGS + 1, res), -1);
+    assert_int_equal(sl_ttc2_read_block(conf, SL_TTC2_REG_LEN_FIRST_RX_PACKET_IN_FIFO, 2, res), -1);
+    assert_int_equal(sl_ttc2_read_block(conf, 0, 0, res), -1);
+}
+
 static void sl_ttc2_read_hk_data_test(void **state)
 {
     sl_ttc2_hk_data_t hk_val = {0};
 
+    uint32_t regs[18] = {0};
+
     hk_val.time_counter = generate_random(0, UINT32_MAX-1);
-    read_adr(3, hk_val.time_counter);
+    regs[3 - 3] = hk_val.time_counter;
 
     hk_val.reset_counter = generate_random(0, UINT16_MAX);
-    read_adr(4, (uint32_t)hk_val.reset_counter);
+    regs[4 - 3] = (uint32_t)hk_val.reset_counter;
 
     hk_val.last_reset_cause = generate_random(0, UINT8_MAX);
-    read_adr(5, (uint32_t)hk_val.last_reset_cause);
+    regs[5 - 3] = (uint32_t)hk_val.last_reset_cause;
 
     hk_val.voltage_mcu = generate_random(0, UINT16_MAX);
-    read_adr(6, (uint32_t)hk_val.voltage_mcu);
+    regs[6 - 3] = (uint32_t)hk_val.voltage_mcu;
 
     hk_val.current_mcu = generate_random(0, UINT16_MAX);
-    read_adr(7, (uint32_t)hk_val.current_mcu);
+    regs[7 - 3] = (uint32_t)hk_val.current_mcu;
 
     hk_val.temperature_mcu = generate_random(0, UINT16_MAX);
-    read_adr(8, (uint32_t)hk_val.temperature_mcu);
+    regs[8 - 3] = (uint32_t)hk_val.temperature_mcu;
 
     hk_val.voltage_radio = generate_random(0, UINT16_MAX);
-    read_adr(9, (uint32_t)hk_val.voltage_radio);
+    regs[9 - 3] = (uint32_t)hk_val.voltage_radio;
 
     hk_val.current_radio = generate_random(0, UINT16_MAX);
-    read_adr(10, (uint32_t)hk_val.current_radio);
+    regs[10 - 3] = (uint32_t)hk_val.current_radio;
 
     hk_val.temperature_radio = generate_random(0, UINT16_MAX);
-    read_adr(11, (uint32_t)hk_val.temperature_radio);
+    regs[11 - 3] = (uint32_t)hk_val.temperature_radio;
 
     hk_val.last_valid_tc = generate_random(0, UINT8_MAX);
-    read_adr(12, (uint32_t)hk_val.last_valid_tc);
+    regs[12 - 3] = (uint32_t)hk_val.last_valid_tc;
 
     hk_val.rssi_last_valid_tc = generate_random(0, UINT16_MAX);
-    read_adr(13, (uint32_t)hk_val.rssi_last_valid_tc);
+    regs[13 - 3] = (uint32_t)hk_val.rssi_last_valid_tc;
 
     hk_val.temperature_antenna = generate_random(0, UINT16_MAX);
-    read_adr(14, (uint32_t)hk_val.temperature_antenna);
+    regs[14 - 3] = (uint32_t)hk_val.temperature_antenna;
 
     hk_val.antenna_status = generate_random(0, UINT16_MAX);
-    read_adr(15, (uint32_t)hk_val.antenna_status);
+    regs[15 - 3] = (uint32_t)hk_val.antenna_status;
 
     hk_val.deployment_status = generate_random(0, UINT8_MAX);
-    read_adr(16, (uint32_t)hk_val.deployment_status);
+    regs[16 - 3] = (uint32_t)hk_val.deployment_status;
 
     hk_val.hibernation_status = generate_random(0, UINT8_MAX);
-    read_adr(17, (uint32_t)hk_val.hibernation_status);
+    regs[17 - 3] = (uint32_t)hk_val.hibernation_status;
 
     hk_val.tx_packet_counter = generate_random(0, UINT32_MAX-1);
-    read_adr(19, (uint32_t)hk_val.tx_packet_counter);
+    regs[19 - 3] = (uint32_t)hk_val.tx_packet_counter;
 
     hk_val.rx_packet_counter = generate_random(0, UINT32_MAX-1);
-    read_adr(20, (uint32_t)hk_val.rx_packet_counter);
+    regs[20 - 3] = (uint32_t)hk_val.rx_packet_counter;
+
+    read_block(3, 18, regs, true);
 
     sl_ttc2_hk_data_t hk_res = {0};
 
@@ -283,6 +324,58 @@ static void sl_ttc2_read_hk_data_test(void **state)
     assert_int_equal(hk_val.rx_packet_counter,      hk_res.rx_packet_counter);
 }
 
+static void sl_ttc2_read_hk_data_fallback_test(void **state)
+{
+    uint32_t regs[18] = {0};
+
+    uint8_t i = 0;
+    for(i = 0; i < 18; i++)
+    {
+        regs[i] = generate_random(0, UINT16_MAX);
+    }
+
+    sl_ttc2_hk_data_t hk_res = {0};
+
+    /* A single invalid answer does not disable the block read */
+    read_block(3, 18, regs, false);
+    read_hk_by_reg(regs);
+
+    assert_return_code(sl_ttc2_read_hk_data(conf, &hk_res), 0);
+
+    read_block(3, 18, regs, true);
+
+    assert_return_code(sl_ttc2_read_hk_data(conf, &hk_res), 0);
+
+    /* Consecutive invalid answers */
+    for(i = 0; i < SL_TTC2_BLOCK_READ_MAX_ERRORS; i++)
+    {
+        read_block(3, 18, regs, false);
+        read_hk_by_reg(regs);
+
+        assert_return_code(sl_ttc2_read_hk_data(conf, &hk_res), 0);
+    }
+
+    /* Reads by register until the next probe of the block read */
+    for(i = 0; i < (SL_TTC2_BLOCK_READ_RETRY_PERIOD - 1); i++)
+    {
+        read_hk_by_reg(regs);
+
+        assert_return_code(sl_ttc2_read_hk_data(conf, &hk_res), 0);
+    }
+
+    /* Block read supported again */
+    read_block(3, 18, regs, true);
+
+    assert_return_code(sl_ttc2_read_hk_data(conf, &hk_res), 0);
+
+    read_block(3, 18, regs, true);
+
+    assert_return_code(sl_ttc2_read_hk_data(conf, &hk_res), 0);
+
+    assert_int_equal(regs[0], hk_res.time_counter);
+    assert_int_equal(regs[20 - 3], hk_res.rx_packet_counter);
+}
+
 static void sl_ttc2_read_device_id_test(void **state)
 {
     uint8_t adr = 0;    /* Device ID register */
@@ -748,7 +841,9 @@ int main(void)
         cmocka_unit_test(sl_ttc2_check_device_test),
         cmocka_unit_test(sl_ttc2_write_reg_test),
         cmocka_unit_test(sl_ttc2_read_reg_test),
+        cmocka_unit_test(sl_ttc2_read_block_test),
         cmocka_unit_test(sl_ttc2_read_hk_data_test),
+        cmocka_unit_test(sl_ttc2_read_hk_data_fallback_test),
         cmocka_unit_test(sl_ttc2_read_device_id_test),
         cmocka_unit_test(sl_ttc2_read_hardware_version_test),
         cmocka_unit_test(sl_ttc2_read_firmware_version_test),
@@ -830,4 +925,64 @@ void read_adr(uint8_t adr, uint32_t val)
     will_return(__wrap_spi_transfer, 0);
 }
 
+void read_block(uint8_t adr, uint8_t n, uint32_t *val, bool valid_crc)
+{
+    uint8_t cmd[256] = {0};
+    uint8_t ans[256] = {0};
+
+    uint16_t len = 3 + 4 * n + 2;
+
+    cmd[0] = 5;     /* Read block command */
+    cmd[1] = adr;   /* First address */
+    cmd[2] = n;     /* Number of registers */
+
+    ans[0] = 5;
+    ans[1] = adr;
+    ans[2] = n;
+
+    uint16_t i = 0;
+    for(i=0; i<n; i++)
+    {
+        ans[3 + 4 * i] = (val[i] >> 24) & 0xFF;
+        ans[4 + 4 * i] = (val[i] >> 16) & 0xFF;
+        ans[5 + 4 * i] = (val[i] >> 8) & 0xFF;
+        ans[6 + 4 * i] = val[i] & 0xFF;
+    }
+
+    uint16_t checksum = crc16_ccitt(ans, len - 2);
+
+    if (!valid_crc)
+    {
+        checksum ^= 0xFFFF;
+    }
+
+    ans[len - 2] = (checksum >> 8) & 0xFF;
+    ans[len - 1] = checksum & 0xFF;
+
+    expect_value(__wrap_spi_transfer, port, SL_TTC2_SPI_PORT);
+    expect_value(__wrap_spi_transfer, cs, SL_TTC2_SPI_CS);
+    expect_memory(__wrap_spi_transfer, wd, (void*)cmd, 3);
+    expect_value(__wrap_spi_transfer, len, len);
+
+    for(i=0; i<len; i++)
+    {
+        will_return(__wrap_spi_transfer, ans[i]);
+    }
+
+    will_return(__wrap_spi_transfer, 0);
+}
+
+void read_hk_by_reg(uint32_t *regs)
+{
+    /* Registers 3 to 20, except the TX enable (18) */
+    uint8_t adr = 0;
+    for(adr = 3; adr <= 20; adr++)
+    {
+        if (adr != 18)
+        {
+            read_adr(adr, regs[adr - 3]);
+        }
+    }
+}
+
 /** \} End of sl_ttc2_test group */
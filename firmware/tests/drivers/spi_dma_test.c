@@ -0,0 +1,229 @@
+/*
+ * spi_dma_test.c
+ * 
+ * Copyright The OBDH 2.0 Contributors.
+ * 
+ * This file is part of OBDH 2.0.
+ * 
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+
+/**
+ * \brief Unit test of the SPI DMA transfers.
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 0.10.8
+ * 
+ * \date 2022/11/26
+ * 
+ * \defgroup spi_dma_unit_test SPI DMA
+ * \ingroup tests
+ * \{
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <float.h>
+#include <cmocka.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <drivers/spi/spi.h>
+#include <drivers/dma/dma.h>
+
+#define SPI_DMA_TEST_PORT           SPI_PORT_0
+#define SPI_DMA_TEST_RX_CH          DMA_CH_0
+#define SPI_DMA_TEST_TX_CH          DMA_CH_1
+#define SPI_DMA_TEST_PERIPH         DMA_PERIPH_USCI_A0
+#define SPI_DMA_TEST_LEN            64U
+
+unsigned int generate_random(unsigned int l, unsigned int r);
+
+void expect_dma_config(bool rx_inc, bool tx_inc, uint16_t len);
+
+void expect_dma_stop(void);
+
+static void spi_dma_available_test(void **state)
+{
+    assert_true(spi_dma_available(SPI_PORT_0));
+
+    /* Ports without DMA channels */
+    assert_false(spi_dma_available(SPI_PORT_1));
+    assert_false(spi_dma_available(SPI_PORT_3));
+    assert_false(spi_dma_available(SPI_PORT_5));
+}
+
+static void spi_dma_transfer_test(void **state)
+{
+    uint8_t wd[SPI_DMA_TEST_LEN] = {0};
+    uint8_t rd[SPI_DMA_TEST_LEN] = {0};
+
+    uint16_t i = 0;
+    for(i = 0; i < SPI_DMA_TEST_LEN; i++)
+    {
+        wd[i] = generate_random(0, UINT8_MAX);
+    }
+
+    expect_dma_config(true, true, SPI_DMA_TEST_LEN);
+
+    expect_value(__wrap_dma_start_tx, periph, SPI_DMA_TEST_PERIPH);
+    will_return(__wrap_dma_start_tx, true);
+    will_return(__wrap_dma_start_tx, 0);
+
+    expect_dma_stop();
+
+    assert_return_code(spi_dma_transfer(SPI_DMA_TEST_PORT, wd, rd, SPI_DMA_TEST_LEN), 0);
+
+    /* The mock DMA engine is a loopback */
+    assert_memory_equal(rd, wd, SPI_DMA_TEST_LEN);
+}
+
+static void spi_dma_write_test(void **state)
+{
+    uint8_t wd[SPI_DMA_TEST_LEN] = {0};
+
+    uint16_t i = 0;
+    for(i = 0; i < SPI_DMA_TEST_LEN; i++)
+    {
+        wd[i] = generate_random(0, UINT8_MAX);
+    }
+
+    /* The received bytes are discarded in a single byte */
+    expect_dma_config(false, true, SPI_DMA_TEST_LEN);
+
+    expect_value(__wrap_dma_start_tx, periph, SPI_DMA_TEST_PERIPH);
+    will_return(__wrap_dma_start_tx, true);
+    will_return(__wrap_dma_start_tx, 0);
+
+    expect_dma_stop();
+
+    assert_return_code(spi_dma_transfer(SPI_DMA_TEST_PORT, wd, NULL, SPI_DMA_TEST_LEN), 0);
+}
+
+static void spi_dma_read_test(void **state)
+{
+    uint8_t rd[SPI_DMA_TEST_LEN] = {0};
+    uint8_t zeros[SPI_DMA_TEST_LEN] = {0};
+
+    memset(rd, 0xAA, SPI_DMA_TEST_LEN);
+
+    /* A single dummy byte is transmitted over and over */
+    expect_dma_config(true, false, SPI_DMA_TEST_LEN);
+
+    expect_value(__wrap_dma_start_tx, periph, SPI_DMA_TEST_PERIPH);
+    will_return(__wrap_dma_start_tx, true);
+    will_return(__wrap_dma_start_tx, 0);
+
+    expect_dma_stop();
+
+    assert_return_code(spi_dma_transfer(SPI_DMA_TEST_PORT, NULL, rd, SPI_DMA_TEST_LEN), 0);
+
+    /* Loopback of the dummy byte (the same transmitted by the polled read) */
+    assert_memory_equal(rd, zeros, SPI_DMA_TEST_LEN);
+}
+
+static void spi_dma_timeout_test(void **state)
+{
+    uint8_t wd[SPI_DMA_TEST_LEN] = {0};
+    uint8_t rd[SPI_DMA_TEST_LEN] = {0};
+
+    expect_dma_config(true, true, SPI_DMA_TEST_LEN);
+
+    /* The transfer never completes */
+    expect_value(__wrap_dma_start_tx, periph, SPI_DMA_TEST_PERIPH);
+    will_return(__wrap_dma_start_tx, false);
+    will_return(__wrap_dma_start_tx, 0);
+
+    /* The channels must be disabled anyway */
+    expect_dma_stop();
+
+    assert_int_equal(spi_dma_transfer(SPI_DMA_TEST_PORT, wd, rd, SPI_DMA_TEST_LEN), -1);
+}
+
+static void spi_dma_config_error_test(void **state)
+{
+    uint8_t wd[SPI_DMA_TEST_LEN] = {0};
+
+    expect_value(__wrap_dma_config_rx, ch, SPI_DMA_TEST_RX_CH);
+    expect_value(__wrap_dma_config_rx, periph, SPI_DMA_TEST_PERIPH);
+    expect_value(__wrap_dma_config_rx, inc, false);
+    expect_value(__wrap_dma_config_rx, len, SPI_DMA_TEST_LEN);
+
+    will_return(__wrap_dma_config_rx, -1);
+
+    expect_dma_stop();
+
+    assert_int_equal(spi_dma_transfer(SPI_DMA_TEST_PORT, wd, NULL, SPI_DMA_TEST_LEN), -1);
+}
+
+static void spi_dma_no_dma_port_test(void **state)
+{
+    uint8_t wd[SPI_DMA_TEST_LEN] = {0};
+    uint8_t rd[SPI_DMA_TEST_LEN] = {0};
+
+    /* No DMA calls are expected */
+    assert_int_equal(spi_dma_transfer(SPI_PORT_2, wd, rd, SPI_DMA_TEST_LEN), -1);
+    assert_int_equal(spi_dma_transfer(SPI_DMA_TEST_PORT, wd, rd, 0), -1);
+}
+
+int main(void)
+{
+    const struct CMUnitTest spi_dma_tests[] = {
+        cmocka_unit_test(spi_dma_available_test),
+        cmocka_unit_test(spi_dma_transfer_test),
+        cmocka_unit_test(spi_dma_write_test),
+        cmocka_unit_test(spi_dma_read_test),
+        cmocka_unit_test(spi_dma_timeout_test),
+        cmocka_unit_test(spi_dma_config_error_test),
+        cmocka_unit_test(spi_dma_no_dma_port_test),
+    };
+
+    return cmocka_run_group_tests(spi_dma_tests, NULL, NULL);
+}
+
+unsigned int generate_random(unsigned int l, unsigned int r)
+{
+    return (rand() % (r - l + 1)) + l;
+}
+
+void expect_dma_config(bool rx_inc, bool tx_inc, uint16_t len)
+{
+    expect_value(__wrap_dma_config_rx, ch, SPI_DMA_TEST_RX_CH);
+    expect_value(__wrap_dma_config_rx, periph, SPI_DMA_TEST_PERIPH);
+    expect_value(__wrap_dma_config_rx, inc, rx_inc);
+    expect_value(__wrap_dma_config_rx, len, len);
+
+    will_return(__wrap_dma_config_rx, 0);
+
+    expect_value(__wrap_dma_config_tx, ch, SPI_DMA_TEST_TX_CH);
+    expect_value(__wrap_dma_config_tx, periph, SPI_DMA_TEST_PERIPH);
+    expect_value(__wrap_dma_config_tx, inc, tx_inc);
+    expect_value(__wrap_dma_config_tx, len, len);
+
+    will_return(__wrap_dma_config_tx, 0);
+}
+
+void expect_dma_stop(void)
+{
+    expect_value(__wrap_dma_stop, ch, SPI_DMA_TEST_RX_CH);
+    expect_value(__wrap_dma_stop, ch, SPI_DMA_TEST_TX_CH);
+}
+
+/** \} End of spi_dma_unit_test group */
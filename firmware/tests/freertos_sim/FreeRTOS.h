@@ -39,6 +39,8 @@
 
 #include <stdint.h>
 
+#define configTICK_RATE_HZ  ((TickType_t)1000)
+
 #define pdMS_TO_TICKS(x)    (x)
 
 /**
@@ -46,6 +48,14 @@
  */
 typedef uint32_t TickType_t;
 
+/**
+ * \brief Base type.
+ */
+typedef long BaseType_t;
+
+#define pdFALSE             ((BaseType_t)0)
+#define pdTRUE              ((BaseType_t)1)
+
 #endif /* FREERTOS_SIM_H_ */
 
 /** \} End of freertos_sim group */
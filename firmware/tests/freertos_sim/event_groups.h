@@ -0,0 +1,72 @@
+/*
+ * event_groups.h
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief FreeRTOS event groups simulation definition.
+ *
+ * Only the types and the declarations, so the task headers can be included by the host tools.
+ * The functions are provided by the programs that need them (e.g. the host simulations).
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.25
+ *
+ * \date 2022/12/13
+ *
+ * \defgroup event_groups_sim FreeRTOS event groups
+ * \ingroup tests
+ * \{
+ */
+
+#ifndef EVENT_GROUPS_SIM_H_
+#define EVENT_GROUPS_SIM_H_
+
+#include "FreeRTOS.h"
+
+struct EventGroupDef_t;
+typedef struct EventGroupDef_t* EventGroupHandle_t;
+
+/**
+ * \brief Event bits type.
+ */
+typedef TickType_t EventBits_t;
+
+/**
+ * \brief Waits for bits of an event group to be set.
+ *
+ * \param[in] xEventGroup is the event group.
+ *
+ * \param[in] uxBitsToWaitFor are the bits to wait for.
+ *
+ * \param[in] xClearOnExit is pdTRUE to clear the bits before returning.
+ *
+ * \param[in] xWaitForAllBits is pdTRUE to wait for all the bits, or pdFALSE to wait for any of them.
+ *
+ * \param[in] xTicksToWait is the maximum time to wait.
+ *
+ * \return The value of the event group bits.
+ */
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToWaitFor, const BaseType_t xClearOnExit, const BaseType_t xWaitForAllBits, TickType_t xTicksToWait);
+
+#endif /* EVENT_GROUPS_SIM_H_ */
+
+/** \} End of event_groups_sim group */
@@ -0,0 +1,52 @@
+/*
+ * semphr.h
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief FreeRTOS semaphores simulation definition.
+ *
+ * There is a single simulated task, so a mutex is always available.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.25
+ *
+ * \date 2022/12/20
+ *
+ * \defgroup semphr_sim FreeRTOS semaphores
+ * \ingroup tests
+ * \{
+ */
+
+#ifndef SEMPHR_SIM_H_
+#define SEMPHR_SIM_H_
+
+#include "FreeRTOS.h"
+
+typedef void* SemaphoreHandle_t;
+
+#define xSemaphoreCreateMutex()         ((SemaphoreHandle_t)1)
+#define xSemaphoreTake(x, t)            ((void)(x), (void)(t), pdTRUE)
+#define xSemaphoreGive(x)               ((void)(x))
+
+#endif /* SEMPHR_SIM_H_ */
+
+/** \} End of semphr_sim group */
@@ -39,11 +39,14 @@
 #include <math.h>
 #include <time.h>
 #include <unistd.h>
+#include <stddef.h>
 
 #include "task.h"
 
 uint64_t initial_time_ms = 0;
 
+static uint32_t notify_value = 0;
+
 TickType_t xTaskGetTickCount(void)
 {
     long ms;    /* Milliseconds */
@@ -80,4 +83,52 @@ void vTaskDelay(const TickType_t xTicksToDelay)
     usleep(1000*xTicksToDelay);
 }
 
+void vTaskDelayUntil(TickType_t *pxPreviousWakeTime, TickType_t xTimeIncrement)
+{
+    TickType_t now = xTaskGetTickCount();
+
+    *pxPreviousWakeTime += xTimeIncrement;
+
+    if ((TickType_t)(*pxPreviousWakeTime - now) <= xTimeIncrement)
+    {
+        vTaskDelay(*pxPreviousWakeTime - now);
+    }
+}
+
+BaseType_t xTaskGetSchedulerState(void)
+{
+    return taskSCHEDULER_RUNNING;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void)
+{
+    return (TaskHandle_t)&notify_value;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait)
+{
+    uint32_t val = notify_value;
+
+    if (xClearCountOnExit == pdTRUE)
+    {
+        notify_value = 0;
+    }
+    else if (notify_value > 0U)
+    {
+        notify_value--;
+    }
+
+    return val;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    notify_value++;
+
+    if (pxHigherPriorityTaskWoken != NULL)
+    {
+        *pxHigherPriorityTaskWoken = pdTRUE;
+    }
+}
+
 /** \} End of task_sim group */
@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.7.48
+ * \version 0.10.25
  * 
  * \date 2021/04/27
  * 
@@ -41,8 +41,20 @@
 
 #include "FreeRTOS.h"
 
+#define tskKERNEL_VERSION_NUMBER        "V10.2.0"
+
 struct tskTaskControlBlock;
 typedef struct tskTaskControlBlock* TaskHandle_t;
+typedef TaskHandle_t xTaskHandle;
+
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+#define taskSCHEDULER_SUSPENDED         ((BaseType_t)0)
+#define taskSCHEDULER_NOT_STARTED       ((BaseType_t)1)
+#define taskSCHEDULER_RUNNING           ((BaseType_t)2)
+
+#define portYIELD_FROM_ISR(x)           ((void)(x))
 
 /**
  * \brief Gets the system tick count since the begining.
@@ -67,6 +79,55 @@ void vTaskSuspend(TaskHandle_t xTaskToSuspend);
  */
 void vTaskDelay(TickType_t xTicksToDelay);
 
+/**
+ * \brief Delays until a given number of ticks after a reference time.
+ *
+ * \param[in,out] pxPreviousWakeTime is the reference time, updated to the wake time.
+ *
+ * \param[in] xTimeIncrement is the number of ticks after the reference time.
+ *
+ * \return None.
+ */
+void vTaskDelayUntil(TickType_t *pxPreviousWakeTime, TickType_t xTimeIncrement);
+
+/**
+ * \brief Gets the scheduler state (always running in the simulation).
+ *
+ * \return The scheduler state.
+ */
+BaseType_t xTaskGetSchedulerState(void);
+
+/**
+ * \brief Gets the handle of the calling task.
+ *
+ * \return The task handle.
+ */
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+
+/**
+ * \brief Takes the notification value of the calling task.
+ *
+ * There is a single simulated task, so the function never blocks.
+ *
+ * \param[in] xClearCountOnExit is pdTRUE/pdFALSE to clear or decrement the value.
+ *
+ * \param[in] xTicksToWait is the maximum time to wait (ignored).
+ *
+ * \return The notification value before being cleared/decremented.
+ */
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait);
+
+/**
+ * \brief Increments the notification value of a task (from an ISR).
+ *
+ * \param[in] xTaskToNotify is the task to notify.
+ *
+ * \param[in,out] pxHigherPriorityTaskWoken is set to pdTRUE.
+ *
+ * \return None.
+ */
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken);
+
 #endif /* TASK_SIM_H_ */
 
 /** \} End of task_sim group */
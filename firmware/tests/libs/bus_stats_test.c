@@ -0,0 +1,145 @@
+/*
+ * bus_stats_test.c
+ * 
+ * Copyright The OBDH 2.0 Contributors.
+ * 
+ * This file is part of OBDH 2.0.
+ * 
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief Unit test of the bus statistics.
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 0.10.16
+ * 
+ * \date 2022/12/04
+ * 
+ * \defgroup bus_stats_unit_test Bus Statistics
+ * \ingroup tests
+ * \{
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <float.h>
+#include <cmocka.h>
+
+#include <libs/stats/bus_stats.h>
+
+static void bus_stats_bin_test(void **state)
+{
+    /* First bin: shorter than 16 us */
+    assert_int_equal(bus_stats_bin(0UL), 0U);
+    assert_int_equal(bus_stats_bin(1UL), 0U);
+    assert_int_equal(bus_stats_bin(15UL), 0U);
+
+    /* Bin k: from 2^(k+3) us to 2^(k+4)-1 us */
+    uint8_t k = 0U;
+    for(k = 1U; k < (BUS_STATS_HIST_BINS - 1U); k++)
+    {
+        assert_int_equal(bus_stats_bin(1UL << (k + 3U)), k);
+        assert_int_equal(bus_stats_bin((1UL << (k + 4U)) - 1UL), k);
+    }
+
+    /* Last bin: 16.384 ms or more */
+    assert_int_equal(bus_stats_bin(16383UL), BUS_STATS_HIST_BINS - 2U);
+    assert_int_equal(bus_stats_bin(16384UL), BUS_STATS_HIST_BINS - 1U);
+    assert_int_equal(bus_stats_bin(UINT32_MAX), BUS_STATS_HIST_BINS - 1U);
+}
+
+static void bus_stats_add_test(void **state)
+{
+    bus_stats_t stats = {0};
+
+    bus_stats_add(&stats, 10UL, 4UL, false);
+    bus_stats_add(&stats, 100UL, 256UL, false);
+    bus_stats_add(&stats, 120UL, 256UL, true);
+    bus_stats_add(&stats, 100000UL, 0UL, true);
+    bus_stats_add_timeout(&stats);
+
+    assert_int_equal(stats.transactions, 4UL);
+    assert_int_equal(stats.bytes, 516UL);
+    assert_int_equal(stats.errors, 2UL);
+    assert_int_equal(stats.timeouts, 1UL);
+
+    assert_int_equal(stats.hist[0], 1U);
+    assert_int_equal(stats.hist[bus_stats_bin(100UL)], 2U);
+    assert_int_equal(stats.hist[BUS_STATS_HIST_BINS - 1U], 1U);
+
+    /* The histogram bins saturate */
+    stats.hist[0] = UINT16_MAX;
+    bus_stats_add(&stats, 1UL, 1UL, false);
+    assert_int_equal(stats.hist[0], UINT16_MAX);
+    assert_int_equal(stats.transactions, 5UL);
+
+    bus_stats_reset(&stats);
+
+    assert_int_equal(stats.transactions, 0UL);
+    assert_int_equal(stats.bytes, 0UL);
+    assert_int_equal(stats.hist[0], 0U);
+}
+
+static void bus_stats_get_field_test(void **state)
+{
+    bus_stats_t stats = {0};
+
+    bus_stats_add(&stats, 40UL, 8UL, true);
+    bus_stats_add_timeout(&stats);
+    bus_stats_add_timeout(&stats);
+
+    uint32_t val = UINT32_MAX;
+
+    assert_return_code(bus_stats_get_field(&stats, BUS_STATS_FIELD_TRANSACTIONS, &val), 0);
+    assert_int_equal(val, 1UL);
+
+    assert_return_code(bus_stats_get_field(&stats, BUS_STATS_FIELD_BYTES, &val), 0);
+    assert_int_equal(val, 8UL);
+
+    assert_return_code(bus_stats_get_field(&stats, BUS_STATS_FIELD_ERRORS, &val), 0);
+    assert_int_equal(val, 1UL);
+
+    assert_return_code(bus_stats_get_field(&stats, BUS_STATS_FIELD_TIMEOUTS, &val), 0);
+    assert_int_equal(val, 2UL);
+
+    /* 40 us is in the [32, 64) us bin */
+    assert_return_code(bus_stats_get_field(&stats, BUS_STATS_FIELD_HIST + 2U, &val), 0);
+    assert_int_equal(val, 1UL);
+
+    assert_return_code(bus_stats_get_field(&stats, BUS_STATS_FIELD_HIST + 1U, &val), 0);
+    assert_int_equal(val, 0UL);
+
+    assert_return_code(bus_stats_get_field(&stats, BUS_STATS_FIELDS - 1U, &val), 0);
+    assert_int_equal(val, 0UL);
+
+    assert_int_equal(bus_stats_get_field(&stats, BUS_STATS_FIELDS, &val), -1);
+}
+
+int main(void)
+{
+    const struct CMUnitTest bus_stats_tests[] = {
+        cmocka_unit_test(bus_stats_bin_test),
+        cmocka_unit_test(bus_stats_add_test),
+        cmocka_unit_test(bus_stats_get_field_test),
+    };
+
+    return cmocka_run_group_tests(bus_stats_tests, NULL, NULL);
+}
+
+/** \} End of bus_stats_unit_test group */
@@ -0,0 +1,120 @@
+/*
+ * cpu_stats_test.c
+ * 
+ * Copyright The OBDH 2.0 Contributors.
+ * 
+ * This file is part of OBDH 2.0.
+ * 
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief Unit test of the CPU statistics.
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 0.10.24
+ * 
+ * \date 2022/12/12
+ * 
+ * \defgroup cpu_stats_unit_test CPU Statistics
+ * \ingroup tests
+ * \{
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <float.h>
+#include <cmocka.h>
+
+#include <libs/stats/cpu_stats.h>
+
+static void cpu_stats_load_test(void **state)
+{
+    cpu_stats_t stats = {0};
+
+    /* 2.5 s of 10 s */
+    cpu_stats_update(&stats, 2500000UL, 10000000UL);
+    assert_int_equal(stats.load, 2500U);
+
+    /* Idle window */
+    cpu_stats_update(&stats, 2500000UL, 10000000UL);
+    assert_int_equal(stats.load, 0U);
+
+    /* Whole window (and more, the counters are sampled at slightly different times) */
+    cpu_stats_update(&stats, 12600000UL, 10000000UL);
+    assert_int_equal(stats.load, CPU_STATS_LOAD_FULL);
+
+    /* Short windows (less than 10 ms) */
+    cpu_stats_update(&stats, 12600000UL + 333UL, 1000UL);
+    assert_int_equal(stats.load, 3330U);
+
+    /* First sample */
+    cpu_stats_update(&stats, 12600333UL, 0UL);
+    assert_int_equal(stats.load, 0U);
+}
+
+static void cpu_stats_run_time_test(void **state)
+{
+    cpu_stats_t stats = {0};
+
+    cpu_stats_update(&stats, 1500UL, 10000UL);
+    assert_int_equal(stats.run_time_ms, 1UL);
+    assert_int_equal(stats.run_time_us, 500U);
+
+    /* The sub-millisecond remainders are accumulated */
+    cpu_stats_update(&stats, 3200UL, 10000UL);
+    assert_int_equal(stats.run_time_ms, 3UL);
+    assert_int_equal(stats.run_time_us, 200U);
+
+    /* The 32-bit counter wraps (about 71 minutes) */
+    stats.counter = UINT32_MAX - 999UL;
+    cpu_stats_update(&stats, 4000UL, 10000000UL);
+    assert_int_equal(stats.run_time_ms, 8UL);
+    assert_int_equal(stats.run_time_us, 200U);
+    assert_int_equal(stats.load, 5U);
+}
+
+static void cpu_stats_get_field_test(void **state)
+{
+    cpu_stats_t stats = {0};
+
+    cpu_stats_update(&stats, 7000000UL, 10000000UL);
+
+    uint32_t val = UINT32_MAX;
+
+    assert_return_code(cpu_stats_get_field(&stats, CPU_STATS_FIELD_LOAD, &val), 0);
+    assert_int_equal(val, 7000UL);
+
+    assert_return_code(cpu_stats_get_field(&stats, CPU_STATS_FIELD_RUN_TIME, &val), 0);
+    assert_int_equal(val, 7000UL);
+
+    assert_int_equal(cpu_stats_get_field(&stats, CPU_STATS_FIELD_RUN_TIME + 1U, &val), -1);
+}
+
+int main(void)
+{
+    const struct CMUnitTest cpu_stats_tests[] = {
+        cmocka_unit_test(cpu_stats_load_test),
+        cmocka_unit_test(cpu_stats_run_time_test),
+        cmocka_unit_test(cpu_stats_get_field_test),
+    };
+
+    return cmocka_run_group_tests(cpu_stats_tests, NULL, NULL);
+}
+
+/** \} End of cpu_stats_unit_test group */
@@ -0,0 +1,285 @@
+/*
+ * fmt_benchmark.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Host benchmark of the number formatter against the previous system log functions.
+ *
+ * The "legacy" cases are copies of the previous sys_log_print_uint/hex/float (log10, pow and
+ * one UART write per character). The "fmt" cases format into a buffer and do a single write.
+ * The UART is replaced by a sink that only counts the calls and the bytes.
+ *
+ * \note The host has a hardware divider and an FPU, so the gain in the MSP430 (where the
+ *       divisions and log10/pow are software routines) is larger than the one measured here.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.21
+ *
+ * \date 2022/12/09
+ *
+ * \defgroup fmt_benchmark Format benchmark
+ * \ingroup tests
+ * \{
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+
+#include <libs/format/fmt.h>
+
+#define FMT_BENCHMARK_VALUES        (4UL*1024UL*1024UL)     /**< Values printed in each case. */
+
+static volatile unsigned long bench_writes = 0UL;
+static volatile unsigned long bench_bytes = 0UL;
+static volatile uint8_t bench_sink = 0U;
+
+/**
+ * \brief Gets the current time in nanoseconds.
+ *
+ * \return The current (monotonic) time in nanoseconds.
+ */
+static uint64_t fmt_benchmark_now_ns(void);
+
+/**
+ * \brief UART write replacement (one call per write, as uart_write).
+ *
+ * \param[in] data is the array of bytes to write.
+ *
+ * \param[in] len is the number of bytes to write.
+ *
+ * \return None.
+ */
+static void __attribute__((noinline)) fmt_benchmark_write(const uint8_t *data, uint16_t len);
+
+/**
+ * \brief Previous sys_log_print_digit.
+ *
+ * \param[in] digit is the digit to print.
+ *
+ * \return None.
+ */
+static void legacy_print_digit(uint8_t digit);
+
+/**
+ * \brief Previous sys_log_print_uint.
+ *
+ * \param[in] uint is the value to print.
+ *
+ * \return None.
+ */
+static void legacy_print_uint(uint32_t uint);
+
+/**
+ * \brief Previous sys_log_print_hex.
+ *
+ * \param[in] hex is the value to print.
+ *
+ * \return None.
+ */
+static void legacy_print_hex(uint32_t hex);
+
+/**
+ * \brief Previous sys_log_print_float.
+ *
+ * \param[in] flt is the value to print.
+ *
+ * \param[in] digits is the number of decimal places.
+ *
+ * \return None.
+ */
+static void legacy_print_float(float flt, uint8_t digits);
+
+/**
+ * \brief Runs a benchmark case.
+ *
+ * \param[in] name is the name of the case.
+ *
+ * \param[in] legacy is the legacy print function of the case (the argument is the value index).
+ *
+ * \param[in] fmt is the new print function of the case (the argument is the value index).
+ *
+ * \return None.
+ */
+static void fmt_benchmark_run(const char *name, void (*legacy)(uint32_t), void (*fmt)(uint32_t));
+
+static void legacy_uint(uint32_t i)     { legacy_print_uint(i * 2654435761UL); }
+static void legacy_hex(uint32_t i)      { legacy_print_hex(i * 2654435761UL); }
+static void legacy_float(uint32_t i)    { legacy_print_float((float)i / 256.0f, 3U); }
+
+static void fmt_uint_case(uint32_t i)
+{
+    char buf[FMT_UINT_MAX_LEN];
+
+    fmt_benchmark_write((const uint8_t*)buf, fmt_uint(buf, i * 2654435761UL));
+}
+
+static void fmt_hex_case(uint32_t i)
+{
+    char buf[FMT_HEX_MAX_LEN];
+
+    fmt_benchmark_write((const uint8_t*)buf, fmt_hex(buf, i * 2654435761UL));
+}
+
+static void fmt_q_case(uint32_t i)
+{
+    char buf[FMT_Q_MAX_LEN];
+
+    /* Same value as the float case, as Q8 */
+    fmt_benchmark_write((const uint8_t*)buf, fmt_q(buf, (int32_t)i, 8U, 3U));
+}
+
+int main(void)
+{
+    printf("Printing %lu values in each case\n\n", FMT_BENCHMARK_VALUES);
+    printf("%-8s %14s %14s %10s %14s %14s\n", "case", "legacy ns/val", "fmt ns/val", "speedup", "legacy wr/val", "fmt wr/val");
+
+    fmt_benchmark_run("uint", legacy_uint, fmt_uint_case);
+    fmt_benchmark_run("hex", legacy_hex, fmt_hex_case);
+    fmt_benchmark_run("float/q", legacy_float, fmt_q_case);
+
+    return 0;
+}
+
+static uint64_t fmt_benchmark_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static void fmt_benchmark_write(const uint8_t *data, uint16_t len)
+{
+    bench_writes++;
+    bench_bytes += len;
+    bench_sink ^= data[len - 1U];
+}
+
+static void fmt_benchmark_run(const char *name, void (*legacy)(uint32_t), void (*fmt)(uint32_t))
+{
+    double t[2] = {0};
+    double w[2] = {0};
+
+    void (*cases[2])(uint32_t) = {legacy, fmt};
+
+    unsigned int c = 0;
+    for(c = 0; c < 2U; c++)
+    {
+        bench_writes = 0UL;
+
+        uint64_t start = fmt_benchmark_now_ns();
+
+        uint32_t i = 0;
+        for(i = 1; i <= FMT_BENCHMARK_VALUES; i++)
+        {
+            cases[c](i);
+        }
+
+        t[c] = (double)(fmt_benchmark_now_ns() - start) / FMT_BENCHMARK_VALUES;
+        w[c] = (double)bench_writes / FMT_BENCHMARK_VALUES;
+    }
+
+    printf("%-8s %14.2f %14.2f %9.2fx %14.2f %14.2f\n", name, t[0], t[1], t[0] / t[1], w[0], w[1]);
+}
+
+static void legacy_print_digit(uint8_t digit)
+{
+    uint8_t c = (digit < 0x0AU) ? (digit + 0x30U) : (digit + 0x37U);
+
+    fmt_benchmark_write(&c, 1U);
+}
+
+static void legacy_print_uint(uint32_t uint)
+{
+    uint32_t uint_buf = uint;
+
+    if (uint == 0U)
+    {
+        legacy_print_digit(0);
+    }
+    else
+    {
+        uint8_t uint_str[10] = {0};
+
+        uint8_t digits = log10(uint) + 1;
+
+        uint8_t i = 0;
+        for(i = 0; i < digits; ++i)
+        {
+            uint_str[i] = uint_buf % 10U;
+
+            uint_buf /= 10U;
+        }
+
+        uint8_t j = 0;
+        for(j = i; j > 0U; j--)
+        {
+            legacy_print_digit(uint_str[j-1U]);
+        }
+    }
+}
+
+static void legacy_print_hex(uint32_t hex)
+{
+    fmt_benchmark_write((const uint8_t*)"0x", 2U);
+
+    if (hex > 0x00FFFFFFU)
+    {
+        legacy_print_digit((uint8_t)(hex >> 28) & 0x0FU);
+        legacy_print_digit((uint8_t)(hex >> 24) & 0x0FU);
+    }
+
+    if (hex > 0x0000FFFFU)
+    {
+        legacy_print_digit((uint8_t)(hex >> 20) & 0x0FU);
+        legacy_print_digit((uint8_t)(hex >> 16) & 0x0FU);
+    }
+
+    if (hex > 0x000000FFU)
+    {
+        legacy_print_digit((uint8_t)(hex >> 12) & 0x0FU);
+        legacy_print_digit((uint8_t)(hex >> 8) & 0x0FU);
+    }
+
+    legacy_print_digit((uint8_t)(hex >> 4) & 0x0FU);
+    legacy_print_digit((uint8_t)(hex & 0x0FU));
+}
+
+static void legacy_print_float(float flt, uint8_t digits)
+{
+    float flt_pos = flt;
+
+    uint32_t ipart = (uint32_t)flt_pos;
+
+    float fpart = flt_pos - (float)ipart;
+
+    legacy_print_uint(ipart);
+
+    fmt_benchmark_write((const uint8_t*)".", 1U);
+
+    legacy_print_uint((uint32_t)(fpart*pow(10, digits)));
+}
+
+/** \} End of fmt_benchmark group */
@@ -0,0 +1,153 @@
+/*
+ * fmt_test.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Unit test of the number formatter.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.21
+ *
+ * \date 2022/12/09
+ *
+ * \defgroup fmt_unit_test Format
+ * \ingroup tests
+ * \{
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <setjmp.h>
+#include <float.h>
+#include <cmocka.h>
+
+#include <libs/format/fmt.h>
+
+static void fmt_uint_test(void **state)
+{
+    char buf[FMT_UINT_MAX_LEN + 1U] = {0};
+
+    assert_int_equal(fmt_uint(buf, 0UL), 1U);
+    assert_memory_equal(buf, "0", 1U);
+
+    assert_int_equal(fmt_uint(buf, 10UL), 2U);
+    assert_memory_equal(buf, "10", 2U);
+
+    assert_int_equal(fmt_uint(buf, 1000000000UL), 10U);
+    assert_memory_equal(buf, "1000000000", 10U);
+
+    assert_int_equal(fmt_uint(buf, UINT32_MAX), 10U);
+    assert_memory_equal(buf, "4294967295", 10U);
+
+    /* Against the C library in a range with all the digit counts */
+    uint32_t val = 0UL;
+    for(val = 1UL; val < (UINT32_MAX / 3UL); val = (val * 3UL) + 7UL)
+    {
+        char exp[16] = {0};
+        int exp_len = snprintf(exp, sizeof(exp), "%lu", (unsigned long)val);
+
+        assert_int_equal(fmt_uint(buf, val), exp_len);
+        assert_memory_equal(buf, exp, exp_len);
+    }
+}
+
+static void fmt_int_test(void **state)
+{
+    char buf[FMT_INT_MAX_LEN + 1U] = {0};
+
+    assert_int_equal(fmt_int(buf, 0L), 1U);
+    assert_memory_equal(buf, "0", 1U);
+
+    assert_int_equal(fmt_int(buf, -1L), 2U);
+    assert_memory_equal(buf, "-1", 2U);
+
+    assert_int_equal(fmt_int(buf, INT32_MAX), 10U);
+    assert_memory_equal(buf, "2147483647", 10U);
+
+    assert_int_equal(fmt_int(buf, INT32_MIN), 11U);
+    assert_memory_equal(buf, "-2147483648", 11U);
+}
+
+static void fmt_hex_test(void **state)
+{
+    char buf[FMT_HEX_MAX_LEN + 1U] = {0};
+
+    assert_int_equal(fmt_hex(buf, 0UL), 4U);
+    assert_memory_equal(buf, "0x00", 4U);
+
+    assert_int_equal(fmt_hex(buf, 0x65UL), 4U);
+    assert_memory_equal(buf, "0x65", 4U);
+
+    assert_int_equal(fmt_hex(buf, 0x1ABUL), 6U);
+    assert_memory_equal(buf, "0x01AB", 6U);
+
+    assert_int_equal(fmt_hex(buf, 0x10000UL), 8U);
+    assert_memory_equal(buf, "0x010000", 8U);
+
+    assert_int_equal(fmt_hex(buf, 0xDEADBEEFUL), 10U);
+    assert_memory_equal(buf, "0xDEADBEEF", 10U);
+}
+
+static void fmt_q_test(void **state)
+{
+    char buf[FMT_Q_MAX_LEN + 1U] = {0};
+
+    /* 411/256 = 1.60546875 */
+    assert_int_equal(fmt_q(buf, 411L, 8U, 3U), 5U);
+    assert_memory_equal(buf, "1.605", 5U);
+
+    assert_int_equal(fmt_q(buf, -411L, 8U, 8U), 11U);
+    assert_memory_equal(buf, "-1.60546875", 11U);
+
+    /* No decimal places */
+    assert_int_equal(fmt_q(buf, 411L, 8U, 0U), 1U);
+    assert_memory_equal(buf, "1", 1U);
+
+    /* Integer (Q0) */
+    assert_int_equal(fmt_q(buf, -25L, 0U, 2U), 6U);
+    assert_memory_equal(buf, "-25.00", 6U);
+
+    /* Q28: 0.5 */
+    assert_int_equal(fmt_q(buf, 1L << 27, 28U, 2U), 4U);
+    assert_memory_equal(buf, "0.50", 4U);
+
+    /* Q15 extremes */
+    assert_int_equal(fmt_q(buf, INT32_MIN, 15U, 1U), 8U);
+    assert_memory_equal(buf, "-65536.0", 8U);
+}
+
+int main(void)
+{
+    const struct CMUnitTest fmt_tests[] = {
+        cmocka_unit_test(fmt_uint_test),
+        cmocka_unit_test(fmt_int_test),
+        cmocka_unit_test(fmt_hex_test),
+        cmocka_unit_test(fmt_q_test),
+    };
+
+    return cmocka_run_group_tests(fmt_tests, NULL, NULL);
+}
+
+/** \} End of fmt_unit_test group */
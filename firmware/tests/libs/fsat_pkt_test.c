@@ -0,0 +1,202 @@
+/*
+ * fsat_pkt_test.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Unit test of the FloripaSat packet builder and view.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.2
+ *
+ * \date 2022/11/21
+ *
+ * \defgroup fsat_pkt_unit_test FSat Packet
+ * \ingroup tests
+ * \{
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <float.h>
+#include <cmocka.h>
+
+#include <string.h>
+
+#include <fsat_pkt/fsat_pkt.h>
+
+static void fsat_pkt_builder_init_test(void **state)
+{
+    uint8_t buf[FSAT_PKT_MAX_LEN] = {0};
+    fsat_pkt_builder_t b = {0};
+    uint16_t len = 0;
+
+    /* Callsign shorter than the field: left padded */
+    assert_return_code(fsat_pkt_builder_init(&b, buf, sizeof(buf), 0x42U, "PY0EFS"), 0);
+    assert_return_code(fsat_pkt_builder_finish(&b, &len), 0);
+
+    assert_int_equal(len, FSAT_PKT_HEADER_LEN);
+    assert_int_equal(buf[0], 0x42U);
+    assert_memory_equal(&buf[1], " PY0EFS", FSAT_PKT_CALLSIGN_LEN);
+
+    /* Callsign longer than the field */
+    assert_int_equal(fsat_pkt_builder_init(&b, buf, sizeof(buf), 0x42U, "PY0EFS00"), -1);
+    assert_int_equal(fsat_pkt_builder_finish(&b, &len), -1);
+
+    /* Buffer smaller than the header */
+    assert_int_equal(fsat_pkt_builder_init(&b, buf, FSAT_PKT_HEADER_LEN - 1U, 0x42U, "PY0EFS"), -1);
+}
+
+static void fsat_pkt_builder_put_test(void **state)
+{
+    uint8_t buf[FSAT_PKT_MAX_LEN] = {0};
+    fsat_pkt_builder_t b = {0};
+    uint16_t len = 0;
+
+    const uint8_t data[3] = {0xAAU, 0xBBU, 0xCCU};
+    const uint8_t cs[5] = {'P', 'P', '5', 'U', 'F'};
+
+    const uint8_t res[] = {0x01U, ' ', 'P', 'Y', '0', 'E', 'F', 'S',
+                           0x12U,
+                           0x34U, 0x56U,
+                           0x01U, 0x02U, 0x03U, 0x04U,
+                           0xAAU, 0xBBU, 0xCCU,
+                           ' ', ' ', 'P', 'P', '5', 'U', 'F'};
+
+    assert_return_code(fsat_pkt_builder_init(&b, buf, sizeof(buf), 0x01U, "PY0EFS"), 0);
+
+    fsat_pkt_builder_put_u8(&b, 0x12U);
+    fsat_pkt_builder_put_u16(&b, 0x3456U);
+    fsat_pkt_builder_put_u32(&b, 0x01020304UL);
+    fsat_pkt_builder_put_bytes(&b, data, sizeof(data));
+    fsat_pkt_builder_put_callsign(&b, cs, sizeof(cs));
+
+    assert_return_code(fsat_pkt_builder_finish(&b, &len), 0);
+    assert_int_equal(len, sizeof(res));
+    assert_memory_equal(buf, res, sizeof(res));
+}
+
+static void fsat_pkt_builder_overflow_test(void **state)
+{
+    uint8_t buf[FSAT_PKT_HEADER_LEN + 4U + 1U] = {0};
+    fsat_pkt_builder_t b = {0};
+    uint16_t len = 0;
+
+    assert_return_code(fsat_pkt_builder_init(&b, buf, sizeof(buf) - 1U, 0x01U, "PY0EFS"), 0);
+
+    fsat_pkt_builder_put_u32(&b, 0xDEADBEEFUL);
+
+    assert_return_code(fsat_pkt_builder_finish(&b, &len), 0);
+    assert_int_equal(len, FSAT_PKT_HEADER_LEN + 4U);
+
+    /* Nothing is written past the given size, and the error is sticky */
+    fsat_pkt_builder_put_u8(&b, 0x55U);
+    fsat_pkt_builder_put_bytes(&b, (const uint8_t*)"", 0U);
+
+    assert_int_equal(fsat_pkt_builder_finish(&b, &len), -1);
+    assert_int_equal(buf[sizeof(buf) - 1U], 0U);
+
+    /* Callsign field that does not fit */
+    assert_return_code(fsat_pkt_builder_init(&b, buf, FSAT_PKT_HEADER_LEN + 6U, 0x01U, "PY0EFS"), 0);
+
+    fsat_pkt_builder_put_callsign(&b, (const uint8_t*)"PY0EFS", 6U);
+
+    assert_int_equal(fsat_pkt_builder_finish(&b, &len), -1);
+
+    /* Callsign longer than the field */
+    assert_return_code(fsat_pkt_builder_init(&b, buf, sizeof(buf), 0x01U, "PY0EFS"), 0);
+
+    fsat_pkt_builder_put_callsign(&b, (const uint8_t*)"PY0EFS00", 8U);
+
+    assert_int_equal(fsat_pkt_builder_finish(&b, &len), -1);
+}
+
+static void fsat_pkt_view_test(void **state)
+{
+    const uint8_t raw[] = {0x0AU, ' ', ' ', 'P', 'P', '5', 'U', 'F', 0x01U, 0x02U, 0x03U};
+
+    fsat_pkt_view_t view = {0};
+
+    assert_return_code(fsat_pkt_view(raw, sizeof(raw), &view), 0);
+
+    assert_ptr_equal(view.raw, raw);
+    assert_int_equal(view.id, 0x0AU);
+    assert_int_equal(view.callsign_len, 5U);
+    assert_memory_equal(view.callsign, "PP5UF", 5U);
+    assert_ptr_equal(view.payload, &raw[FSAT_PKT_HEADER_LEN]);
+    assert_int_equal(view.length, 3U);
+
+    /* Header only */
+    assert_return_code(fsat_pkt_view(raw, FSAT_PKT_HEADER_LEN, &view), 0);
+    assert_int_equal(view.length, 0U);
+
+    /* Truncated header */
+    assert_int_equal(fsat_pkt_view(raw, FSAT_PKT_HEADER_LEN - 1U, &view), -1);
+}
+
+static void fsat_pkt_builder_view_test(void **state)
+{
+    const uint8_t raw[] = {0x0AU, ' ', ' ', 'P', 'P', '5', 'U', 'F', 0x01U, 0x02U};
+
+    fsat_pkt_view_t view = {0};
+
+    assert_return_code(fsat_pkt_view(raw, sizeof(raw), &view), 0);
+
+    /* Answer with the requester callsign and the payload of the request */
+    uint8_t buf[FSAT_PKT_MAX_LEN] = {0};
+    fsat_pkt_builder_t b = {0};
+    uint16_t len = 0;
+
+    assert_return_code(fsat_pkt_builder_init(&b, buf, sizeof(buf), 0x0BU, "PY0EFS"), 0);
+
+    fsat_pkt_builder_put_callsign(&b, view.callsign, view.callsign_len);
+    fsat_pkt_builder_put_bytes(&b, view.payload, view.length);
+
+    assert_return_code(fsat_pkt_builder_finish(&b, &len), 0);
+    assert_int_equal(len, FSAT_PKT_HEADER_LEN + FSAT_PKT_CALLSIGN_LEN + 2U);
+    assert_memory_equal(&buf[FSAT_PKT_HEADER_LEN], &raw[1], FSAT_PKT_CALLSIGN_LEN + 2U);
+
+    /* The answer is parsed back */
+    fsat_pkt_view_t ans = {0};
+
+    assert_return_code(fsat_pkt_view(buf, len, &ans), 0);
+    assert_int_equal(ans.id, 0x0BU);
+    assert_int_equal(ans.callsign_len, 6U);
+    assert_memory_equal(ans.callsign, "PY0EFS", 6U);
+    assert_int_equal(ans.length, FSAT_PKT_CALLSIGN_LEN + 2U);
+}
+
+int main(void)
+{
+    const struct CMUnitTest fsat_pkt_tests[] = {
+        cmocka_unit_test(fsat_pkt_builder_init_test),
+        cmocka_unit_test(fsat_pkt_builder_put_test),
+        cmocka_unit_test(fsat_pkt_builder_overflow_test),
+        cmocka_unit_test(fsat_pkt_view_test),
+        cmocka_unit_test(fsat_pkt_builder_view_test),
+    };
+
+    return cmocka_run_group_tests(fsat_pkt_tests, NULL, NULL);
+}
+
+/** \} End of fsat_pkt_unit_test group */
@@ -0,0 +1,167 @@
+/*
+ * ring_benchmark.c
+ * 
+ * Copyright The OBDH 2.0 Contributors.
+ * 
+ * This file is part of OBDH 2.0.
+ * 
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief Host benchmark of the ring buffer against the byte queue.
+ *
+ * Each case moves the same amount of data through a container, in chunks of a given size
+ * (as the UART RX buffer is drained), and reports the average time per byte.
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 0.10.11
+ * 
+ * \date 2022/11/29
+ * 
+ * \defgroup ring_benchmark Ring benchmark
+ * \ingroup tests
+ * \{
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <time.h>
+
+#include <libs/containers/queue.h>
+#include <libs/containers/ring.h>
+
+#define RING_BENCHMARK_BYTES        (16UL*1024UL*1024UL)    /**< Bytes moved in each case. */
+#define RING_BENCHMARK_CAPACITY     256U
+
+RING_DEFINE(bench_ring, RING_BENCHMARK_CAPACITY);
+
+static queue_t bench_queue;
+
+static volatile uint8_t bench_sink = 0U;
+
+/**
+ * \brief Gets the current time in nanoseconds.
+ *
+ * \return The current (monotonic) time in nanoseconds.
+ */
+static uint64_t ring_benchmark_now_ns(void);
+
+/**
+ * \brief Byte queue, pushed and popped byte by byte.
+ *
+ * \param[in] chunk is the number of bytes pushed before draining the queue.
+ *
+ * \return The elapsed time in nanoseconds.
+ */
+static uint64_t ring_benchmark_queue(uint16_t chunk);
+
+/**
+ * \brief Ring, pushed byte by byte (as by the ISR) and drained with a single pop_n.
+ *
+ * \param[in] chunk is the number of bytes pushed before draining the ring.
+ *
+ * \return The elapsed time in nanoseconds.
+ */
+static uint64_t ring_benchmark_ring(uint16_t chunk);
+
+int main(void)
+{
+    const uint16_t chunks[] = {1U, 16U, 64U, 128U};
+
+    printf("Moving %lu bytes in each case (ns/byte)\n\n", RING_BENCHMARK_BYTES);
+    printf("%8s %12s %12s %10s\n", "chunk", "queue", "ring", "speedup");
+
+    unsigned int i = 0;
+    for(i = 0; i < (sizeof(chunks) / sizeof(chunks[0])); i++)
+    {
+        double t_queue  = (double)ring_benchmark_queue(chunks[i]) / RING_BENCHMARK_BYTES;
+        double t_ring   = (double)ring_benchmark_ring(chunks[i]) / RING_BENCHMARK_BYTES;
+
+        printf("%8u %12.3f %12.3f %9.2fx\n", chunks[i], t_queue, t_ring, t_queue / t_ring);
+    }
+
+    return 0;
+}
+
+static uint64_t ring_benchmark_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t ring_benchmark_queue(uint16_t chunk)
+{
+    uint8_t buf[RING_BENCHMARK_CAPACITY] = {0};
+
+    queue_init(&bench_queue);
+
+    uint64_t start = ring_benchmark_now_ns();
+
+    unsigned long moved = 0UL;
+    while(moved < RING_BENCHMARK_BYTES)
+    {
+        uint16_t i = 0U;
+        for(i = 0U; i < chunk; i++)
+        {
+            queue_push_back(&bench_queue, (uint8_t)i);
+        }
+
+        /* Same loop as the original UART RX read */
+        for(i = 0U; i < chunk; i++)
+        {
+            buf[i] = queue_pop_front(&bench_queue);
+        }
+
+        bench_sink ^= buf[chunk - 1U];
+
+        moved += chunk;
+    }
+
+    return ring_benchmark_now_ns() - start;
+}
+
+static uint64_t ring_benchmark_ring(uint16_t chunk)
+{
+    uint8_t buf[RING_BENCHMARK_CAPACITY] = {0};
+
+    ring_clear(&bench_ring);
+
+    uint64_t start = ring_benchmark_now_ns();
+
+    unsigned long moved = 0UL;
+    while(moved < RING_BENCHMARK_BYTES)
+    {
+        uint16_t i = 0U;
+        for(i = 0U; i < chunk; i++)
+        {
+            ring_push(&bench_ring, (uint8_t)i);
+        }
+
+        (void)ring_pop_n(&bench_ring, buf, chunk);
+
+        bench_sink ^= buf[chunk - 1U];
+
+        moved += chunk;
+    }
+
+    return ring_benchmark_now_ns() - start;
+}
+
+/** \} End of ring_benchmark group */
@@ -0,0 +1,238 @@
+/*
+ * ring_test.c
+ * 
+ * Copyright The OBDH 2.0 Contributors.
+ * 
+ * This file is part of OBDH 2.0.
+ * 
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http://www.gnu.org/licenses/>.
+ * 
+ */
+
+/**
+ * \brief Unit test of the ring buffer.
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 0.10.11
+ * 
+ * \date 2022/11/29
+ * 
+ * \defgroup ring_unit_test Ring
+ * \ingroup tests
+ * \{
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <setjmp.h>
+#include <float.h>
+#include <cmocka.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <libs/containers/ring.h>
+
+#define RING_TEST_CAPACITY      64U
+
+RING_DEFINE(ring_test_ring, RING_TEST_CAPACITY);
+
+unsigned int generate_random(unsigned int l, unsigned int r);
+
+static void ring_init_test(void **state)
+{
+    uint8_t storage[100] = {0};
+    ring_t ring;
+
+    /* Only powers of two are accepted */
+    assert_int_equal(ring_init(&ring, storage, 0U), -1);
+    assert_int_equal(ring_init(&ring, storage, 100U), -1);
+    assert_int_equal(ring_init(&ring, storage, 48U), -1);
+
+    assert_return_code(ring_init(&ring, storage, 64U), 0);
+    assert_int_equal(ring_capacity(&ring), 64U);
+    assert_int_equal(ring_size(&ring), 0U);
+    assert_int_equal(ring_free(&ring), 64U);
+    assert_true(ring_empty(&ring));
+    assert_false(ring_full(&ring));
+
+    assert_return_code(ring_init(&ring, storage, 1U), 0);
+    assert_int_equal(ring_capacity(&ring), 1U);
+
+    /* Compile-time definition */
+    assert_int_equal(ring_capacity(&ring_test_ring), RING_TEST_CAPACITY);
+}
+
+static void ring_push_pop_test(void **state)
+{
+    ring_clear(&ring_test_ring);
+
+    uint8_t byte = 0U;
+
+    assert_false(ring_pop(&ring_test_ring, &byte));
+
+    uint16_t i = 0U;
+    for(i = 0U; i < RING_TEST_CAPACITY; i++)
+    {
+        assert_true(ring_push(&ring_test_ring, (uint8_t)i));
+    }
+
+    /* No space left (all the positions are usable) */
+    assert_true(ring_full(&ring_test_ring));
+    assert_false(ring_push(&ring_test_ring, 0xAAU));
+    assert_int_equal(ring_size(&ring_test_ring), RING_TEST_CAPACITY);
+
+    for(i = 0U; i < RING_TEST_CAPACITY; i++)
+    {
+        assert_true(ring_pop(&ring_test_ring, &byte));
+        assert_int_equal(byte, (uint8_t)i);
+    }
+
+    assert_true(ring_empty(&ring_test_ring));
+    assert_false(ring_pop(&ring_test_ring, &byte));
+}
+
+static void ring_push_n_pop_n_test(void **state)
+{
+    ring_clear(&ring_test_ring);
+
+    uint8_t wd[RING_TEST_CAPACITY] = {0};
+    uint8_t rd[RING_TEST_CAPACITY] = {0};
+
+    uint16_t i = 0U;
+    for(i = 0U; i < RING_TEST_CAPACITY; i++)
+    {
+        wd[i] = generate_random(0, UINT8_MAX);
+    }
+
+    /* Moves the indexes close to the end of the storage */
+    assert_int_equal(ring_push_n(&ring_test_ring, wd, 50U), 50U);
+    assert_int_equal(ring_pop_n(&ring_test_ring, rd, 50U), 50U);
+    assert_memory_equal(rd, wd, 50U);
+
+    /* Wrap-around in both directions */
+    assert_int_equal(ring_push_n(&ring_test_ring, wd, 40U), 40U);
+    assert_int_equal(ring_size(&ring_test_ring), 40U);
+
+    memset(rd, 0, sizeof(rd));
+    assert_int_equal(ring_pop_n(&ring_test_ring, rd, 40U), 40U);
+    assert_memory_equal(rd, wd, 40U);
+
+    /* Partial push when the ring gets full */
+    assert_int_equal(ring_push_n(&ring_test_ring, wd, 30U), 30U);
+    assert_int_equal(ring_push_n(&ring_test_ring, &wd[30], 60U), RING_TEST_CAPACITY - 30U);
+    assert_true(ring_full(&ring_test_ring));
+    assert_int_equal(ring_push_n(&ring_test_ring, wd, 1U), 0U);
+
+    /* Partial pop when the ring gets empty */
+    memset(rd, 0, sizeof(rd));
+    assert_int_equal(ring_pop_n(&ring_test_ring, rd, 10U), 10U);
+    assert_int_equal(ring_pop_n(&ring_test_ring, &rd[10], 200U), RING_TEST_CAPACITY - 10U);
+    assert_memory_equal(rd, wd, RING_TEST_CAPACITY);
+    assert_int_equal(ring_pop_n(&ring_test_ring, rd, 1U), 0U);
+}
+
+static void ring_random_test(void **state)
+{
+    ring_clear(&ring_test_ring);
+
+    /* Compares the ring against a plain FIFO model */
+    uint8_t model[4096] = {0};
+    uint16_t model_in = 0U;
+    uint16_t model_out = 0U;
+
+    uint8_t buf[RING_TEST_CAPACITY + 8U] = {0};
+
+    uint16_t i = 0U;
+    for(i = 0U; i < 2000U; i++)
+    {
+        uint16_t len = generate_random(0, RING_TEST_CAPACITY + 8U);
+
+        if (generate_random(0, 1) == 1U)
+        {
+            uint16_t j = 0U;
+            for(j = 0U; j < len; j++)
+            {
+                buf[j] = generate_random(0, UINT8_MAX);
+            }
+
+            uint16_t pushed = ring_push_n(&ring_test_ring, buf, len);
+
+            uint16_t expected = RING_TEST_CAPACITY - (model_in - model_out);
+            expected = (len < expected) ? len : expected;
+
+            assert_int_equal(pushed, expected);
+
+            for(j = 0U; j < pushed; j++)
+            {
+                model[model_in % sizeof(model)] = buf[j];
+                model_in++;
+            }
+        }
+        else
+        {
+            uint16_t popped = ring_pop_n(&ring_test_ring, buf, len);
+
+            uint16_t expected = model_in - model_out;
+            expected = (len < expected) ? len : expected;
+
+            assert_int_equal(popped, expected);
+
+            uint16_t j = 0U;
+            for(j = 0U; j < popped; j++)
+            {
+                assert_int_equal(buf[j], model[model_out % sizeof(model)]);
+                model_out++;
+            }
+        }
+
+        assert_int_equal(ring_size(&ring_test_ring), model_in - model_out);
+    }
+}
+
+static void ring_clear_test(void **state)
+{
+    ring_clear(&ring_test_ring);
+
+    uint8_t wd[10] = {0};
+
+    assert_int_equal(ring_push_n(&ring_test_ring, wd, 10U), 10U);
+
+    ring_clear(&ring_test_ring);
+
+    assert_true(ring_empty(&ring_test_ring));
+    assert_int_equal(ring_free(&ring_test_ring), RING_TEST_CAPACITY);
+}
+
+int main(void)
+{
+    const struct CMUnitTest ring_tests[] = {
+        cmocka_unit_test(ring_init_test),
+        cmocka_unit_test(ring_push_pop_test),
+        cmocka_unit_test(ring_push_n_pop_n_test),
+        cmocka_unit_test(ring_random_test),
+        cmocka_unit_test(ring_clear_test),
+    };
+
+    return cmocka_run_group_tests(ring_tests, NULL, NULL);
+}
+
+unsigned int generate_random(unsigned int l, unsigned int r)
+{
+    return (rand() % (r - l + 1)) + l;
+}
+
+/** \} End of ring_unit_test group */
@@ -0,0 +1,7 @@
+#!/bin/bash
+
+./ring_unit_test
+./bus_stats_unit_test
+./cpu_stats_unit_test
+./fmt_unit_test
+./fsat_pkt_unit_test
@@ -41,6 +41,8 @@
 #include <float.h>
 #include <cmocka.h>
 
+#include <string.h>
+
 #include "ttc_wrap.h"
 
 int __wrap_ttc_init(ttc_e dev)
@@ -70,14 +72,18 @@ int __wrap_ttc_recv(ttc_e dev, uint8_t *data, uint16_t *len)
 {
     check_expected(dev);
 
-    if (data != NULL)
+    /* The mock value is a pointer to the received bytes, followed by their number */
+    uint8_t *mock_data = mock_ptr_type(uint8_t*);
+    uint16_t mock_len = mock_type(uint16_t);
+
+    if ((data != NULL) && (mock_data != NULL))
     {
-        *data = mock_ptr_type(uint8_t*);
+        memcpy(data, mock_data, mock_len);
     }
 
     if (len != NULL)
     {
-        *len = mock_type(uint16_t);
+        *len = mock_len;
     }
 
     return mock_type(int);
@@ -104,4 +110,16 @@ int __wrap_ttc_leave_hibernation(ttc_e dev)
     return mock_type(int);
 }
 
+int __wrap_ttc_get_tx_fifo_pkts(ttc_e dev, uint8_t *pkts)
+{
+    check_expected(dev);
+
+    if (pkts != NULL)
+    {
+        *pkts = mock_type(uint8_t);
+    }
+
+    return mock_type(int);
+}
+
 /** \} End of ttc_wrap group */
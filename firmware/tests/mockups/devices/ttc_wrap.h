@@ -55,6 +55,8 @@ int __wrap_ttc_enter_hibernation(ttc_e dev);
 
 int __wrap_ttc_leave_hibernation(ttc_e dev);
 
+int __wrap_ttc_get_tx_fifo_pkts(ttc_e dev, uint8_t *pkts);
+
 #endif /* TTC_WRAP_H_ */
 
 /** \} End of ttc_wrap group */
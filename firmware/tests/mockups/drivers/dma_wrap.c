@@ -0,0 +1,123 @@
+/*
+ * dma_wrap.c
+ * 
+ * Copyright The OBDH 2.0 Contributors.
+ * 
+ * This file is part of OBDH 2.0.
+ * 
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ * 
+ */
+
+
+/**
+ * \brief DMA driver wrap implementation.
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 0.10.8
+ * 
+ * \date 2022/11/26
+ * 
+ * \addtogroup dma_wrap
+ * \{
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <setjmp.h>
+#include <float.h>
+#include <cmocka.h>
+
+#include "dma_wrap.h"
+
+/**
+ * \brief Emulated channel configuration.
+ */
+typedef struct
+{
+    dma_ch_t ch;
+    uint8_t *mem;
+    bool inc;
+    uint16_t len;
+    dma_callback_t cb;
+} dma_wrap_ch_t;
+
+static dma_wrap_ch_t dma_wrap_rx = {0};
+static dma_wrap_ch_t dma_wrap_tx = {0};
+
+int __wrap_dma_config_rx(dma_ch_t ch, dma_periph_t periph, uint8_t *dst, bool inc, uint16_t len, dma_callback_t cb)
+{
+    check_expected(ch);
+    check_expected(periph);
+    check_expected(inc);
+    check_expected(len);
+
+    dma_wrap_rx.ch  = ch;
+    dma_wrap_rx.mem = dst;
+    dma_wrap_rx.inc = inc;
+    dma_wrap_rx.len = len;
+    dma_wrap_rx.cb  = cb;
+
+    return mock_type(int);
+}
+
+int __wrap_dma_config_tx(dma_ch_t ch, dma_periph_t periph, uint8_t *src, bool inc, uint16_t len, dma_callback_t cb)
+{
+    check_expected(ch);
+    check_expected(periph);
+    check_expected(inc);
+    check_expected(len);
+
+    dma_wrap_tx.ch  = ch;
+    dma_wrap_tx.mem = src;
+    dma_wrap_tx.inc = inc;
+    dma_wrap_tx.len = len;
+    dma_wrap_tx.cb  = cb;
+
+    return mock_type(int);
+}
+
+int __wrap_dma_start_tx(dma_periph_t periph)
+{
+    check_expected(periph);
+
+    /* TRUE if the transfer completes (FALSE to emulate a stuck transfer) */
+    if (mock_type(bool))
+    {
+        uint16_t i = 0;
+        for(i = 0; i < dma_wrap_tx.len; i++)
+        {
+            dma_wrap_rx.mem[dma_wrap_rx.inc ? i : 0] = dma_wrap_tx.mem[dma_wrap_tx.inc ? i : 0];
+        }
+
+        if (dma_wrap_rx.cb != NULL)
+        {
+            dma_wrap_rx.cb(dma_wrap_rx.ch);
+        }
+    }
+
+    return mock_type(int);
+}
+
+int __wrap_dma_stop(dma_ch_t ch)
+{
+    check_expected(ch);
+
+    return 0;
+}
+
+/** \} End of dma_wrap group */
@@ -0,0 +1,59 @@
+/*
+ * dma_wrap.h
+ * 
+ * Copyright The OBDH 2.0 Contributors.
+ * 
+ * This file is part of OBDH 2.0.
+ * 
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http:/\/www.gnu.org/licenses/>.
+ * 
+ */
+
+
+/**
+ * \brief DMA driver wrap definition.
+ *
+ * The wrap emulates a DMA engine connected to a SPI peripheral in loopback: when the
+ * transmission is started, the TX channel bytes are copied to the RX channel destination.
+ * 
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ * 
+ * \version 0.10.8
+ * 
+ * \date 2022/11/26
+ * 
+ * \defgroup dma_wrap DMA Wrap
+ * \ingroup tests
+ * \{
+ */
+
+#ifndef DMA_WRAP_H_
+#define DMA_WRAP_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include <drivers/dma/dma.h>
+
+int __wrap_dma_config_rx(dma_ch_t ch, dma_periph_t periph, uint8_t *dst, bool inc, uint16_t len, dma_callback_t cb);
+
+int __wrap_dma_config_tx(dma_ch_t ch, dma_periph_t periph, uint8_t *src, bool inc, uint16_t len, dma_callback_t cb);
+
+int __wrap_dma_start_tx(dma_periph_t periph);
+
+int __wrap_dma_stop(dma_ch_t ch);
+
+#endif /* DMA_WRAP_H_ */
+
+/** \} End of dma_wrap group */
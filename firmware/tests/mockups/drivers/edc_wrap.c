@@ -342,6 +342,26 @@ int16_t __wrap_edc_get_adc_seq(edc_config_t config, uint8_t *seq)
     return mock_type(int16_t);
 }
 
+int16_t __wrap_edc_get_adc_seq_stream(edc_config_t config, uint8_t *chunk, uint16_t chunk_len, edc_stream_cb_t cb, void *arg)
+{
+    check_expected(config.interface);
+    check_expected(config.en_pin);
+
+    if (config.interface == EDC_IF_UART)
+    {
+        check_expected(config.uart_port);
+    }
+    else if (config.interface == EDC_IF_I2C)
+    {
+        check_expected(config.i2c_port);
+        check_expected(config.i2c_bitrate);
+    }
+
+    check_expected(chunk_len);
+
+    return mock_type(int16_t);
+}
+
 int __wrap_edc_echo(edc_config_t config)
 {
     check_expected(config.interface);
@@ -71,6 +71,8 @@ int16_t __wrap_edc_get_hk_pkg(edc_config_t config, uint8_t *hk);
 
 int16_t __wrap_edc_get_adc_seq(edc_config_t config, uint8_t *seq);
 
+int16_t __wrap_edc_get_adc_seq_stream(edc_config_t config, uint8_t *chunk, uint16_t chunk_len, edc_stream_cb_t cb, void *arg);
+
 int __wrap_edc_echo(edc_config_t config);
 
 uint16_t __wrap_edc_calc_checksum(uint8_t *data, uint16_t len);
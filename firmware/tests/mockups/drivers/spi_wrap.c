@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.7.10
+ * \version 0.10.17
  * 
  * \date 2021/08/25
  * 
@@ -52,6 +52,16 @@ int __wrap_spi_init(spi_port_t port, spi_config_t config)
     return mock_type(int);
 }
 
+int __wrap_spi_init_device(spi_port_t port, spi_cs_t cs, spi_config_t config)
+{
+    check_expected(port);
+    check_expected(cs);
+    check_expected(config.speed_hz);
+    check_expected(config.mode);
+
+    return mock_type(int);
+}
+
 int __wrap_spi_select_slave(spi_port_t port, spi_cs_t cs, bool active)
 {
     check_expected(port);
@@ -25,7 +25,7 @@
  * 
  * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
  * 
- * \version 0.7.8
+ * \version 0.10.17
  * 
  * \date 2021/08/25
  * 
@@ -43,6 +43,8 @@
 
 int __wrap_spi_init(spi_port_t port, spi_config_t config);
 
+int __wrap_spi_init_device(spi_port_t port, spi_cs_t cs, spi_config_t config);
+
 int __wrap_spi_select_slave(spi_port_t port, spi_cs_t cs, bool active);
 
 int __wrap_spi_write(spi_port_t port, spi_cs_t cs, uint8_t *data, uint16_t len);
@@ -58,6 +58,16 @@ void __wrap_sys_log_print_event_from_module(uint8_t type, const char *module, co
     return;
 }
 
+void __wrap_sys_log_deferred(uint8_t type, uint8_t module, uint16_t token, uint32_t arg0, uint32_t arg1)
+{
+    return;
+}
+
+int __wrap_sys_log_black_box_init(void)
+{
+    return 0;
+}
+
 void __wrap_sys_log_print_msg(const char *msg)
 {
     return;
@@ -73,6 +83,11 @@ void __wrap_sys_log_new_line(void)
     return;
 }
 
+void __wrap_sys_log_flush(void)
+{
+    return;
+}
+
 void __wrap_sys_log_print_uint(uint32_t uint)
 {
     return;
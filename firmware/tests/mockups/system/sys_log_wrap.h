@@ -45,12 +45,18 @@ void __wrap_sys_log_print_event(uint8_t type, const char *event);
 
 void __wrap_sys_log_print_event_from_module(uint8_t type, const char *module, const char *event);
 
+void __wrap_sys_log_deferred(uint8_t type, uint8_t module, uint16_t token, uint32_t arg0, uint32_t arg1);
+
+int __wrap_sys_log_black_box_init(void);
+
 void __wrap_sys_log_print_msg(const char *msg);
 
 void __wrap_sys_log_print_str(char *str);
 
 void __wrap_sys_log_new_line(void);
 
+void __wrap_sys_log_flush(void);
+
 void __wrap_sys_log_print_uint(uint32_t uint);
 
 void __wrap_sys_log_print_int(int32_t sint);
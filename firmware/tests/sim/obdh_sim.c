@@ -0,0 +1,242 @@
+/*
+ * obdh_sim.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Host environment of the OBDH tasks implementation.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.25
+ *
+ * \date 2022/12/20
+ *
+ * \addtogroup obdh_sim
+ * \{
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+#include <event_groups.h>
+
+#include <system/system.h>
+#include <devices/media/media.h>
+#include <devices/payload/payload.h>
+#include <structs/satellite.h>
+#include <structs/beacon_frame.h>
+#include <structs/params.h>
+#include <structs/payload_data.h>
+
+#include "sl_ttc2_emu.h"
+#include "obdh_sim.h"
+
+sat_data_t sat_data_buf = {0};
+
+EventGroupHandle_t task_startup_status = NULL;
+
+static uint8_t obdh_sim_nor[OBDH_SIM_NOR_SIZE];
+static uint8_t obdh_sim_fram[OBDH_SIM_FRAM_SIZE];
+
+int obdh_sim_init(void)
+{
+    memset(obdh_sim_nor, 0xFF, sizeof(obdh_sim_nor));
+    memset(obdh_sim_fram, 0x00, sizeof(obdh_sim_fram));
+
+    return payload_data_init();
+}
+
+/* FreeRTOS (on the simulated clock) */
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)(sl_ttc2_emu_time_us() / 1000ULL);
+}
+
+void vTaskDelay(const TickType_t xTicksToDelay)
+{
+    sl_ttc2_delay_ms(xTicksToDelay);
+}
+
+void vTaskDelayUntil(TickType_t *pxPreviousWakeTime, TickType_t xTimeIncrement)
+{
+    TickType_t now = xTaskGetTickCount();
+
+    *pxPreviousWakeTime += xTimeIncrement;
+
+    if ((TickType_t)(*pxPreviousWakeTime - now) <= xTimeIncrement)
+    {
+        vTaskDelay(*pxPreviousWakeTime - now);
+    }
+}
+
+EventBits_t xEventGroupWaitBits(EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToWaitFor, const BaseType_t xClearOnExit, const BaseType_t xWaitForAllBits, TickType_t xTicksToWait)
+{
+    return uxBitsToWaitFor;     /* The startup is always done */
+}
+
+/* System */
+
+void system_reset(void)
+{
+    fprintf(stderr, "OBDH: system reset requested (ignored)\n");
+}
+
+sys_time_t system_get_time(void)
+{
+    return (sys_time_t)(sl_ttc2_emu_time_us() / 1000000ULL);
+}
+
+/* Memories */
+
+int media_init(media_t med)
+{
+    return 0;
+}
+
+int media_write(media_t med, uint32_t adr, uint8_t *data, uint16_t len)
+{
+    int err = -1;
+
+    if ((med == MEDIA_NOR) && (((uint64_t)adr + len) <= OBDH_SIM_NOR_SIZE))
+    {
+        /* A NOR write can only clear bits */
+        uint16_t i = 0;
+        for(i = 0; i < len; i++)
+        {
+            obdh_sim_nor[adr + i] &= data[i];
+        }
+
+        err = 0;
+    }
+    else if ((med == MEDIA_FRAM) && (((uint64_t)adr + len) <= OBDH_SIM_FRAM_SIZE))
+    {
+        memcpy(&obdh_sim_fram[adr], data, len);
+
+        err = 0;
+    }
+    else
+    {
+        /* Invalid memory or address */
+    }
+
+    return err;
+}
+
+int media_read(media_t med, uint32_t adr, uint8_t *data, uint16_t len)
+{
+    int err = -1;
+
+    if ((med == MEDIA_NOR) && (((uint64_t)adr + len) <= OBDH_SIM_NOR_SIZE))
+    {
+        memcpy(data, &obdh_sim_nor[adr], len);
+
+        err = 0;
+    }
+    else if ((med == MEDIA_FRAM) && (((uint64_t)adr + len) <= OBDH_SIM_FRAM_SIZE))
+    {
+        memcpy(data, &obdh_sim_fram[adr], len);
+
+        err = 0;
+    }
+    else
+    {
+        /* Invalid memory or address */
+    }
+
+    return err;
+}
+
+int media_erase(media_t med, media_erase_t type, uint32_t sector)
+{
+    int err = -1;
+
+    if (med == MEDIA_NOR)
+    {
+        switch(type)
+        {
+            case MEDIA_ERASE_DIE:
+                memset(obdh_sim_nor, 0xFF, sizeof(obdh_sim_nor));
+
+                err = 0;
+
+                break;
+            case MEDIA_ERASE_SUB_SECTOR:
+                if (sector < (OBDH_SIM_NOR_SIZE / OBDH_SIM_NOR_SUB_SECTOR_SIZE))
+                {
+                    memset(&obdh_sim_nor[sector * OBDH_SIM_NOR_SUB_SECTOR_SIZE], 0xFF, OBDH_SIM_NOR_SUB_SECTOR_SIZE);
+
+                    err = 0;
+                }
+
+                break;
+            default:
+                break;
+        }
+    }
+
+    return err;
+}
+
+media_info_t media_get_info(media_t med)
+{
+    media_info_t info = {0};
+
+    if (med == MEDIA_NOR)
+    {
+        info.size               = OBDH_SIM_NOR_SIZE;
+        info.sub_sector_size    = OBDH_SIM_NOR_SUB_SECTOR_SIZE;
+        info.page_size          = OBDH_SIM_NOR_PAGE_SIZE;
+    }
+
+    return info;
+}
+
+/* Modules not covered by the simulations */
+
+int beacon_frame_send(void)
+{
+    return 0;
+}
+
+int param_get(uint8_t subsystem, uint8_t param, uint32_t *val)
+{
+    return -1;
+}
+
+int param_set(uint8_t subsystem, uint8_t param, uint32_t val)
+{
+    return -1;
+}
+
+int payload_enable(payload_t pl)
+{
+    return -1;
+}
+
+int payload_disable(payload_t pl)
+{
+    return -1;
+}
+
+/** \} End of obdh_sim group */
@@ -0,0 +1,63 @@
+/*
+ * obdh_sim.h
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Host environment of the OBDH tasks definition.
+ *
+ * Provides what the process TC task needs to run on the host: the FreeRTOS delays and tick
+ * count (on the simulated clock of the TTC emulator), the system time, the NOR and FRAM
+ * memories (in RAM, with the NOR write and erase semantics) and stubs of the modules not
+ * covered by the simulations (beacon frame, parameters and payloads).
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.25
+ *
+ * \date 2022/12/20
+ *
+ * \defgroup obdh_sim OBDH Environment
+ * \ingroup tests
+ * \{
+ */
+
+#ifndef OBDH_SIM_H_
+#define OBDH_SIM_H_
+
+#include <stdint.h>
+
+#include <config/config.h>
+
+#define OBDH_SIM_NOR_SIZE               (2UL*CONFIG_MEM_PAYLOAD_DATA_SIZE)  /**< Emulated NOR memory size in bytes. */
+#define OBDH_SIM_NOR_SUB_SECTOR_SIZE    4096UL                              /**< Emulated NOR sub-sector size in bytes. */
+#define OBDH_SIM_NOR_PAGE_SIZE          256UL                               /**< Emulated NOR page size in bytes. */
+#define OBDH_SIM_FRAM_SIZE              (32UL*1024UL)                       /**< Emulated FRAM memory size in bytes. */
+
+/**
+ * \brief Initializes the emulated memories (erased) and the payload data storage.
+ *
+ * \return The status/error code.
+ */
+int obdh_sim_init(void);
+
+#endif /* OBDH_SIM_H_ */
+
+/** \} End of obdh_sim group */
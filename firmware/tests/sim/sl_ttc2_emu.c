@@ -0,0 +1,624 @@
+/*
+ * sl_ttc2_emu.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Host emulator of the SpaceLab TTC 2.0 (two radios) implementation.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.13
+ *
+ * \date 2022/11/23
+ *
+ * \addtogroup sl_ttc2_emu
+ * \{
+ */
+
+#include <string.h>
+
+#include <drivers/sl_ttc2/sl_ttc2.h>
+
+#include "sl_ttc2_emu.h"
+
+#define SL_TTC2_EMU_HARDWARE_VERSION    1U
+#define SL_TTC2_EMU_FIRMWARE_VERSION    0x00010000UL
+
+/**
+ * \brief Packet stored in a FIFO or propagating in the link.
+ */
+typedef struct
+{
+    uint8_t data[SL_TTC2_EMU_MAX_PKT_LEN];
+    uint16_t len;
+    uint64_t time_us;                   /**< End of transmission (TX FIFO) or arrival time (link). */
+} sl_ttc2_emu_pkt_t;
+
+/**
+ * \brief Packet FIFO.
+ */
+typedef struct
+{
+    sl_ttc2_emu_pkt_t pkts[SL_TTC2_EMU_FIFO_DEPTH];
+    uint8_t head;
+    uint8_t count;
+} sl_ttc2_emu_fifo_t;
+
+/**
+ * \brief Emulated radio.
+ */
+typedef struct
+{
+    bool present;
+    bool tx_enable;
+    uint32_t tx_counter;
+    uint32_t rx_counter;
+    uint64_t tx_busy_until_us;
+    sl_ttc2_emu_fifo_t tx_fifo;
+    sl_ttc2_emu_fifo_t rx_fifo;
+    sl_ttc2_emu_stats_t stats;
+} sl_ttc2_emu_radio_t;
+
+/**
+ * \brief Packet propagating in the link.
+ */
+typedef struct
+{
+    bool used;
+    bool uplink;                        /**< TRUE for ground -> radio, FALSE for radio -> ground. */
+    uint8_t radio;
+    sl_ttc2_emu_pkt_t pkt;
+} sl_ttc2_emu_in_flight_t;
+
+static sl_ttc2_emu_link_t emu_link = {0};
+static sl_ttc2_emu_downlink_cb_t emu_downlink_cb = NULL;
+static sl_ttc2_emu_radio_t emu_radios[SL_TTC2_EMU_RADIOS];
+static sl_ttc2_emu_in_flight_t emu_in_flight[SL_TTC2_EMU_IN_FLIGHT_MAX];
+static uint64_t emu_time_us = 0;
+static uint64_t emu_ground_busy_until_us = 0;
+static uint32_t emu_rand_state = 1;
+
+/**
+ * \brief Computes the CRC16 used by the SL TTC 2.0 protocol.
+ */
+static uint16_t sl_ttc2_emu_crc16(const uint8_t *data, uint16_t len);
+
+/**
+ * \brief Draws the loss of a packet from the link model.
+ */
+static bool sl_ttc2_emu_lost(void);
+
+/**
+ * \brief Computes the airtime of a packet in microseconds.
+ */
+static uint64_t sl_ttc2_emu_airtime_us(uint16_t len);
+
+/**
+ * \brief Pushes a packet into a FIFO (FALSE if the FIFO is full).
+ */
+static bool sl_ttc2_emu_fifo_push(sl_ttc2_emu_fifo_t *fifo, const uint8_t *data, uint16_t len, uint64_t time_us);
+
+/**
+ * \brief Gets the oldest packet of a FIFO (NULL if the FIFO is empty).
+ */
+static sl_ttc2_emu_pkt_t *sl_ttc2_emu_fifo_head(sl_ttc2_emu_fifo_t *fifo);
+
+/**
+ * \brief Removes the oldest packet of a FIFO.
+ */
+static void sl_ttc2_emu_fifo_pop(sl_ttc2_emu_fifo_t *fifo);
+
+/**
+ * \brief Adds a packet to the link, arriving at a given time.
+ */
+static int sl_ttc2_emu_in_flight_add(bool uplink, uint8_t radio, const uint8_t *data, uint16_t len, uint64_t time_us);
+
+/**
+ * \brief Reads a register of a radio.
+ */
+static uint32_t sl_ttc2_emu_read_reg(sl_ttc2_emu_radio_t *radio, uint8_t id, uint8_t adr);
+
+/**
+ * \brief Advances the clock by the duration of a SPI transaction.
+ */
+static void sl_ttc2_emu_spi_cost(sl_ttc2_config_t config, uint16_t len);
+
+/**
+ * \brief Gets the radio addressed by a driver configuration.
+ */
+static sl_ttc2_emu_radio_t *sl_ttc2_emu_get_radio(sl_ttc2_config_t config);
+
+void sl_ttc2_emu_init(const sl_ttc2_emu_link_t *link, sl_ttc2_emu_downlink_cb_t cb)
+{
+    emu_link = *link;
+    emu_downlink_cb = cb;
+
+    memset(emu_radios, 0, sizeof(emu_radios));
+    memset(emu_in_flight, 0, sizeof(emu_in_flight));
+
+    uint8_t i = 0;
+    for(i = 0; i < SL_TTC2_EMU_RADIOS; i++)
+    {
+        emu_radios[i].present = true;
+        emu_radios[i].tx_enable = true;
+    }
+
+    emu_time_us = 0;
+    emu_ground_busy_until_us = 0;
+    emu_rand_state = (link->seed == 0U) ? 1U : link->seed;
+}
+
+void sl_ttc2_emu_set_present(uint8_t radio, bool present)
+{
+    if (radio < SL_TTC2_EMU_RADIOS)
+    {
+        emu_radios[radio].present = present;
+    }
+}
+
+int sl_ttc2_emu_uplink(const uint8_t *data, uint16_t len)
+{
+    int err = -1;
+
+    if ((len > 0U) && (len <= SL_TTC2_EMU_MAX_PKT_LEN))
+    {
+        uint64_t start = (emu_ground_busy_until_us > emu_time_us) ? emu_ground_busy_until_us : emu_time_us;
+
+        emu_ground_busy_until_us = start + sl_ttc2_emu_airtime_us(len);
+
+        err = 0;
+
+        uint8_t i = 0;
+        for(i = 0; i < SL_TTC2_EMU_RADIOS; i++)
+        {
+            if (sl_ttc2_emu_in_flight_add(true, i, data, len, emu_ground_busy_until_us + emu_link.latency_ms * 1000ULL) != 0)
+            {
+                err = -1;
+            }
+        }
+    }
+
+    return err;
+}
+
+void sl_ttc2_emu_advance_us(uint64_t us)
+{
+    uint64_t target = emu_time_us + us;
+
+    while(1)
+    {
+        uint64_t next = UINT64_MAX;
+
+        uint16_t i = 0;
+        for(i = 0; i < SL_TTC2_EMU_RADIOS; i++)
+        {
+            sl_ttc2_emu_pkt_t *head = sl_ttc2_emu_fifo_head(&emu_radios[i].tx_fifo);
+
+            if ((head != NULL) && (head->time_us < next))
+            {
+                next = head->time_us;
+            }
+        }
+
+        for(i = 0; i < SL_TTC2_EMU_IN_FLIGHT_MAX; i++)
+        {
+            if (emu_in_flight[i].used && (emu_in_flight[i].pkt.time_us < next))
+            {
+                next = emu_in_flight[i].pkt.time_us;
+            }
+        }
+
+        if (next > target)
+        {
+            break;
+        }
+
+        emu_time_us = next;
+
+        /* End of transmissions */
+        for(i = 0; i < SL_TTC2_EMU_RADIOS; i++)
+        {
+            sl_ttc2_emu_radio_t *radio = &emu_radios[i];
+            sl_ttc2_emu_pkt_t *head = sl_ttc2_emu_fifo_head(&radio->tx_fifo);
+
+            if ((head != NULL) && (head->time_us == next))
+            {
+                radio->stats.tx_pkts++;
+                radio->tx_counter++;
+
+                if (sl_ttc2_emu_lost())
+                {
+                    radio->stats.tx_lost++;
+                }
+                else
+                {
+                    sl_ttc2_emu_in_flight_add(false, (uint8_t)i, head->data, head->len, next + emu_link.latency_ms * 1000ULL);
+                }
+
+                sl_ttc2_emu_fifo_pop(&radio->tx_fifo);
+            }
+        }
+
+        /* Arrivals */
+        for(i = 0; i < SL_TTC2_EMU_IN_FLIGHT_MAX; i++)
+        {
+            sl_ttc2_emu_in_flight_t *f = &emu_in_flight[i];
+
+            if (f->used && (f->pkt.time_us == next))
+            {
+                f->used = false;
+
+                if (f->uplink)
+                {
+                    sl_ttc2_emu_radio_t *radio = &emu_radios[f->radio];
+
+                    if (radio->present && !sl_ttc2_emu_lost() && sl_ttc2_emu_fifo_push(&radio->rx_fifo, f->pkt.data, f->pkt.len, next))
+                    {
+                        radio->stats.rx_pkts++;
+                        radio->rx_counter++;
+                    }
+                    else
+                    {
+                        radio->stats.rx_lost++;
+                    }
+                }
+                else if (emu_downlink_cb != NULL)
+                {
+                    emu_downlink_cb(f->radio, f->pkt.data, f->pkt.len, next);
+                }
+            }
+        }
+    }
+
+    emu_time_us = target;
+}
+
+uint64_t sl_ttc2_emu_time_us(void)
+{
+    return emu_time_us;
+}
+
+bool sl_ttc2_emu_is_idle(void)
+{
+    bool idle = true;
+
+    uint16_t i = 0;
+    for(i = 0; i < SL_TTC2_EMU_RADIOS; i++)
+    {
+        if (emu_radios[i].tx_fifo.count > 0U)
+        {
+            idle = false;
+        }
+    }
+
+    for(i = 0; i < SL_TTC2_EMU_IN_FLIGHT_MAX; i++)
+    {
+        if (emu_in_flight[i].used)
+        {
+            idle = false;
+        }
+    }
+
+    return idle;
+}
+
+void sl_ttc2_emu_get_stats(uint8_t radio, sl_ttc2_emu_stats_t *stats)
+{
+    if (radio < SL_TTC2_EMU_RADIOS)
+    {
+        *stats = emu_radios[radio].stats;
+    }
+}
+
+int sl_ttc2_spi_init(sl_ttc2_config_t config)
+{
+    return 0;
+}
+
+int sl_ttc2_spi_write(sl_ttc2_config_t config, uint8_t *data, uint16_t len)
+{
+    sl_ttc2_emu_radio_t *radio = sl_ttc2_emu_get_radio(config);
+
+    sl_ttc2_emu_spi_cost(config, len);
+
+    /* A missing radio ignores the write */
+    if ((radio != NULL) && radio->present && (len >= 3U))
+    {
+        uint16_t crc = ((uint16_t)data[len - 2U] << 8) | (uint16_t)data[len - 1U];
+
+        if (crc == sl_ttc2_emu_crc16(data, len - 2U))
+        {
+            switch(data[0])
+            {
+                case SL_TTC2_CMD_WRITE_REG:
+                    if ((len == 8U) && (data[1] == SL_TTC2_REG_TX_ENABLE))
+                    {
+                        radio->tx_enable = (data[5] != 0U);
+                    }
+
+                    break;
+                case SL_TTC2_CMD_TRANSMIT_PKT:
+                    if (radio->tx_enable)
+                    {
+                        uint16_t pkt_len = len - 3U;
+
+                        uint64_t start = (radio->tx_busy_until_us > emu_time_us) ? radio->tx_busy_until_us : emu_time_us;
+                        uint64_t done = start + sl_ttc2_emu_airtime_us(pkt_len);
+
+                        if ((pkt_len <= SL_TTC2_EMU_MAX_PKT_LEN) && sl_ttc2_emu_fifo_push(&radio->tx_fifo, &data[1], pkt_len, done))
+                        {
+                            radio->tx_busy_until_us = done;
+                        }
+                        else
+                        {
+                            radio->stats.tx_overflows++;
+                        }
+                    }
+
+                    break;
+                default:
+                    break;
+            }
+        }
+        else
+        {
+            radio->stats.crc_errors++;
+        }
+    }
+
+    return 0;
+}
+
+int sl_ttc2_spi_read(sl_ttc2_config_t config, uint8_t *data, uint16_t len)
+{
+    sl_ttc2_emu_spi_cost(config, len);
+
+    memset(data, 0xFF, len);
+
+    return 0;
+}
+
+int sl_ttc2_spi_transfer(sl_ttc2_config_t config, uint8_t *wdata, uint8_t *rdata, uint16_t len)
+{
+    sl_ttc2_emu_radio_t *radio = sl_ttc2_emu_get_radio(config);
+
+    sl_ttc2_emu_spi_cost(config, len);
+
+    memset(rdata, 0xFF, len);
+
+    /* A missing radio leaves the bus floating (0xFF) */
+    if ((radio != NULL) && radio->present && (len >= 3U))
+    {
+        switch(wdata[0])
+        {
+            case SL_TTC2_CMD_READ_REG:
+                if (len == 8U)
+                {
+                    uint32_t val = sl_ttc2_emu_read_reg(radio, config.id, wdata[1]);
+
+                    rdata[0] = SL_TTC2_CMD_READ_REG;
+                    rdata[1] = wdata[1];
+                    rdata[2] = (val >> 24) & 0xFFU;
+                    rdata[3] = (val >> 16) & 0xFFU;
+                    rdata[4] = (val >> 8) & 0xFFU;
+                    rdata[5] = val & 0xFFU;
+
+                    uint16_t crc = sl_ttc2_emu_crc16(rdata, 6U);
+
+                    rdata[6] = (crc >> 8) & 0xFFU;
+                    rdata[7] = crc & 0xFFU;
+                }
+
+                break;
+            case SL_TTC2_CMD_READ_BLOCK:
+            {
+                uint8_t adr = wdata[1];
+                uint8_t n = wdata[2];
+
+                if ((n > 0U) && (((uint16_t)adr + n) <= SL_TTC2_BLOCK_READ_MAX_REGS) && (len == (3U + (4U * n) + 2U)))
+                {
+                    rdata[0] = SL_TTC2_CMD_READ_BLOCK;
+                    rdata[1] = adr;
+                    rdata[2] = n;
+
+                    uint8_t i = 0U;
+                    for(i = 0U; i < n; i++)
+                    {
+                        uint32_t val = sl_ttc2_emu_read_reg(radio, config.id, adr + i);
+
+                        rdata[3U + (4U * i)] = (val >> 24) & 0xFFU;
+                        rdata[4U + (4U * i)] = (val >> 16) & 0xFFU;
+                        rdata[5U + (4U * i)] = (val >> 8) & 0xFFU;
+                        rdata[6U + (4U * i)] = val & 0xFFU;
+                    }
+
+                    uint16_t crc = sl_ttc2_emu_crc16(rdata, len - 2U);
+
+                    rdata[len - 2U] = (crc >> 8) & 0xFFU;
+                    rdata[len - 1U] = crc & 0xFFU;
+                }
+
+                break;
+            }
+            case SL_TTC2_CMD_RECEIVE_PKT:
+            {
+                sl_ttc2_emu_pkt_t *pkt = sl_ttc2_emu_fifo_head(&radio->rx_fifo);
+
+                if ((pkt != NULL) && (len == (1U + pkt->len + 2U)))
+                {
+                    rdata[0] = SL_TTC2_CMD_RECEIVE_PKT;
+
+                    memcpy(&rdata[1], pkt->data, pkt->len);
+
+                    uint16_t crc = sl_ttc2_emu_crc16(rdata, 1U + pkt->len);
+
+                    rdata[1U + pkt->len] = (crc >> 8) & 0xFFU;
+                    rdata[2U + pkt->len] = crc & 0xFFU;
+
+                    sl_ttc2_emu_fifo_pop(&radio->rx_fifo);
+                }
+
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    return 0;
+}
+
+void sl_ttc2_delay_ms(uint32_t ms)
+{
+    sl_ttc2_emu_advance_us((uint64_t)ms * 1000ULL);
+}
+
+static uint16_t sl_ttc2_emu_crc16(const uint8_t *data, uint16_t len)
+{
+    uint8_t x;
+    uint16_t crc = 0;
+
+    uint16_t i = 0;
+    for(i = 0; i < len; i++)
+    {
+        x = (crc >> 8) ^ data[i];
+        x ^= x >> 4;
+        crc = (crc << 8) ^ ((uint16_t)x << 12) ^ ((uint16_t)x << 5) ^ (uint16_t)x;
+    }
+
+    return crc;
+}
+
+static bool sl_ttc2_emu_lost(void)
+{
+    /* xorshift32 */
+    emu_rand_state ^= emu_rand_state << 13;
+    emu_rand_state ^= emu_rand_state >> 17;
+    emu_rand_state ^= emu_rand_state << 5;
+
+    return (emu_rand_state % 1000U) < emu_link.loss_permille;
+}
+
+static uint64_t sl_ttc2_emu_airtime_us(uint16_t len)
+{
+    uint64_t bits = ((uint64_t)len + emu_link.overhead_bytes) * 8ULL;
+
+    return (emu_link.bitrate_bps == 0U) ? 0U : ((bits * 1000000ULL) + emu_link.bitrate_bps - 1U) / emu_link.bitrate_bps;
+}
+
+static bool sl_ttc2_emu_fifo_push(sl_ttc2_emu_fifo_t *fifo, const uint8_t *data, uint16_t len, uint64_t time_us)
+{
+    bool res = false;
+
+    if (fifo->count < SL_TTC2_EMU_FIFO_DEPTH)
+    {
+        sl_ttc2_emu_pkt_t *pkt = &fifo->pkts[(fifo->head + fifo->count) % SL_TTC2_EMU_FIFO_DEPTH];
+
+        memcpy(pkt->data, data, len);
+        pkt->len = len;
+        pkt->time_us = time_us;
+
+        fifo->count++;
+
+        res = true;
+    }
+
+    return res;
+}
+
+static sl_ttc2_emu_pkt_t *sl_ttc2_emu_fifo_head(sl_ttc2_emu_fifo_t *fifo)
+{
+    return (fifo->count > 0U) ? &fifo->pkts[fifo->head] : NULL;
+}
+
+static void sl_ttc2_emu_fifo_pop(sl_ttc2_emu_fifo_t *fifo)
+{
+    if (fifo->count > 0U)
+    {
+        fifo->head = (fifo->head + 1U) % SL_TTC2_EMU_FIFO_DEPTH;
+        fifo->count--;
+    }
+}
+
+static int sl_ttc2_emu_in_flight_add(bool uplink, uint8_t radio, const uint8_t *data, uint16_t len, uint64_t time_us)
+{
+    int err = -1;
+
+    uint16_t i = 0;
+    for(i = 0; i < SL_TTC2_EMU_IN_FLIGHT_MAX; i++)
+    {
+        sl_ttc2_emu_in_flight_t *f = &emu_in_flight[i];
+
+        if (!f->used)
+        {
+            f->used = true;
+            f->uplink = uplink;
+            f->radio = radio;
+
+            memcpy(f->pkt.data, data, len);
+            f->pkt.len = len;
+            f->pkt.time_us = time_us;
+
+            err = 0;
+
+            break;
+        }
+    }
+
+    return err;
+}
+
+static uint32_t sl_ttc2_emu_read_reg(sl_ttc2_emu_radio_t *radio, uint8_t id, uint8_t adr)
+{
+    uint32_t val = 0;
+
+    switch(adr)
+    {
+        case SL_TTC2_REG_DEVICE_ID:                     val = (id == SL_TTC2_RADIO_0) ? SL_TTC2_DEVICE_ID_RADIO_0 : SL_TTC2_DEVICE_ID_RADIO_1;  break;
+        case SL_TTC2_REG_HARDWARE_VERSION:              val = SL_TTC2_EMU_HARDWARE_VERSION;                         break;
+        case SL_TTC2_REG_FIRMWARE_VERSION:              val = SL_TTC2_EMU_FIRMWARE_VERSION;                         break;
+        case SL_TTC2_REG_TIME_COUNTER:                  val = (uint32_t)(emu_time_us / 1000ULL);                    break;
+        case SL_TTC2_REG_TX_ENABLE:                     val = radio->tx_enable ? 1U : 0U;                           break;
+        case SL_TTC2_REG_TX_PACKET_COUNTER:             val = radio->tx_counter;                                    break;
+        case SL_TTC2_REG_RX_PACKET_COUNTER:             val = radio->rx_counter;                                    break;
+        case SL_TTC2_REG_FIFO_TX_PACKET:                val = radio->tx_fifo.count;                                 break;
+        case SL_TTC2_REG_FIFO_RX_PACKET:                val = radio->rx_fifo.count;                                 break;
+        case SL_TTC2_REG_LEN_FIRST_RX_PACKET_IN_FIFO:   val = (radio->rx_fifo.count > 0U) ? sl_ttc2_emu_fifo_head(&radio->rx_fifo)->len : 0U;  break;
+        default:                                                                                                    break;
+    }
+
+    return val;
+}
+
+static void sl_ttc2_emu_spi_cost(sl_ttc2_config_t config, uint16_t len)
+{
+    if (config.port_config.speed_hz > 0U)
+    {
+        sl_ttc2_emu_advance_us(((uint64_t)len * 8ULL * 1000000ULL) / config.port_config.speed_hz);
+    }
+}
+
+static sl_ttc2_emu_radio_t *sl_ttc2_emu_get_radio(sl_ttc2_config_t config)
+{
+    return (config.id < SL_TTC2_EMU_RADIOS) ? &emu_radios[config.id] : NULL;
+}
+
+/** \} End of sl_ttc2_emu group */
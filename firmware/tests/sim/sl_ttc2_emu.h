@@ -0,0 +1,172 @@
+/*
+ * sl_ttc2_emu.h
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Host emulator of the SpaceLab TTC 2.0 (two radios) definition.
+ *
+ * Replaces the SPI layer of the SL TTC 2.0 driver (sl_ttc2_spi_*) and sl_ttc2_delay_ms. The
+ * register and FIFO protocol of the module is decoded from the SPI frames, and each radio
+ * drains its TX FIFO over a simulated RF link with a given bit rate, latency and loss rate.
+ * All the timing runs on a simulated clock, advanced by the driver delays, by the SPI
+ * transactions and explicitly by the caller.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.5
+ *
+ * \date 2022/11/23
+ *
+ * \defgroup sl_ttc2_emu SL TTC 2.0 Emulator
+ * \ingroup tests
+ * \{
+ */
+
+#ifndef SL_TTC2_EMU_H_
+#define SL_TTC2_EMU_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SL_TTC2_EMU_RADIOS              2U          /**< Number of emulated radios. */
+#define SL_TTC2_EMU_MAX_PKT_LEN         220U        /**< Maximum packet length in bytes. */
+#define SL_TTC2_EMU_FIFO_DEPTH          8U          /**< TX and RX FIFO depth in packets. */
+#define SL_TTC2_EMU_IN_FLIGHT_MAX       256U        /**< Maximum number of packets propagating at the same time. */
+
+/**
+ * \brief RF link model.
+ */
+typedef struct
+{
+    uint32_t bitrate_bps;               /**< Over-the-air bit rate (both directions). */
+    uint32_t latency_ms;                /**< One-way latency (propagation and ground station processing). */
+    uint16_t loss_permille;             /**< Probability of losing a packet, in 1/1000. */
+    uint16_t overhead_bytes;            /**< Bytes added to each packet on air (preamble, sync word, length, CRC). */
+    uint32_t seed;                      /**< Seed of the loss generator. */
+} sl_ttc2_emu_link_t;
+
+/**
+ * \brief Per-radio statistics.
+ */
+typedef struct
+{
+    uint32_t tx_pkts;                   /**< Packets transmitted on air. */
+    uint32_t tx_lost;                   /**< Transmitted packets lost in the link. */
+    uint32_t tx_overflows;              /**< Packets refused because the TX FIFO was full. */
+    uint32_t rx_pkts;                   /**< Uplink packets stored in the RX FIFO. */
+    uint32_t rx_lost;                   /**< Uplink packets lost in the link or by a full RX FIFO. */
+    uint32_t crc_errors;                /**< SPI frames with an invalid checksum. */
+} sl_ttc2_emu_stats_t;
+
+/**
+ * \brief Callback called when a downlink packet reaches the ground station.
+ *
+ * \param[in] radio is the radio that transmitted the packet.
+ *
+ * \param[in] data is the packet.
+ *
+ * \param[in] len is the length of the packet.
+ *
+ * \param[in] time_us is the arrival time in microseconds.
+ *
+ * \return None.
+ */
+typedef void (*sl_ttc2_emu_downlink_cb_t)(uint8_t radio, const uint8_t *data, uint16_t len, uint64_t time_us);
+
+/**
+ * \brief Initializes the emulator.
+ *
+ * Both radios start present, with TX enabled and empty FIFOs. The clock starts at zero.
+ *
+ * \param[in] link is the RF link model.
+ *
+ * \param[in] cb is the ground station callback for the downlink packets.
+ *
+ * \return None.
+ */
+void sl_ttc2_emu_init(const sl_ttc2_emu_link_t *link, sl_ttc2_emu_downlink_cb_t cb);
+
+/**
+ * \brief Connects or disconnects a radio from the SPI bus.
+ *
+ * A disconnected radio answers every read with 0xFF and ignores every write.
+ *
+ * \param[in] radio is the radio index.
+ *
+ * \param[in] present is TRUE to connect and FALSE to disconnect the radio.
+ *
+ * \return None.
+ */
+void sl_ttc2_emu_set_present(uint8_t radio, bool present);
+
+/**
+ * \brief Transmits an uplink packet from the ground station.
+ *
+ * The packet is delivered to the RX FIFO of every radio after its airtime and the link
+ * latency. Consecutive uplink packets are serialized on air.
+ *
+ * \param[in] data is the packet to transmit.
+ *
+ * \param[in] len is the length of the packet.
+ *
+ * \return The status/error code.
+ */
+int sl_ttc2_emu_uplink(const uint8_t *data, uint16_t len);
+
+/**
+ * \brief Advances the simulated clock, processing every event until the new time.
+ *
+ * \param[in] us is the time to advance in microseconds.
+ *
+ * \return None.
+ */
+void sl_ttc2_emu_advance_us(uint64_t us);
+
+/**
+ * \brief Gets the simulated time.
+ *
+ * \return The current time in microseconds.
+ */
+uint64_t sl_ttc2_emu_time_us(void);
+
+/**
+ * \brief Checks if there is no packet being transmitted or propagating.
+ *
+ * The RX FIFOs are not considered, since a radio may never be polled by the OBDH.
+ *
+ * \return TRUE/FALSE if the link is idle.
+ */
+bool sl_ttc2_emu_is_idle(void);
+
+/**
+ * \brief Gets the statistics of a radio.
+ *
+ * \param[in] radio is the radio index.
+ *
+ * \param[in,out] stats is a pointer to store the statistics.
+ *
+ * \return None.
+ */
+void sl_ttc2_emu_get_stats(uint8_t radio, sl_ttc2_emu_stats_t *stats);
+
+#endif /* SL_TTC2_EMU_H_ */
+
+/** \} End of sl_ttc2_emu group */
@@ -0,0 +1,208 @@
+/*
+ * sys_log_sim.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief System log for the host simulations implementation.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.5
+ *
+ * \date 2022/11/23
+ *
+ * \addtogroup sys_log_sim
+ * \{
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <system/sys_log/sys_log.h>
+
+#include "sys_log_sim.h"
+
+static bool sys_log_sim_enabled = false;
+
+void sys_log_sim_set_enabled(bool en)
+{
+    sys_log_sim_enabled = en;
+}
+
+int sys_log_init(void)
+{
+    return 0;
+}
+
+void sys_log_set_color(uint8_t color)
+{
+    return;
+}
+
+void sys_log_reset_color(void)
+{
+    return;
+}
+
+void sys_log_print_event(uint8_t type, const char *event)
+{
+    if (sys_log_sim_enabled)
+    {
+        fprintf(stderr, "%s", event);
+    }
+}
+
+void sys_log_print_event_from_module(uint8_t type, const char *module, const char *event)
+{
+    if (sys_log_sim_enabled)
+    {
+        fprintf(stderr, "%s: %s", module, event);
+    }
+}
+
+void sys_log_print_msg(const char *msg)
+{
+    if (sys_log_sim_enabled)
+    {
+        fprintf(stderr, "%s", msg);
+    }
+}
+
+void sys_log_print_str(char *str)
+{
+    sys_log_print_msg(str);
+}
+
+void sys_log_flush(void)
+{
+    fflush(stderr);
+}
+
+void sys_log_new_line(void)
+{
+    if (sys_log_sim_enabled)
+    {
+        fprintf(stderr, "\n");
+    }
+}
+
+void sys_log_print_digit(uint8_t d)
+{
+    if (sys_log_sim_enabled)
+    {
+        fprintf(stderr, "%u", (unsigned)d);
+    }
+}
+
+void sys_log_print_uint(uint32_t uint)
+{
+    if (sys_log_sim_enabled)
+    {
+        fprintf(stderr, "%lu", (unsigned long)uint);
+    }
+}
+
+void sys_log_print_int(int32_t sint)
+{
+    if (sys_log_sim_enabled)
+    {
+        fprintf(stderr, "%ld", (long)sint);
+    }
+}
+
+void sys_log_print_hex(uint32_t hex)
+{
+    if (sys_log_sim_enabled)
+    {
+        fprintf(stderr, "0x%lX", (unsigned long)hex);
+    }
+}
+
+void sys_log_dump_hex(uint8_t *data, uint16_t len)
+{
+    uint16_t i = 0;
+    for(i = 0; i < len; i++)
+    {
+        sys_log_print_hex(data[i]);
+        sys_log_print_msg(",");
+    }
+}
+
+void sys_log_print_float(float flt, uint8_t digits)
+{
+    if (sys_log_sim_enabled)
+    {
+        fprintf(stderr, "%.*f", (int)digits, (double)flt);
+    }
+}
+
+void sys_log_print_byte(uint8_t byte)
+{
+    if (sys_log_sim_enabled)
+    {
+        fputc(byte, stderr);
+    }
+}
+
+void sys_log_print_system_time(void)
+{
+    return;
+}
+
+void sys_log_print_license_msg(void)
+{
+    return;
+}
+
+void sys_log_print_splash_screen(void)
+{
+    return;
+}
+
+void sys_log_print_firmware_version(void)
+{
+    return;
+}
+
+void sys_log_deferred(uint8_t type, uint8_t module, uint16_t token, uint32_t arg0, uint32_t arg1)
+{
+    if (sys_log_sim_enabled)
+    {
+        fprintf(stderr, "Module %u: token %u (%lu, %lu)\n", (unsigned)module, (unsigned)token, (unsigned long)arg0, (unsigned long)arg1);
+    }
+}
+
+uint32_t sys_log_black_box_first(void)
+{
+    return 0;
+}
+
+uint32_t sys_log_black_box_next(void)
+{
+    return 0;   /* Empty black box */
+}
+
+int sys_log_black_box_read(uint32_t seq, uint8_t *data, uint16_t n)
+{
+    return -1;
+}
+
+/** \} End of sys_log_sim group */
@@ -0,0 +1,56 @@
+/*
+ * sys_log_sim.h
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief System log for the host simulations definition.
+ *
+ * Implements the system log API on stderr, so the firmware modules can be linked on the host
+ * without the UART driver. The messages are discarded unless the log is enabled.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.5
+ *
+ * \date 2022/11/23
+ *
+ * \defgroup sys_log_sim System Log Simulation
+ * \ingroup tests
+ * \{
+ */
+
+#ifndef SYS_LOG_SIM_H_
+#define SYS_LOG_SIM_H_
+
+#include <stdbool.h>
+
+/**
+ * \brief Enables or disables the log messages.
+ *
+ * \param[in] en is TRUE to print the messages on stderr.
+ *
+ * \return None.
+ */
+void sys_log_sim_set_enabled(bool en);
+
+#endif /* SYS_LOG_SIM_H_ */
+
+/** \} End of sys_log_sim group */
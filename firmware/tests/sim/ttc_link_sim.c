@@ -0,0 +1,707 @@
+/*
+ * ttc_link_sim.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief End-to-end simulation of the TTC downlink path.
+ *
+ * Runs the real SL TTC 2.0 driver, the TTC device, the TTC link layer, the telecommand handler
+ * of the process TC task and the payload data storage against the TTC emulator. The OBDH side
+ * executes a cycle of the process TC task (process_tc_poll()) with the period of the task, so
+ * the telecommands are decoded, authenticated and answered by the flight code. The ground
+ * station side is driven by a script read from the standard input, so it can be fed from a
+ * file or from a pipe.
+ *
+ * Script format (one command per line, ordered by time, '#' starts a comment):
+ * \code
+ * <time_ms> ping                   Uplinks a ping request.
+ * <time_ms> store <records>        Stores <records> payload data records in the OBDH (time tags 0, 1, 2, ...).
+ * <time_ms> adc <bytes>            Stores an EDC ADC sequence stream of <bytes> bytes in the OBDH (next time tag).
+ * <time_ms> data <first> <last>    Uplinks a "Get Payload Data" request of the records with time tags in [first, last].
+ * <time_ms> radio <0|1> <on|off>   Connects or disconnects a radio.
+ * <time_ms> end                    Ends the simulation (after the link is idle).
+ * \endcode
+ *
+ * The ADC sequence stream is stored as the read EDC task does (full chunks of
+ * PAYLOAD_DATA_STREAM_CHUNK_LEN bytes), and the ground station reassembles it from the received
+ * records and checks its length and CRC16 against the final record of the stream.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.5
+ *
+ * \date 2022/11/23
+ *
+ * \defgroup ttc_link_sim TTC Link Simulation
+ * \ingroup tests
+ * \{
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <config/config.h>
+#include <devices/ttc/ttc.h>
+#include <devices/ttc/ttc_link.h>
+#include <config/keys.h>
+#include <hmac/sha.h>
+#include <fsat_pkt/fsat_pkt.h>
+#include <structs/payload_data.h>
+#include <tasks/process_tc.h>
+
+#include "sl_ttc2_emu.h"
+#include "sys_log_sim.h"
+#include "obdh_sim.h"
+
+#define SIM_OBDH_POLL_PERIOD_MS         TASK_PROCESS_TC_PERIOD_MS
+#define SIM_PL_ID                       CONFIG_PL_ID_EDC_1
+#define SIM_MAX_FRAMES                  UINT16_MAX
+#define SIM_MAX_PINGS                   256U
+#define SIM_GROUND_CALLSIGN             "PP5UF"
+#define SIM_LINE_MAX_LEN                128U
+
+/**
+ * \brief Ground station command.
+ */
+typedef struct
+{
+    uint64_t time_us;
+    char cmd[16];
+    unsigned long arg1;
+    char arg2[16];
+} sim_cmd_t;
+
+/**
+ * \brief Ground station measurements.
+ */
+typedef struct
+{
+    uint64_t ping_sent_us[SIM_MAX_PINGS];
+    uint16_t pings_sent;
+    uint16_t pongs;
+    uint64_t rtt_min_us;
+    uint64_t rtt_max_us;
+    uint64_t rtt_sum_us;
+    uint64_t bulk_request_us;
+    uint64_t bulk_last_us;
+    uint32_t bulk_requests;
+    uint32_t bulk_unique;
+    uint32_t bulk_dups;
+    uint32_t bulk_out_of_order;
+    int32_t bulk_last_seq;
+    uint32_t bulk_records;
+    uint32_t bulk_bad_records;
+    uint32_t bulk_bytes;
+    uint32_t dl_frames[2];
+    uint8_t *bulk_seen;
+    uint8_t *stream_buf;
+    uint32_t stream_bytes;
+    bool stream_end;
+    uint16_t stream_len;
+    uint16_t stream_crc;
+} sim_ground_t;
+
+static sim_ground_t ground = {0};
+
+static bool dump_downlink = false;
+
+static uint32_t obdh_stored = 0;
+
+static uint32_t obdh_time_tag = 0;
+
+static uint32_t obdh_stream_len = 0;
+
+static uint32_t obdh_stream_time_tag = 0;
+
+/**
+ * \brief Ground station reception of a downlink frame.
+ */
+static void sim_ground_downlink(uint8_t radio, const uint8_t *data, uint16_t len, uint64_t time_us);
+
+/**
+ * \brief Ground station check of the records of a "payload data" frame.
+ */
+static void sim_ground_payload_data(const uint8_t *data, uint16_t len);
+
+/**
+ * \brief Ground station check of a record of the ADC sequence stream (chunk or final record).
+ */
+static bool sim_ground_stream_record(uint8_t type, const uint8_t *data, uint8_t len);
+
+/**
+ * \brief Ground station check of the reassembled ADC sequence stream (TRUE if it is complete and valid).
+ */
+static bool sim_ground_stream_check(void);
+
+/**
+ * \brief Ground station transmission of a telecommand (authenticated if key is not NULL).
+ */
+static void sim_ground_uplink(uint8_t id, const uint8_t *payload, uint16_t payload_len, const char *key);
+
+/**
+ * \brief Reads the next command of the script (FALSE at the end of the script).
+ */
+static bool sim_read_cmd(FILE *f, sim_cmd_t *cmd);
+
+/**
+ * \brief Executes a ground station command (TRUE for the end command).
+ */
+static bool sim_run_cmd(const sim_cmd_t *cmd);
+
+/**
+ * \brief OBDH side: stores payload data records with the expected content of the ground station check.
+ */
+static void sim_obdh_store(uint32_t records);
+
+/**
+ * \brief OBDH side: stores an ADC sequence stream with the expected content of the ground station check.
+ */
+static void sim_obdh_store_stream(uint32_t len);
+
+/**
+ * \brief Expected byte of the ADC sequence stream at a given offset.
+ */
+static uint8_t sim_stream_byte(uint32_t time_tag, uint32_t offset);
+
+/**
+ * \brief CRC16 of the payload data streams (ground station implementation).
+ */
+static uint16_t sim_crc16(uint16_t initial_value, const uint8_t *data, uint32_t size);
+
+/**
+ * \brief Prints the measurements.
+ */
+static void sim_report(const sl_ttc2_emu_link_t *link);
+
+int main(int argc, char **argv)
+{
+    sl_ttc2_emu_link_t link = {0};
+
+    link.bitrate_bps    = 9600;
+    link.latency_ms     = 20;
+    link.loss_permille  = 0;
+    link.overhead_bytes = 16;
+    link.seed           = 1;
+
+    int opt = 0;
+    while((opt = getopt(argc, argv, "b:l:p:o:s:dv")) != -1)
+    {
+        switch(opt)
+        {
+            case 'b':   link.bitrate_bps = strtoul(optarg, NULL, 0);                break;
+            case 'l':   link.latency_ms = strtoul(optarg, NULL, 0);                 break;
+            case 'p':   link.loss_permille = (uint16_t)strtoul(optarg, NULL, 0);    break;
+            case 'o':   link.overhead_bytes = (uint16_t)strtoul(optarg, NULL, 0);   break;
+            case 's':   link.seed = strtoul(optarg, NULL, 0);                       break;
+            case 'd':   dump_downlink = true;                                       break;
+            case 'v':   sys_log_sim_set_enabled(true);                              break;
+            default:
+                fprintf(stderr, "Usage: %s [-b bitrate_bps] [-l latency_ms] [-p loss_permille] [-o overhead_bytes] [-s seed] [-d] [-v] < script\n", argv[0]);
+
+                return EXIT_FAILURE;
+        }
+    }
+
+    ground.rtt_min_us = UINT64_MAX;
+    ground.bulk_last_seq = -1;
+    ground.bulk_seen = calloc(SIM_MAX_FRAMES + 1U, 1U);
+    ground.stream_buf = calloc(UINT16_MAX + 1UL, 1U);
+
+    sl_ttc2_emu_init(&link, sim_ground_downlink);
+
+    if ((ground.bulk_seen == NULL) || (ground.stream_buf == NULL) || (ttc_init(TTC_0) != 0) || (ttc_init(TTC_1) != 0) || (obdh_sim_init() != 0))
+    {
+        fprintf(stderr, "Error initializing the TTC devices or the OBDH memories!\n");
+
+        return EXIT_FAILURE;
+    }
+
+    sim_cmd_t cmd = {0};
+    bool cmd_valid = sim_read_cmd(stdin, &cmd);
+    bool end = false;
+
+    while(!(end && sl_ttc2_emu_is_idle() && (ttc_avail(TTC_1) == 0)))
+    {
+        /* Ground station */
+        while(cmd_valid && (cmd.time_us <= sl_ttc2_emu_time_us()))
+        {
+            end |= sim_run_cmd(&cmd);
+
+            cmd_valid = sim_read_cmd(stdin, &cmd);
+        }
+
+        if (!cmd_valid)
+        {
+            end = true;
+        }
+
+        /* OBDH (process TC task) */
+        process_tc_poll();
+
+        sl_ttc2_delay_ms(SIM_OBDH_POLL_PERIOD_MS);
+    }
+
+    bool stream_ok = sim_ground_stream_check();
+
+    sim_report(&link);
+
+    free(ground.bulk_seen);
+    free(ground.stream_buf);
+
+    return ((ground.bulk_bad_records == 0U) && stream_ok) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static void sim_ground_downlink(uint8_t radio, const uint8_t *data, uint16_t len, uint64_t time_us)
+{
+    fsat_pkt_view_t pkt = {0};
+
+    if (dump_downlink)
+    {
+        printf("DL %llu.%03llu %u ", (unsigned long long)(time_us / 1000ULL), (unsigned long long)(time_us % 1000ULL), (unsigned)radio);
+
+        uint16_t i = 0;
+        for(i = 0; i < len; i++)
+        {
+            printf("%02X", data[i]);
+        }
+
+        printf("\n");
+    }
+
+    ground.dl_frames[radio & 1U]++;
+
+    if (fsat_pkt_view(data, len, &pkt) != 0)
+    {
+        return;
+    }
+
+    switch(pkt.id)
+    {
+        case CONFIG_PKT_ID_DOWNLINK_PING_ANS:
+            if (ground.pongs < ground.pings_sent)
+            {
+                uint64_t rtt = time_us - ground.ping_sent_us[ground.pongs++];
+
+                ground.rtt_sum_us += rtt;
+
+                if (rtt < ground.rtt_min_us)
+                {
+                    ground.rtt_min_us = rtt;
+                }
+
+                if (rtt > ground.rtt_max_us)
+                {
+                    ground.rtt_max_us = rtt;
+                }
+            }
+
+            break;
+        case CONFIG_PKT_ID_DOWNLINK_PAYLOAD_DATA:
+            /* Requester callsign + sequence number + records */
+            if (pkt.length >= (FSAT_PKT_CALLSIGN_LEN + 2U))
+            {
+                uint16_t seq = ((uint16_t)pkt.payload[FSAT_PKT_CALLSIGN_LEN] << 8) | pkt.payload[FSAT_PKT_CALLSIGN_LEN + 1U];
+
+                if (ground.bulk_seen[seq])
+                {
+                    ground.bulk_dups++;
+                }
+                else
+                {
+                    ground.bulk_seen[seq] = 1U;
+                    ground.bulk_unique++;
+
+                    sim_ground_payload_data(&pkt.payload[FSAT_PKT_CALLSIGN_LEN + 2U], pkt.length - FSAT_PKT_CALLSIGN_LEN - 2U);
+                }
+
+                if ((int32_t)seq < ground.bulk_last_seq)
+                {
+                    ground.bulk_out_of_order++;
+                }
+
+                ground.bulk_last_seq = seq;
+                ground.bulk_last_us = time_us;
+            }
+
+            break;
+        default:
+            break;
+    }
+}
+
+static void sim_ground_payload_data(const uint8_t *data, uint16_t len)
+{
+    uint16_t pos = 0;
+
+    /* Type + time tag + length + data */
+    while((pos + PAYLOAD_DATA_FRAME_RECORD_HEADER_LEN) <= len)
+    {
+        uint32_t time_tag = ((uint32_t)data[pos + 1U] << 24) | ((uint32_t)data[pos + 2U] << 16) | ((uint32_t)data[pos + 3U] << 8) | (uint32_t)data[pos + 4U];
+        uint8_t rec_len = data[pos + 5U];
+
+        bool valid = (rec_len <= PAYLOAD_DATA_MAX_LEN) && ((pos + PAYLOAD_DATA_FRAME_RECORD_HEADER_LEN + rec_len) <= len);
+
+        if (valid && (data[pos] == PAYLOAD_DATA_TYPE_EDC_HK))
+        {
+            valid = (rec_len == PAYLOAD_DATA_MAX_LEN);
+
+            uint16_t i = 0;
+            for(i = 0; valid && (i < rec_len); i++)
+            {
+                valid = (data[pos + PAYLOAD_DATA_FRAME_RECORD_HEADER_LEN + i] == (uint8_t)(time_tag + i));
+            }
+        }
+        else if (valid && ((data[pos] & ~PAYLOAD_DATA_STREAM_END) == PAYLOAD_DATA_TYPE_EDC_ADC_SEQ))
+        {
+            valid = (time_tag == obdh_stream_time_tag) && sim_ground_stream_record(data[pos], &data[pos + PAYLOAD_DATA_FRAME_RECORD_HEADER_LEN], rec_len);
+        }
+        else
+        {
+            valid = false;
+        }
+
+        ground.bulk_records++;
+        ground.bulk_bytes += PAYLOAD_DATA_FRAME_RECORD_HEADER_LEN + rec_len;
+
+        if (!valid)
+        {
+            ground.bulk_bad_records++;
+        }
+
+        pos += PAYLOAD_DATA_FRAME_RECORD_HEADER_LEN + rec_len;
+    }
+}
+
+static bool sim_ground_stream_record(uint8_t type, const uint8_t *data, uint8_t len)
+{
+    bool valid = false;
+
+    if ((type & PAYLOAD_DATA_STREAM_END) != 0U)
+    {
+        /* Length + CRC16 of the stream */
+        if (len == 4U)
+        {
+            ground.stream_end = true;
+            ground.stream_len = ((uint16_t)data[0] << 8) | data[1];
+            ground.stream_crc = ((uint16_t)data[2] << 8) | data[3];
+
+            valid = true;
+        }
+    }
+    else if (len > PAYLOAD_DATA_STREAM_OFFSET_LEN)
+    {
+        /* Offset + chunk (every chunk but the last one must be full) */
+        uint32_t offset = ((uint32_t)data[0] << 8) | data[1];
+        uint16_t chunk_len = len - PAYLOAD_DATA_STREAM_OFFSET_LEN;
+
+        valid = ((offset % PAYLOAD_DATA_STREAM_CHUNK_LEN) == 0U) && ((offset + chunk_len) <= obdh_stream_len) &&
+                ((chunk_len == PAYLOAD_DATA_STREAM_CHUNK_LEN) || ((offset + chunk_len) == obdh_stream_len));
+
+        if (valid)
+        {
+            memcpy(&ground.stream_buf[offset], &data[PAYLOAD_DATA_STREAM_OFFSET_LEN], chunk_len);
+
+            ground.stream_bytes += chunk_len;
+        }
+    }
+    else
+    {
+        /* Invalid stream record */
+    }
+
+    return valid;
+}
+
+static bool sim_ground_stream_check(void)
+{
+    bool valid = true;
+
+    if (obdh_stream_len > 0U)
+    {
+        valid = ground.stream_end && (ground.stream_len == obdh_stream_len) && (ground.stream_bytes == obdh_stream_len) &&
+                (sim_crc16(0U, ground.stream_buf, obdh_stream_len) == ground.stream_crc);
+
+        uint32_t i = 0;
+        for(i = 0; valid && (i < obdh_stream_len); i++)
+        {
+            valid = (ground.stream_buf[i] == sim_stream_byte(obdh_stream_time_tag, i));
+        }
+    }
+
+    return valid;
+}
+
+static void sim_ground_uplink(uint8_t id, const uint8_t *payload, uint16_t payload_len, const char *key)
+{
+    uint8_t buf[FSAT_PKT_MAX_LEN] = {0};
+    uint16_t len = 0;
+
+    fsat_pkt_builder_t b = {0};
+
+    fsat_pkt_builder_init(&b, buf, sizeof(buf), id, SIM_GROUND_CALLSIGN);
+    fsat_pkt_builder_put_bytes(&b, payload, payload_len);
+
+    if ((key != NULL) && (b.err == 0))
+    {
+        /* HMAC-SHA1 of the packet (ID + callsign + payload) */
+        uint8_t hash[USHAMaxHashSize] = {0};
+
+        hmac(SHA1, b.buf, b.len, (const unsigned char*)key, (int)strlen(key), hash);
+
+        fsat_pkt_builder_put_bytes(&b, hash, SHA1HashSize);
+    }
+
+    if ((fsat_pkt_builder_finish(&b, &len) != 0) || (sl_ttc2_emu_uplink(buf, len) != 0))
+    {
+        fprintf(stderr, "Error transmitting an uplink packet!\n");
+    }
+}
+
+static bool sim_read_cmd(FILE *f, sim_cmd_t *cmd)
+{
+    char line[SIM_LINE_MAX_LEN];
+
+    while(fgets(line, sizeof(line), f) != NULL)
+    {
+        unsigned long long t = 0;
+
+        char *comment = strchr(line, '#');
+
+        if (comment != NULL)
+        {
+            *comment = '\0';
+        }
+
+        memset(cmd, 0, sizeof(sim_cmd_t));
+
+        if (sscanf(line, "%llu %15s %lu %15s", &t, cmd->cmd, &cmd->arg1, cmd->arg2) >= 2)
+        {
+            cmd->time_us = t * 1000ULL;
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool sim_run_cmd(const sim_cmd_t *cmd)
+{
+    bool end = false;
+
+    if (strcmp(cmd->cmd, "ping") == 0)
+    {
+        if (ground.pings_sent < SIM_MAX_PINGS)
+        {
+            ground.ping_sent_us[ground.pings_sent++] = sl_ttc2_emu_time_us();
+
+            sim_ground_uplink(CONFIG_PKT_ID_UPLINK_PING_REQ, NULL, 0U, NULL);
+        }
+    }
+    else if (strcmp(cmd->cmd, "store") == 0)
+    {
+        sim_obdh_store(cmd->arg1);
+    }
+    else if (strcmp(cmd->cmd, "adc") == 0)
+    {
+        sim_obdh_store_stream(cmd->arg1);
+    }
+    else if (strcmp(cmd->cmd, "data") == 0)
+    {
+        uint8_t pl[1U + 4U + 4U] = {0};
+
+        uint32_t first = (uint32_t)cmd->arg1;
+        uint32_t last = (uint32_t)strtoul(cmd->arg2, NULL, 0);
+
+        pl[0] = SIM_PL_ID;
+        pl[1] = (first >> 24) & 0xFFU;
+        pl[2] = (first >> 16) & 0xFFU;
+        pl[3] = (first >> 8) & 0xFFU;
+        pl[4] = first & 0xFFU;
+        pl[5] = (last >> 24) & 0xFFU;
+        pl[6] = (last >> 16) & 0xFFU;
+        pl[7] = (last >> 8) & 0xFFU;
+        pl[8] = last & 0xFFU;
+
+        if (ground.bulk_requests == 0U)
+        {
+            ground.bulk_request_us = sl_ttc2_emu_time_us();
+        }
+
+        ground.bulk_requests++;
+
+        sim_ground_uplink(CONFIG_PKT_ID_UPLINK_GET_PAYLOAD_DATA, pl, sizeof(pl), CONFIG_TC_KEY_GET_PAYLOAD_DATA);
+    }
+    else if (strcmp(cmd->cmd, "radio") == 0)
+    {
+        sl_ttc2_emu_set_present((uint8_t)cmd->arg1, strcmp(cmd->arg2, "off") != 0);
+    }
+    else if (strcmp(cmd->cmd, "end") == 0)
+    {
+        end = true;
+    }
+    else
+    {
+        fprintf(stderr, "Unknown script command \"%s\"!\n", cmd->cmd);
+    }
+
+    return end;
+}
+
+static void sim_obdh_store(uint32_t records)
+{
+    uint32_t i = 0;
+    for(i = 0; i < records; i++)
+    {
+        uint8_t data[PAYLOAD_DATA_MAX_LEN] = {0};
+
+        uint16_t j = 0;
+        for(j = 0; j < sizeof(data); j++)
+        {
+            data[j] = (uint8_t)(obdh_time_tag + j);
+        }
+
+        if (payload_data_write(SIM_PL_ID, PAYLOAD_DATA_TYPE_EDC_HK, obdh_time_tag, data, sizeof(data)) != 0)
+        {
+            fprintf(stderr, "Error storing a payload data record!\n");
+
+            break;
+        }
+
+        obdh_stored++;
+        obdh_time_tag++;
+    }
+}
+
+static void sim_obdh_store_stream(uint32_t len)
+{
+    payload_data_stream_t st = {0};
+
+    int err = -1;
+
+    if ((obdh_stream_len == 0U) && (len > 0U) && (len <= UINT16_MAX))
+    {
+        err = payload_data_stream_begin(&st, SIM_PL_ID, PAYLOAD_DATA_TYPE_EDC_ADC_SEQ, obdh_time_tag, (uint16_t)len);
+    }
+
+    /* Full chunks, as the read EDC task */
+    uint32_t offset = 0;
+    while((err == 0) && (offset < len))
+    {
+        uint8_t chunk[PAYLOAD_DATA_STREAM_CHUNK_LEN] = {0};
+        uint16_t chunk_len = ((len - offset) < sizeof(chunk)) ? (uint16_t)(len - offset) : (uint16_t)sizeof(chunk);
+
+        uint16_t i = 0;
+        for(i = 0; i < chunk_len; i++)
+        {
+            chunk[i] = sim_stream_byte(obdh_time_tag, offset + i);
+        }
+
+        err = payload_data_stream_write(&st, chunk, chunk_len);
+
+        offset += chunk_len;
+
+        obdh_stored++;
+    }
+
+    if ((err == 0) && (payload_data_stream_end(&st) == 0))
+    {
+        obdh_stored++;
+
+        obdh_stream_len = len;
+        obdh_stream_time_tag = obdh_time_tag++;
+    }
+    else
+    {
+        fprintf(stderr, "Error storing an ADC sequence stream (one stream of up to %u bytes per simulation)!\n", (unsigned)UINT16_MAX);
+    }
+}
+
+static uint8_t sim_stream_byte(uint32_t time_tag, uint32_t offset)
+{
+    return (uint8_t)(time_tag + offset + (offset >> 8));
+}
+
+static uint16_t sim_crc16(uint16_t initial_value, const uint8_t *data, uint32_t size)
+{
+    uint8_t x = 0;
+    uint16_t crc = initial_value;
+
+    uint32_t i = 0;
+    for(i = 0; i < size; i++)
+    {
+        x = (crc >> 8) ^ data[i];
+        x ^= x >> 4;
+        crc = (crc << 8) ^ ((uint16_t)x << 12) ^ ((uint16_t)x << 5) ^ (uint16_t)x;
+    }
+
+    return crc;
+}
+
+static void sim_report(const sl_ttc2_emu_link_t *link)
+{
+    ttc_link_stats_t link_stats = {0};
+
+    ttc_link_get_stats(&link_stats);
+
+    printf("Link: %lu bps, %lu ms latency, %u/1000 loss, %u bytes of overhead\n", (unsigned long)link->bitrate_bps, (unsigned long)link->latency_ms, (unsigned)link->loss_permille, (unsigned)link->overhead_bytes);
+    printf("Simulated time: %.3f s\n", (double)sl_ttc2_emu_time_us() / 1e6);
+
+    printf("Ping: %u sent, %u answered", (unsigned)ground.pings_sent, (unsigned)ground.pongs);
+
+    if (ground.pongs > 0U)
+    {
+        printf(", RTT min/avg/max = %.1f/%.1f/%.1f ms", (double)ground.rtt_min_us / 1e3, (double)ground.rtt_sum_us / (1e3 * ground.pongs), (double)ground.rtt_max_us / 1e3);
+    }
+
+    printf("\n");
+
+    if (ground.bulk_requests > 0U)
+    {
+        double elapsed_s = (ground.bulk_unique > 0U) ? ((double)(ground.bulk_last_us - ground.bulk_request_us) / 1e6) : 0.0;
+        double goodput_bps = (elapsed_s > 0.0) ? ((double)ground.bulk_bytes * 8.0) / elapsed_s : 0.0;
+
+        printf("Payload data: %lu request(s), %lu frames received (%lu duplicated, %lu out of order) in %.3f s\n", (unsigned long)ground.bulk_requests, (unsigned long)ground.bulk_unique, (unsigned long)ground.bulk_dups, (unsigned long)ground.bulk_out_of_order, elapsed_s);
+        printf("Records: %lu stored, %lu received (%lu corrupted)\n", (unsigned long)obdh_stored, (unsigned long)ground.bulk_records, (unsigned long)ground.bulk_bad_records);
+        if (obdh_stream_len > 0U)
+        {
+            printf("ADC sequence: %lu bytes stored, %lu received, %s\n", (unsigned long)obdh_stream_len, (unsigned long)ground.stream_bytes, sim_ground_stream_check() ? "length and CRC16 valid" : "INVALID");
+        }
+
+        printf("Goodput: %.0f bps (%.1f%% of one radio bit rate)\n", goodput_bps, (link->bitrate_bps > 0U) ? (100.0 * goodput_bps / link->bitrate_bps) : 0.0);
+    }
+
+    uint8_t i = 0;
+    for(i = 0; i < SL_TTC2_EMU_RADIOS; i++)
+    {
+        sl_ttc2_emu_stats_t stats = {0};
+
+        sl_ttc2_emu_get_stats(i, &stats);
+
+        printf("Radio %u: %lu TX (%lu lost, %lu refused), %lu RX (%lu lost), %lu at the ground station\n", (unsigned)i, (unsigned long)stats.tx_pkts, (unsigned long)stats.tx_lost, (unsigned long)stats.tx_overflows, (unsigned long)stats.rx_pkts, (unsigned long)stats.rx_lost, (unsigned long)ground.dl_frames[i]);
+    }
+
+    printf("TTC link: %lu frames by TTC_0, %lu by TTC_1, %lu failovers, %lu busy, %lu failed\n", (unsigned long)link_stats.tx_pkts[TTC_0], (unsigned long)link_stats.tx_pkts[TTC_1], (unsigned long)link_stats.failovers, (unsigned long)link_stats.busy, (unsigned long)link_stats.errors);
+}
+
+/** \} End of ttc_link_sim group */
@@ -0,0 +1,474 @@
+/*
+ * payload_data_test.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Unit test of the payload data storage.
+ *
+ * The NOR and FRAM memories are emulated in RAM. A NOR write can only clear bits, so a record
+ * written over a page that was not erased is detected as corrupted.
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.25
+ *
+ * \date 2022/12/20
+ *
+ * \defgroup payload_data_unit_test Payload Data
+ * \ingroup tests
+ * \{
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <setjmp.h>
+#include <float.h>
+#include <string.h>
+#include <cmocka.h>
+
+#include <config/config.h>
+#include <devices/media/media.h>
+#include <structs/payload_data.h>
+
+#define PAYLOAD_DATA_TEST_NOR_SIZE          (2UL*CONFIG_MEM_PAYLOAD_DATA_SIZE)
+#define PAYLOAD_DATA_TEST_SUB_SECTOR_SIZE   4096UL
+#define PAYLOAD_DATA_TEST_FRAM_SIZE         256UL
+#define PAYLOAD_DATA_TEST_SLOTS             (CONFIG_MEM_PAYLOAD_DATA_SIZE / PAYLOAD_DATA_RECORD_SIZE)
+#define PAYLOAD_DATA_TEST_SLOTS_PER_SUB     (PAYLOAD_DATA_TEST_SUB_SECTOR_SIZE / PAYLOAD_DATA_RECORD_SIZE)
+#define PAYLOAD_DATA_TEST_REGION_START      (PAYLOAD_DATA_TEST_NOR_SIZE - CONFIG_MEM_PAYLOAD_DATA_SIZE)
+
+static uint8_t nor_mem[PAYLOAD_DATA_TEST_NOR_SIZE];
+static uint8_t fram_mem[PAYLOAD_DATA_TEST_FRAM_SIZE];
+
+static uint32_t nor_reads = 0;
+static uint32_t nor_erases = 0;
+static uint32_t nor_min_write_adr = UINT32_MAX;
+
+int __wrap_media_read(media_t med, uint32_t adr, uint8_t *data, uint16_t len);
+int __wrap_media_write(media_t med, uint32_t adr, uint8_t *data, uint16_t len);
+int __wrap_media_erase(media_t med, media_erase_t type, uint32_t sector);
+media_info_t __wrap_media_get_info(media_t med);
+
+static void reset_memories(void);
+static void write_records(sys_time_t first, uint32_t qty, sys_time_t step);
+static void check_records(sys_time_t start, sys_time_t end, sys_time_t *expected, uint32_t qty);
+
+static void payload_data_write_test(void **state)
+{
+    reset_memories();
+
+    uint8_t data[PAYLOAD_DATA_MAX_LEN + 1U] = {0};
+
+    uint16_t i = 0;
+    for(i = 0; i < sizeof(data); i++)
+    {
+        data[i] = i & 0xFFU;
+    }
+
+    /* Records longer than a downlink frame are rejected */
+    assert_int_equal(payload_data_write(CONFIG_PL_ID_EDC_1, PAYLOAD_DATA_TYPE_EDC_HK, 10, data, PAYLOAD_DATA_MAX_LEN + 1U), -1);
+    assert_int_equal(payload_data_get_count(), 0);
+
+    assert_return_code(payload_data_write(CONFIG_PL_ID_EDC_1, PAYLOAD_DATA_TYPE_EDC_HK, 10, data, PAYLOAD_DATA_MAX_LEN), 0);
+    assert_return_code(payload_data_write(CONFIG_PL_ID_EDC_2, PAYLOAD_DATA_TYPE_EDC_PTT, 20, data, 1U), 0);
+
+    assert_int_equal(payload_data_get_count(), 2);
+
+    payload_data_cursor_t cur = {0};
+    payload_data_record_t rec = {0};
+
+    assert_return_code(payload_data_seek(0, UINT32_MAX, &cur), 0);
+
+    assert_return_code(payload_data_next(&cur, &rec), 0);
+    assert_int_equal(rec.pl_id, CONFIG_PL_ID_EDC_1);
+    assert_int_equal(rec.type, PAYLOAD_DATA_TYPE_EDC_HK);
+    assert_int_equal(rec.time_tag, 10);
+    assert_int_equal(rec.length, PAYLOAD_DATA_MAX_LEN);
+    assert_memory_equal(rec.data, data, PAYLOAD_DATA_MAX_LEN);
+
+    assert_return_code(payload_data_next(&cur, &rec), 0);
+    assert_int_equal(rec.pl_id, CONFIG_PL_ID_EDC_2);
+    assert_int_equal(rec.time_tag, 20);
+    assert_int_equal(rec.length, 1);
+
+    assert_int_equal(payload_data_next(&cur, &rec), -1);
+
+    /* The records are stored at the end of the NOR memory */
+    assert_true(nor_min_write_adr >= PAYLOAD_DATA_TEST_REGION_START);
+
+    /* The index is kept across a reset */
+    assert_return_code(payload_data_init(), 0);
+    assert_int_equal(payload_data_get_count(), 2);
+
+    sys_time_t expected[] = {20};
+
+    check_records(15, 25, expected, 1);
+}
+
+static void payload_data_seek_test(void **state)
+{
+    reset_memories();
+
+    write_records(0, 100, 10);
+
+    sys_time_t expected[21] = {0};
+
+    uint32_t i = 0;
+    for(i = 0; i < 21U; i++)
+    {
+        expected[i] = 500U + (10U*i);
+    }
+
+    /* Bisection over the ring in chronological order */
+    payload_data_cursor_t cur = {0};
+
+    nor_reads = 0;
+
+    assert_return_code(payload_data_seek(495, 700, &cur), 0);
+
+    assert_true(nor_reads <= 8U);
+    assert_int_equal(cur.remaining, 50);
+    assert_int_equal(cur.unsorted, 0);
+
+    check_records(495, 700, expected, 21);
+    check_records(500, 700, expected, 21);
+
+    /* Interval out of the stored records */
+    check_records(1000, 2000, NULL, 0);
+    check_records(1, 9, NULL, 0);
+}
+
+static void payload_data_unsorted_test(void **state)
+{
+    reset_memories();
+
+    write_records(100, 10, 10);
+
+    /* System time set back */
+    write_records(50, 3, 10);
+
+    payload_data_cursor_t cur = {0};
+
+    assert_return_code(payload_data_seek(60, 120, &cur), 0);
+
+    assert_int_equal(cur.remaining, 13);
+
+    sys_time_t expected[] = {100, 110, 120, 60, 70};
+
+    check_records(60, 120, expected, 5);
+
+    /* The order is kept across a reset */
+    assert_return_code(payload_data_init(), 0);
+
+    check_records(60, 120, expected, 5);
+
+    /* Only the newest records are in order after a clear */
+    assert_return_code(payload_data_clear(), 0);
+
+    write_records(1000, 20, 1);
+
+    assert_return_code(payload_data_seek(1010, 1011, &cur), 0);
+
+    assert_int_equal(cur.unsorted, 0);
+    assert_int_equal(cur.remaining, 10);
+}
+
+static void payload_data_invalid_records_test(void **state)
+{
+    reset_memories();
+
+    write_records(0, 20, 1);
+
+    /* Corrupted record (bad CRC) */
+    nor_mem[PAYLOAD_DATA_TEST_REGION_START + (5U*PAYLOAD_DATA_RECORD_SIZE) + PAYLOAD_DATA_RECORD_HEADER_LEN] ^= 0x01U;
+
+    /* Erased record (in the middle of the bisection) */
+    memset(&nor_mem[PAYLOAD_DATA_TEST_REGION_START + (10U*PAYLOAD_DATA_RECORD_SIZE)], 0xFF, PAYLOAD_DATA_RECORD_SIZE);
+
+    payload_data_cursor_t cur = {0};
+
+    /* An invalid record found by the bisection falls back to a linear scan */
+    assert_return_code(payload_data_seek(12, 19, &cur), 0);
+
+    assert_int_equal(cur.remaining, 20);
+
+    sys_time_t expected[] = {3, 4, 6, 7, 8, 9, 11, 12};
+
+    check_records(3, 12, expected, 8);
+}
+
+static void payload_data_wrap_test(void **state)
+{
+    reset_memories();
+
+    uint32_t qty = PAYLOAD_DATA_TEST_SLOTS + 40U;
+
+    write_records(0, qty, 1);
+
+    uint32_t count = payload_data_get_count();
+
+    /* The oldest sub-sector is dropped when the ring is full */
+    assert_true(count <= PAYLOAD_DATA_TEST_SLOTS);
+    assert_true(count > (PAYLOAD_DATA_TEST_SLOTS - PAYLOAD_DATA_TEST_SLOTS_PER_SUB));
+
+    /* The records never leave the payload data region */
+    assert_true(nor_min_write_adr >= PAYLOAD_DATA_TEST_REGION_START);
+
+    payload_data_cursor_t cur = {0};
+    payload_data_record_t rec = {0};
+
+    assert_return_code(payload_data_seek(0, UINT32_MAX, &cur), 0);
+
+    sys_time_t time_tag = qty - count;
+
+    while(payload_data_next(&cur, &rec) == 0)
+    {
+        assert_int_equal(rec.time_tag, time_tag);
+
+        time_tag++;
+    }
+
+    assert_int_equal(time_tag, qty);
+
+    /* Bisection across the end of the region */
+    sys_time_t expected[] = {qty - 45U, qty - 44U, qty - 43U};
+
+    nor_reads = 0;
+
+    assert_return_code(payload_data_seek(qty - 45U, qty - 43U, &cur), 0);
+
+    assert_true(nor_reads <= 13U);
+    assert_int_equal(cur.unsorted, 0);
+
+    check_records(qty - 45U, qty - 43U, expected, 3);
+}
+
+static void payload_data_reserve_test(void **state)
+{
+    reset_memories();
+
+    /* Leave the head in the middle of a sub-sector */
+    write_records(0, 3, 1);
+
+    uint16_t len = 10U*PAYLOAD_DATA_STREAM_CHUNK_LEN;
+    uint8_t chunk[PAYLOAD_DATA_STREAM_CHUNK_LEN] = {0};
+
+    memset(chunk, 0xA5, sizeof(chunk));
+
+    payload_data_stream_t st = {0};
+
+    nor_erases = 0;
+
+    assert_return_code(payload_data_stream_begin(&st, CONFIG_PL_ID_EDC_1, PAYLOAD_DATA_TYPE_EDC_ADC_SEQ, 3, len), 0);
+
+    /* 10 chunks + the final record fit in the rest of the sub-sector (13 slots) */
+    assert_int_equal(nor_erases, 0);
+
+    len = 20U*PAYLOAD_DATA_STREAM_CHUNK_LEN;
+
+    assert_return_code(payload_data_stream_begin(&st, CONFIG_PL_ID_EDC_1, PAYLOAD_DATA_TYPE_EDC_ADC_SEQ, 3, len), 0);
+
+    /* 20 chunks + the final record need one more sub-sector */
+    assert_int_equal(nor_erases, 1);
+
+    nor_erases = 0;
+
+    uint32_t i = 0;
+    for(i = 0; i < 20U; i++)
+    {
+        assert_return_code(payload_data_stream_write(&st, chunk, sizeof(chunk)), 0);
+    }
+
+    assert_return_code(payload_data_stream_end(&st), 0);
+
+    /* The whole stream is written without erasing the memory */
+    assert_int_equal(nor_erases, 0);
+    assert_int_equal(payload_data_get_count(), 3U + 21U);
+
+    /* Chunks longer than the limit are rejected */
+    uint8_t long_chunk[PAYLOAD_DATA_STREAM_CHUNK_LEN + 1U] = {0};
+
+    assert_int_equal(payload_data_stream_write(&st, long_chunk, sizeof(long_chunk)), -1);
+
+    /* The reserved sub-sectors drop the oldest records of a full ring */
+    assert_return_code(payload_data_clear(), 0);
+
+    write_records(100, PAYLOAD_DATA_TEST_SLOTS - PAYLOAD_DATA_TEST_SLOTS_PER_SUB, 1);
+
+    nor_erases = 0;
+
+    assert_return_code(payload_data_stream_begin(&st, CONFIG_PL_ID_EDC_1, PAYLOAD_DATA_TYPE_EDC_ADC_SEQ, 100000, len), 0);
+
+    assert_int_equal(nor_erases, 2);
+    assert_int_equal(payload_data_get_count(), PAYLOAD_DATA_TEST_SLOTS - (2U*PAYLOAD_DATA_TEST_SLOTS_PER_SUB));
+
+    payload_data_cursor_t cur = {0};
+    payload_data_record_t rec = {0};
+
+    assert_return_code(payload_data_seek(0, UINT32_MAX, &cur), 0);
+    assert_return_code(payload_data_next(&cur, &rec), 0);
+
+    assert_int_equal(rec.time_tag, 100U + PAYLOAD_DATA_TEST_SLOTS_PER_SUB);
+}
+
+int main(void)
+{
+    const struct CMUnitTest payload_data_tests[] = {
+        cmocka_unit_test(payload_data_write_test),
+        cmocka_unit_test(payload_data_seek_test),
+        cmocka_unit_test(payload_data_unsorted_test),
+        cmocka_unit_test(payload_data_invalid_records_test),
+        cmocka_unit_test(payload_data_wrap_test),
+        cmocka_unit_test(payload_data_reserve_test),
+    };
+
+    return cmocka_run_group_tests(payload_data_tests, NULL, NULL);
+}
+
+static void reset_memories(void)
+{
+    /* Non-erased memory: any write to a page not erased by the storage corrupts the record */
+    memset(nor_mem, 0x00, sizeof(nor_mem));
+    memset(fram_mem, 0x00, sizeof(fram_mem));
+
+    nor_min_write_adr = UINT32_MAX;
+
+    assert_return_code(payload_data_init(), 0);
+    assert_int_equal(payload_data_get_count(), 0);
+}
+
+static void write_records(sys_time_t first, uint32_t qty, sys_time_t step)
+{
+    uint32_t i = 0;
+    for(i = 0; i < qty; i++)
+    {
+        uint8_t data[4] = {0};
+
+        data[0] = (i >> 24) & 0xFFU;
+        data[1] = (i >> 16) & 0xFFU;
+        data[2] = (i >> 8) & 0xFFU;
+        data[3] = i & 0xFFU;
+
+        assert_return_code(payload_data_write(CONFIG_PL_ID_EDC_1, PAYLOAD_DATA_TYPE_EDC_HK, first + (i*step), data, sizeof(data)), 0);
+    }
+}
+
+static void check_records(sys_time_t start, sys_time_t end, sys_time_t *expected, uint32_t qty)
+{
+    payload_data_cursor_t cur = {0};
+    payload_data_record_t rec = {0};
+
+    assert_return_code(payload_data_seek(start, end, &cur), 0);
+
+    uint32_t i = 0;
+    for(i = 0; i < qty; i++)
+    {
+        assert_return_code(payload_data_next(&cur, &rec), 0);
+        assert_int_equal(rec.time_tag, expected[i]);
+    }
+
+    assert_int_equal(payload_data_next(&cur, &rec), -1);
+}
+
+int __wrap_media_read(media_t med, uint32_t adr, uint8_t *data, uint16_t len)
+{
+    int err = -1;
+
+    if ((med == MEDIA_NOR) && ((adr + len) <= PAYLOAD_DATA_TEST_NOR_SIZE))
+    {
+        memcpy(data, &nor_mem[adr], len);
+
+        nor_reads++;
+
+        err = 0;
+    }
+    else if ((med == MEDIA_FRAM) && ((adr + len) <= PAYLOAD_DATA_TEST_FRAM_SIZE))
+    {
+        memcpy(data, &fram_mem[adr], len);
+
+        err = 0;
+    }
+
+    return err;
+}
+
+int __wrap_media_write(media_t med, uint32_t adr, uint8_t *data, uint16_t len)
+{
+    int err = -1;
+
+    if ((med == MEDIA_NOR) && ((adr + len) <= PAYLOAD_DATA_TEST_NOR_SIZE))
+    {
+        uint16_t i = 0;
+        for(i = 0; i < len; i++)
+        {
+            nor_mem[adr + i] &= data[i];
+        }
+
+        if (adr < nor_min_write_adr)
+        {
+            nor_min_write_adr = adr;
+        }
+
+        err = 0;
+    }
+    else if ((med == MEDIA_FRAM) && ((adr + len) <= PAYLOAD_DATA_TEST_FRAM_SIZE))
+    {
+        memcpy(&fram_mem[adr], data, len);
+
+        err = 0;
+    }
+
+    return err;
+}
+
+int __wrap_media_erase(media_t med, media_erase_t type, uint32_t sector)
+{
+    int err = -1;
+
+    if ((med == MEDIA_NOR) && (type == MEDIA_ERASE_SUB_SECTOR) && (sector < (PAYLOAD_DATA_TEST_NOR_SIZE / PAYLOAD_DATA_TEST_SUB_SECTOR_SIZE)))
+    {
+        memset(&nor_mem[sector*PAYLOAD_DATA_TEST_SUB_SECTOR_SIZE], 0xFF, PAYLOAD_DATA_TEST_SUB_SECTOR_SIZE);
+
+        nor_erases++;
+
+        err = 0;
+    }
+
+    return err;
+}
+
+media_info_t __wrap_media_get_info(media_t med)
+{
+    media_info_t info = {0};
+
+    if (med == MEDIA_NOR)
+    {
+        info.size               = PAYLOAD_DATA_TEST_NOR_SIZE;
+        info.sub_sector_size    = PAYLOAD_DATA_TEST_SUB_SECTOR_SIZE;
+        info.page_size          = PAYLOAD_DATA_RECORD_SIZE;
+    }
+
+    return info;
+}
+
+/** \} End of payload_data_unit_test group */
@@ -0,0 +1,3 @@
+#!/bin/bash
+
+./payload_data_unit_test
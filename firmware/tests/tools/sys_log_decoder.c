@@ -0,0 +1,508 @@
+/*
+ * sys_log_decoder.c
+ *
+ * Copyright The OBDH 2.0 Contributors.
+ *
+ * This file is part of OBDH 2.0.
+ *
+ * OBDH 2.0 is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * OBDH 2.0 is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with OBDH 2.0. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * \brief Host decoder of the system log output.
+ *
+ * Reads the raw output of the system log UART from the standard input. The text messages are
+ * copied to the standard output as they are, and the tokenized frames are decoded with the
+ * dictionary of the firmware (sys_log_tokens.def and sys_log_modules.def, built in this tool).
+ * Frames with an invalid checksum are copied as raw bytes, so the decoder resynchronizes on
+ * the next sync byte.
+ *
+ * With the option "-b", the input is a dump of black box records (the records of the "black
+ * box" downlink frames, concatenated), rendered with the same dictionary. The time of these
+ * records is the system time in seconds (instead of the milliseconds since the boot).
+ *
+ * With the option "-s", the events are not printed: the stack monitor records (stack size and
+ * lowest free stack of each task) are collected and a stack budget report is printed at the end.
+ * The task index is the same of the CPU usage table (task creation order).
+ *
+ * \author Gabriel Mariano Marcelino <gabriel.mm8@gmail.com>
+ *
+ * \version 0.10.25
+ *
+ * \date 2022/12/08
+ *
+ * \defgroup sys_log_decoder System Log Decoder
+ * \ingroup tests
+ * \{
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <unistd.h>
+
+#include <config/config.h>
+#include <system/sys_log/sys_log.h>
+
+#define STACK_MARGIN_PERCENT        25U     /**< Margin over the used stack of the suggested stack sizes. */
+
+static const char *const modules[SYS_LOG_MODULES] =
+{
+#define SYS_LOG_MODULE(id, name)    name,
+#include <system/sys_log/sys_log_modules.def>
+#undef SYS_LOG_MODULE
+};
+
+static const char *const tokens[SYS_LOG_TOKENS] =
+{
+#define SYS_LOG_TOKEN(id, fmt)      fmt,
+#include <system/sys_log/sys_log_tokens.def>
+#undef SYS_LOG_TOKEN
+};
+
+static bool stack_report = false;
+
+static uint32_t stack_sizes[CONFIG_CPU_USAGE_MAX_TASKS] = {0};
+static uint32_t stack_min_free[CONFIG_CPU_USAGE_MAX_TASKS] = {0};
+static bool stack_sampled[CONFIG_CPU_USAGE_MAX_TASKS] = {0};
+
+/**
+ * \brief Reads a little-endian unsigned integer.
+ *
+ * \param[in] buf is the buffer with the value.
+ *
+ * \param[in] len is the number of bytes of the value.
+ *
+ * \return The read value.
+ */
+static uint32_t get_le(const uint8_t *buf, uint8_t len);
+
+/**
+ * \brief Reads a big-endian unsigned integer.
+ *
+ * \param[in] buf is the buffer with the value.
+ *
+ * \param[in] len is the number of bytes of the value.
+ *
+ * \return The read value.
+ */
+static uint32_t get_be(const uint8_t *buf, uint8_t len);
+
+/**
+ * \brief Prints the dictionary as CSV (kind, ID, text).
+ *
+ * \return None.
+ */
+static void print_dictionary(void);
+
+/**
+ * \brief Prints a decoded frame.
+ *
+ * \param[in] frame is the frame (SYS_LOG_FRAME_LEN bytes, with a valid checksum).
+ *
+ * \return None.
+ */
+static void print_frame(const uint8_t *frame);
+
+/**
+ * \brief Decodes a capture of the system log UART from the standard input.
+ *
+ * \return None.
+ */
+static void decode_uart(void);
+
+/**
+ * \brief Decodes a dump of black box records from the standard input.
+ *
+ * \return None.
+ */
+static void decode_black_box(void);
+
+/**
+ * \brief Copies a text character of the capture (not in the stack report).
+ *
+ * \param[in] c is the character.
+ *
+ * \return None.
+ */
+static void put_text(int c);
+
+/**
+ * \brief Handles a decoded event (printed, or collected in the stack report).
+ *
+ * \param[in] time is the timestamp of the event (milliseconds, or seconds in the black box).
+ *
+ * \param[in] module is the module ID.
+ *
+ * \param[in] type is the event type.
+ *
+ * \param[in] token is the token ID.
+ *
+ * \param[in] args are the two arguments of the event.
+ *
+ * \return None.
+ */
+static void handle_event(uint32_t time, uint8_t module, uint8_t type, uint16_t token, const uint32_t *args);
+
+/**
+ * \brief Prints the stack budget report (CSV) of the collected stack monitor records.
+ *
+ * The used stack is the stack size minus the lowest free stack, and the suggested size is the
+ * used stack plus a margin (STACK_MARGIN_PERCENT, at least CONFIG_STACK_MONITOR_MIN_FREE).
+ *
+ * \return None.
+ */
+static void print_stack_report(void);
+
+/**
+ * \brief Prints a decoded event.
+ *
+ * \param[in] time is the timestamp of the event (milliseconds, or seconds in the black box).
+ *
+ * \param[in] module is the module ID.
+ *
+ * \param[in] type is the event type.
+ *
+ * \param[in] token is the token ID.
+ *
+ * \param[in] args are the two arguments of the event.
+ *
+ * \return None.
+ */
+static void print_event(uint32_t time, uint8_t module, uint8_t type, uint16_t token, const uint32_t *args);
+
+int main(int argc, char **argv)
+{
+    bool black_box = false;
+    int opt = 0;
+
+    while((opt = getopt(argc, argv, "dbs")) != -1)
+    {
+        switch(opt)
+        {
+            case 'd':
+                print_dictionary();
+                return 0;
+            case 'b':
+                black_box = true;
+                break;
+            case 's':
+                stack_report = true;
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-d | [-b] [-s]] < capture\n", argv[0]);
+                return 1;
+        }
+    }
+
+    if (black_box)
+    {
+        decode_black_box();
+    }
+    else
+    {
+        decode_uart();
+    }
+
+    if (stack_report)
+    {
+        print_stack_report();
+    }
+
+    return 0;
+}
+
+static uint32_t get_le(const uint8_t *buf, uint8_t len)
+{
+    uint32_t val = 0;
+
+    uint8_t i = 0;
+    for(i = 0; i < len; i++)
+    {
+        val |= (uint32_t)buf[i] << (8U * i);
+    }
+
+    return val;
+}
+
+static uint32_t get_be(const uint8_t *buf, uint8_t len)
+{
+    uint32_t val = 0;
+
+    uint8_t i = 0;
+    for(i = 0; i < len; i++)
+    {
+        val = (val << 8) | buf[i];
+    }
+
+    return val;
+}
+
+static void print_dictionary(void)
+{
+    printf("kind,id,text\n");
+
+    unsigned int i = 0;
+    for(i = 0; i < SYS_LOG_MODULES; i++)
+    {
+        printf("module,%u,\"%s\"\n", i, modules[i]);
+    }
+
+    for(i = 0; i < SYS_LOG_TOKENS; i++)
+    {
+        printf("token,%u,\"", i);
+
+        const char *c = tokens[i];
+        for(; *c != '\0'; c++)
+        {
+            if (*c == '"')
+            {
+                putchar('"');   /* CSV escape */
+            }
+
+            putchar(*c);
+        }
+
+        printf("\"\n");
+    }
+}
+
+static void print_frame(const uint8_t *frame)
+{
+    uint32_t args[2] = {get_le(&frame[9], 4), get_le(&frame[13], 4)};
+
+    handle_event(get_le(&frame[1], 4), frame[7], frame[8], (uint16_t)get_le(&frame[5], 2), args);
+}
+
+static void decode_uart(void)
+{
+    uint8_t frame[SYS_LOG_FRAME_LEN] = {0};
+    uint8_t len = 0;
+    int c = 0;
+
+    while((c = getchar()) != EOF)
+    {
+        if (len == 0U)
+        {
+            if ((uint8_t)c == SYS_LOG_FRAME_SYNC)
+            {
+                frame[len++] = (uint8_t)c;
+            }
+            else
+            {
+                put_text(c);
+            }
+
+            continue;
+        }
+
+        frame[len++] = (uint8_t)c;
+
+        if (len == SYS_LOG_FRAME_LEN)
+        {
+            uint8_t xor = 0;
+            uint8_t i = 0;
+            for(i = 1; i < (SYS_LOG_FRAME_LEN - 1U); i++)
+            {
+                xor ^= frame[i];
+            }
+
+            if (xor == frame[SYS_LOG_FRAME_LEN - 1U])
+            {
+                print_frame(frame);
+                len = 0;
+            }
+            else
+            {
+                /* Not a frame: copies the sync byte and looks for another one in the rest */
+                put_text(frame[0]);
+
+                uint8_t j = 0;
+                for(i = 1; i < SYS_LOG_FRAME_LEN; i++)
+                {
+                    if ((j == 0U) && (frame[i] != SYS_LOG_FRAME_SYNC))
+                    {
+                        put_text(frame[i]);
+                    }
+                    else
+                    {
+                        frame[j++] = frame[i];
+                    }
+                }
+
+                len = j;
+            }
+        }
+    }
+
+    /* Incomplete frame at the end of the capture */
+    uint8_t i = 0;
+    for(i = 0; i < len; i++)
+    {
+        put_text(frame[i]);
+    }
+
+}
+
+
+static void decode_black_box(void)
+{
+    uint8_t rec[SYS_LOG_BLACK_BOX_RECORD_LEN] = {0};
+
+    while(fread(rec, 1, sizeof(rec), stdin) == sizeof(rec))
+    {
+        uint32_t args[2] = {get_be(&rec[8], 4), get_be(&rec[12], 4)};
+
+        handle_event(get_be(&rec[0], 4), rec[4], rec[5], (uint16_t)get_be(&rec[6], 2), args);
+    }
+}
+
+static void put_text(int c)
+{
+    if (!stack_report)
+    {
+        putchar(c);
+    }
+}
+
+static void handle_event(uint32_t time, uint8_t module, uint8_t type, uint16_t token, const uint32_t *args)
+{
+    if (!stack_report)
+    {
+        print_event(time, module, type, token, args);
+    }
+    else if ((token == SYS_LOG_TOK_STACK_SIZE) && (args[0] < CONFIG_CPU_USAGE_MAX_TASKS))
+    {
+        stack_sizes[args[0]] = args[1];
+    }
+    else if ((token == SYS_LOG_TOK_STACK_MIN_FREE) && (args[0] < CONFIG_CPU_USAGE_MAX_TASKS))
+    {
+        /* The lowest value of all the records (including the ones before a reset) */
+        if (!stack_sampled[args[0]] || (args[1] < stack_min_free[args[0]]))
+        {
+            stack_min_free[args[0]] = args[1];
+            stack_sampled[args[0]] = true;
+        }
+    }
+    else
+    {
+        /* Not a stack monitor record */
+    }
+}
+
+static void print_stack_report(void)
+{
+    printf("task,stack_size,min_free,used,suggested_size,status\n");
+
+    unsigned int i = 0;
+    for(i = 0; i < CONFIG_CPU_USAGE_MAX_TASKS; i++)
+    {
+        if ((stack_sizes[i] == 0U) && !stack_sampled[i])
+        {
+            continue;   /* No records of this task */
+        }
+
+        printf("%u,", i);
+
+        if ((stack_sizes[i] == 0U) || !stack_sampled[i])
+        {
+            /* The size is logged only in the first sample after a reset, and the minimum from the second one */
+            if (stack_sizes[i] == 0U)
+            {
+                printf(",%lu,,,no size\n", (unsigned long)stack_min_free[i]);
+            }
+            else
+            {
+                printf("%lu,,,,no data\n", (unsigned long)stack_sizes[i]);
+            }
+
+            continue;
+        }
+
+        printf("%lu,", (unsigned long)stack_sizes[i]);
+
+        uint32_t used = (stack_min_free[i] < stack_sizes[i]) ? (stack_sizes[i] - stack_min_free[i]) : 0U;
+        uint32_t margin = (used * STACK_MARGIN_PERCENT + 99U) / 100U;
+
+        if (margin < CONFIG_STACK_MONITOR_MIN_FREE)
+        {
+            margin = CONFIG_STACK_MONITOR_MIN_FREE;
+        }
+
+        const char *status = "ok";
+
+        if (stack_min_free[i] < CONFIG_STACK_MONITOR_MIN_FREE)
+        {
+            status = "low";
+        }
+        else if (stack_min_free[i] > margin)
+        {
+            status = "oversized";
+        }
+        else
+        {
+            /* Within the margin */
+        }
+
+        printf("%lu,%lu,%lu,%s\n", (unsigned long)stack_min_free[i], (unsigned long)used, (unsigned long)(used + margin), status);
+    }
+}
+
+static void print_event(uint32_t time, uint8_t module, uint8_t type, uint16_t token, const uint32_t *args)
+{
+    printf("[ %lu ] %s: ", (unsigned long)time, (module < SYS_LOG_MODULES) ? modules[module] : "Unknown module");
+
+    switch(type)
+    {
+        case SYS_LOG_WARNING:   printf("WARNING: ");    break;
+        case SYS_LOG_ERROR:     printf("ERROR: ");      break;
+        default:                                        break;
+    }
+
+    if (token >= SYS_LOG_TOKENS)
+    {
+        printf("Unknown token %u (%lu, %lu)\n", token, (unsigned long)args[0], (unsigned long)args[1]);
+        return;
+    }
+
+    const char *fmt = tokens[token];
+    unsigned int arg = 0;
+
+    for(; *fmt != '\0'; fmt++)
+    {
+        if ((*fmt == '%') && (fmt[1] != '\0'))
+        {
+            fmt++;
+
+            uint32_t val = (arg < 2U) ? args[arg] : 0U;
+
+            switch(*fmt)
+            {
+                case 'u':   printf("%lu", (unsigned long)val);      arg++;  break;
+                case 'd':   printf("%ld", (long)(int32_t)val);      arg++;  break;
+                case 'x':   printf("0x%02lX", (unsigned long)val);  arg++;  break;
+                default:    putchar(*fmt);                                  break;
+            }
+        }
+        else
+        {
+            putchar(*fmt);
+        }
+    }
+
+    printf("\n\r");
+}
+
+/** \} End of sys_log_decoder group */